@@ -0,0 +1,80 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Tiny timing harness shared by the benchmark executable.
+// Build Release|x64 and run Benchmarks.exe [name...] [--json path] [--label text]
+// from the repo root.
+
+struct BenchmarkOptions {
+    std::string jsonPath;   // --json: benchmarks with machine readable output write it here, stdout otherwise
+    std::string label;      // --label: stored in that output, e.g. the commit being measured
+};
+
+const BenchmarkOptions& getBenchmarkOptions();
+
+struct AllocationStats {
+    size_t count = 0;
+    size_t bytes = 0;
+};
+
+// Counted by the global operator new in BenchmarkMain.cpp
+AllocationStats getAllocationStats();
+
+struct BenchmarkResult {
+    std::string name;
+    int iterations = 0;
+    double minMs = 0.0;
+    double medianMs = 0.0;
+    double meanMs = 0.0;
+    AllocationStats allocationsPerRun;
+};
+
+template<typename Fn>
+BenchmarkResult runBenchmark(const std::string& name, int iterations, Fn&& fn) {
+    std::vector<double> samples;
+    samples.reserve(iterations);
+
+    fn();   // warm up caches and the allocator
+
+    AllocationStats before = getAllocationStats();
+    for (int i = 0; i < iterations; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        fn();
+        auto end = std::chrono::steady_clock::now();
+        samples.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+    }
+    AllocationStats after = getAllocationStats();
+
+    BenchmarkResult result;
+    result.name = name;
+    result.iterations = iterations;
+    result.allocationsPerRun.count = (after.count - before.count) / iterations;
+    result.allocationsPerRun.bytes = (after.bytes - before.bytes) / iterations;
+
+    double total = 0.0;
+    for (double sample : samples) total += sample;
+    result.meanMs = total / iterations;
+
+    std::sort(samples.begin(), samples.end());
+    result.minMs = samples.front();
+    result.medianMs = samples[samples.size() / 2];
+    return result;
+}
+
+inline void printResult(const BenchmarkResult& result) {
+    std::printf("  %-28s min %9.3f ms  median %9.3f ms  mean %9.3f ms  %10zu allocs %12zu bytes\n",
+        result.name.c_str(), result.minMs, result.medianMs, result.meanMs,
+        result.allocationsPerRun.count, result.allocationsPerRun.bytes);
+}
+
+// Individual benchmarks, return 0 on success
+int runMapLoadBenchmark();
+int runCollisionBenchmark();
+int runShapeBenchmark();
+int runRaycastBenchmark();
+int runProximityBenchmark();
+int runSceneBenchmark();
@@ -0,0 +1,98 @@
+#include "Benchmark.h"
+#include <atomic>
+#include <cstdlib>
+#include <cstring>
+#include <new>
+
+namespace {
+    std::atomic<size_t> g_allocationCount{ 0 };
+    std::atomic<size_t> g_allocationBytes{ 0 };
+
+    struct BenchmarkEntry {
+        const char* name;
+        int (*run)();
+        const char* description;
+    };
+
+    const BenchmarkEntry BENCHMARKS[] = {
+        { "mapload", runMapLoadBenchmark, "DOM walk vs AreaSaxLoader on a generated 10 MB area" },
+        { "collision", runCollisionBenchmark, "per-object collider checks vs the SoA SIMD kernels" },
+        { "shapes", runShapeBenchmark, "each shape pair, RTTI vs tag dispatch" },
+        { "raycast", runRaycastBenchmark, "brute force rays vs the grid walk and raycastBatch" },
+        { "proximity", runProximityBenchmark, "per-trigger radius tests vs the batched proximity kernel" },
+        { "scenes", runSceneBenchmark, "broadphase costs on generated areas of 100 to 100k colliders, --json for comparing commits" },
+    };
+
+    void printUsage() {
+        std::printf("usage: Benchmarks [--json <file>] [--label <name>] [benchmark...]\n");
+        std::printf("runs every benchmark when none is named\n\n");
+        for (const auto& benchmark : BENCHMARKS) {
+            std::printf("  %-10s %s\n", benchmark.name, benchmark.description);
+        }
+    }
+
+    BenchmarkOptions g_options;
+}
+
+const BenchmarkOptions& getBenchmarkOptions() {
+    return g_options;
+}
+
+void* operator new(std::size_t size) {
+    g_allocationCount.fetch_add(1, std::memory_order_relaxed);
+    g_allocationBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* memory = std::malloc(size ? size : 1)) {
+        return memory;
+    }
+    throw std::bad_alloc();
+}
+
+void operator delete(void* memory) noexcept {
+    std::free(memory);
+}
+
+void operator delete(void* memory, std::size_t) noexcept {
+    std::free(memory);
+}
+
+AllocationStats getAllocationStats() {
+    AllocationStats stats;
+    stats.count = g_allocationCount.load(std::memory_order_relaxed);
+    stats.bytes = g_allocationBytes.load(std::memory_order_relaxed);
+    return stats;
+}
+
+int main(int argc, char* argv[]) {
+    std::vector<const char*> names;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            g_options.jsonPath = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--label") == 0 && i + 1 < argc) {
+            g_options.label = argv[++i];
+        }
+        else if (std::strcmp(argv[i], "--help") == 0) {
+            printUsage();
+            return 0;
+        }
+        else {
+            names.push_back(argv[i]);
+        }
+    }
+
+    int failures = 0;
+    for (const auto& benchmark : BENCHMARKS) {
+        bool selected = names.empty();
+        for (const char* name : names) {
+            selected = selected || std::strcmp(name, benchmark.name) == 0;
+        }
+        if (!selected) continue;
+
+        std::printf("[%s]\n", benchmark.name);
+        if (benchmark.run() != 0) {
+            std::printf("  FAILED\n");
+            ++failures;
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,96 @@
+#include "Benchmark.h"
+#include "../include/headers/collision/BoxCollider.h"
+#include "../include/headers/collision/ColliderSoA.h"
+#include <memory>
+#include <random>
+
+namespace {
+    constexpr size_t COLLIDER_COUNT = 20000;
+    constexpr size_t QUERY_COUNT = 256;
+    constexpr int ITERATIONS = 20;
+
+    struct Scene {
+        std::vector<std::unique_ptr<BoxCollider>> colliders;    // what Area keeps today
+        ColliderSoA soa;
+        std::vector<std::unique_ptr<BoxCollider>> movers;
+    };
+
+    // Colliders spread over the whole valid BoxCollider range with a mix of
+    // layers, queried with player sized boxes
+    Scene buildScene() {
+        std::mt19937 rng(4321);
+        std::uniform_real_distribution<float> coord(-9000.0f, 9000.0f);
+        std::uniform_real_distribution<float> extent(16.0f, 400.0f);
+        const uint32_t layers[] = {
+            static_cast<uint32_t>(CollisionLayerBits::Wall),
+            static_cast<uint32_t>(CollisionLayerBits::Door),
+            static_cast<uint32_t>(CollisionLayerBits::Trigger),
+            static_cast<uint32_t>(CollisionLayerBits::Item)
+        };
+
+        Scene scene;
+        for (size_t i = 0; i < COLLIDER_COUNT; ++i) {
+            auto collider = std::make_unique<BoxCollider>(glm::vec2(coord(rng), coord(rng)), glm::vec2(extent(rng), extent(rng)));
+            collider->setCollisionLayer(layers[i % 4]);
+            scene.soa.add(collider->getBounds(), layers[i % 4], static_cast<uint32_t>(i));
+            scene.colliders.push_back(std::move(collider));
+        }
+
+        for (size_t i = 0; i < QUERY_COUNT; ++i) {
+            auto mover = std::make_unique<BoxCollider>(glm::vec2(coord(rng), coord(rng)), glm::vec2(40.0f, 50.0f));
+            mover->setCollisionLayer(static_cast<uint32_t>(CollisionLayerBits::Player));
+            mover->setCollisionMask(CollisionMasks::Player);
+            scene.movers.push_back(std::move(mover));
+        }
+        return scene;
+    }
+}
+
+int runCollisionBenchmark() {
+    Scene scene = buildScene();
+    std::printf("  %zu colliders, %zu query boxes per run\n", COLLIDER_COUNT, QUERY_COUNT);
+
+    size_t objectHits = 0;
+    BenchmarkResult perObject = runBenchmark("per-object checkCollision", ITERATIONS, [&]() {
+        objectHits = 0;
+        for (const auto& mover : scene.movers) {
+            for (const auto& collider : scene.colliders) {
+                if (mover->checkCollision(collider.get()).hasCollision) ++objectHits;
+            }
+        }
+    });
+    printResult(perObject);
+
+    int failures = 0;
+    std::vector<BoxContact> contacts;
+    CollisionKernel original = ColliderSoA::getKernel();
+
+    for (CollisionKernel kernel : { CollisionKernel::Scalar, CollisionKernel::Sse2, CollisionKernel::Avx2 }) {
+        if (!ColliderSoA::setKernel(kernel)) {
+            std::printf("  %-28s not supported on this CPU\n", ColliderSoA::getKernelName(kernel));
+            continue;
+        }
+
+        size_t soaHits = 0;
+        BenchmarkResult result = runBenchmark(std::string("soa ") + ColliderSoA::getKernelName(kernel), ITERATIONS, [&]() {
+            soaHits = 0;
+            for (const auto& mover : scene.movers) {
+                contacts.clear();
+                scene.soa.computeManifolds(mover->getBounds(), mover->getCollisionLayer().mask, contacts);
+                soaHits += contacts.size();
+            }
+        });
+        printResult(result);
+        std::printf("  %-28s speedup %.2fx over per-object\n", "", perObject.medianMs / result.medianMs);
+
+        if (soaHits != objectHits) {
+            std::printf("  %s found %zu contacts, per-object found %zu\n",
+                ColliderSoA::getKernelName(kernel), soaHits, objectHits);
+            ++failures;
+        }
+    }
+
+    ColliderSoA::setKernel(original);
+    std::printf("  %zu contacts per run\n", objectHits);
+    return failures == 0 ? 0 : 1;
+}
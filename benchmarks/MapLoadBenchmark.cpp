@@ -0,0 +1,176 @@
+#include "Benchmark.h"
+#include "../include/headers/map/AreaDefinition.h"
+#include "../include/headers/map/AreaSaxLoader.h"
+#include "../include/nlohmann/json.hpp"
+#include <random>
+#include <string>
+
+namespace {
+    constexpr size_t TARGET_MAP_BYTES = 10 * 1024 * 1024;
+    constexpr int ITERATIONS = 10;
+
+    using json = nlohmann::json;
+
+    // Reference DOM walk the SAX loader replaced; kept here only to compare
+    // against, the game itself never parses areas this way.
+    void parseDomMechanism(const json& json, MechanismDefinition& outMechanism) {
+        outMechanism.id = json["id"].get<std::string>();
+        outMechanism.type = static_cast<MechanismType>(json["type"].get<int>());
+        if (json.contains("position") && json.contains("size")) {
+            outMechanism.position = glm::vec2(json["position"]["x"].get<float>(), json["position"]["y"].get<float>());
+            outMechanism.size = glm::vec2(json["size"]["x"].get<float>(), json["size"]["y"].get<float>());
+        }
+
+        switch (outMechanism.type) {
+        case MechanismType::Trigger:
+            outMechanism.condition.requiresPlayerPresence = json["requiresPlayer"].get<bool>();
+            outMechanism.condition.triggerRadius = json["radius"].get<float>();
+            outMechanism.effect.type = static_cast<EffectType>(json["effectType"].get<int>());
+            outMechanism.effect.targetId = json["targetId"].get<std::string>();
+            outMechanism.effect.value = json["value"].get<float>();
+            outMechanism.effect.duration = json["duration"].get<float>();
+            break;
+        case MechanismType::Sequence:
+            for (const auto& step : json["sequence"]) {
+                outMechanism.sequence.push_back(step.get<std::string>());
+            }
+            outMechanism.timeLimit = json.value("timeLimit", 0.0f);
+            break;
+        default:
+            outMechanism.machine = json.value("machine", "");
+            break;
+        }
+    }
+
+    void parseDomArea(const json& json, AreaDefinition& outDefinition) {
+        outDefinition.data.id = json["id"].get<std::string>();
+        outDefinition.data.name = json["name"].get<std::string>();
+        outDefinition.data.type = static_cast<AreaType>(json["type"].get<int>());
+        outDefinition.data.isUnlocked = json.value("unlocked", true);
+        const auto& bounds = json["bounds"];
+        outDefinition.data.bounds.position = { bounds["x"].get<float>(), bounds["y"].get<float>() };
+        outDefinition.data.bounds.size = { bounds["width"].get<float>(), bounds["height"].get<float>() };
+
+        for (const auto& portalJson : json["portals"]) {
+            PortalData portal;
+            portal.targetAreaId = portalJson["targetArea"].get<std::string>();
+            portal.position = glm::vec2(portalJson["x"].get<float>(), portalJson["y"].get<float>());
+            portal.size = glm::vec2(portalJson["width"].get<float>(), portalJson["height"].get<float>());
+            portal.targetPosition = glm::vec2(portalJson["targetX"].get<float>(), portalJson["targetY"].get<float>());
+            portal.isLocked = portalJson.value("locked", false);
+            outDefinition.portals.push_back(portal);
+        }
+
+        for (const auto& mechJson : json["mechanisms"]) {
+            MechanismDefinition mechanism;
+            parseDomMechanism(mechJson, mechanism);
+            outDefinition.mechanisms.push_back(std::move(mechanism));
+        }
+
+        for (const auto& colliderJson : json["colliders"]) {
+            ColliderDefinition collider;
+            collider.position = glm::vec2(colliderJson["x"].get<float>(), colliderJson["y"].get<float>());
+            collider.size = glm::vec2(colliderJson["width"].get<float>(), colliderJson["height"].get<float>());
+            collider.layer = colliderJson.value("layer", 0u);
+            collider.mask = colliderJson.value("mask", 0u);
+            outDefinition.colliders.push_back(collider);
+        }
+    }
+
+    // Synthetic area with the same shape as resources/maps/areas/*.json,
+    // scaled up until the file is about TARGET_MAP_BYTES.
+    std::string generateMapJson(size_t targetBytes) {
+        std::mt19937 rng(1234);
+        std::uniform_real_distribution<float> coord(0.0f, 8000.0f);
+        std::uniform_real_distribution<float> extent(8.0f, 256.0f);
+
+        std::string json;
+        json.reserve(targetBytes + 4096);
+        json += "{\n  \"id\": \"bench_area\",\n  \"name\": \"Benchmark Area\",\n  \"type\": 0,\n  \"unlocked\": true,\n";
+        json += "  \"bounds\": { \"x\": 0, \"y\": 0, \"width\": 8192, \"height\": 8192 },\n";
+
+        json += "  \"portals\": [\n";
+        for (int i = 0; i < 64; ++i) {
+            json += "    { \"x\": " + std::to_string(coord(rng)) + ", \"y\": " + std::to_string(coord(rng)) +
+                ", \"width\": 32, \"height\": 64, \"targetArea\": \"area_" + std::to_string(i) +
+                "\", \"targetX\": 100, \"targetY\": 100, \"locked\": false }";
+            json += i + 1 < 64 ? ",\n" : "\n";
+        }
+        json += "  ],\n";
+
+        // Mechanisms take about a third of the file, colliders the rest
+        json += "  \"mechanisms\": [\n";
+        int index = 0;
+        while (json.size() < targetBytes / 3) {
+            std::string id = "mech_" + std::to_string(index);
+            std::string position = "\"position\": { \"x\": " + std::to_string(coord(rng)) +
+                ", \"y\": " + std::to_string(coord(rng)) + " }, \"size\": { \"x\": 32, \"y\": 32 }";
+            switch (index % 3) {
+            case 0:
+                json += "    { \"id\": \"" + id + "\", \"type\": 0, " + position +
+                    ", \"requiresPlayer\": true, \"radius\": 48.5, \"effectType\": 0, \"targetId\": \"mech_" +
+                    std::to_string(index + 1) + "\", \"value\": 1.0, \"duration\": 0.0 },\n";
+                break;
+            case 1:
+                json += "    { \"id\": \"" + id + "\", \"type\": 5, " + position + " },\n";
+                break;
+            default:
+                json += "    { \"id\": \"" + id + "\", \"type\": 1, \"sequence\": [\"mech_" +
+                    std::to_string(index - 2) + "\", \"mech_" + std::to_string(index - 1) + "\"], \"timeLimit\": 5.0 },\n";
+                break;
+            }
+            ++index;
+        }
+        json.resize(json.size() - 2);
+        json += "\n  ],\n";
+
+        json += "  \"colliders\": [\n";
+        while (json.size() < targetBytes) {
+            json += "    { \"x\": " + std::to_string(coord(rng)) + ", \"y\": " + std::to_string(coord(rng)) +
+                ", \"width\": " + std::to_string(extent(rng)) + ", \"height\": " + std::to_string(extent(rng)) +
+                ", \"layer\": 1, \"mask\": 6 },\n";
+        }
+        json.resize(json.size() - 2);
+        json += "\n  ]\n}\n";
+        return json;
+    }
+
+    bool sameDefinition(const AreaDefinition& a, const AreaDefinition& b) {
+        return a.data.id == b.data.id &&
+            a.portals.size() == b.portals.size() &&
+            a.colliders.size() == b.colliders.size() &&
+            a.mechanisms.size() == b.mechanisms.size() &&
+            a.mechanisms.back().id == b.mechanisms.back().id &&
+            a.colliders.back().size == b.colliders.back().size;
+    }
+}
+
+int runMapLoadBenchmark() {
+    std::string json = generateMapJson(TARGET_MAP_BYTES);
+    std::printf("  synthetic map: %.2f MB\n", json.size() / (1024.0 * 1024.0));
+
+    AreaDefinition domDefinition;
+    AreaDefinition saxDefinition;
+
+    BenchmarkResult dom = runBenchmark("dom (parse + walk)", ITERATIONS, [&]() {
+        domDefinition = AreaDefinition();
+        parseDomArea(nlohmann::json::parse(json), domDefinition);
+    });
+
+    BenchmarkResult sax = runBenchmark("sax (AreaSaxLoader)", ITERATIONS, [&]() {
+        saxDefinition = AreaDefinition();
+        AreaSaxLoader::parseArea(json.data(), json.size(), saxDefinition);
+    });
+
+    printResult(dom);
+    printResult(sax);
+    std::printf("  speedup: %.2fx, %zu portals, %zu mechanisms, %zu colliders\n",
+        dom.medianMs / sax.medianMs, saxDefinition.portals.size(),
+        saxDefinition.mechanisms.size(), saxDefinition.colliders.size());
+
+    if (!sameDefinition(domDefinition, saxDefinition)) {
+        std::printf("  dom and sax results differ\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,88 @@
+#include "Benchmark.h"
+#include "../include/headers/collision/BoxCollider.h"
+#include "../include/headers/collision/CircleCollider.h"
+#include "../include/headers/collision/ColliderSoA.h"
+#include "../include/headers/collision/NarrowPhase.h"
+#include "../include/headers/collision/ProximityKernel.h"
+#include <memory>
+#include <random>
+
+namespace {
+    constexpr size_t TRIGGER_COUNT = 4096;
+    constexpr int ITERATIONS = 50;
+
+    struct Scene {
+        std::vector<std::unique_ptr<CircleCollider>> triggers;  // one range per radius trigger
+        ProximityKernel kernel;
+        std::vector<std::unique_ptr<BoxCollider>> actors;
+        std::vector<Aabb> actorBounds;
+    };
+
+    // Radius triggers over a couple of screens, player sized actors walking among them
+    Scene buildScene(size_t actorCount) {
+        std::mt19937 rng(777);
+        std::uniform_real_distribution<float> coord(0.0f, 4000.0f);
+        std::uniform_real_distribution<float> radius(24.0f, 160.0f);
+
+        Scene scene;
+        for (size_t i = 0; i < TRIGGER_COUNT; ++i) {
+            auto trigger = std::make_unique<CircleCollider>(glm::vec2(coord(rng), coord(rng)), radius(rng));
+            scene.kernel.add(trigger->getCenter(), trigger->getRadius(), static_cast<uint32_t>(i));
+            scene.triggers.push_back(std::move(trigger));
+        }
+        for (size_t i = 0; i < actorCount; ++i) {
+            auto actor = std::make_unique<BoxCollider>(glm::vec2(coord(rng), coord(rng)), glm::vec2(40.0f, 50.0f));
+            scene.actorBounds.push_back(actor->getBounds());
+            scene.actors.push_back(std::move(actor));
+        }
+        return scene;
+    }
+}
+
+int runProximityBenchmark() {
+    int failures = 0;
+    CollisionKernel original = ColliderSoA::getKernel();
+
+    // One player, co-op, and co-op with enemies that can set off traps too
+    for (size_t actorCount : { size_t(1), size_t(4), size_t(32) }) {
+        Scene scene = buildScene(actorCount);
+        std::printf("  %zu radius triggers x %zu actors\n", TRIGGER_COUNT, actorCount);
+
+        // What TriggerMechanism did per trigger: build the range, narrow test it
+        size_t objectHits = 0;
+        BenchmarkResult perObject = runBenchmark("per-trigger narrow phase", ITERATIONS, [&]() {
+            objectHits = 0;
+            for (const auto& trigger : scene.triggers) {
+                for (const auto& actor : scene.actors) {
+                    CircleCollider range(trigger->getCenter(), trigger->getRadius());
+                    if (NarrowPhase::overlaps(range, *actor)) ++objectHits;
+                }
+            }
+        });
+        printResult(perObject);
+
+        ProximityHits hits;
+        for (CollisionKernel kernel : { CollisionKernel::Scalar, CollisionKernel::Sse2, CollisionKernel::Avx2 }) {
+            if (!ColliderSoA::setKernel(kernel)) {
+                std::printf("  %-28s not supported on this CPU\n", ColliderSoA::getKernelName(kernel));
+                continue;
+            }
+
+            BenchmarkResult result = runBenchmark(std::string("batched ") + ColliderSoA::getKernelName(kernel), ITERATIONS, [&]() {
+                scene.kernel.test(scene.actorBounds.data(), scene.actorBounds.size(), hits);
+            });
+            printResult(result);
+            std::printf("  %-28s speedup %.2fx over per-trigger\n", "", perObject.medianMs / result.medianMs);
+
+            if (hits.countHits() != objectHits) {
+                std::printf("  %s found %zu hits, per-trigger found %zu\n",
+                    ColliderSoA::getKernelName(kernel), hits.countHits(), objectHits);
+                ++failures;
+            }
+        }
+        ColliderSoA::setKernel(original);
+        std::printf("  %zu hits per run\n", objectHits);
+    }
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,104 @@
+#include "Benchmark.h"
+#include "../include/headers/collision/BoxCollider.h"
+#include "../include/headers/collision/CollisionWorld.h"
+#include "../include/headers/collision/NarrowPhase.h"
+#include "../include/headers/core/JobSystem.h"
+#include <cfloat>
+#include <cmath>
+#include <memory>
+#include <random>
+
+namespace {
+    constexpr size_t COLLIDER_COUNT = 20000;
+    constexpr size_t RAY_COUNT = 10000;
+    constexpr float RAY_LENGTH = 1500.0f;
+    constexpr int ITERATIONS = 10;
+
+    // Same collider spread as the collision benchmark, rays of a bullet pattern length
+    void buildScene(std::vector<std::unique_ptr<BoxCollider>>& colliders, CollisionWorld& world, std::vector<RayQuery>& rays) {
+        std::mt19937 rng(4321);
+        std::uniform_real_distribution<float> coord(-9000.0f, 9000.0f);
+        std::uniform_real_distribution<float> extent(16.0f, 400.0f);
+        std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+
+        for (size_t i = 0; i < COLLIDER_COUNT; ++i) {
+            auto collider = std::make_unique<BoxCollider>(glm::vec2(coord(rng), coord(rng)), glm::vec2(extent(rng), extent(rng)));
+            collider->setCollisionLayer(static_cast<uint32_t>(i % 2 ? CollisionLayerBits::Wall : CollisionLayerBits::Enemy));
+            world.addCollider(collider.get(), CollisionBodyKind::Static);
+            colliders.push_back(std::move(collider));
+        }
+
+        for (size_t i = 0; i < RAY_COUNT; ++i) {
+            float a = angle(rng);
+            RayQuery ray;
+            ray.origin = glm::vec2(coord(rng), coord(rng));
+            ray.direction = glm::vec2(std::cos(a), std::sin(a));
+            ray.maxDistance = RAY_LENGTH;
+            ray.mask = static_cast<uint32_t>(CollisionLayerBits::Wall) | static_cast<uint32_t>(CollisionLayerBits::Enemy);
+            rays.push_back(ray);
+        }
+    }
+}
+
+int runRaycastBenchmark() {
+    std::vector<std::unique_ptr<BoxCollider>> colliders;
+    CollisionWorld world;
+    std::vector<RayQuery> rays;
+    buildScene(colliders, world, rays);
+    std::printf("  %zu colliders, %zu rays of %.0f units per run\n", COLLIDER_COUNT, RAY_COUNT, RAY_LENGTH);
+
+    // Brute force over a tenth of the rays, it is far too slow for all of them
+    const size_t bruteCount = RAY_COUNT / 10;
+    std::vector<const ICollider*> bruteHits(bruteCount);
+    BenchmarkResult brute = runBenchmark("brute force (1/10 rays)", 1, [&]() {
+        for (size_t i = 0; i < bruteCount; ++i) {
+            float best = rays[i].maxDistance;
+            bruteHits[i] = nullptr;
+            for (const auto& collider : colliders) {
+                float distance;
+                glm::vec2 normal;
+                if (NarrowPhase::raycast(*collider, rays[i].origin, rays[i].direction, best, distance, normal) && distance < best) {
+                    best = distance;
+                    bruteHits[i] = collider.get();
+                }
+            }
+        }
+    });
+    printResult(brute);
+
+    std::vector<RaycastHit> hits(RAY_COUNT);
+    BenchmarkResult serial = runBenchmark("world raycast, 1 thread", ITERATIONS, [&]() {
+        for (size_t i = 0; i < RAY_COUNT; ++i) {
+            world.raycast(rays[i].origin, rays[i].direction, rays[i].maxDistance, rays[i].mask, hits[i]);
+        }
+    });
+    printResult(serial);
+    std::printf("  %-28s %.0fx over brute force per ray\n", "",
+        brute.medianMs * 10.0 / serial.medianMs);
+
+    int failures = 0;
+    for (size_t i = 0; i < bruteCount; ++i) {
+        if (hits[i].collider != bruteHits[i]) ++failures;
+    }
+
+    JobSystem::getInstance().initialize();
+    std::vector<RaycastHit> batchHits;
+    BenchmarkResult batch = runBenchmark("world raycastBatch", ITERATIONS, [&]() {
+        world.raycastBatch(rays, batchHits);
+    });
+    printResult(batch);
+    std::printf("  %-28s speedup %.2fx over 1 thread with %zu workers\n", "",
+        serial.medianMs / batch.medianMs, JobSystem::getInstance().getWorkerCount());
+    JobSystem::getInstance().shutdown();
+
+    size_t hitCount = 0;
+    for (size_t i = 0; i < RAY_COUNT; ++i) {
+        if (batchHits[i].collider != hits[i].collider) ++failures;
+        if (hits[i].collider) ++hitCount;
+    }
+    std::printf("  %zu of %zu rays hit\n", hitCount, RAY_COUNT);
+    if (failures > 0) {
+        std::printf("  %d rays disagree with brute force or the serial pass\n", failures);
+    }
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,276 @@
+#include "Benchmark.h"
+#include "../include/headers/collision/BoxCollider.h"
+#include "../include/headers/collision/ColliderSoA.h"
+#include "../include/headers/collision/CollisionWorld.h"
+#include "../include/nlohmann/json.hpp"
+#include <cmath>
+#include <fstream>
+#include <memory>
+#include <random>
+
+namespace {
+    constexpr size_t QUERY_COUNT = 1024;
+    constexpr size_t RAY_COUNT = 1024;
+    constexpr float RAY_LENGTH = 1000.0f;
+    constexpr size_t MOVING_EVERY = 10;             // every tenth collider is a platform in the tree
+    constexpr size_t BRUTE_FORCE_LIMIT = 10000;     // per-object checks past this take minutes
+    constexpr float WORLD_EXTENT = 9000.0f;         // inside BoxCollider::MAX_POSITION
+
+    enum class Layout {
+        Uniform,    // open field, colliders spread evenly
+        Clustered,  // towns: dense groups with empty space between
+        Corridor    // dungeon: long narrow halls lined with walls
+    };
+
+    const char* layoutName(Layout layout) {
+        switch (layout) {
+        case Layout::Uniform: return "uniform";
+        case Layout::Clustered: return "clustered";
+        default: return "corridor";
+        }
+    }
+
+    struct Scene {
+        std::vector<std::unique_ptr<BoxCollider>> colliders;
+        std::vector<BoxCollider*> moving;
+        std::vector<std::unique_ptr<BoxCollider>> movers;   // player sized query boxes
+        std::vector<RayQuery> rays;
+    };
+
+    glm::vec2 clampToWorld(const glm::vec2& position) {
+        return glm::clamp(position, glm::vec2(-WORLD_EXTENT), glm::vec2(WORLD_EXTENT));
+    }
+
+    // Same density for every size until the world is full, so the numbers show
+    // how the structures scale rather than how crowded the area gets
+    Scene buildScene(Layout layout, size_t colliderCount) {
+        std::mt19937 rng(static_cast<uint32_t>(colliderCount) * 3 + static_cast<uint32_t>(layout));
+        std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+        std::uniform_real_distribution<float> extent(16.0f, 96.0f);
+        std::normal_distribution<float> spread(0.0f, 1.0f);
+
+        float side = std::min(2.0f * WORLD_EXTENT, std::sqrt(static_cast<float>(colliderCount)) * 160.0f);
+        glm::vec2 origin(-side * 0.5f);
+
+        // Corridor layout: horizontal halls 192 units tall, 512 apart
+        constexpr float HALL_HEIGHT = 192.0f;
+        constexpr float HALL_PITCH = 512.0f;
+        int hallCount = std::max(1, static_cast<int>(side / HALL_PITCH));
+
+        std::vector<glm::vec2> clusters;
+        if (layout == Layout::Clustered) {
+            size_t clusterCount = std::max<size_t>(1, colliderCount / 200);
+            for (size_t i = 0; i < clusterCount; ++i) {
+                clusters.push_back(origin + glm::vec2(unit(rng), unit(rng)) * side);
+            }
+        }
+
+        Scene scene;
+        for (size_t i = 0; i < colliderCount; ++i) {
+            glm::vec2 size(extent(rng), extent(rng));
+            glm::vec2 position;
+            switch (layout) {
+            case Layout::Uniform:
+                position = origin + glm::vec2(unit(rng), unit(rng)) * side;
+                break;
+            case Layout::Clustered:
+                position = clusters[i % clusters.size()] + glm::vec2(spread(rng), spread(rng)) * 240.0f;
+                break;
+            case Layout::Corridor: {
+                // Walls hug the top or bottom edge of a hall
+                int hall = static_cast<int>(unit(rng) * hallCount) % hallCount;
+                float hallTop = origin.y + hall * HALL_PITCH;
+                bool top = (i & 1) != 0;
+                position.x = origin.x + unit(rng) * side;
+                position.y = top ? hallTop - size.y + unit(rng) * 24.0f : hallTop + HALL_HEIGHT - unit(rng) * 24.0f;
+                break;
+            }
+            }
+
+            auto collider = std::make_unique<BoxCollider>(clampToWorld(position), size);
+            collider->setCollisionLayer(static_cast<uint32_t>(CollisionLayerBits::Wall));
+            collider->setCollisionMask(CollisionMasks::Wall);
+            if (i % MOVING_EVERY == 0) {
+                collider->setMoving(true);
+                scene.moving.push_back(collider.get());
+            }
+            scene.colliders.push_back(std::move(collider));
+        }
+
+        // Queries go where the player could be: corridors query inside the halls
+        for (size_t i = 0; i < QUERY_COUNT; ++i) {
+            glm::vec2 position = origin + glm::vec2(unit(rng), unit(rng)) * side;
+            if (layout == Layout::Corridor) {
+                int hall = static_cast<int>(unit(rng) * hallCount) % hallCount;
+                position.y = origin.y + hall * HALL_PITCH + unit(rng) * (HALL_HEIGHT - 50.0f);
+            }
+            else if (layout == Layout::Clustered) {
+                position = clusters[i % clusters.size()] + glm::vec2(spread(rng), spread(rng)) * 240.0f;
+            }
+
+            auto mover = std::make_unique<BoxCollider>(clampToWorld(position), glm::vec2(40.0f, 50.0f));
+            mover->setCollisionLayer(static_cast<uint32_t>(CollisionLayerBits::Player));
+            mover->setCollisionMask(CollisionMasks::Player);
+
+            float angle = unit(rng) * 6.2831853f;
+            RayQuery ray;
+            ray.origin = mover->getPosition();
+            ray.direction = layout == Layout::Corridor
+                ? glm::vec2(unit(rng) < 0.5f ? -1.0f : 1.0f, 0.0f)    // down the hall
+                : glm::vec2(std::cos(angle), std::sin(angle));
+            ray.maxDistance = RAY_LENGTH;
+            scene.rays.push_back(ray);
+            scene.movers.push_back(std::move(mover));
+        }
+        return scene;
+    }
+
+    void populate(CollisionWorld& world, const Scene& scene) {
+        for (const auto& collider : scene.colliders) {
+            world.addCollider(collider.get(), CollisionBodyKind::Static);
+        }
+    }
+
+    // Enough repetitions to get past timer noise without spending minutes on the big scenes
+    int iterationsFor(size_t opsPerRun) {
+        return static_cast<int>(std::clamp<size_t>(2000000 / std::max<size_t>(opsPerRun, 1), 3, 50));
+    }
+
+    struct SceneReport {
+        nlohmann::json records = nlohmann::json::array();
+
+        void add(Layout layout, size_t colliderCount, const char* operation, const BenchmarkResult& result, size_t opsPerRun) {
+            double nsPerOp = result.medianMs * 1.0e6 / static_cast<double>(opsPerRun);
+            double opsPerSecond = nsPerOp > 0.0 ? 1.0e9 / nsPerOp : 0.0;
+            std::printf("  %-10s %7zu %-16s %12.1f ns/op %14.0f op/s  %8zu allocs/run\n",
+                layoutName(layout), colliderCount, operation, nsPerOp, opsPerSecond, result.allocationsPerRun.count);
+
+            records.push_back({
+                { "layout", layoutName(layout) },
+                { "colliders", colliderCount },
+                { "operation", operation },
+                { "ops_per_run", opsPerRun },
+                { "iterations", result.iterations },
+                { "median_ms", result.medianMs },
+                { "min_ms", result.minMs },
+                { "ns_per_op", nsPerOp },
+                { "ops_per_sec", opsPerSecond },
+                { "allocs_per_run", result.allocationsPerRun.count },
+            });
+        }
+    };
+}
+
+int runSceneBenchmark() {
+    const size_t colliderCounts[] = { 100, 1000, 10000, 100000 };
+    const Layout layouts[] = { Layout::Uniform, Layout::Clustered, Layout::Corridor };
+
+    int failures = 0;
+    SceneReport report;
+    std::printf("  %zu queries and %zu rays of %.0f units per run, kernel %s\n",
+        QUERY_COUNT, RAY_COUNT, RAY_LENGTH, ColliderSoA::getKernelName(ColliderSoA::getKernel()));
+
+    for (Layout layout : layouts) {
+        for (size_t colliderCount : colliderCounts) {
+            Scene scene = buildScene(layout, colliderCount);
+
+            // Broadphase build: every collider registered from scratch
+            BenchmarkResult build = runBenchmark("build", iterationsFor(colliderCount), [&]() {
+                CollisionWorld world;
+                populate(world, scene);
+            });
+            report.add(layout, colliderCount, "build", build, colliderCount);
+
+            CollisionWorld world;
+            populate(world, scene);
+
+            // Incremental update: platforms drift back and forth a few units per frame
+            float direction = 1.0f;
+            BenchmarkResult update = runBenchmark("update", iterationsFor(scene.moving.size()), [&]() {
+                direction = -direction;
+                for (BoxCollider* collider : scene.moving) {
+                    collider->setPosition(collider->getPosition() + glm::vec2(4.0f * direction, 2.0f * direction));
+                    world.updateCollider(collider);
+                }
+            });
+            report.add(layout, colliderCount, "update", update, scene.moving.size());
+
+            std::vector<ICollider*> nearby;
+            size_t overlapCount = 0;
+            BenchmarkResult query = runBenchmark("query", iterationsFor(QUERY_COUNT * 8), [&]() {
+                overlapCount = 0;
+                for (const auto& mover : scene.movers) {
+                    nearby.clear();
+                    world.queryColliders(*mover, nearby);
+                    overlapCount += nearby.size();
+                }
+            });
+            report.add(layout, colliderCount, "overlap_query", query, QUERY_COUNT);
+
+            std::vector<ColliderContact> contacts;
+            size_t contactCount = 0;
+            BenchmarkResult manifolds = runBenchmark("manifolds", iterationsFor(QUERY_COUNT * 8), [&]() {
+                contactCount = 0;
+                for (const auto& mover : scene.movers) {
+                    contacts.clear();
+                    world.collide(*mover, contacts);
+                    contactCount += contacts.size();
+                }
+            });
+            report.add(layout, colliderCount, "manifolds", manifolds, QUERY_COUNT);
+
+            RaycastHit hit;
+            BenchmarkResult rays = runBenchmark("raycast", iterationsFor(RAY_COUNT * 8), [&]() {
+                for (const auto& ray : scene.rays) {
+                    world.raycast(ray.origin, ray.direction, ray.maxDistance, ray.mask, hit);
+                }
+            });
+            report.add(layout, colliderCount, "raycast", rays, RAY_COUNT);
+
+            // Baseline: what a loop over every BoxCollider costs, and a check on the world's answers
+            if (colliderCount <= BRUTE_FORCE_LIMIT) {
+                size_t bruteCount = 0;
+                BenchmarkResult brute = runBenchmark("brute", iterationsFor(QUERY_COUNT * colliderCount / 64), [&]() {
+                    bruteCount = 0;
+                    for (const auto& mover : scene.movers) {
+                        for (const auto& collider : scene.colliders) {
+                            if (mover->checkCollision(collider.get()).hasCollision) ++bruteCount;
+                        }
+                    }
+                });
+                report.add(layout, colliderCount, "brute_manifolds", brute, QUERY_COUNT);
+
+                if (bruteCount != contactCount) {
+                    std::printf("  %s/%zu: world found %zu contacts, brute force %zu\n",
+                        layoutName(layout), colliderCount, contactCount, bruteCount);
+                    ++failures;
+                }
+            }
+        }
+    }
+
+    nlohmann::json document = {
+        { "benchmark", "scenes" },
+        { "label", getBenchmarkOptions().label },
+        { "kernel", ColliderSoA::getKernelName(ColliderSoA::getKernel()) },
+        { "queries_per_run", QUERY_COUNT },
+        { "rays_per_run", RAY_COUNT },
+        { "records", report.records },
+    };
+
+    const std::string& jsonPath = getBenchmarkOptions().jsonPath;
+    if (jsonPath.empty()) {
+        std::printf("%s\n", document.dump(2).c_str());
+    }
+    else {
+        std::ofstream file(jsonPath);
+        if (!file.is_open()) {
+            std::printf("  could not write %s\n", jsonPath.c_str());
+            return 1;
+        }
+        file << document.dump(2) << std::endl;
+        std::printf("  wrote %zu records to %s\n", report.records.size(), jsonPath.c_str());
+    }
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,177 @@
+#include "Benchmark.h"
+#include "../include/headers/collision/BoxCollider.h"
+#include "../include/headers/collision/CircleCollider.h"
+#include "../include/headers/collision/CapsuleCollider.h"
+#include "../include/headers/collision/OrientedBoxCollider.h"
+#include "../include/headers/collision/PolygonCollider.h"
+#include "../include/headers/collision/NarrowPhase.h"
+#include <cmath>
+#include <iterator>
+#include <memory>
+#include <random>
+
+namespace {
+    constexpr size_t SHAPE_COUNT = 2000;
+    constexpr int ITERATIONS = 20;
+
+    bool isValidBox(const BoxCollider& box) {
+        return BoxCollider::isValidPosition(box.getPosition()) && BoxCollider::isValidSize(box.getSize());
+    }
+
+    // What BoxCollider::checkCollision did before shape tags: RTTI to find
+    // the other box, then the inline AABB manifold
+    CollisionManifold legacyCheckCollision(const BoxCollider& self, const ICollider* other) {
+        if (!other || !isValidBox(self)) return CollisionManifold(false);
+        if (!(self.getCollisionLayer().mask & other->getCollisionLayer().layer)) return CollisionManifold(false);
+
+        const BoxCollider* boxOther = dynamic_cast<const BoxCollider*>(other);
+        if (!boxOther || !isValidBox(*boxOther)) return CollisionManifold(false);
+
+        glm::vec2 minA = self.getMin();
+        glm::vec2 maxA = self.getMax();
+        glm::vec2 minB = boxOther->getMin();
+        glm::vec2 maxB = boxOther->getMax();
+
+        glm::vec2 overlap(
+            std::min(maxA.x, maxB.x) - std::max(minA.x, minB.x),
+            std::min(maxA.y, maxB.y) - std::max(minA.y, minB.y)
+        );
+
+        if (overlap.x > 0 && overlap.y > 0) {
+            CollisionManifold manifold(true);
+            if (overlap.x < overlap.y) {
+                manifold.normal.x = (minA.x + maxA.x < minB.x + maxB.x) ? 1.0f : -1.0f;
+                manifold.penetration = overlap.x;
+            }
+            else {
+                manifold.normal.y = (minA.y + maxA.y < minB.y + maxB.y) ? 1.0f : -1.0f;
+                manifold.penetration = overlap.y;
+            }
+            return manifold;
+        }
+        return CollisionManifold(false);
+    }
+
+    std::unique_ptr<ICollider> makeShape(ColliderShape shape, std::mt19937& rng) {
+        std::uniform_real_distribution<float> coord(-2000.0f, 2000.0f);
+        std::uniform_real_distribution<float> extent(16.0f, 160.0f);
+        std::uniform_real_distribution<float> angle(0.0f, 6.2831853f);
+        glm::vec2 center(coord(rng), coord(rng));
+
+        switch (shape) {
+        case ColliderShape::Circle:
+            return std::make_unique<CircleCollider>(center, extent(rng) * 0.5f);
+        case ColliderShape::Capsule:
+            return std::make_unique<CapsuleCollider>(center, extent(rng) * 0.5f, extent(rng) * 0.25f, angle(rng));
+        case ColliderShape::OrientedBox:
+            return std::make_unique<OrientedBoxCollider>(center, glm::vec2(extent(rng), extent(rng)) * 0.5f, angle(rng));
+        case ColliderShape::Polygon: {
+            auto polygon = std::make_unique<PolygonCollider>(center);
+            float radius = extent(rng) * 0.5f;
+            std::vector<glm::vec2> vertices;
+            for (int i = 0; i < 6; ++i) {
+                float a = angle(rng);
+                vertices.push_back(glm::vec2(std::cos(a), std::sin(a)) * radius);
+            }
+            polygon->setVertices(vertices);
+            return polygon;
+        }
+        default:
+            return std::make_unique<BoxCollider>(center, glm::vec2(extent(rng), extent(rng)));
+        }
+    }
+
+    std::vector<std::unique_ptr<ICollider>> makeShapes(ColliderShape shape, size_t count, uint32_t seed) {
+        std::mt19937 rng(seed);
+        std::vector<std::unique_ptr<ICollider>> shapes;
+        for (size_t i = 0; i < count; ++i) {
+            shapes.push_back(makeShape(shape, rng));
+        }
+        return shapes;
+    }
+
+    const char* shapeName(ColliderShape shape) {
+        switch (shape) {
+        case ColliderShape::Box: return "box";
+        case ColliderShape::Circle: return "circle";
+        case ColliderShape::Capsule: return "capsule";
+        case ColliderShape::OrientedBox: return "obb";
+        case ColliderShape::Polygon: return "polygon";
+        default: return "?";
+        }
+    }
+}
+
+int runShapeBenchmark() {
+    int failures = 0;
+    const size_t pairs = SHAPE_COUNT * SHAPE_COUNT / 4;
+    std::printf("  %zu pairs per run\n", pairs);
+
+    // Box pairs: RTTI dispatch against tag dispatch, same results expected
+    auto boxesA = makeShapes(ColliderShape::Box, SHAPE_COUNT / 2, 11);
+    auto boxesB = makeShapes(ColliderShape::Box, SHAPE_COUNT / 2, 12);
+    // Layers that pass the filter, or both paths stop at the mask check
+    for (auto& box : boxesA) {
+        box->setCollisionLayer(static_cast<uint32_t>(CollisionLayerBits::Player));
+        box->setCollisionMask(static_cast<uint32_t>(CollisionLayerBits::Wall));
+    }
+    for (auto& box : boxesB) {
+        box->setCollisionLayer(static_cast<uint32_t>(CollisionLayerBits::Wall));
+    }
+
+    size_t legacyHits = 0;
+    BenchmarkResult legacy = runBenchmark("box dynamic_cast", ITERATIONS, [&]() {
+        legacyHits = 0;
+        for (const auto& a : boxesA) {
+            const BoxCollider& box = static_cast<const BoxCollider&>(*a);
+            for (const auto& b : boxesB) {
+                if (legacyCheckCollision(box, b.get()).hasCollision) ++legacyHits;
+            }
+        }
+    });
+    printResult(legacy);
+
+    size_t taggedHits = 0;
+    BenchmarkResult tagged = runBenchmark("box tag dispatch", ITERATIONS, [&]() {
+        taggedHits = 0;
+        for (const auto& a : boxesA) {
+            for (const auto& b : boxesB) {
+                if (a->checkCollision(b.get()).hasCollision) ++taggedHits;
+            }
+        }
+    });
+    printResult(tagged);
+    std::printf("  %-28s speedup %.2fx over dynamic_cast\n", "", legacy.medianMs / tagged.medianMs);
+
+    if (legacyHits != taggedHits) {
+        std::printf("  tag dispatch found %zu box contacts, dynamic_cast found %zu\n", taggedHits, legacyHits);
+        ++failures;
+    }
+
+    // Cost per pair for each shape combination through NarrowPhase::collide
+    const ColliderShape shapes[] = {
+        ColliderShape::Box, ColliderShape::Circle, ColliderShape::Capsule,
+        ColliderShape::OrientedBox, ColliderShape::Polygon
+    };
+    for (size_t i = 0; i < std::size(shapes); ++i) {
+        for (size_t j = i; j < std::size(shapes); ++j) {
+            auto setA = makeShapes(shapes[i], SHAPE_COUNT / 2, 21 + static_cast<uint32_t>(i));
+            auto setB = makeShapes(shapes[j], SHAPE_COUNT / 2, 41 + static_cast<uint32_t>(j));
+
+            size_t hits = 0;
+            std::string name = std::string(shapeName(shapes[i])) + "-" + shapeName(shapes[j]);
+            BenchmarkResult result = runBenchmark(name, ITERATIONS / 4, [&]() {
+                hits = 0;
+                for (const auto& a : setA) {
+                    for (const auto& b : setB) {
+                        if (NarrowPhase::collide(*a, *b).hasCollision) ++hits;
+                    }
+                }
+            });
+            std::printf("  %-28s median %9.3f ms  %6.2f ns/pair  %8zu contacts\n",
+                result.name.c_str(), result.medianMs, result.medianMs * 1.0e6 / pairs, hits);
+        }
+    }
+
+    return failures == 0 ? 0 : 1;
+}
@@ -10,6 +10,10 @@
 #include "../../include/headers/renderer/SpriteSheet.h"
 #include "../../include/headers/renderer/Animation.h"
 #include "../../include/headers/collision/BoxCollider.h"
+#include "../../include/headers/collision/CharacterController.h"
+#include "../../include/headers/core/TraceRecorder.h"
+#include "../../include/headers/core/ExpressionProgram.h"
+#include "../../include/headers/map/LoadingScreen.h"
 #include <vector>
 
 class Engine {
@@ -26,6 +30,10 @@ public:
     bool m_spriteFlipX = false;
 
     BoxCollider* getPlayerCollider();
+    // Places the player sprite at position; the collider keeps its offset from it
+    void setPlayerPosition(const glm::vec2& position);
+    // Game state and player position for map expressions, capture once per batch
+    ExpressionEnvironment getExpressionEnvironment() const;
     GLFWwindow* getWindow() { return m_window; }
 
     void setCameraOffset(const glm::vec2& offset) { m_cameraOffset = offset; }
@@ -54,10 +62,15 @@ private:
     void update(float deltaTime);
     void render();
     void handleMovement(float deltaTime);
-    void handleCollisions();
 
     void initializeCameraOffset();
 
+    // Startup: asset work runs as a task graph while the loading screen is drawn
+    bool runStartupTasks();
+    void setupCharacterAnimations();
+    void renderStartupFrame(float progress);
+    void finishStartupTrace();
+
     GLFWwindow* m_window;
     bool m_isRunning;
     float m_lastFrame;
@@ -80,7 +93,11 @@ private:
 
     std::vector<BoxCollider*> m_colliders;  // collision body manage
     BoxCollider* m_playerCollider;          // player collision body
+    std::unique_ptr<CharacterController> m_characterController;  // moves m_playerCollider
 
     glm::vec2 m_cameraOffset{ 0.0f, 0.0f };
 
+    std::unique_ptr<TraceRecorder> m_startupTrace;
+    std::unique_ptr<LoadingScreen> m_startupScreen;
+
 };
\ No newline at end of file
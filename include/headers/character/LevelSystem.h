@@ -23,14 +23,20 @@ public:
 
     int getAttributePoints() const;
 
+    // The player's level system mirrors its base level into GameState, where
+    // portal and trigger conditions read it as "level"
+    void setPublishesLevel(bool publish);
+
 private:
     int m_baseLevel;
     int m_advancedLevel;
     uint32_t m_currentExp;
+    bool m_publishesLevel = false;
 
     // exp
     static constexpr float BASE_EXP = 1000.0f;  // level 1 to level 2
     static const std::array<float, 3> LEVEL_MULTIPLIERS;  // different exp multiply in different level episode
 
     uint32_t calculateRequiredExp(int level) const;
+    void publishLevel() const;
 };
\ No newline at end of file
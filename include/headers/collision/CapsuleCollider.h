@@ -0,0 +1,36 @@
+#pragma once
+#include "ICollider.h"
+
+// Segment swept by a circle. The segment runs along the x axis before
+// rotation; setSize takes the unrotated length (caps included) and diameter.
+// Position and getSize are the world bounding box.
+class CapsuleCollider : public ICollider {
+public:
+    CapsuleCollider(const glm::vec2& center = glm::vec2(0.0f), float halfLength = 0.0f,
+        float radius = 1.0f, float rotation = 0.0f);
+
+    void setPosition(const glm::vec2& pos) override;
+    void setSize(const glm::vec2& size) override;
+
+    glm::vec2 getPosition() const override { return getBounds().min; }
+    glm::vec2 getSize() const override { Aabb bounds = getBounds(); return bounds.max - bounds.min; }
+    Aabb getBounds() const override;
+
+    bool isColliding(const ICollider* other) const override;
+    CollisionManifold checkCollision(const ICollider* other) const override;
+
+    void setCenter(const glm::vec2& center) { m_center = center; }
+    const glm::vec2& getCenter() const { return m_center; }
+    void setRotation(float radians) { m_rotation = radians; }
+    float getRotation() const { return m_rotation; }
+    float getRadius() const { return m_radius; }
+    float getHalfLength() const { return m_halfLength; }
+
+    void getSegment(glm::vec2& outStart, glm::vec2& outEnd) const;
+
+private:
+    glm::vec2 m_center;
+    float m_halfLength;
+    float m_radius;
+    float m_rotation;
+};
@@ -0,0 +1,47 @@
+#pragma once
+#include "BoxCollider.h"
+#include "CollisionWorld.h"
+#include <vector>
+
+struct CharacterContact {
+    ICollider* collider = nullptr;
+    glm::vec2 normal{ 0.0f, 0.0f };     // surface normal, points back towards the character
+    float time = 0.0f;                  // fraction of the iteration's move at impact, 0 for depenetration
+};
+
+// Kinematic mover for a box character. Each move sweeps the collider's box
+// against the area's broadphase, stops at the first time of impact, and slides
+// the rest of the move along the contact plane, so fast or long frames can not
+// tunnel and diagonal wall contact keeps the tangential part of the input.
+// Colliders that are not boxes are swept as their bounds.
+class CharacterController {
+public:
+    static constexpr int DEFAULT_MAX_ITERATIONS = 4;
+    static constexpr float SKIN_WIDTH = 0.01f;  // gap kept to surfaces so the next sweep does not start touching
+
+    explicit CharacterController(BoxCollider& collider);
+
+    // Pushes the collider out of anything it already penetrates (doors that
+    // closed on it, platforms that moved into it), then sweeps delta.
+    // Returns the displacement actually applied to the collider.
+    glm::vec2 move(const CollisionWorld& world, const glm::vec2& delta);
+
+    // Contacts from the last move, in the order they were hit
+    const std::vector<CharacterContact>& getContacts() const { return m_contacts; }
+    bool isBlocked() const { return !m_contacts.empty(); }
+
+    // Layers that stop the character, on top of the layer matrix; defaults to the collider's mask
+    void setSolidMask(uint32_t mask) { m_solidMask = mask; }
+    uint32_t getSolidMask() const { return m_solidMask; }
+    void setMaxIterations(int iterations) { m_maxIterations = iterations > 0 ? iterations : 1; }
+
+private:
+    BoxCollider& m_collider;
+    uint32_t m_solidMask;
+    int m_maxIterations = DEFAULT_MAX_ITERATIONS;
+
+    std::vector<CharacterContact> m_contacts;
+    std::vector<ColliderContact> m_penetrations;
+
+    void depenetrate(const CollisionWorld& world, uint32_t solidMask);
+};
@@ -0,0 +1,27 @@
+#pragma once
+#include "ICollider.h"
+
+// Position and size are the bounding box, like every other collider.
+// setSize keeps the top-left corner and uses the smaller side as diameter.
+class CircleCollider : public ICollider {
+public:
+    CircleCollider(const glm::vec2& center = glm::vec2(0.0f), float radius = 1.0f);
+
+    void setPosition(const glm::vec2& pos) override;
+    void setSize(const glm::vec2& size) override;
+
+    glm::vec2 getPosition() const override { return m_center - glm::vec2(m_radius); }
+    glm::vec2 getSize() const override { return glm::vec2(m_radius * 2.0f); }
+
+    bool isColliding(const ICollider* other) const override;
+    CollisionManifold checkCollision(const ICollider* other) const override;
+
+    void setCenter(const glm::vec2& center) { m_center = center; }
+    const glm::vec2& getCenter() const { return m_center; }
+    void setRadius(float radius);
+    float getRadius() const { return m_radius; }
+
+private:
+    glm::vec2 m_center;
+    float m_radius;
+};
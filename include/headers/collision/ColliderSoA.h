@@ -0,0 +1,66 @@
+#pragma once
+#include "CollisionTypes.h"
+#include <cstdint>
+#include <vector>
+
+struct BoxContact {
+    uint32_t id;                    // id the box was added with
+    CollisionManifold manifold;
+};
+
+struct BoxRayHit {
+    uint32_t id;
+    float distance;                 // where the ray enters the box, 0 if it starts inside
+};
+
+enum class CollisionKernel {
+    Scalar,
+    Sse2,
+    Avx2
+};
+
+// Boxes stored as structure of arrays (min/max per axis, layer) so one query
+// box can be tested against many with SIMD. Removal swaps the last box into
+// the hole, so slots are not stable; look them up with findSlot().
+class ColliderSoA {
+public:
+    uint32_t add(const Aabb& bounds, uint32_t layer, uint32_t id);
+    void setBounds(uint32_t slot, const Aabb& bounds);
+    void removeSlot(uint32_t slot);
+    int findSlot(uint32_t id) const;
+    void clear();
+
+    size_t size() const { return m_ids.size(); }
+    bool empty() const { return m_ids.empty(); }
+    uint32_t getId(uint32_t slot) const { return m_ids[slot]; }
+    Aabb getBounds(uint32_t slot) const;
+
+    // Ids of boxes touching bounds (edges count, like BoxCollider::isColliding)
+    // whose layer shares a bit with mask
+    void queryOverlaps(const Aabb& bounds, uint32_t mask, std::vector<uint32_t>& outIds) const;
+    // Manifolds for boxes that penetrate bounds, same rules as BoxCollider::checkCollision
+    // with bounds as collider A
+    void computeManifolds(const Aabb& bounds, uint32_t mask, std::vector<BoxContact>& outContacts) const;
+    // Boxes whose layer passes mask that the ray enters within maxDistance;
+    // direction does not need to be normalized, distances are in its units
+    void raycast(const glm::vec2& origin, const glm::vec2& direction, float maxDistance, uint32_t mask,
+        std::vector<BoxRayHit>& outHits) const;
+
+    // Kernel used by all instances; defaults to the widest one the CPU supports
+    static CollisionKernel getKernel();
+    static bool setKernel(CollisionKernel kernel);     // false if the CPU can't run it
+    static const char* getKernelName(CollisionKernel kernel);
+
+    static CollisionManifold computeManifold(const Aabb& a, const Aabb& b);
+
+private:
+    std::vector<float> m_minX;
+    std::vector<float> m_minY;
+    std::vector<float> m_maxX;
+    std::vector<float> m_maxY;
+    std::vector<uint32_t> m_layers;
+    std::vector<uint32_t> m_ids;
+
+    // Writes matching slots into outSlots (room for size() entries), returns the count
+    size_t findOverlappingSlots(const Aabb& bounds, uint32_t mask, bool strict, uint32_t* outSlots) const;
+};
@@ -0,0 +1,67 @@
+#pragma once
+#include "CollisionTypes.h"
+#include <array>
+#include <atomic>
+#include <string>
+
+// Which collision layers interact: a symmetric 32x32 matrix indexed by layer
+// bit position, kept as one mask row per layer so the broadphase can filter a
+// whole query with a single AND. Defaults match CollisionMasks; a config file
+// replaces them:
+//   {
+//     "layers": { "Projectile": 8 },     // optional names for bits past Weapon
+//     "pairs": [ ["Player", "Wall"], ["Projectile", "Enemy"] ]
+//   }
+// Colliders keep their own mask on top: a pair is tested only when the matrix
+// allows it and the querying collider's mask accepts the other's layer.
+class CollisionManager {
+public:
+    static constexpr int MAX_LAYERS = 32;
+
+    static CollisionManager& getInstance() {
+        static CollisionManager instance;
+        return instance;
+    }
+
+    // Bit position of the lowest set bit, -1 for 0
+    static int getLayerIndex(uint32_t layers);
+    const std::string& getLayerName(int index) const;
+    int findLayer(const std::string& name) const;
+
+    void setLayerCollision(CollisionLayerBits layer1, CollisionLayerBits layer2, bool shouldCollide);
+    void setLayerCollision(int index1, int index2, bool shouldCollide);
+    void resetToDefaults();
+    // Replaces the matrix; on failure the current one stays
+    bool loadFromFile(const std::string& path);
+
+    // Layers that any bit of layers may touch
+    uint32_t getCollisionMask(uint32_t layers) const;
+    bool canLayersCollide(uint32_t layers1, uint32_t layers2) const {
+        return (getCollisionMask(layers1) & layers2) != 0;
+    }
+    // Precomputed pair filter for a query: matrix row and the collider's own mask
+    uint32_t getQueryMask(const CollisionLayer& layer) const {
+        return layer.mask & getCollisionMask(layer.layer);
+    }
+    bool shouldCollide(const CollisionLayer& querying, const CollisionLayer& other) const {
+        return (getQueryMask(querying) & other.layer) != 0;
+    }
+
+    // Layer plus the matrix row as its mask
+    CollisionLayer getDefaultLayer(CollisionLayerBits type) const;
+
+    // Tuning stats: pairs that passed the filter and went on to narrow phase work.
+    // Counting is thread safe, queries may run on workers.
+    void recordPairTest(uint32_t layers1, uint32_t layers2);
+    void resetPairTestCounts();
+    void logPairTestCounts() const;
+
+private:
+    CollisionManager();
+    CollisionManager(const CollisionManager&) = delete;
+    CollisionManager& operator=(const CollisionManager&) = delete;
+
+    std::array<uint32_t, MAX_LAYERS> m_collisionMatrix{};   // row i: layers that collide with layer i
+    std::array<std::string, MAX_LAYERS> m_layerNames;
+    std::array<std::atomic<uint32_t>, MAX_LAYERS * MAX_LAYERS> m_pairTests{};
+};
@@ -1,5 +1,6 @@
 #pragma once
 #include <glm/glm.hpp>
+#include <algorithm>
 #include <cstdint>
 
 // ײ㶨
@@ -44,6 +45,64 @@ struct CollisionMasks {
         static_cast<uint32_t>(CollisionLayerBits::Wall);
 };
 
+// Shape tag every ICollider carries, NarrowPhase dispatches pairs on it
+enum class ColliderShape : uint8_t {
+    Box,            // axis aligned, BoxCollider
+    Circle,
+    Capsule,
+    OrientedBox,
+    Polygon,        // convex
+    Count
+};
+
+// Axis aligned box in world space, min is the top-left corner like BoxCollider's position
+struct Aabb {
+    glm::vec2 min{ 0.0f, 0.0f };
+    glm::vec2 max{ 0.0f, 0.0f };
+
+    Aabb() = default;
+    Aabb(const glm::vec2& minCorner, const glm::vec2& maxCorner) : min(minCorner), max(maxCorner) {}
+
+    static Aabb fromPositionSize(const glm::vec2& position, const glm::vec2& size) {
+        return Aabb(position, position + size);
+    }
+
+    bool overlaps(const Aabb& other) const {
+        return min.x <= other.max.x && max.x >= other.min.x &&
+            min.y <= other.max.y && max.y >= other.min.y;
+    }
+
+    bool contains(const Aabb& other) const {
+        return min.x <= other.min.x && min.y <= other.min.y &&
+            max.x >= other.max.x && max.y >= other.max.y;
+    }
+
+    // Slab test against a ray; outEntry is the distance along direction where the
+    // ray enters, 0 when origin is already inside
+    bool intersectsRay(const glm::vec2& origin, const glm::vec2& direction, float maxDistance, float& outEntry) const {
+        float entry = 0.0f;
+        float exit = maxDistance;
+        for (int axis = 0; axis < 2; ++axis) {
+            if (direction[axis] == 0.0f) {
+                if (origin[axis] < min[axis] || origin[axis] > max[axis]) return false;
+                continue;
+            }
+            float inverse = 1.0f / direction[axis];
+            float t0 = (min[axis] - origin[axis]) * inverse;
+            float t1 = (max[axis] - origin[axis]) * inverse;
+            if (t0 > t1) std::swap(t0, t1);
+            entry = std::max(entry, t0);
+            exit = std::min(exit, t1);
+            if (entry > exit) return false;
+        }
+        outEntry = entry;
+        return true;
+    }
+
+    bool operator==(const Aabb& other) const { return min == other.min && max == other.max; }
+    bool operator!=(const Aabb& other) const { return !(*this == other); }
+};
+
 struct CollisionLayer {
     uint32_t layer = static_cast<uint32_t>(CollisionLayerBits::None);
     uint32_t mask = static_cast<uint32_t>(CollisionLayerBits::None);
@@ -64,66 +123,3 @@ struct CollisionManifold {
     CollisionManifold() = default;
     explicit CollisionManifold(bool collision) : hasCollision(collision) {}
 };
-
-// ײ
-class CollisionManager {
-public:
-    static CollisionManager& getInstance() {
-        static CollisionManager instance;
-        return instance;
-    }
-
-    void setLayerCollision(CollisionLayerBits layer1, CollisionLayerBits layer2, bool shouldCollide) {
-        if (shouldCollide) {
-            enableLayerCollision(layer1, layer2);
-        }
-        else {
-            disableLayerCollision(layer1, layer2);
-        }
-    }
-
-    bool canLayersCollide(uint32_t layer1, uint32_t layer2) const {
-        return (layer1 & layer2) != 0;
-    }
-
-    // ȡĬײ
-    CollisionLayer getDefaultLayer(CollisionLayerBits type) const {
-        switch (type) {
-        case CollisionLayerBits::Player:
-            return CollisionLayer(CollisionLayerBits::Player, CollisionMasks::Player);
-        case CollisionLayerBits::Trigger:
-            return CollisionLayer(CollisionLayerBits::Trigger, CollisionMasks::Trigger);
-        case CollisionLayerBits::Door:
-            return CollisionLayer(CollisionLayerBits::Door, CollisionMasks::Door);
-        case CollisionLayerBits::Portal:
-            return CollisionLayer(CollisionLayerBits::Portal, CollisionMasks::Portal);
-        case CollisionLayerBits::Wall:
-            return CollisionLayer(CollisionLayerBits::Wall, CollisionMasks::Wall);
-        case CollisionLayerBits::Enemy:
-            return CollisionLayer(CollisionLayerBits::Enemy, CollisionMasks::Enemy);
-        default:
-            return CollisionLayer();
-        }
-    }
-
-private:
-    CollisionManager() = default;
-
-    void enableLayerCollision(CollisionLayerBits layer1, CollisionLayerBits layer2) {
-        uint32_t bit1 = static_cast<uint32_t>(layer1);
-        uint32_t bit2 = static_cast<uint32_t>(layer2);
-        // ˫ײ
-        m_collisionMatrix[bit1] |= bit2;
-        m_collisionMatrix[bit2] |= bit1;
-    }
-
-    void disableLayerCollision(CollisionLayerBits layer1, CollisionLayerBits layer2) {
-        uint32_t bit1 = static_cast<uint32_t>(layer1);
-        uint32_t bit2 = static_cast<uint32_t>(layer2);
-        // Ƴ˫ײ
-        m_collisionMatrix[bit1] &= ~bit2;
-        m_collisionMatrix[bit2] &= ~bit1;
-    }
-
-    uint32_t m_collisionMatrix[32] = { 0 };  // ײ
-};
\ No newline at end of file
@@ -0,0 +1,122 @@
+#pragma once
+#include "ICollider.h"
+#include "SpatialHashGrid.h"
+#include "DynamicAabbTree.h"
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+enum class CollisionBodyKind : uint8_t {
+    Static,     // area colliders, never move
+    Mechanism,  // doors, triggers, platforms; moved through updateCollider()
+    Portal      // no collider, bounds only
+};
+
+struct CollisionBody {
+    CollisionBodyKind kind = CollisionBodyKind::Static;
+    ICollider* collider = nullptr;  // null for portals
+    size_t portalIndex = 0;         // index into Area::getPortals() for portals
+    bool isDynamic = false;         // collider flagged as moving, lives in the tree
+    SpatialHashGrid::ProxyId proxy = SpatialHashGrid::INVALID_PROXY;
+    DynamicAabbTree::ProxyId treeProxy = DynamicAabbTree::NULL_NODE;
+};
+
+struct ColliderContact {
+    ICollider* collider;
+    CollisionManifold manifold;     // mover is collider A
+};
+
+struct RaycastHit {
+    ICollider* collider = nullptr;  // null when nothing was hit
+    glm::vec2 point{ 0.0f, 0.0f };  // rays: where the surface was hit; shape casts: the box's min corner at impact
+    glm::vec2 normal{ 0.0f, 0.0f }; // surface normal, faces the ray or cast
+    float distance = 0.0f;          // along the normalized direction
+    float fraction = 0.0f;          // distance / maxDistance for rays, share of delta for shape casts
+};
+
+struct RayQuery {
+    glm::vec2 origin{ 0.0f, 0.0f };
+    glm::vec2 direction{ 1.0f, 0.0f };
+    float maxDistance = 0.0f;
+    uint32_t mask = static_cast<uint32_t>(CollisionLayerBits::All);
+};
+
+struct CollisionPair {
+    const CollisionBody* moving;    // always a dynamic body
+    const CollisionBody* other;
+};
+
+// Broadphase for one area. Colliders are registered once and only re-bucketed
+// when they move, so a query costs the same no matter how big the area gets.
+// Colliders flagged isMoving() go into a dynamic AABB tree instead of the grid.
+// The world does not own colliders; whoever removes one has to unregister it.
+class CollisionWorld {
+public:
+    using BodyId = uint32_t;
+    static constexpr float DEFAULT_CELL_SIZE = 128.0f;
+
+    explicit CollisionWorld(float cellSize = DEFAULT_CELL_SIZE);
+
+    BodyId addCollider(ICollider* collider, CollisionBodyKind kind);
+    BodyId addPortal(const Aabb& bounds, size_t portalIndex);
+    void removeCollider(const ICollider* collider);
+    void clear();
+
+    // Re-reads the collider's bounds after it moved or resized, and moves it
+    // between grid and tree if its moving flag changed
+    void updateCollider(const ICollider* collider);
+    bool contains(const ICollider* collider) const { return m_bodyByCollider.count(collider) != 0; }
+
+    // Bodies whose bounds overlap, portals included
+    void query(const Aabb& bounds, std::vector<const CollisionBody*>& outBodies) const;
+    // Colliders near the mover that the layer matrix and its mask accept, the mover itself excluded
+    void queryColliders(const ICollider& mover, std::vector<ICollider*>& outColliders) const;
+    // Manifolds for every collider penetrating the mover that the layer matrix and
+    // its mask accept. Grid cells are tested in batches by the ColliderSoA kernels,
+    // with layers the mover never touches masked out before any box math.
+    // Pairs that reach narrow phase work are counted in CollisionManager.
+    void collide(const ICollider& mover, std::vector<ColliderContact>& outContacts) const;
+    // Portal indices overlapping bounds
+    void queryPortals(const Aabb& bounds, std::vector<size_t>& outPortalIndices) const;
+    // Overlapping pairs with at least one moving body: moving vs grid and moving vs moving.
+    // A pair needs the layer matrix and either collider's mask to accept it.
+    void queryPairs(std::vector<CollisionPair>& outPairs) const;
+
+    // Ray queries against colliders whose layer passes mask. The grid is walked
+    // cell by cell from the origin and the tree is traversed, both stop early once
+    // nothing closer can be found. Rays starting inside a collider ignore it.
+    bool raycast(const glm::vec2& origin, const glm::vec2& direction, float maxDistance, uint32_t mask,
+        RaycastHit& outHit) const;
+    // Every collider along the ray, nearest first
+    void raycastAll(const glm::vec2& origin, const glm::vec2& direction, float maxDistance, uint32_t mask,
+        std::vector<RaycastHit>& outHits) const;
+    // Sweeps box by delta and reports the first collider it would hit, non-box
+    // colliders by their bounds. Boxes the cast starts inside are ignored unless
+    // they are within skin, which counts as touching at the start.
+    bool shapeCast(const Aabb& box, const glm::vec2& delta, uint32_t mask, RaycastHit& outHit,
+        const ICollider* ignore = nullptr, float skin = 0.0f) const;
+    // One result per ray in outHits, collider null for misses. Rays are split
+    // across JobSystem workers; nothing may modify the world meanwhile.
+    void raycastBatch(const std::vector<RayQuery>& rays, std::vector<RaycastHit>& outHits) const;
+
+    size_t getBodyCount() const { return m_grid.getProxyCount() + m_dynamicTree.getProxyCount(); }
+    size_t getDynamicBodyCount() const { return m_dynamicBodies.size(); }
+    DynamicAabbTree::Quality getDynamicTreeQuality() const { return m_dynamicTree.computeQuality(); }
+    void logStats(const std::string& label) const;
+
+private:
+    SpatialHashGrid m_grid;
+    DynamicAabbTree m_dynamicTree;
+    std::vector<BodyId> m_dynamicBodies;
+    std::vector<CollisionBody> m_bodies;
+    std::vector<BodyId> m_freeBodies;
+    std::unordered_map<const ICollider*, BodyId> m_bodyByCollider;
+
+    BodyId allocateBody();
+    // Grid proxies are filtered by mask inside the cell kernels, tree hits by their collider's layer
+    void gather(const Aabb& bounds, std::vector<uint32_t>& outIds,
+        uint32_t mask = static_cast<uint32_t>(CollisionLayerBits::All)) const;
+    void insertProxy(BodyId id, const Aabb& bounds);
+    void removeProxy(BodyId id);
+};
@@ -0,0 +1,73 @@
+#pragma once
+#include "CollisionTypes.h"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+// Bounding volume tree for colliders that move every frame. Leaves store a
+// fattened box, so small moves only rewrite the tight bounds; a leaf is
+// reinserted (and its ancestors refit) once it leaves its fat box.
+class DynamicAabbTree {
+public:
+    using ProxyId = int32_t;
+    static constexpr ProxyId NULL_NODE = -1;
+    // Same contract as SpatialHashGrid::RayCallback
+    using RayCallback = std::function<float(uint32_t userData, float distance)>;
+
+    struct Quality {
+        int height = 0;             // longest root to leaf path
+        int maxBalance = 0;         // worst height difference between siblings
+        float areaRatio = 0.0f;     // sum of node perimeters / root perimeter, lower is tighter
+        size_t leafCount = 0;
+        size_t nodeCount = 0;
+    };
+
+    explicit DynamicAabbTree(float fatMargin = 8.0f, float displacementMultiplier = 2.0f);
+
+    ProxyId createProxy(const Aabb& bounds, uint32_t userData);
+    void destroyProxy(ProxyId proxy);
+    // Returns true when the leaf had to be reinserted
+    bool moveProxy(ProxyId proxy, const Aabb& bounds, const glm::vec2& displacement);
+    void clear();
+
+    // Appends userData of leaves whose fat box overlaps bounds
+    void query(const Aabb& bounds, std::vector<uint32_t>& outUserData) const;
+    // Reports leaves whose tight box the ray enters; subtrees past the distance
+    // the callback returns are skipped
+    void raycast(const glm::vec2& origin, const glm::vec2& direction, float maxDistance, const RayCallback& callback) const;
+
+    const Aabb& getFatBounds(ProxyId proxy) const { return m_nodes[proxy].fatBounds; }
+    const Aabb& getBounds(ProxyId proxy) const { return m_nodes[proxy].bounds; }
+    uint32_t getUserData(ProxyId proxy) const { return m_nodes[proxy].userData; }
+
+    Quality computeQuality() const;
+    size_t getProxyCount() const { return m_leafCount; }
+
+private:
+    struct Node {
+        Aabb fatBounds;         // leaf: tight bounds + margin, internal: union of children
+        Aabb bounds;            // leaf only, the collider's actual box
+        uint32_t userData = 0;
+        ProxyId parent = NULL_NODE;     // doubles as next free node
+        ProxyId child1 = NULL_NODE;
+        ProxyId child2 = NULL_NODE;
+        int height = -1;        // leaf 0, free -1
+
+        bool isLeaf() const { return child1 == NULL_NODE; }
+    };
+
+    std::vector<Node> m_nodes;
+    ProxyId m_root = NULL_NODE;
+    ProxyId m_freeList = NULL_NODE;
+    size_t m_leafCount = 0;
+    float m_fatMargin;
+    float m_displacementMultiplier;
+
+    ProxyId allocateNode();
+    void freeNode(ProxyId node);
+    void insertLeaf(ProxyId leaf);
+    void removeLeaf(ProxyId leaf);
+    ProxyId balance(ProxyId node);
+    void refitAncestors(ProxyId node);
+    Aabb fatten(const Aabb& bounds, const glm::vec2& displacement) const;
+};
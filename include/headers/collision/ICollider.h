@@ -3,13 +3,17 @@
 
 class ICollider {
 public:
+    explicit ICollider(ColliderShape shape = ColliderShape::Box) : m_shape(shape) {}
     virtual ~ICollider() = default;
 
+    ColliderShape getShape() const { return m_shape; }
+
     virtual void setPosition(const glm::vec2& pos) = 0;
     virtual void setSize(const glm::vec2& size) = 0;
 
     virtual glm::vec2 getPosition() const = 0;
     virtual glm::vec2 getSize() const = 0;
+    virtual Aabb getBounds() const { return Aabb::fromPositionSize(getPosition(), getSize()); }
 
     virtual bool isColliding(const ICollider* other) const = 0;
     virtual CollisionManifold checkCollision(const ICollider* other) const = 0;
@@ -19,6 +23,12 @@ public:
     void setCollisionMask(uint32_t mask) { m_layer.mask = mask; }
     const CollisionLayer& getCollisionLayer() const { return m_layer; }
 
+    // Moving colliders live in the dynamic tree instead of the static grid
+    void setMoving(bool moving) { m_isMoving = moving; }
+    bool isMoving() const { return m_isMoving; }
+
 protected:
     CollisionLayer m_layer;
+    bool m_isMoving = false;
+    ColliderShape m_shape;
 };
\ No newline at end of file
@@ -0,0 +1,30 @@
+#pragma once
+#include "ICollider.h"
+
+// Any supported shape as a convex point set inflated by a radius:
+// circle = 1 point, capsule = 2, boxes and polygons = their corners.
+struct ConvexShape {
+    static constexpr int MAX_VERTICES = 8;
+
+    glm::vec2 vertices[MAX_VERTICES];
+    int count = 0;
+    float radius = 0.0f;
+};
+
+// Shape pair tests, dispatched through a table indexed by ColliderShape tags.
+// Layer masks are the caller's business. Manifold normals point from a to b.
+class NarrowPhase {
+public:
+    static CollisionManifold collide(const ICollider& a, const ICollider& b);
+    // Touching counts for box pairs, like BoxCollider always did
+    static bool overlaps(const ICollider& a, const ICollider& b);
+
+    static ConvexShape toConvexShape(const ICollider& collider);
+    // SAT over face normals plus vertex to vertex axes for rounded shapes
+    static CollisionManifold collideConvex(const ConvexShape& a, const ConvexShape& b);
+
+    // Exact ray test against the collider's shape. direction must be normalized.
+    // Rays starting inside a shape do not hit it. outNormal faces the ray.
+    static bool raycast(const ICollider& collider, const glm::vec2& origin, const glm::vec2& direction,
+        float maxDistance, float& outDistance, glm::vec2& outNormal);
+};
@@ -0,0 +1,34 @@
+#pragma once
+#include "ICollider.h"
+
+// Rotated box. setSize takes the unrotated width and height; position and
+// getSize are the world bounding box.
+class OrientedBoxCollider : public ICollider {
+public:
+    OrientedBoxCollider(const glm::vec2& center = glm::vec2(0.0f), const glm::vec2& halfExtents = glm::vec2(0.5f),
+        float rotation = 0.0f);
+
+    void setPosition(const glm::vec2& pos) override;
+    void setSize(const glm::vec2& size) override;
+
+    glm::vec2 getPosition() const override { return getBounds().min; }
+    glm::vec2 getSize() const override { Aabb bounds = getBounds(); return bounds.max - bounds.min; }
+    Aabb getBounds() const override;
+
+    bool isColliding(const ICollider* other) const override;
+    CollisionManifold checkCollision(const ICollider* other) const override;
+
+    void setCenter(const glm::vec2& center) { m_center = center; }
+    const glm::vec2& getCenter() const { return m_center; }
+    void setRotation(float radians) { m_rotation = radians; }
+    float getRotation() const { return m_rotation; }
+    const glm::vec2& getHalfExtents() const { return m_halfExtents; }
+
+    // Corners in winding order
+    void getVertices(glm::vec2 outVertices[4]) const;
+
+private:
+    glm::vec2 m_center;
+    glm::vec2 m_halfExtents;
+    float m_rotation;
+};
@@ -0,0 +1,39 @@
+#pragma once
+#include "ICollider.h"
+#include <vector>
+
+// Convex polygon, vertices relative to the center. Non-convex input is
+// replaced by its convex hull. setSize scales the unrotated outline to the
+// given extents; position and getSize are the world bounding box.
+class PolygonCollider : public ICollider {
+public:
+    static constexpr int MAX_VERTICES = 8;
+
+    PolygonCollider(const glm::vec2& center = glm::vec2(0.0f),
+        const std::vector<glm::vec2>& localVertices = {}, float rotation = 0.0f);
+
+    void setPosition(const glm::vec2& pos) override;
+    void setSize(const glm::vec2& size) override;
+
+    glm::vec2 getPosition() const override { return getBounds().min; }
+    glm::vec2 getSize() const override { Aabb bounds = getBounds(); return bounds.max - bounds.min; }
+    Aabb getBounds() const override;
+
+    bool isColliding(const ICollider* other) const override;
+    CollisionManifold checkCollision(const ICollider* other) const override;
+
+    bool setVertices(const std::vector<glm::vec2>& localVertices);
+    int getVertexCount() const { return static_cast<int>(m_localVertices.size()); }
+    // Writes getVertexCount() world space vertices in winding order
+    void getWorldVertices(glm::vec2* outVertices) const;
+
+    void setCenter(const glm::vec2& center) { m_center = center; }
+    const glm::vec2& getCenter() const { return m_center; }
+    void setRotation(float radians) { m_rotation = radians; }
+    float getRotation() const { return m_rotation; }
+
+private:
+    glm::vec2 m_center;
+    std::vector<glm::vec2> m_localVertices;
+    float m_rotation;
+};
@@ -0,0 +1,59 @@
+#pragma once
+#include "CollisionTypes.h"
+#include <cstdint>
+#include <vector>
+
+// Result of ProximityKernel::test: one row of circle bits per actor
+class ProximityHits {
+public:
+    void reset(size_t circleCount, size_t actorCount);
+
+    bool test(size_t circle, size_t actor) const {
+        return (m_words[actor * m_wordsPerActor + circle / 64] >> (circle % 64)) & 1u;
+    }
+    const uint64_t* getRow(size_t actor) const { return m_words.data() + actor * m_wordsPerActor; }
+    uint64_t* getRow(size_t actor) { return m_words.data() + actor * m_wordsPerActor; }
+    size_t getWordsPerActor() const { return m_wordsPerActor; }
+    size_t getCircleCount() const { return m_circleCount; }
+    size_t getActorCount() const { return m_actorCount; }
+    size_t countHits() const;
+
+private:
+    std::vector<uint64_t> m_words;
+    size_t m_wordsPerActor = 0;
+    size_t m_circleCount = 0;
+    size_t m_actorCount = 0;
+};
+
+// Radius triggers as structure of arrays (center, squared radius) so a batch
+// of actors is tested against all of them without a sqrt. A circle reaches an
+// actor when the squared distance from its center to the closest point of the
+// actor's box is below its squared radius, the rule NarrowPhase uses for
+// circle/box; points are empty boxes. Runs on whichever kernel
+// ColliderSoA::getKernel() selected. Removal swaps like ColliderSoA.
+class ProximityKernel {
+public:
+    uint32_t add(const glm::vec2& center, float radius, uint32_t id);
+    void setCircle(uint32_t slot, const glm::vec2& center, float radius);
+    void removeSlot(uint32_t slot);
+    int findSlot(uint32_t id) const;
+    void clear();
+
+    size_t size() const { return m_ids.size(); }
+    bool empty() const { return m_ids.empty(); }
+    uint32_t getId(uint32_t slot) const { return m_ids[slot]; }
+
+    // Every circle against every actor, bit (slot, actor) set on a hit
+    void test(const Aabb* actors, size_t actorCount, ProximityHits& outHits) const;
+
+    // Bit i of outBits is set when circle i reaches box.
+    // outBits needs (count + 63) / 64 words and is overwritten.
+    static void testCircles(const float* centerX, const float* centerY, const float* radiusSquared, size_t count,
+        const Aabb& box, uint64_t* outBits);
+
+private:
+    std::vector<float> m_centerX;
+    std::vector<float> m_centerY;
+    std::vector<float> m_radiusSquared;
+    std::vector<uint32_t> m_ids;
+};
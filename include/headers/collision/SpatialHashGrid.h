@@ -0,0 +1,76 @@
+#pragma once
+#include "CollisionTypes.h"
+#include "ColliderSoA.h"
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+// Uniform grid broadphase. Proxies are bucketed into every cell their bounds
+// touch; cells are hashed so only occupied ones cost memory. Each cell keeps
+// its boxes as a ColliderSoA so a query runs the SIMD kernels per cell.
+// Queries only read, so several threads may query while nobody inserts or
+// moves proxies.
+class SpatialHashGrid {
+public:
+    using ProxyId = uint32_t;
+    static constexpr ProxyId INVALID_PROXY = 0xFFFFFFFF;
+    // Gets a proxy's userData and the distance its box is entered at, returns the
+    // distance the walk may stop at (return the max distance to keep everything)
+    using RayCallback = std::function<float(uint32_t userData, float distance)>;
+
+    explicit SpatialHashGrid(float cellSize = 128.0f);
+
+    ProxyId insert(const Aabb& bounds, uint32_t userData, uint32_t layer = 0xFFFFFFFF);
+    // Only the cells the proxy enters or leaves are re-bucketed
+    void update(ProxyId proxy, const Aabb& bounds);
+    void remove(ProxyId proxy);
+    void clear();
+
+    // Appends the userData of every proxy overlapping bounds whose layer passes mask, each one once
+    void query(const Aabb& bounds, std::vector<uint32_t>& outUserData, uint32_t mask = 0xFFFFFFFF) const;
+    // Manifolds against every penetrating proxy, BoxContact::id is the proxy's userData
+    void collide(const Aabb& bounds, uint32_t mask, std::vector<BoxContact>& outContacts) const;
+    // Walks the cells along the ray front to back (DDA), clipped to the occupied part of the grid.
+    // Each box is reported from the cell its entry point lies in, give or take boundary rounding.
+    void raycast(const glm::vec2& origin, const glm::vec2& direction, float maxDistance, uint32_t mask,
+        const RayCallback& callback) const;
+
+    const Aabb& getBounds(ProxyId proxy) const { return m_proxies[proxy].bounds; }
+    float getCellSize() const { return m_cellSize; }
+    size_t getProxyCount() const { return m_proxies.size() - m_freeProxies.size(); }
+    size_t getCellCount() const { return m_cells.size(); }
+
+private:
+    struct CellRange {
+        int minX = 0, minY = 0, maxX = -1, maxY = -1;
+
+        bool contains(int x, int y) const { return x >= minX && x <= maxX && y >= minY && y <= maxY; }
+        bool operator==(const CellRange& other) const {
+            return minX == other.minX && minY == other.minY && maxX == other.maxX && maxY == other.maxY;
+        }
+    };
+
+    struct Proxy {
+        Aabb bounds;
+        CellRange cells;
+        uint32_t userData = 0;
+        uint32_t layer = 0;
+        bool alive = false;
+    };
+
+    float m_cellSize;
+    float m_inverseCellSize;
+    std::vector<Proxy> m_proxies;
+    std::vector<ProxyId> m_freeProxies;
+    std::unordered_map<uint64_t, ColliderSoA> m_cells;
+    CellRange m_occupied;       // every cell ever filled since clear(), only grows
+
+    CellRange getCellRange(const Aabb& bounds) const;
+    static uint64_t cellKey(int x, int y) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(x)) << 32) | static_cast<uint32_t>(y);
+    }
+    void addToCell(int x, int y, ProxyId proxy);
+    void removeFromCell(int x, int y, ProxyId proxy);
+    void setCellBounds(int x, int y, ProxyId proxy, const Aabb& bounds);
+};
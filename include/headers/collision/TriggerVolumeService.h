@@ -0,0 +1,92 @@
+#pragma once
+#include "ICollider.h"
+#include "DynamicAabbTree.h"
+#include "ProximityKernel.h"
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+enum class OverlapEventType : uint8_t {
+    Enter,      // first update the actor overlaps the volume
+    Stay,       // every later update while it still does
+    Exit        // first update it no longer does, or the actor was removed
+};
+
+struct OverlapEvent {
+    OverlapEventType type;
+    uint32_t volume;            // id addVolume returned
+    const ICollider* actor;
+};
+
+// Persistent overlap pairs between actors (the player, later co-op players and
+// enemies) and trigger volumes (radius triggers, portals). Circle volumes are
+// kept in a ProximityKernel and tested against every actor's bounds in one
+// batch; other volumes sit in a dynamic tree that is queried once per actor
+// and narrow tested. The result is diffed against the previous update's pairs,
+// so listeners only hear about volumes an actor is actually in or just left.
+// Circle volumes see actors as their bounds, exact for the usual box actors.
+// Layers are filtered by the CollisionManager matrix only; actor masks are for
+// solid contacts and do not apply.
+class TriggerVolumeService {
+public:
+    using VolumeId = uint32_t;
+    static constexpr VolumeId INVALID_VOLUME = 0xFFFFFFFF;
+    using Listener = std::function<void(const OverlapEvent& event)>;
+
+    // Shape volume, tested against actors with NarrowPhase. The service does not
+    // own the shape; call updateVolume after moving it.
+    VolumeId addVolume(const ICollider* shape, Listener listener);
+    // Box volume that has no collider, e.g. a portal
+    VolumeId addVolume(const Aabb& bounds, uint32_t layer, Listener listener);
+    // Pairs with the volume are dropped without Exit events
+    void removeVolume(VolumeId volume);
+    void updateVolume(VolumeId volume);
+
+    void addActor(const ICollider* actor);
+    // Sends Exit for every volume the actor was in
+    void removeActor(const ICollider* actor);
+    bool hasActor(const ICollider* actor) const;
+
+    // Finds this update's overlaps and dispatches an event per changed or
+    // lasting pair. Listeners must not add or remove volumes or actors.
+    void update();
+    void clear();
+
+    size_t getVolumeCount() const { return m_tree.getProxyCount() + m_circles.size(); }
+    size_t getPairCount() const { return m_pairs.size(); }
+
+private:
+    struct Volume {
+        const ICollider* shape = nullptr;   // null for box volumes
+        Aabb bounds;                        // box volumes only
+        uint32_t layer = 0;
+        Listener listener;
+        DynamicAabbTree::ProxyId proxy = DynamicAabbTree::NULL_NODE;   // not used by circles
+        bool isCircle = false;
+        bool alive = false;
+    };
+
+    struct Pair {
+        const ICollider* actor;
+        VolumeId volume;
+
+        bool operator==(const Pair& other) const { return actor == other.actor && volume == other.volume; }
+        bool operator<(const Pair& other) const;
+    };
+
+    DynamicAabbTree m_tree;
+    ProximityKernel m_circles;          // ids are volume ids
+    std::vector<Volume> m_volumes;
+    std::vector<VolumeId> m_freeVolumes;
+    std::vector<const ICollider*> m_actors;
+
+    std::vector<Pair> m_pairs;          // sorted, as of the last update
+    std::vector<Pair> m_currentPairs;
+    std::vector<uint32_t> m_candidates;
+    std::vector<Aabb> m_actorBounds;
+    ProximityHits m_circleHits;
+
+    VolumeId allocateVolume();
+    bool isOverlapping(const Volume& volume, const ICollider& actor) const;
+    void dispatch(OverlapEventType type, const Pair& pair) const;
+};
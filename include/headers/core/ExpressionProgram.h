@@ -0,0 +1,108 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+class GameState;
+
+// The world an expression reads, captured once per batch
+struct ExpressionEnvironment {
+    const float* values = nullptr;      // GameState::getValues()
+    size_t valueCount = 0;
+    glm::vec2 playerPosition{ 0.0f };
+    bool hasPlayer = false;
+
+    // Player position is null while there is no player
+    static ExpressionEnvironment capture(const GameState& state, const glm::vec2* playerPosition);
+};
+
+// The mechanism or portal an expression belongs to
+struct ExpressionContext {
+    glm::vec2 origin{ 0.0f };   // "distance" is measured from here to the player
+    float time = 0.0f;          // "time", seconds the owner has been running its effect
+    bool occupied = false;      // "occupied", the player is inside the owner's volume
+};
+
+enum class ExpressionOp : uint8_t {
+    LoadConst,      // r[dst] = constants[a]
+    LoadVar,        // r[dst] = game state value vars[a]
+    LoadDistance,   // r[dst] = distance from the context origin to the player
+    LoadTime,
+    LoadOccupied,
+    Neg,            // r[dst] = -r[a]
+    Not,
+    Abs,
+    Bool,           // r[dst] = r[a] != 0
+    Add,            // r[dst] = r[a] + r[b]
+    Sub,
+    Mul,
+    Div,            // x / 0 is 0
+    Min,
+    Max,
+    Less,
+    LessEqual,
+    Greater,
+    GreaterEqual,
+    Equal,
+    NotEqual,
+    JumpIfFalse,    // skip the next a instructions when r[dst] is 0
+    JumpIfTrue,
+    Return          // the result is r[dst]
+};
+
+struct ExpressionInstruction {
+    ExpressionOp op;
+    uint8_t dst;
+    uint8_t a;
+    uint8_t b;
+};
+
+// A condition or effect expression from map data, compiled to register
+// bytecode at load:
+//   "level >= 5 && key(\"red\")"
+//   "distance < 64 || flag(\"alarm\")"
+//   "10 + level * 2"
+// Inputs are level, distance, time and occupied; key(), quest(), flag() and
+// counter() read GameState; min(), max() and abs() are built in. Constant
+// subexpressions are folded, jumps only go forward and a program is capped
+// at MAX_INSTRUCTIONS, so one evaluation never runs longer than that.
+class ExpressionProgram {
+public:
+    static constexpr size_t MAX_INSTRUCTIONS = 64;
+    static constexpr size_t MAX_REGISTERS = 16;
+    static constexpr size_t MAX_SOURCE_LENGTH = 512;
+
+    // Null on a syntax error or when the budget is exceeded, the reason goes to outError.
+    // Interns the GameState names it reads, so main thread only.
+    static std::shared_ptr<const ExpressionProgram> compile(const std::string& source, std::string* outError = nullptr);
+
+    float evaluate(const ExpressionEnvironment& environment, const ExpressionContext& context) const;
+    bool test(const ExpressionEnvironment& environment, const ExpressionContext& context) const {
+        return evaluate(environment, context) != 0.0f;
+    }
+
+    // Tests many conditions against one environment, outResults[i] is 0 or 1
+    static void evaluateBatch(const ExpressionEnvironment& environment, const ExpressionProgram* const* programs,
+        const ExpressionContext* contexts, size_t count, uint8_t* outResults);
+
+    const std::string& getSource() const { return m_source; }
+    size_t getInstructionCount() const { return m_code.size(); }
+    bool isConstant() const { return m_isConstant; }
+    // GameState ids the program reads, each once
+    const std::vector<uint32_t>& getReads() const { return m_vars; }
+    // Reads distance, time or occupied, not only game state
+    bool readsContext() const { return m_readsContext; }
+
+private:
+    friend class ExpressionCompiler;
+
+    std::string m_source;
+    std::vector<ExpressionInstruction> m_code;
+    std::vector<float> m_constants;
+    std::vector<uint32_t> m_vars;       // GameState ids
+    bool m_isConstant = false;
+    bool m_readsContext = false;
+    float m_constantValue = 0.0f;
+};
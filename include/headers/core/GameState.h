@@ -0,0 +1,75 @@
+#pragma once
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Player progress the map data can test: level, keys, quests and free flags
+// or counters. Every value is a float in one array indexed by an interned id,
+// so compiled expressions read them without a string lookup. Main thread only.
+class GameState {
+public:
+    using VarId = uint32_t;
+
+    static GameState& getInstance() {
+        static GameState instance;
+        return instance;
+    }
+
+    // Ids stay valid for the whole run, unknown names start out as 0
+    VarId intern(const std::string& name);
+    const std::string& getName(VarId id) const { return m_names[id]; }
+
+    float getValue(VarId id) const { return id < m_values.size() ? m_values[id] : 0.0f; }
+    void setValue(VarId id, float value);
+    float getValue(const std::string& name) const;
+    void setValue(const std::string& name, float value) { setValue(intern(name), value); }
+
+    const float* getValues() const { return m_values.data(); }
+    size_t getValueCount() const { return m_values.size(); }
+    // Bumped on every change, lets callers skip re-testing conditions that only read state
+    uint32_t getRevision() const { return m_revision; }
+
+    // Called with the id of every value that actually changes, so a cache can
+    // re-test only what read it. Listeners must not change state themselves.
+    using ChangeListener = std::function<void(VarId)>;
+    using ListenerId = uint32_t;
+    ListenerId addChangeListener(ChangeListener listener);
+    void removeChangeListener(ListenerId id);
+
+    VarId getLevelId() const { return m_level; }
+    int getLevel() const { return static_cast<int>(getValue(m_level)); }
+    void setLevel(int level) { setValue(m_level, static_cast<float>(level)); }
+
+    bool hasKey(const std::string& id) const { return getValue(keyName(id)) != 0.0f; }
+    void giveKey(const std::string& id) { setValue(keyName(id), 1.0f); }
+    bool isQuestComplete(const std::string& id) const { return getValue(questName(id)) != 0.0f; }
+    void completeQuest(const std::string& id) { setValue(questName(id), 1.0f); }
+    bool getFlag(const std::string& name) const { return getValue(flagName(name)) != 0.0f; }
+    void setFlag(const std::string& name, bool value) { setValue(flagName(name), value ? 1.0f : 0.0f); }
+
+    static std::string keyName(const std::string& id) { return "key." + id; }
+    static std::string questName(const std::string& id) { return "quest." + id; }
+    static std::string flagName(const std::string& name) { return "flag." + name; }
+    static std::string counterName(const std::string& name) { return "counter." + name; }
+
+    // Zeroes every value; ids are kept since compiled expressions hold them
+    void reset();
+
+private:
+    GameState() { m_level = intern("level"); }
+    GameState(const GameState&) = delete;
+    GameState& operator=(const GameState&) = delete;
+
+    std::unordered_map<std::string, VarId> m_ids;
+    std::vector<std::string> m_names;
+    std::vector<float> m_values;
+    uint32_t m_revision = 0;
+    VarId m_level = 0;
+
+    std::vector<std::pair<ListenerId, ChangeListener>> m_listeners;
+    ListenerId m_nextListener = 1;
+
+    void notifyChanged(VarId id);
+};
@@ -0,0 +1,72 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+// Worker pool for background loading and data parallel work.
+// Anything touching GL or irrKlang goes through submitMainThread() instead,
+// Engine drains that queue once per frame.
+class JobSystem {
+public:
+    using Job = std::function<void()>;
+
+    static JobSystem& getInstance() {
+        static JobSystem instance;
+        return instance;
+    }
+
+    // 0 workers = one per hardware thread, minus the main thread
+    void initialize(size_t workerCount = 0);
+    void shutdown();
+    bool isInitialized() const { return !m_workers.empty(); }
+    size_t getWorkerCount() const { return m_workers.size(); }
+
+    // Lower priority values run first, equal priorities run in submission order.
+    // Runs inline when the pool isn't initialized.
+    void submit(Job job, int priority = 0);
+
+    // Splits [0, count) into grainSize chunks across the workers; the caller
+    // works on chunks too and returns once every chunk is done.
+    void parallelFor(size_t count, size_t grainSize, const std::function<void(size_t begin, size_t end)>& fn);
+
+    void submitMainThread(Job job);
+    // Runs queued main thread jobs until the queue is empty or budgetMs is spent
+    size_t runMainThreadJobs(double budgetMs);
+
+private:
+    JobSystem() = default;
+    ~JobSystem() { shutdown(); }
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    struct QueuedJob {
+        int priority;
+        uint64_t sequence;
+        Job job;
+    };
+
+    struct QueuedJobOrder {
+        bool operator()(const QueuedJob& a, const QueuedJob& b) const {
+            if (a.priority != b.priority) return a.priority > b.priority;
+            return a.sequence > b.sequence;
+        }
+    };
+
+    std::vector<std::thread> m_workers;
+    std::priority_queue<QueuedJob, std::vector<QueuedJob>, QueuedJobOrder> m_queue;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    bool m_stopping = false;
+    uint64_t m_sequence = 0;
+
+    std::mutex m_mainThreadMutex;
+    std::deque<Job> m_mainThreadJobs;
+
+    void workerLoop();
+};
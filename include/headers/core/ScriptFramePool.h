@@ -0,0 +1,44 @@
+#pragma once
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+// Coroutine frames for gameplay scripts. Frames are carved from 16 KB blocks
+// into 64 byte size classes and recycled through free lists, so starting a
+// script after warm-up never reaches the heap. Frames above MAX_POOLED_SIZE
+// fall back to operator new. Main thread only, like the scripts themselves.
+class ScriptFramePool {
+public:
+    static ScriptFramePool& getInstance() {
+        static ScriptFramePool instance;
+        return instance;
+    }
+
+    static constexpr size_t SIZE_CLASS = 64;
+    static constexpr size_t MAX_POOLED_SIZE = 1024;
+    static constexpr size_t BLOCK_SIZE = 16 * 1024;
+
+    void* allocate(size_t size);
+    void deallocate(void* frame, size_t size);
+
+    size_t getLiveFrames() const { return m_liveFrames; }
+    size_t getReservedBytes() const { return m_blocks.size() * BLOCK_SIZE; }
+
+private:
+    ScriptFramePool() = default;
+    ScriptFramePool(const ScriptFramePool&) = delete;
+    ScriptFramePool& operator=(const ScriptFramePool&) = delete;
+
+    struct FreeFrame {
+        FreeFrame* next;
+    };
+
+    static constexpr size_t CLASS_COUNT = MAX_POOLED_SIZE / SIZE_CLASS;
+
+    FreeFrame* m_free[CLASS_COUNT] = {};
+    std::vector<std::unique_ptr<std::byte[]>> m_blocks;
+    size_t m_blockUsed = BLOCK_SIZE;    // bytes handed out from the newest block
+    size_t m_liveFrames = 0;
+
+    static size_t sizeClass(size_t size) { return (size + SIZE_CLASS - 1) / SIZE_CLASS - 1; }
+};
@@ -0,0 +1,168 @@
+#pragma once
+#include "TimerWheel.h"
+#include "ScriptFramePool.h"
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <utility>
+#include <vector>
+
+class ScriptScheduler;
+class ScriptSignal;
+
+// Return type of a gameplay script:
+//   ScriptTask SequenceMechanism::runTimeLimit(float seconds) {
+//       co_await ScriptDelay{ seconds };
+//       handleSequenceFailure();
+//   }
+// Nothing runs until the task is handed to ScriptScheduler::start. Frames
+// come from ScriptFramePool.
+class ScriptTask {
+public:
+    struct promise_type {
+        ScriptScheduler* scheduler = nullptr;
+        uint32_t slot = 0;
+        uint32_t generation = 0;
+        TimerWheel::TimerId timer = TimerWheel::INVALID_TIMER;
+        ScriptSignal* signal = nullptr;     // what the script is waiting on, if anything
+
+        ScriptTask get_return_object() { return ScriptTask(std::coroutine_handle<promise_type>::from_promise(*this)); }
+        std::suspend_always initial_suspend() noexcept { return {}; }
+        std::suspend_always final_suspend() noexcept { return {}; }
+        void return_void() {}
+        void unhandled_exception() { std::terminate(); }
+
+        static void* operator new(size_t size) { return ScriptFramePool::getInstance().allocate(size); }
+        static void operator delete(void* frame, size_t size) { ScriptFramePool::getInstance().deallocate(frame, size); }
+    };
+    using Handle = std::coroutine_handle<promise_type>;
+
+    ScriptTask() = default;
+    ScriptTask(ScriptTask&& other) noexcept : m_handle(std::exchange(other.m_handle, nullptr)) {}
+    ScriptTask& operator=(ScriptTask&& other) noexcept {
+        if (this != &other) {
+            reset();
+            m_handle = std::exchange(other.m_handle, nullptr);
+        }
+        return *this;
+    }
+    ~ScriptTask() { reset(); }
+
+    explicit operator bool() const { return static_cast<bool>(m_handle); }
+    Handle release() { return std::exchange(m_handle, nullptr); }
+
+private:
+    explicit ScriptTask(Handle handle) : m_handle(handle) {}
+
+    void reset() {
+        if (m_handle) {
+            m_handle.destroy();
+            m_handle = nullptr;
+        }
+    }
+
+    Handle m_handle;
+};
+
+// co_await ScriptDelay{ seconds } sleeps on the scheduler's timer wheel
+struct ScriptDelay {
+    float seconds;
+
+    bool await_ready() const noexcept { return seconds <= 0.0f; }
+    void await_suspend(ScriptTask::Handle handle) const;
+    void await_resume() const noexcept {}
+};
+
+// Something scripts wait for, e.g. a mechanism changing state or a trigger
+// being entered: `co_await door.getStateSignal();`. notify() hands every
+// waiting script to its scheduler, which resumes it on the next update.
+// Scripts waiting here cost nothing until then.
+class ScriptSignal {
+public:
+    ScriptSignal() = default;
+    ScriptSignal(ScriptSignal&& other) noexcept;
+    ScriptSignal& operator=(ScriptSignal&& other) noexcept;
+    ScriptSignal(const ScriptSignal&) = delete;
+    ScriptSignal& operator=(const ScriptSignal&) = delete;
+    ~ScriptSignal();
+
+    void notify();
+    bool hasWaiters() const { return !m_waiters.empty(); }
+
+    struct Awaiter {
+        ScriptSignal& signal;
+
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(ScriptTask::Handle handle);
+        void await_resume() const noexcept {}
+    };
+    Awaiter operator co_await() noexcept { return Awaiter{ *this }; }
+
+private:
+    friend class ScriptScheduler;
+
+    std::vector<ScriptTask::Handle> m_waiters;
+
+    void detach(ScriptTask::Handle handle);
+    void adoptWaiters();
+};
+
+// Owns running scripts and resumes them only when what they wait for
+// happens: a delay running out on the timer wheel, or a signal. update()
+// touches fired timers and signalled scripts, never the suspended rest.
+class ScriptScheduler {
+public:
+    using ScriptId = uint64_t;
+    static constexpr ScriptId INVALID_SCRIPT = 0;
+
+    ScriptScheduler() = default;
+    ~ScriptScheduler() { clear(); }
+    ScriptScheduler(const ScriptScheduler&) = delete;
+    ScriptScheduler& operator=(const ScriptScheduler&) = delete;
+
+    // Runs the script up to its first co_await. The owner, usually a mechanism,
+    // lets cancelOwned stop everything it started. INVALID_SCRIPT if the
+    // script finished without suspending.
+    ScriptId start(ScriptTask task, const void* owner = nullptr);
+    // Destroys the frame; a script cancelling itself stops at its next co_await
+    bool cancel(ScriptId id);
+    size_t cancelOwned(const void* owner);
+    bool isRunning(ScriptId id) const { return findSlot(id) != nullptr; }
+
+    void update(float deltaTime);
+    void clear();
+
+    double getTime() const { return m_timers.getTime(); }
+    size_t getScriptCount() const { return m_scriptCount; }
+
+private:
+    friend struct ScriptDelay;
+    friend class ScriptSignal;
+
+    struct Slot {
+        ScriptTask::Handle handle;
+        const void* owner = nullptr;
+        uint32_t generation = 1;
+        bool cancelled = false;
+    };
+
+    std::vector<Slot> m_slots;
+    std::vector<uint32_t> m_freeSlots;
+    size_t m_scriptCount = 0;
+
+    TimerWheel m_timers;
+    std::vector<void*> m_fired;
+    std::vector<ScriptId> m_ready;
+    std::vector<ScriptId> m_resuming;
+    ScriptTask::Handle m_current;
+
+    static ScriptId makeId(uint32_t slot, uint32_t generation) {
+        return (static_cast<ScriptId>(generation) << 32) | slot;
+    }
+    const Slot* findSlot(ScriptId id) const;
+
+    void sleep(ScriptTask::Handle handle, float seconds);
+    void makeReady(ScriptTask::Handle handle);
+    void resume(ScriptId id);
+    void destroy(uint32_t slot);
+};
@@ -0,0 +1,62 @@
+#pragma once
+#include "TraceRecorder.h"
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+enum class TaskThread {
+    Worker,     // runs on the JobSystem pool
+    Main        // needs the GL context or another main thread only API
+};
+
+// Dependency graph of one-shot tasks, used for startup. Worker tasks go to the
+// JobSystem as soon as their dependencies finish; main thread tasks run on the
+// thread calling run(), which pumps the progress screen in between.
+class TaskGraph {
+public:
+    using TaskId = size_t;
+    using TaskFunction = std::function<bool()>;
+
+    // Returning false fails the task; its dependents are skipped. A failed
+    // critical task makes run() return false.
+    TaskId add(const std::string& name, TaskThread thread, TaskFunction fn,
+        const std::vector<TaskId>& dependencies = {}, bool critical = false);
+
+    // pump(progress) is called on the main thread between main thread tasks and
+    // while waiting for workers, progress runs from 0 to 1.
+    bool run(TraceRecorder* trace = nullptr, const std::function<void(float)>& pump = {});
+
+    // Longest chain of dependent tasks ending at the task that finished last
+    std::vector<TaskId> getCriticalPath() const;
+    void logCriticalPath() const;
+
+    size_t getTaskCount() const { return m_tasks.size(); }
+    const std::string& getTaskName(TaskId id) const { return m_tasks[id].name; }
+
+private:
+    enum class TaskState { Pending, Done, Failed, Skipped };
+
+    struct Task {
+        std::string name;
+        TaskThread thread;
+        TaskFunction fn;
+        std::vector<TaskId> dependencies;
+        std::vector<TaskId> dependents;
+        bool critical = false;
+        size_t remainingDependencies = 0;
+        bool dependencyFailed = false;
+        TaskState state = TaskState::Pending;
+        TraceRecorder::Clock::time_point start;
+        TraceRecorder::Clock::time_point end;
+    };
+
+    std::vector<Task> m_tasks;
+
+    std::mutex m_completedMutex;
+    std::condition_variable m_completedCondition;
+    std::vector<TaskId> m_completed;    // finished worker tasks not yet processed by run()
+
+    bool execute(Task& task, TraceRecorder* trace);
+};
@@ -0,0 +1,42 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Hashed timing wheel for wake-ups after a delay. Timers land in the slot of
+// their deadline tick, so scheduling and cancelling are O(1) and advance()
+// only visits the slots of the ticks that passed. Deadlines further out than
+// one turn of the wheel wait in their slot until their round comes up.
+class TimerWheel {
+public:
+    using TimerId = uint32_t;
+    static constexpr TimerId INVALID_TIMER = UINT32_MAX;
+
+    explicit TimerWheel(float tickSeconds = 1.0f / 60.0f, size_t slotCount = 256);
+
+    // Fires on the first tick at least delay seconds from now, never on the current one
+    TimerId schedule(float delay, void* payload);
+    bool cancel(TimerId id);
+    void clear();
+
+    // Moves time forward and appends the payloads of the timers that came due
+    void advance(float deltaTime, std::vector<void*>& outFired);
+
+    double getTime() const { return m_time; }
+    size_t size() const { return m_pending; }
+
+private:
+    struct Timer {
+        uint64_t deadline = 0;    // in ticks
+        void* payload = nullptr;
+        bool alive = false;
+    };
+
+    double m_time = 0.0;
+    uint64_t m_currentTick = 0;
+    float m_tickSeconds;
+    std::vector<std::vector<TimerId>> m_slots;
+    std::vector<Timer> m_timers;
+    std::vector<TimerId> m_freeTimers;
+    size_t m_pending = 0;
+};
@@ -0,0 +1,40 @@
+#pragma once
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+// Collects timed spans from any thread and writes them in the Chrome trace
+// event format (open in chrome://tracing or ui.perfetto.dev).
+class TraceRecorder {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    explicit TraceRecorder(Clock::time_point origin = Clock::now());
+
+    void addSpan(const std::string& name, const std::string& category,
+        Clock::time_point start, Clock::time_point end);
+    void addInstant(const std::string& name, Clock::time_point when = Clock::now());
+
+    double getElapsedMs(Clock::time_point when = Clock::now()) const;
+    bool writeChromeTrace(const std::string& path) const;
+
+private:
+    struct TraceEvent {
+        std::string name;
+        std::string category;
+        double startUs;
+        double durationUs;      // negative for instant events
+        int threadIndex;
+    };
+
+    Clock::time_point m_origin;
+    mutable std::mutex m_mutex;
+    std::vector<TraceEvent> m_events;
+    std::unordered_map<std::thread::id, int> m_threadIndices;   // first thread seen (main) is 0
+
+    int getThreadIndex();
+    double toMicroseconds(Clock::time_point when) const;
+};
@@ -1,11 +1,14 @@
 #pragma once
 #include "MapTypes.h"
 #include "../../../include/headers/collision/BoxCollider.h"
+#include "../../../include/headers/collision/CollisionWorld.h"
+#include "../../../include/headers/collision/TriggerVolumeService.h"
 #include <vector>
 #include <memory>
 #include <unordered_map>
-#include "../../../include/headers/map/mechanism/IMechanism.h"
+#include "../../../include/headers/map/mechanism/MechanismStore.h"
 #include "LayerRenderer.h"
+#include "TileMap.h"
 
 class Area {
 public:
@@ -24,11 +27,17 @@ public:
 
     void addPortal(const PortalData& portal);
     const std::vector<PortalData>& getPortals() const { return m_portals; }
+    // For PortalConditionService, which caches condition results in place
+    PortalData& getPortal(size_t index) { return m_portals[index]; }
     bool hasPortalTo(const std::string& areaId) const;
 
     void addCollider(std::unique_ptr<BoxCollider> collider);
     const std::vector<std::unique_ptr<BoxCollider>>& getColliders() const { return m_colliders; }
 
+    // Drawn between the background and the object layer, in the order added
+    void addTileLayer(const TileLayerData& layer);
+    const std::vector<TileLayerData>& getTileLayers() const { return m_tileLayers; }
+
     virtual void update(float deltaTime);
     virtual void render();
     void renderMechanisms();
@@ -44,21 +53,46 @@ public:
 
     bool loadResources();
     void unloadResources();
+    // name, path of the area's bgm and ambient sounds; they need not exist
+    static std::vector<std::pair<std::string, std::string>> getSoundFiles(const std::string& areaId);
     bool initializeRenderer();
 
-    std::unordered_map<std::string, std::unique_ptr<IMechanism>>& getMechanisms() { return m_mechanisms; }
-    void setMechanisms(std::unordered_map<std::string, std::unique_ptr<IMechanism>>&& mechanisms);
+    MechanismStore& getMechanisms() { return m_mechanisms; }
+    const MechanismStore& getMechanisms() const { return m_mechanisms; }
+
+    // Broadphase over static colliders, mechanism colliders and portals
+    CollisionWorld& getCollisionWorld() { return m_collisionWorld; }
+    const CollisionWorld& getCollisionWorld() const { return m_collisionWorld; }
+    // Picks up mechanism colliders that moved or were replaced this frame
+    void syncMechanismColliders();
+
+    // Radius triggers are registered here; MapManager adds the player and portals
+    TriggerVolumeService& getTriggerVolumes() { return m_triggerVolumes; }
 
 private:
-    std::unordered_map<std::string, std::unique_ptr<IMechanism>> m_mechanisms;
+    MechanismStore m_mechanisms;
     std::unique_ptr<LayerRenderer> m_layerRenderer;
 
+    CollisionWorld m_collisionWorld;
+    std::unordered_map<const IMechanism*, const ICollider*> m_mechanismColliders;  // what the world currently holds
+
+    struct TriggerRange {
+        TriggerMechanism* trigger;      // null for state machines, their collider is the volume
+        TriggerVolumeService::VolumeId volume;
+    };
+    TriggerVolumeService m_triggerVolumes;
+    std::unordered_map<const IMechanism*, TriggerRange> m_triggerRanges;
+
+    void registerMechanismCollider(IMechanism& mechanism);
+    void unregisterMechanismCollider(const IMechanism& mechanism);
+
     bool loadBackgroundTexture();
-    bool loadMechanismConfigs();
+    bool loadTilesetTextures();
 
 
 protected:
     AreaData m_data;
     std::vector<PortalData> m_portals;
     std::vector<std::unique_ptr<BoxCollider>> m_colliders;
+    std::vector<TileLayerData> m_tileLayers;
 };
\ No newline at end of file
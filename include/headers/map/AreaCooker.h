@@ -0,0 +1,31 @@
+#pragma once
+#include "AreaDefinition.h"
+#include "CookedAreaFormat.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// Compiles areas/<id>.json plus mechanisms/triggers/<id>.json and the tile map
+// the area names into a cooked blob.
+class AreaCooker {
+public:
+    static bool cookArea(const std::string& areaId);
+    static int cookAllAreas();
+
+    // Reads the JSON sources into a definition, same rules the runtime loader uses
+    static bool loadJsonDefinition(const std::string& areaId, AreaDefinition& outDefinition);
+    // Newest write time of the area's sources; tilemap is the one the area file names, if any
+    static int64_t getSourceTimestamp(const std::string& areaId, const std::string& tilemap = "");
+
+    static bool writeCookedArea(const AreaDefinition& definition, int64_t sourceTimestamp,
+        std::vector<unsigned char>& outBlob);
+};
+
+// Builds an AreaDefinition from a cooked blob without touching JSON.
+class CookedAreaLoader {
+public:
+    // Returns false if the blob is missing, stale, or doesn't match this build
+    static bool loadArea(const std::string& areaId, AreaDefinition& outDefinition);
+    static bool readBlob(const unsigned char* data, size_t size, AreaDefinition& outDefinition,
+        int64_t* outSourceTimestamp = nullptr);
+};
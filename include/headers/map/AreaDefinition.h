@@ -0,0 +1,47 @@
+#pragma once
+#include "MapTypes.h"
+#include "TileMap.h"
+#include "mechanism/MechanismTypes.h"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// Plain description of an area as it comes out of a map file.
+// Both the JSON loader and the cooked binary loader produce this,
+// MapManager then builds the runtime Area from it.
+
+struct ColliderDefinition {
+    glm::vec2 position{ 0.0f };
+    glm::vec2 size{ 0.0f };
+    uint32_t layer = 0;
+    uint32_t mask = 0;
+};
+
+struct MechanismDefinition {
+    std::string id;
+    MechanismType type = MechanismType::Trigger;
+    glm::vec2 position{ 0.0f };
+    glm::vec2 size{ 0.0f };
+
+    // Trigger
+    TriggerCondition condition;
+    MechanismEffect effect;
+
+    // Sequence
+    std::vector<std::string> sequence;
+    float timeLimit = 0.0f;
+
+    // Breakable, Trap, BuffZone, MovingPlatform: maps/mechanisms/machines/<machine>.json
+    std::string machine;
+};
+
+struct AreaDefinition {
+    AreaData data;
+    std::vector<PortalData> portals;
+    std::vector<ColliderDefinition> colliders;
+    std::vector<MechanismDefinition> mechanisms;
+
+    // maps/tilemaps/<tilemap>.json; its solid tiles are merged into colliders
+    std::string tilemap;
+    std::vector<TileLayerData> tileLayers;
+};
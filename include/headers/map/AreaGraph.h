@@ -0,0 +1,34 @@
+#pragma once
+#include "MapTypes.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct AreaGraphEdge {
+    std::string targetAreaId;
+    glm::vec2 portalCenter;     // where the portal sits in the source area
+};
+
+// Which areas connect to which, built from every area's portals.
+class AreaGraph {
+public:
+    struct ReachableArea {
+        std::string areaId;
+        int hops;
+        glm::vec2 exitPortal;   // portal in the start area the shortest route leaves through
+    };
+
+    void clear() { m_edges.clear(); }
+    void setArea(const std::string& areaId, const std::vector<PortalData>& portals);
+    bool hasArea(const std::string& areaId) const { return m_edges.count(areaId) != 0; }
+    size_t getAreaCount() const { return m_edges.size(); }
+    const std::vector<AreaGraphEdge>* getEdges(const std::string& areaId) const;
+
+    // Breadth first search up to maxHops portals away, excluding the start area.
+    // Routes leave through the start area portal closest to fromPosition first.
+    std::vector<ReachableArea> collectWithinHops(const std::string& startAreaId, int maxHops,
+        const glm::vec2& fromPosition) const;
+
+private:
+    std::unordered_map<std::string, std::vector<AreaGraphEdge>> m_edges;
+};
@@ -0,0 +1,91 @@
+#pragma once
+#include "AreaGraph.h"
+#include "AreaDefinition.h"
+#include "../resource/TextureData.h"
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+struct PrefetchSettings {
+    int maxHops = 2;                                    // how far through portals to look ahead
+    int maxInFlight = 2;                                // concurrent background loads
+    float hopPenalty = 512.0f;                          // world units added per extra hop when ranking
+    float replanDistance = 64.0f;                       // player movement that re-ranks the queue
+    size_t memoryBudgetBytes = 256 * 1024 * 1024;       // resident areas beyond this get evicted
+    double installBudgetMs = 4.0;                       // main thread time per frame for uploads and building
+};
+
+struct StreamedTexture {
+    std::string name;
+    std::string path;
+    DecodedTexture decoded;         // empty if decoding failed
+};
+
+struct StreamedSound {
+    std::string name;
+    std::string path;
+    std::vector<char> data;         // empty if reading failed
+};
+
+// An area loaded off the main thread, ready to be turned into a runtime Area
+struct PrefetchedArea {
+    std::string areaId;
+    bool success = false;
+    AreaDefinition definition;
+    std::vector<StreamedTexture> textures;  // background and tilesets
+    std::vector<StreamedSound> sounds;      // bgm and ambient
+};
+
+// Loads the areas around the current one on JobSystem workers.
+// Candidates come from the portal graph and are ranked by how close the player
+// is to the portal leading towards them; MapManager installs the results.
+class AreaPrefetcher {
+public:
+    AreaPrefetcher();
+
+    void setSettings(const PrefetchSettings& settings) { m_settings = settings; }
+    const PrefetchSettings& getSettings() const { return m_settings; }
+
+    // Main thread, every frame. Re-ranks when the area changed or the player moved enough.
+    void update(const AreaGraph& graph, const std::string& currentAreaId, const glm::vec2& playerPosition,
+        const std::function<bool(const std::string&)>& isResident);
+
+    // Main thread. Hands over at most one finished area that is still wanted.
+    bool takeReady(PrefetchedArea& outArea);
+
+    // Within maxHops of the current area, these are never evicted
+    bool isWanted(const std::string& areaId) const { return m_wanted.count(areaId) != 0; }
+    bool isLoading(const std::string& areaId) const { return m_inFlight.count(areaId) != 0; }
+
+    // Worker threads. collectResources lists the textures and sounds on disk that
+    // building the area will ask for, the other two load one of them.
+    static void collectResources(PrefetchedArea& area);
+    static bool decodeTexture(StreamedTexture& texture);
+    static bool readSound(StreamedSound& sound);
+
+private:
+    struct SharedState {
+        std::mutex mutex;
+        std::deque<PrefetchedArea> ready;
+    };
+
+    std::shared_ptr<SharedState> m_shared;
+    PrefetchSettings m_settings;
+
+    std::string m_plannedAreaId;
+    glm::vec2 m_plannedPosition{ 0.0f };
+    size_t m_plannedGraphSize = 0;
+
+    std::vector<AreaGraph::ReachableArea> m_queue;   // best candidate last
+    std::unordered_set<std::string> m_wanted;
+    std::unordered_set<std::string> m_inFlight;
+
+    void plan(const AreaGraph& graph, const std::string& currentAreaId, const glm::vec2& playerPosition,
+        const std::function<bool(const std::string&)>& isResident);
+    void submitLoads(const std::function<bool(const std::string&)>& isResident);
+    float getScore(const AreaGraph::ReachableArea& area) const;
+};
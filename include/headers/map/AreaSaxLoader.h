@@ -0,0 +1,31 @@
+#pragma once
+#include "AreaDefinition.h"
+#include <string>
+#include <vector>
+
+struct AreaLoadIssue {
+    size_t line = 0;
+    size_t column = 0;
+    std::string path;       // JSON pointer to the offending value, e.g. /mechanisms/3/radius
+    std::string message;
+    bool isFatal = false;   // fatal issues abort the load, others only drop the entry
+};
+
+// Single pass loader for area and mechanism JSON built on nlohmann's SAX interface.
+// Fills the definition while parsing, never builds a DOM, and validates the same
+// required fields ConfigValidator checks. Invalid portals, colliders or mechanisms
+// are skipped like the DOM loader does; a broken area header fails the load.
+class AreaSaxLoader {
+public:
+    static bool loadAreaFile(const std::string& path, AreaDefinition& outDefinition,
+        std::vector<AreaLoadIssue>* outIssues = nullptr);
+    static bool loadMechanismFile(const std::string& path, std::vector<MechanismDefinition>& outMechanisms,
+        std::vector<AreaLoadIssue>* outIssues = nullptr);
+
+    static bool parseArea(const char* data, size_t size, AreaDefinition& outDefinition,
+        std::vector<AreaLoadIssue>* outIssues = nullptr);
+    static bool parseMechanisms(const char* data, size_t size, std::vector<MechanismDefinition>& outMechanisms,
+        std::vector<AreaLoadIssue>* outIssues = nullptr);
+
+    static std::string formatIssue(const std::string& source, const AreaLoadIssue& issue);
+};
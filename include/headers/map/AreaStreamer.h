@@ -0,0 +1,37 @@
+#pragma once
+#include "AreaPrefetcher.h"
+#include <atomic>
+#include <memory>
+#include <string>
+
+// Loads the area a transition is waiting for. One worker job parses it, then
+// every texture decode and sound read runs as a job of its own ahead of any
+// prefetching, so progress can be reported per finished job.
+class AreaStreamer {
+public:
+    // Main thread. Forgets any load still running, its jobs finish unobserved.
+    void start(const std::string& areaId);
+    void cancel() { m_shared.reset(); }
+
+    bool isActive() const { return m_shared != nullptr; }
+    const std::string& getAreaId() const { return m_areaId; }
+
+    // The job count grows once the area is parsed and its resources are known
+    size_t getJobCount() const;
+    size_t getFinishedJobCount() const;
+
+    // Main thread. Hands the area over once every job has finished, check success.
+    bool takeResult(PrefetchedArea& outArea);
+
+private:
+    struct SharedState {
+        PrefetchedArea area;
+        std::atomic<size_t> jobCount{ 1 };
+        std::atomic<size_t> finishedJobs{ 0 };
+    };
+
+    std::shared_ptr<SharedState> m_shared;
+    std::string m_areaId;
+
+    static void parse(const std::shared_ptr<SharedState>& shared);
+};
@@ -12,6 +12,8 @@ public:
     AreaTransitionEffect(Type type = Type::FADE);
 
     void start(float duration = 1.0f);
+    // The effect holds at its end state until stopped
+    void stop() { m_isActive = false; }
     void update(float deltaTime);
     void render();
 
@@ -23,6 +25,7 @@ private:
     float m_duration;
     float m_progress;
     bool m_isFinished;
+    bool m_isActive = false;
 
     void renderFade();
     void renderSlide();
@@ -0,0 +1,129 @@
+#pragma once
+#include <cstdint>
+
+// Binary layout of a cooked area (resources/maps/cooked/<id>.area).
+//
+// [CookedAreaHeader][CookedAreaRecord][portals][colliders][mechanisms][sequence steps]
+// [tile layers][tiles][string table]
+//
+// Every record is fixed size and made of 4 byte fields only, so the blob can be
+// read straight out of a file mapping. Strings are stored once in the trailing
+// table and referenced by offset/length. Bump COOKED_AREA_VERSION whenever a
+// record changes; stale or mismatching blobs are ignored and the JSON is used.
+
+constexpr uint32_t COOKED_AREA_MAGIC = 0x41545341;  // "ASTA"
+constexpr uint32_t COOKED_AREA_VERSION = 4;
+
+struct CookedStringRef {
+    uint32_t offset;
+    uint32_t length;
+};
+
+struct CookedAreaHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t sourceTimeLow;     // newest source json write time when cooked
+    uint32_t sourceTimeHigh;
+    uint32_t totalSize;
+
+    uint32_t portalOffset;
+    uint32_t portalCount;
+    uint32_t colliderOffset;
+    uint32_t colliderCount;
+    uint32_t mechanismOffset;
+    uint32_t mechanismCount;
+    uint32_t stepOffset;
+    uint32_t stepCount;
+    uint32_t tileLayerOffset;
+    uint32_t tileLayerCount;
+    uint32_t tileOffset;        // uint32_t per tile, every layer's grid back to back
+    uint32_t tileCount;
+    uint32_t stringOffset;
+    uint32_t stringSize;
+};
+
+enum CookedAreaFlags : uint32_t {
+    COOKED_AREA_UNLOCKED = 1 << 0,
+    COOKED_AREA_DISCOVERED = 1 << 1
+};
+
+struct CookedAreaRecord {
+    CookedStringRef id;
+    CookedStringRef name;
+    int32_t type;
+    uint32_t flags;
+    float bounds[4];            // x, y, width, height
+    CookedStringRef tilemap;    // source name only, tile layers and colliders are cooked in
+};
+
+enum CookedPortalFlags : uint32_t {
+    COOKED_PORTAL_LOCKED = 1 << 0
+};
+
+struct CookedPortalRecord {
+    CookedStringRef targetAreaId;
+    float position[2];
+    float size[2];
+    float targetPosition[2];
+    uint32_t flags;
+    int32_t conditionType;
+    CookedStringRef conditionExpression;
+};
+
+struct CookedColliderRecord {
+    float position[2];
+    float size[2];
+    uint32_t layer;
+    uint32_t mask;
+};
+
+enum CookedMechanismFlags : uint32_t {
+    COOKED_MECH_REQUIRES_PLAYER = 1 << 0,
+    COOKED_MECH_REQUIRES_INTERACTION = 1 << 1
+};
+
+struct CookedMechanismRecord {
+    CookedStringRef id;
+    int32_t type;
+    uint32_t flags;
+    float position[2];
+    float size[2];
+
+    // Trigger
+    float triggerRadius;
+    int32_t effectType;
+    CookedStringRef effectTargetId;
+    float effectValue;
+    float effectDuration;
+    float effectDirection[2];
+    CookedStringRef conditionExpression;
+    CookedStringRef valueExpression;
+
+    // Sequence
+    float timeLimit;
+    uint32_t firstStep;
+    uint32_t stepCount;
+
+    // Breakable, Trap, BuffZone, MovingPlatform
+    CookedStringRef machine;
+};
+
+// Solid tiles are not kept, their merged colliders are in the collider section
+struct CookedTileLayerRecord {
+    CookedStringRef name;
+    CookedStringRef tileset;
+    int32_t width;
+    int32_t height;
+    float tileSize[2];
+    float origin[2];
+    int32_t tilesetColumns;
+    int32_t tilesetRows;
+    uint32_t firstTile;         // index into the tile section, width * height tiles
+};
+
+static_assert(sizeof(CookedAreaHeader) == 76, "CookedAreaHeader layout changed, bump COOKED_AREA_VERSION");
+static_assert(sizeof(CookedAreaRecord) == 48, "CookedAreaRecord layout changed, bump COOKED_AREA_VERSION");
+static_assert(sizeof(CookedPortalRecord) == 48, "CookedPortalRecord layout changed, bump COOKED_AREA_VERSION");
+static_assert(sizeof(CookedColliderRecord) == 24, "CookedColliderRecord layout changed, bump COOKED_AREA_VERSION");
+static_assert(sizeof(CookedMechanismRecord) == 100, "CookedMechanismRecord layout changed, bump COOKED_AREA_VERSION");
+static_assert(sizeof(CookedTileLayerRecord) == 52, "CookedTileLayerRecord layout changed, bump COOKED_AREA_VERSION");
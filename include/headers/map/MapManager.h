@@ -1,5 +1,11 @@
 #pragma once
 #include "Area.h"
+#include "AreaDefinition.h"
+#include "AreaGraph.h"
+#include "AreaPrefetcher.h"
+#include "AreaStreamer.h"
+#include "portal/PortalConditionService.h"
+#include <deque>
 #include <unordered_map>
 #include <memory>
 #include "AreaTransitionEffect.h"
@@ -14,19 +20,45 @@ public:
     }
 
     bool loadArea(const std::string& areaId, const std::string& filePath);
-    bool parseAreaData(const nlohmann::json& json, AreaData& outData);
-    void unloadArea(const std::string& areaId);
+    // Builds from a definition parsed elsewhere, e.g. by a startup worker
+    bool loadArea(const std::string& areaId, const AreaDefinition& definition);
+    bool unloadArea(const std::string& areaId);
     Area* getCurrentArea() const { return m_currentArea; }
     Area* getArea(const std::string& areaId) const;
 
+    // Rebuilds a loaded area from a fresh definition, mechanism state is kept by id.
+    // Main thread only, between frames.
+    bool reloadArea(const std::string& areaId, const AreaDefinition& definition);
+    // Rebuilds the loaded areas that place a mechanism using this machine, returns how many
+    int reloadMachineUsers(const std::string& machine);
+
+    // Reads every area's portals into the connectivity graph used for prefetching
+    void buildAreaGraph();
+    void setAreaPortals(const std::string& areaId, const std::vector<PortalData>& portals) { m_areaGraph.setArea(areaId, portals); }
+    // Ids of every area with a JSON or cooked file under resources/maps
+    static std::vector<std::string> findAreaIds();
+    const AreaGraph& getAreaGraph() const { return m_areaGraph; }
+    void setPrefetchSettings(const PrefetchSettings& settings) { m_prefetcher.setSettings(settings); }
+    size_t getResidentMemoryUsage() const;
+    const PortalConditionService& getPortalConditions() const { return m_portalConditions; }
+
+    // Cooked blob if it is current, JSON otherwise. Safe to call from worker threads.
+    static bool loadAreaDefinition(const std::string& areaId, AreaDefinition& outDefinition);
+
+    // Resident areas swap in right away. Others stream in on workers while the
+    // current area keeps running under the transition effect; update swaps once built.
     bool changeArea(const std::string& areaId, const glm::vec2& position);
+    bool isTransitioning() const { return m_isTransitioning; }
+    // Runs the current area's overlap events for the player after it moved:
+    // radius triggers and portals hear enter, stay and exit from there
+    void updateTriggerVolumes(const BoxCollider* playerCollider);
+    // Takes the area change a portal asked for in the last updateTriggerVolumes,
+    // unless the portal's condition keeps it shut
     bool handlePortalTransition(const BoxCollider* playerCollider);
 
     void update(float deltaTime);
     void render();
 
-    void loadMechanisms(Area* area, const std::string& areaId);
-
 private:
     MapManager()
         : m_currentArea(nullptr)
@@ -44,16 +76,57 @@ private:
     bool m_isTransitioning = false;
     Area* m_currentArea;
 
-    std::unique_ptr<IMechanism> createMechanism(MechanismType type, const nlohmann::json& mechData);
+    AreaGraph m_areaGraph;
+    AreaPrefetcher m_prefetcher;
+    PortalConditionService m_portalConditions;
+    std::unordered_map<std::string, uint64_t> m_areaLastUsed;   // frame the area was last current
+    uint64_t m_frameCounter = 0;
+
+    struct PendingPortal {
+        const Area* area = nullptr;
+        size_t portalIndex = 0;
+    };
+    PendingPortal m_pendingPortal;
+    Area* m_overlapArea = nullptr;                  // area whose trigger volumes hold the player
+    const BoxCollider* m_overlapActor = nullptr;
 
-    bool loadAreaData(const std::string& filePath, AreaData& outData);
+    std::unique_ptr<IMechanism> createMechanism(const MechanismDefinition& definition);
+
+    std::unique_ptr<Area> buildArea(const std::string& areaId, const AreaDefinition& definition);
+    void subscribePortals(Area& area);
+    // Before an area is destroyed, so nothing keeps pointing into it
+    void forgetArea(const Area* area);
     bool preloadAreaResources(const std::string& areaId);
-    void loadColliders(Area* area, const nlohmann::json& json);
+
+    // A loaded area on its way to becoming resident: textures are uploaded and
+    // sounds registered one per step, then the area is built
+    struct AreaInstall {
+        PrefetchedArea area;
+        size_t nextTexture = 0;
+        size_t nextSound = 0;
+
+        size_t getStepCount() const { return area.textures.size() + area.sounds.size() + 1; }
+        size_t getFinishedSteps() const { return nextTexture + nextSound; }
+    };
+    std::deque<AreaInstall> m_installs;             // front first, a transition's area goes to the front
+
+    AreaStreamer m_streamer;
+    std::string m_transitionAreaId;
+    glm::vec2 m_transitionPosition{ 0.0f };
+
+    void updatePrefetch(const glm::vec2& playerPosition);
+    // Works through m_installs within PrefetchSettings::installBudgetMs
+    void runInstalls();
+    void runInstallStep(AreaInstall& install);
+    void installArea(PrefetchedArea& prefetched);
+    void enforceMemoryBudget();
+    size_t getAreaMemoryUsage(const Area& area) const;
 
     void startAreaTransition(const std::string& areaId, const glm::vec2& position);
-    bool loadAreaResources(const std::string& areaId);
-    void unloadCurrentArea();
+    void updateTransition(float deltaTime);
+    float getTransitionProgress() const;
     void finalizeAreaChange(const std::string& areaId, const glm::vec2& position);
+    void endTransition();
     std::string getAreaPath(const std::string& areaId) const;
 
     //std::unique_ptr<IMechanism> createTriggerMechanism(const nlohmann::json& mechData);
@@ -2,7 +2,8 @@
 #include <string>
 #include <vector>
 #include <glm/glm.hpp>
-#include <functional>
+#include <memory>
+#include "../core/ExpressionProgram.h"
 
 enum class AreaType {
     Normal,         
@@ -46,7 +47,7 @@ enum class PortalConditionType {
     Key,            // Requires specific key
     Quest,          // Requires quest completion
     Level,          // Requires specific level
-    Custom          // Custom condition
+    Custom          // Expression from the map data
 };
 
 // Add new condition struct
@@ -56,10 +57,12 @@ struct PortalCondition {
     // Condition parameters
     std::string requiredId;     // Key/Quest ID
     int requiredLevel = 0;      // Required level
-    bool isMet = false;         // Condition state
+    bool isMet = false;         // Cached by PortalConditionService
+    bool isLive = false;        // Reads the player's position, tested on entry instead
 
-    // Custom condition callback
-    std::function<bool()> customCheck = nullptr;
+    // Custom: e.g. "quest(\"bridge\") || level >= 10", compiled when the area is built
+    std::string expression;
+    std::shared_ptr<const ExpressionProgram> program;
 };
 
 struct PortalData {
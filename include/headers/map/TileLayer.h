@@ -0,0 +1,46 @@
+#pragma once
+#include "ILayer.h"
+#include "TileMap.h"
+#include <vector>
+
+// Draws a tile grid in chunks of CHUNK_TILES x CHUNK_TILES tiles. Each chunk's
+// quads are built once into a static vertex buffer, uploaded the first time
+// the chunk comes into view; a frame draws only the chunks the camera sees,
+// one draw call each.
+class TileLayer : public ILayer {
+public:
+    static constexpr int CHUNK_TILES = 16;
+
+    TileLayer(const TileLayerData& data, const TextureData* tileset);
+    ~TileLayer() override;
+
+    void update(float deltaTime) override;
+    void render() override;
+
+    size_t getChunkCount() const { return m_chunks.size(); }
+    size_t getUploadedChunkCount() const { return m_uploadedChunks; }
+    size_t getDrawnChunkCount() const { return m_drawnChunks; }    // last frame
+
+private:
+    struct Chunk {
+        std::vector<float> vertices;    // x, y, u, v per vertex in world space, freed once uploaded
+        GLsizei vertexCount = 0;
+        GLuint vao = 0;
+        GLuint vbo = 0;
+    };
+
+    const TextureData* m_tileset;
+    glm::vec2 m_origin;
+    glm::vec2 m_chunkSize;              // world units
+    int m_chunksX = 0;
+    int m_chunksY = 0;
+    std::vector<Chunk> m_chunks;        // row major
+    size_t m_uploadedChunks = 0;
+    size_t m_drawnChunks = 0;
+
+    TileLayer(const TileLayer&) = delete;
+    TileLayer& operator=(const TileLayer&) = delete;
+
+    void buildChunk(const TileLayerData& data, int chunkX, int chunkY, Chunk& outChunk) const;
+    void upload(Chunk& chunk);
+};
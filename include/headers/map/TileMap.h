@@ -0,0 +1,47 @@
+#pragma once
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// One grid of tiles as it comes out of a tile map file, drawn by TileLayer.
+// Tiles index the tileset row by row from its top left, 0 is empty and n is
+// tileset tile n - 1.
+struct TileLayerData {
+    std::string name;
+    int width = 0;                  // in tiles
+    int height = 0;
+    glm::vec2 tileSize{ 32.0f };
+    glm::vec2 origin{ 0.0f };       // world position of the top left tile
+
+    std::string tileset;            // textures/tilesets/<tileset>.png
+    int tilesetColumns = 1;
+    int tilesetRows = 1;
+
+    std::vector<uint32_t> tiles;    // width * height, row major
+    // Tileset tiles that block movement. Only needed to build colliders, so
+    // cooked areas carry the merged colliders instead of this.
+    std::vector<uint32_t> solidTiles;
+
+    uint32_t at(int x, int y) const { return tiles[static_cast<size_t>(y) * width + x]; }
+};
+
+// Rectangle in tile coordinates
+struct TileRect {
+    int x, y;
+    int width, height;
+};
+
+class TileMapLoader {
+public:
+    // Reads an orthogonal Tiled JSON map (.tmj/.json): every tile layer with
+    // uncompressed CSV data, using the map's embedded tilesets. Tileset tiles
+    // with a "solid" bool property, and every tile of a layer with a
+    // "collision" bool property, become solid. Safe to call from worker threads.
+    static bool loadTiled(const std::string& path, std::vector<TileLayerData>& outLayers);
+
+    // Covers the layer's solid tiles with few rectangles: each row is swept
+    // left to right, a run of solid tiles is grown as wide as it goes and then
+    // down while the rows below are solid over its whole width
+    static std::vector<TileRect> mergeSolidTiles(const TileLayerData& layer);
+};
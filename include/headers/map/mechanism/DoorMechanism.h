@@ -1,10 +1,13 @@
 #pragma once
 #include "IMechanism.h"
+#include "MechanismPrototypes.h"
 #include "../../../../include/headers/renderer/Renderer.h"
 #include <algorithm>
 
-class DoorMechanism : public IMechanism {
+class DoorMechanism final : public IMechanism {
 public:
+    static constexpr MechanismType TYPE = MechanismType::Door;
+
     enum class DoorState {
         Closed,         
         Opening,        
@@ -13,13 +16,17 @@ public:
         Locked,        
         Malfunction    
     };
-    DoorMechanism(const std::string& id, const glm::vec2& position, const glm::vec2& size);
-    ~DoorMechanism() override = default;
+    // Null prototype means the default door
+    DoorMechanism(const std::string& id, const glm::vec2& position, const glm::vec2& size,
+        std::shared_ptr<const DoorPrototype> prototype = nullptr);
 
     void activate() override;
     void deactivate() override;
     void update(float deltaTime) override;
     void reset() override;
+    void restoreState(const IMechanism& previous) override;
+    // Only a door that is swinging needs updates
+    bool isDormant() const override { return m_doorState != DoorState::Opening && m_doorState != DoorState::Closing; }
     void render();
 
     bool isOpen() const { return m_doorState == DoorState::Open; }
@@ -28,22 +35,12 @@ public:
     void setLocked(bool locked);
 
 private:
+    std::shared_ptr<const DoorPrototype> m_prototype;
     DoorState m_doorState;
     float m_transitionProgress;
-    float m_transitionDuration;
-    float m_openSpeed;        
-    float m_closeSpeed;       
-
-    glm::vec4 m_closedColor;
-    glm::vec4 m_openColor;
-    glm::vec4 m_lockedColor;
 
     void updateDoorState(float deltaTime);
     void updateCollider();
     void updateVisuals();
     glm::vec4 getCurrentColor() const;
-
-    static constexpr float COLLISION_DISABLE_THRESHOLD = 0.8f;  
-    static constexpr float DOOR_OPEN_SPEED = 2.0f;    
-    static constexpr float DOOR_CLOSE_SPEED = 1.5f;   
 };
\ No newline at end of file
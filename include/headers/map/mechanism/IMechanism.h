@@ -1,9 +1,24 @@
 #pragma once
 #include "MechanismTypes.h"
 #include "../../collision/BoxCollider.h"
+#include "../../core/ScriptScheduler.h"
+#include <cstdint>
 #include <memory>
 #include <iostream>
 
+class IMechanism;
+
+// Told when a mechanism has work to do again. MechanismStore implements it and
+// only updates mechanisms that are awake.
+class IMechanismScheduler {
+public:
+    virtual ~IMechanismScheduler() = default;
+
+    virtual void wake(IMechanism& mechanism) = 0;
+    virtual void wakeAfter(IMechanism& mechanism, float delay) = 0;
+    virtual ScriptScheduler& getScripts() = 0;
+};
+
 class IMechanism {
 public:
     IMechanism(const std::string& id, MechanismType type)
@@ -12,6 +27,10 @@ public:
 
     virtual ~IMechanism() = default;
 
+    // Areas keep mechanisms by value in per-type pools and move them in
+    IMechanism(IMechanism&&) = default;
+    IMechanism& operator=(IMechanism&&) = default;
+
     const std::string& getId() const { return m_id; }
     MechanismType getType() const { return m_type; }
     MechanismState getState() const { return m_state; }
@@ -21,6 +40,23 @@ public:
     virtual void update(float deltaTime) = 0;
     virtual void reset() = 0;
 
+    // Hot reload: take over runtime state from the mechanism with the same id and type
+    virtual void restoreState(const IMechanism& previous) { m_state = previous.m_state; }
+
+    // True when update() has nothing to do until an event or a timer wakes the
+    // mechanism. Asked after each update; dormant mechanisms leave the active set.
+    virtual bool isDormant() const { return false; }
+
+    // Scheduler bookkeeping, owned by whoever holds the mechanism
+    struct Schedule {
+        IMechanismScheduler* scheduler = nullptr;
+        bool awake = false;
+        bool timed = false;             // slept on a timer: the next update gets all the time since the last one
+        uint32_t timer = UINT32_MAX;
+        double lastUpdate = 0.0;
+    };
+    Schedule& getSchedule() { return m_schedule; }
+
     void setCollider(std::unique_ptr<BoxCollider> collider) {
         m_collider = std::move(collider);
         if (m_collider) {
@@ -32,11 +68,44 @@ public:
     bool isActive() const { return m_state == MechanismState::Active; }
     bool isFinished() const { return m_state == MechanismState::Finished; }
 
+    // Notified on every state change, for scripts: `while (!door.isActive()) co_await door.getStateSignal();`
+    ScriptSignal& getStateSignal() { return m_stateSignal; }
+
 protected:
     std::string m_id;
     MechanismType m_type;
     MechanismState m_state;
     std::unique_ptr<BoxCollider> m_collider;
 
-    void setState(MechanismState state) { m_state = state; }
+    Schedule m_schedule;
+    ScriptSignal m_stateSignal;
+
+    void setState(MechanismState state) {
+        if (m_state == state) return;
+        m_state = state;
+        m_stateSignal.notify();
+    }
+
+    void wake() {
+        if (m_schedule.scheduler) m_schedule.scheduler->wake(*this);
+    }
+    void wakeAfter(float delay) {
+        if (m_schedule.scheduler) m_schedule.scheduler->wakeAfter(*this, delay);
+    }
+
+    // Scripts run on the owning store's scheduler and are cancelled when the
+    // mechanism leaves it. Outside a store the script is dropped unstarted.
+    ScriptScheduler::ScriptId startScript(ScriptTask script) {
+        if (!m_schedule.scheduler) return ScriptScheduler::INVALID_SCRIPT;
+        return m_schedule.scheduler->getScripts().start(std::move(script), this);
+    }
+    void cancelScript(ScriptScheduler::ScriptId& script) {
+        if (m_schedule.scheduler && script != ScriptScheduler::INVALID_SCRIPT) {
+            m_schedule.scheduler->getScripts().cancel(script);
+        }
+        script = ScriptScheduler::INVALID_SCRIPT;
+    }
+    double getScriptTime() const {
+        return m_schedule.scheduler ? m_schedule.scheduler->getScripts().getTime() : 0.0;
+    }
 };
\ No newline at end of file
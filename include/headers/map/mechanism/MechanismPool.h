@@ -0,0 +1,127 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+// Mechanisms of one concrete type stored by value in fixed size chunks.
+// Iteration walks contiguous slots and calls T directly, addresses never
+// change while others are added or removed, and freed slots are reused.
+template<typename T>
+class MechanismPool {
+public:
+    static constexpr size_t CHUNK_SIZE = 32;
+
+    MechanismPool() = default;
+    ~MechanismPool() { clear(); }
+
+    MechanismPool(const MechanismPool&) = delete;
+    MechanismPool& operator=(const MechanismPool&) = delete;
+
+    // Chunks change owner as a whole, so pointers into the pool stay valid
+    MechanismPool(MechanismPool&& other) noexcept
+        : m_chunks(std::move(other.m_chunks)), m_freeSlots(std::move(other.m_freeSlots)), m_size(other.m_size) {
+        other.m_size = 0;
+    }
+    MechanismPool& operator=(MechanismPool&& other) noexcept {
+        if (this != &other) {
+            clear();
+            m_chunks = std::move(other.m_chunks);
+            m_freeSlots = std::move(other.m_freeSlots);
+            m_size = other.m_size;
+            other.m_size = 0;
+        }
+        return *this;
+    }
+
+    T* add(T&& mechanism) {
+        size_t slot = allocateSlot();
+        Chunk& chunk = *m_chunks[slot / CHUNK_SIZE];
+        size_t index = slot % CHUNK_SIZE;
+        T* stored = new (chunk.at(index)) T(std::move(mechanism));
+        chunk.alive |= uint32_t(1) << index;
+        ++m_size;
+        return stored;
+    }
+
+    bool remove(const T* mechanism) {
+        for (size_t c = 0; c < m_chunks.size(); ++c) {
+            Chunk& chunk = *m_chunks[c];
+            if (mechanism < chunk.at(0) || mechanism >= chunk.at(0) + CHUNK_SIZE) continue;
+
+            size_t index = static_cast<size_t>(mechanism - chunk.at(0));
+            if (!chunk.isAlive(index)) return false;
+            chunk.at(index)->~T();
+            chunk.alive &= ~(uint32_t(1) << index);
+            m_freeSlots.push_back(c * CHUNK_SIZE + index);
+            --m_size;
+            return true;
+        }
+        return false;
+    }
+
+    void clear() {
+        for (auto& chunk : m_chunks) {
+            for (size_t i = 0; i < CHUNK_SIZE; ++i) {
+                if (chunk->isAlive(i)) chunk->at(i)->~T();
+            }
+        }
+        m_chunks.clear();
+        m_freeSlots.clear();
+        m_size = 0;
+    }
+
+    template<typename Fn>
+    void forEach(Fn&& fn) {
+        for (auto& chunk : m_chunks) {
+            for (size_t i = 0; i < CHUNK_SIZE; ++i) {
+                if (chunk->isAlive(i)) fn(*chunk->at(i));
+            }
+        }
+    }
+
+    template<typename Fn>
+    void forEach(Fn&& fn) const {
+        for (const auto& chunk : m_chunks) {
+            for (size_t i = 0; i < CHUNK_SIZE; ++i) {
+                if (chunk->isAlive(i)) fn(static_cast<const T&>(*chunk->at(i)));
+            }
+        }
+    }
+
+    size_t size() const { return m_size; }
+    // Chunk storage, live or free
+    size_t getReservedBytes() const { return m_chunks.size() * sizeof(Chunk); }
+    bool empty() const { return m_size == 0; }
+
+private:
+    static_assert(CHUNK_SIZE <= 32, "alive mask is 32 bits");
+
+    struct Chunk {
+        alignas(T) unsigned char storage[sizeof(T) * CHUNK_SIZE];
+        uint32_t alive = 0;
+
+        T* at(size_t index) { return reinterpret_cast<T*>(storage + index * sizeof(T)); }
+        bool isAlive(size_t index) const { return (alive >> index) & 1u; }
+    };
+
+    size_t allocateSlot() {
+        if (!m_freeSlots.empty()) {
+            size_t slot = m_freeSlots.back();
+            m_freeSlots.pop_back();
+            return slot;
+        }
+        size_t slot = m_chunks.size() * CHUNK_SIZE;
+        m_chunks.push_back(std::make_unique<Chunk>());
+        for (size_t i = CHUNK_SIZE - 1; i > 0; --i) {
+            m_freeSlots.push_back(slot + i);
+        }
+        return slot;
+    }
+
+    std::vector<std::unique_ptr<Chunk>> m_chunks;
+    std::vector<size_t> m_freeSlots;
+    size_t m_size = 0;
+};
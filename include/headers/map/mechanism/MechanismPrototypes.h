@@ -0,0 +1,59 @@
+#pragma once
+#include "MechanismTypes.h"
+#include <glm/glm.hpp>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+// What every door of a kind shares; a door instance keeps only its state and progress
+struct DoorPrototype {
+    float openSpeed = 2.0f;
+    float closeSpeed = 1.5f;
+    float collisionDisableThreshold = 0.8f;     // the opening door stops blocking past this
+
+    glm::vec4 closedColor{ 0.8f, 0.2f, 0.2f, 1.0f };
+    glm::vec4 openColor{ 0.2f, 0.8f, 0.2f, 0.5f };
+    glm::vec4 lockedColor{ 0.5f, 0.1f, 0.1f, 1.0f };
+};
+
+// A trigger's condition and effect as the map data wrote them, expressions
+// compiled. Instances track what changes while they run (the computed value,
+// the platform start, the period timer) themselves.
+struct TriggerPrototype {
+    TriggerCondition condition;
+    MechanismEffect effect;
+};
+
+// Immutable mechanism data shared between instances. Trigger prototypes are
+// interned by content: a hundred identical spike traps reference one
+// prototype and one pair of compiled expressions. Entries go away with the
+// last instance using them. Main thread only, expressions intern GameState names.
+class MechanismPrototypes {
+public:
+    static MechanismPrototypes& getInstance() {
+        static MechanismPrototypes instance;
+        return instance;
+    }
+
+    std::shared_ptr<const DoorPrototype> getDefaultDoor() const { return m_defaultDoor; }
+
+    // Null when an expression does not compile, the reason goes to outError
+    std::shared_ptr<const TriggerPrototype> internTrigger(const TriggerCondition& condition,
+        const MechanismEffect& effect, std::string* outError = nullptr);
+
+    // Live prototypes and their approximate footprint, counted once however many use them
+    size_t getTriggerPrototypeCount() const;
+    size_t getSharedBytes() const;
+
+private:
+    MechanismPrototypes() : m_defaultDoor(std::make_shared<DoorPrototype>()) {}
+    MechanismPrototypes(const MechanismPrototypes&) = delete;
+    MechanismPrototypes& operator=(const MechanismPrototypes&) = delete;
+
+    std::shared_ptr<const DoorPrototype> m_defaultDoor;
+    std::unordered_map<std::string, std::weak_ptr<const TriggerPrototype>> m_triggers;
+    size_t m_pruneAt = 64;
+
+    static std::string makeKey(const TriggerCondition& condition, const MechanismEffect& effect);
+    void pruneExpired();
+};
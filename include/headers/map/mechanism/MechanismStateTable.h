@@ -0,0 +1,89 @@
+#pragma once
+#include "../../../nlohmann/json.hpp"
+#include <glm/glm.hpp>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// Events every machine understands. Machine files may name more ("hit",
+// "reset"); those get ids after these in the order they first appear.
+enum class MachineEvent : uint8_t {
+    Activate,       // IMechanism::activate, interaction or a linked trigger
+    Deactivate,
+    Enter,          // an actor's box started overlapping the mechanism
+    Exit,
+    Timeout,        // the state's timeout ran out
+    Count
+};
+
+enum MachineStateFlags : uint8_t {
+    MACHINE_STATE_SOLID = 1 << 0,       // collider blocks like a closed door
+    MACHINE_STATE_ACTIVE = 1 << 1,      // mechanism reports MechanismState::Active
+    MACHINE_STATE_FINAL = 1 << 2        // reports Finished and ignores further events
+};
+
+struct MachineStateInfo {
+    float timeout = 0.0f;           // seconds until Timeout fires, 0 for never
+    float moveTime = 0.0f;          // glide to offset over this long, 0 snaps
+    glm::vec2 offset{ 0.0f };       // collider position relative to where it was placed
+    glm::vec4 color{ 0.0f };        // alpha 0 draws nothing
+    uint8_t flags = 0;
+};
+
+// A mechanism state machine compiled from maps/mechanisms/machines/<name>.json:
+//   {
+//     "initial": "idle",
+//     "states": [
+//       { "name": "idle", "color": [0.4, 0.4, 0.4, 0.5] },
+//       { "name": "armed", "timeout": 0.5 },
+//       { "name": "firing", "solid": true, "active": true, "timeout": 1.0 },
+//       { "name": "broken", "final": true }
+//     ],
+//     "transitions": [
+//       { "from": "idle", "on": "enter", "to": "armed" },
+//       { "from": "armed", "on": "timeout", "to": "firing" },
+//       { "from": "firing", "on": "timeout", "to": "idle" },
+//       { "from": "*", "on": "hit", "to": "broken" }
+//     ]
+//   }
+// States and events become small integers and the transitions one flat
+// state x event table, so stepping an instance is a single array read.
+// "*" applies to every state that is not final; an explicit row wins over it.
+class MechanismStateTable {
+public:
+    using StateId = uint16_t;
+    using EventId = uint8_t;
+    static constexpr int16_t NO_TRANSITION = -1;
+    static constexpr size_t MAX_STATES = 1024;
+    static constexpr size_t MAX_EVENTS = 64;
+
+    // Null when the file is malformed; every problem is logged with the machine name
+    static std::shared_ptr<const MechanismStateTable> compile(const std::string& name, const nlohmann::json& definition);
+
+    int16_t getNext(StateId state, EventId event) const { return m_transitions[state * m_eventCount + event]; }
+    const MachineStateInfo& getState(StateId state) const { return m_states[state]; }
+    StateId getInitialState() const { return m_initial; }
+
+    size_t getStateCount() const { return m_states.size(); }
+    size_t getEventCount() const { return m_eventCount; }
+    int findState(const std::string& name) const;
+    int findEvent(const std::string& name) const;
+    const std::string& getStateName(StateId state) const { return m_stateNames[state]; }
+    const std::string& getName() const { return m_name; }
+
+    // Whether any state reacts to the event, e.g. to skip overlap tracking
+    bool handlesEvent(MachineEvent event) const { return (m_handledEvents >> static_cast<int>(event)) & 1u; }
+    bool hasMovement() const { return m_hasMovement; }
+
+private:
+    std::string m_name;
+    std::vector<MachineStateInfo> m_states;
+    std::vector<std::string> m_stateNames;
+    std::vector<std::string> m_eventNames;
+    std::vector<int16_t> m_transitions;     // [state * eventCount + event]
+    size_t m_eventCount = 0;
+    StateId m_initial = 0;
+    uint64_t m_handledEvents = 0;
+    bool m_hasMovement = false;
+};
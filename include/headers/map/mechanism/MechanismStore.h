@@ -0,0 +1,124 @@
+#pragma once
+#include "MechanismPool.h"
+#include "DoorMechanism.h"
+#include "TriggerMechanism.h"
+#include "SequenceMechanism.h"
+#include "StateMachineMechanism.h"
+#include "../../core/TimerWheel.h"
+#include <string>
+#include <unordered_map>
+
+// An area's mechanisms, one pool per mechanism class; the data-driven types
+// (Breakable, Trap, BuffZone, MovingPlatform) share the machine pool. Update and render walk the
+// pools with the concrete type known, the id map only serves lookups by name.
+// Trigger targets are resolved to pointers as mechanisms are added; a graph of
+// target id -> triggers clears and re-resolves them when a target is removed
+// or replaced, so nothing looks a target up by name at runtime.
+//
+// update() only ticks the active set: mechanisms enter it when added or woken
+// (activation, overlap events, timers) and leave once they report isDormant().
+class MechanismStore : public IMechanismScheduler {
+public:
+    MechanismStore() = default;
+    MechanismStore(const MechanismStore&) = delete;
+    MechanismStore& operator=(const MechanismStore&) = delete;
+
+    // Takes over the mechanism, replacing one with the same id.
+    // Returns the stored mechanism, or null for types without a pool.
+    IMechanism* add(std::unique_ptr<IMechanism> mechanism);
+    bool remove(const std::string& id);
+    void clear();
+
+    IMechanism* find(const std::string& id) const;
+
+    // Null when the id is unknown or belongs to another type
+    template<typename T>
+    T* find(const std::string& id) const {
+        IMechanism* mechanism = find(id);
+        return mechanism && mechanism->getType() == T::TYPE ? static_cast<T*>(mechanism) : nullptr;
+    }
+
+    // Logs every link that points nowhere: triggers whose effect needs a
+    // mechanism target, and sequence steps that name no trigger.
+    // Returns how many were found.
+    size_t validateLinks(const std::string& areaId) const;
+
+    size_t size() const { return m_index.size(); }
+    // What this area's instances hold: pool chunks plus each mechanism's
+    // collider and id. Prototypes and machine tables are shared and counted
+    // by MechanismPrototypes and StateMachineLibrary.
+    size_t getInstanceBytes() const;
+    bool empty() const { return m_index.empty(); }
+
+    MechanismPool<DoorMechanism>& getDoors() { return m_doors; }
+    const MechanismPool<DoorMechanism>& getDoors() const { return m_doors; }
+    MechanismPool<TriggerMechanism>& getTriggers() { return m_triggers; }
+    const MechanismPool<TriggerMechanism>& getTriggers() const { return m_triggers; }
+    MechanismPool<SequenceMechanism>& getSequences() { return m_sequences; }
+    const MechanismPool<SequenceMechanism>& getSequences() const { return m_sequences; }
+    MechanismPool<StateMachineMechanism>& getMachines() { return m_machines; }
+    const MechanismPool<StateMachineMechanism>& getMachines() const { return m_machines; }
+
+    void update(float deltaTime);
+
+    void wake(IMechanism& mechanism) override;
+    void wakeAfter(IMechanism& mechanism, float delay) override;
+    ScriptScheduler& getScripts() override { return m_scripts; }
+
+    size_t getAwakeCount() const { return m_awakeDoors.size() + m_awakeTriggers.size() + m_awakeSequences.size() + m_awakeMachines.size(); }
+    size_t getTimerCount() const { return m_timers.size(); }
+    // Mechanisms the last update() ticked; only these can have moved or changed colliders
+    const std::vector<IMechanism*>& getTicked() const { return m_ticked; }
+
+    // Every mechanism through the base class, pool by pool. For cold paths
+    // like hot reload; per-frame code should use the typed pools.
+    template<typename Fn>
+    void forEach(Fn&& fn) {
+        m_doors.forEach([&fn](DoorMechanism& door) { fn(static_cast<IMechanism&>(door)); });
+        m_triggers.forEach([&fn](TriggerMechanism& trigger) { fn(static_cast<IMechanism&>(trigger)); });
+        m_sequences.forEach([&fn](SequenceMechanism& sequence) { fn(static_cast<IMechanism&>(sequence)); });
+        m_machines.forEach([&fn](StateMachineMechanism& machine) { fn(static_cast<IMechanism&>(machine)); });
+    }
+
+    template<typename Fn>
+    void forEach(Fn&& fn) const {
+        m_doors.forEach([&fn](const DoorMechanism& door) { fn(static_cast<const IMechanism&>(door)); });
+        m_triggers.forEach([&fn](const TriggerMechanism& trigger) { fn(static_cast<const IMechanism&>(trigger)); });
+        m_sequences.forEach([&fn](const SequenceMechanism& sequence) { fn(static_cast<const IMechanism&>(sequence)); });
+        m_machines.forEach([&fn](const StateMachineMechanism& machine) { fn(static_cast<const IMechanism&>(machine)); });
+    }
+
+private:
+    MechanismPool<DoorMechanism> m_doors;
+    MechanismPool<TriggerMechanism> m_triggers;
+    MechanismPool<SequenceMechanism> m_sequences;
+    MechanismPool<StateMachineMechanism> m_machines;
+    std::unordered_map<std::string, IMechanism*> m_index;
+    std::unordered_map<std::string, std::vector<TriggerMechanism*>> m_dependents;   // by target id
+
+    std::vector<DoorMechanism*> m_awakeDoors;
+    std::vector<TriggerMechanism*> m_awakeTriggers;
+    std::vector<SequenceMechanism*> m_awakeSequences;
+    std::vector<StateMachineMechanism*> m_awakeMachines;
+    std::vector<IMechanism*> m_ticked;
+    TimerWheel m_timers;
+    std::vector<void*> m_fired;
+
+    // Scratch for the per-frame condition batch
+    std::vector<TriggerMechanism*> m_conditionOwners;
+    std::vector<const ExpressionProgram*> m_conditionPrograms;
+    std::vector<ExpressionContext> m_conditionContexts;
+    std::vector<uint8_t> m_conditionResults;
+
+    // After the pools, so scripts are torn down before the signals they wait on
+    ScriptScheduler m_scripts;
+
+    template<typename T>
+    void tick(std::vector<T*>& awake, float deltaTime);
+    void evaluateConditions();
+    void unschedule(IMechanism& mechanism);
+
+    void linkTrigger(TriggerMechanism& trigger);
+    void unlinkTrigger(TriggerMechanism& trigger);
+    void resolveDependents(const std::string& targetId);
+};
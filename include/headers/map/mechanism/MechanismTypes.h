@@ -1,7 +1,8 @@
 #pragma once
-#include <functional>
+#include <memory>
 #include <string>
 #include <glm/glm.hpp>
+#include "../../core/ExpressionProgram.h"
 
 enum class MechanismType {
     Trigger,          // Trigger mechanism
@@ -13,6 +14,12 @@ enum class MechanismType {
     BuffZone          // Buff zone mechanism
 };
 
+// Types whose behavior is a state machine file rather than a class of their own
+inline bool isMachineType(MechanismType type) {
+    return type == MechanismType::Breakable || type == MechanismType::Trap ||
+        type == MechanismType::BuffZone || type == MechanismType::MovingPlatform;
+}
+
 enum class MechanismState {
     Inactive,    // Mechanism is inactive
     Active,      // Mechanism is active
@@ -25,8 +32,10 @@ struct TriggerCondition {
     bool requiresInteraction = false;     // Requires player interaction
     float triggerRadius = 0.0f;          // Activation radius
 
-    // Custom condition callback
-    std::function<bool()> customCondition = nullptr;
+    // Extra condition from the map data, e.g. "level >= 5 && key(\"red\")";
+    // compiled when the mechanism is built
+    std::string expression;
+    std::shared_ptr<const ExpressionProgram> program;
 };
 
 enum class EffectType {
@@ -48,6 +57,10 @@ struct MechanismEffect {
     float value = 0.0f;          // Effect value
     glm::vec2 direction{ 0.0f };  // Effect direction (if needed)
 
+    // Computes value each time the effect is applied, e.g. "10 + level * 2"
+    std::string valueExpression;
+    std::shared_ptr<const ExpressionProgram> valueProgram;
+
     // Effect timing parameters
     struct {
         bool isPeriodic = false;      // Is periodic effect
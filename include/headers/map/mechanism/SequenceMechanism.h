@@ -3,21 +3,29 @@
 #include <vector>
 #include <string>
 
-class SequenceMechanism : public IMechanism {
+class SequenceMechanism final : public IMechanism {
 public:
+    static constexpr MechanismType TYPE = MechanismType::Sequence;
+
     SequenceMechanism(const std::string& id, const std::vector<std::string>& sequence);
 
     void activate() override;
     void deactivate() override;
     void update(float deltaTime) override;
     void reset() override;
+    void restoreState(const IMechanism& previous) override;
+    // Steps arrive through activateTrigger and the time limit runs as a script
+    bool isDormant() const override { return true; }
 
     void activateTrigger(const std::string& triggerId);
     bool isSequenceComplete() const;
 
+    const std::vector<std::string>& getSteps() const { return m_sequence; }
     size_t getCurrentStep() const { return m_currentStep; }
     float getTimeLimit() const { return m_timeLimit; }
     void setTimeLimit(float limit) { m_timeLimit = limit; }
+    // Seconds since activation, 0 while inactive
+    float getElapsed() const;
 
 private:
     std::vector<std::string> m_sequence;        
@@ -25,8 +33,11 @@ private:
     size_t m_currentStep;                     
 
     float m_timeLimit;     
-    float m_timer;        
+    double m_startedAt;
+    ScriptScheduler::ScriptId m_timeLimitScript = ScriptScheduler::INVALID_SCRIPT;
 
     bool validateSequence() const;
     void handleSequenceFailure();
+    void startTimeLimit(float remaining);
+    ScriptTask runTimeLimit(float seconds);
 };
\ No newline at end of file
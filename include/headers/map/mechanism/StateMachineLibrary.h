@@ -0,0 +1,29 @@
+#pragma once
+#include "MechanismStateTable.h"
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+// Compiled machines by name. Each file is compiled once and shared by every
+// instance that names it; instances hold their own reference, so replacing an
+// entry on hot reload reaches mechanisms as their area is rebuilt.
+class StateMachineLibrary {
+public:
+    static StateMachineLibrary& getInstance() {
+        static StateMachineLibrary instance;
+        return instance;
+    }
+
+    // Loads maps/mechanisms/machines/<name>.json on first use, null if missing or invalid
+    std::shared_ptr<const MechanismStateTable> getMachine(const std::string& name);
+    void setMachine(const std::string& name, std::shared_ptr<const MechanismStateTable> table);
+    void clear();
+
+private:
+    StateMachineLibrary() = default;
+    StateMachineLibrary(const StateMachineLibrary&) = delete;
+    StateMachineLibrary& operator=(const StateMachineLibrary&) = delete;
+
+    std::mutex m_mutex;
+    std::unordered_map<std::string, std::shared_ptr<const MechanismStateTable>> m_machines;
+};
@@ -0,0 +1,53 @@
+#pragma once
+#include "IMechanism.h"
+#include "MechanismStateTable.h"
+#include "../../collision/TriggerVolumeService.h"
+#include <array>
+
+// Breakable, Trap, BuffZone and MovingPlatform mechanisms: behavior comes from
+// a compiled MechanismStateTable instead of code. Events are queued and
+// stepped through the table in update(); between events the mechanism sleeps,
+// and state timeouts run on the store's timer wheel.
+class StateMachineMechanism final : public IMechanism {
+public:
+    StateMachineMechanism(const std::string& id, MechanismType type,
+        std::shared_ptr<const MechanismStateTable> table,
+        const glm::vec2& position, const glm::vec2& size);
+
+    void activate() override { sendEvent(static_cast<MechanismStateTable::EventId>(MachineEvent::Activate)); }
+    void deactivate() override { sendEvent(static_cast<MechanismStateTable::EventId>(MachineEvent::Deactivate)); }
+    void update(float deltaTime) override;
+    void reset() override;
+    void restoreState(const IMechanism& previous) override;
+    bool isDormant() const override { return m_pendingCount == 0 && !m_moving; }
+    void render();
+
+    void sendEvent(MechanismStateTable::EventId event);
+    // Custom events by name; false when the machine doesn't know the event
+    bool sendEvent(const std::string& event);
+    void onOverlap(const OverlapEvent& event);
+
+    const MechanismStateTable& getTable() const { return *m_table; }
+    MechanismStateTable::StateId getCurrentState() const { return m_current; }
+    float getStateTime() const { return m_stateTime; }
+    bool usesOverlap() const;
+
+private:
+    static constexpr size_t MAX_PENDING_EVENTS = 8;
+    static constexpr int MAX_STEPS_PER_UPDATE = 16;    // bounds event chains between zero-length states
+
+    std::shared_ptr<const MechanismStateTable> m_table;
+    MechanismStateTable::StateId m_current;
+    float m_stateTime = 0.0f;
+
+    std::array<MechanismStateTable::EventId, MAX_PENDING_EVENTS> m_pending{};
+    size_t m_pendingCount = 0;
+
+    glm::vec2 m_origin;
+    glm::vec2 m_moveFrom{ 0.0f };
+    bool m_moving = false;
+
+    void enterState(MechanismStateTable::StateId state);
+    void applyState();
+    void updateMovement();
+};
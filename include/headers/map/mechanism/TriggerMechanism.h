@@ -1,49 +1,97 @@
 #pragma once
 #include "IMechanism.h"
 #include "IEffectTarget.h"
+#include "MechanismPrototypes.h"
+#include "../../collision/CircleCollider.h"
+#include "../../collision/TriggerVolumeService.h"
 #include <unordered_map>
 
-class TriggerMechanism : public IMechanism {
+class DoorMechanism;
+
+class TriggerMechanism final : public IMechanism {
 public:
-    TriggerMechanism(const std::string& id,
-        const TriggerCondition& condition,
-        const MechanismEffect& effect);
+    static constexpr MechanismType TYPE = MechanismType::Trigger;
+
+    // Identical triggers share one prototype, see MechanismPrototypes::internTrigger
+    TriggerMechanism(const std::string& id, std::shared_ptr<const TriggerPrototype> prototype);
+
+    const std::string& getTargetId() const { return m_prototype->effect.targetId; }
+    EffectType getEffectType() const { return m_prototype->effect.type; }
+    const TriggerPrototype& getPrototype() const { return *m_prototype; }
 
-    const std::string& getTargetId() const { return m_effect.targetId; }
+    // targetId resolved when the area is built, null while it names no door.
+    // MechanismStore clears and re-resolves it as the door comes and goes.
+    DoorMechanism* getTargetDoor() const { return m_targetDoor; }
+    void setTargetDoor(DoorMechanism* door) { m_targetDoor = door; }
 
     void activate() override;
     void deactivate() override;
     void update(float deltaTime) override;
     void reset() override;
+    void restoreState(const IMechanism& previous) override;
+    bool isDormant() const override;
     void render();
     void initializeCollider(const glm::vec2& position, const glm::vec2& size);
     bool isPlayerInRange(const BoxCollider* playerCollider) const;
     bool checkConditions();
 
+    // The condition expression, null if there is none. MechanismStore tests the
+    // awake triggers' conditions in one batch and hands each its result.
+    const ExpressionProgram* getConditionProgram() const { return m_prototype->condition.program.get(); }
+    ExpressionContext getExpressionContext() const;
+    void setConditionResult(bool met) {
+        m_conditionMet = met;
+        m_conditionFresh = true;
+    }
+
+    // Circle around the collider center for radius triggers, null otherwise.
+    // The area registers it with its TriggerVolumeService and forwards events.
+    const ICollider* getRangeVolume() const { return m_prototype->condition.triggerRadius > 0.0f ? &m_range : nullptr; }
+    // Moves the range along with the collider
+    void syncRangeVolume();
+    void onOverlap(const OverlapEvent& event);
+    bool isOccupied() const { return m_occupants > 0; }
+    // Notified when an actor enters or leaves the range, for scripts
+    ScriptSignal& getOverlapSignal() { return m_overlapSignal; }
+
     // Ŀ
     void registerTarget(const std::string& id, IEffectTarget* target);
     void unregisterTarget(const std::string& id);
 
     // Ч
-    void setEffectValue(float value) { m_effect.value = value; }
-    void setEffectDuration(float duration) { m_effect.duration = duration; }
-    void setEffectDirection(const glm::vec2& direction) { m_effect.direction = direction; }
+    // Give this trigger a private copy of its prototype first
+    void setEffectValue(float value) { m_effectValue = value; }
+    void setEffectDuration(float duration) { overrideEffect().duration = duration; }
+    void setEffectDirection(const glm::vec2& direction) { overrideEffect().direction = direction; }
 
     bool isActive() const { return m_state == MechanismState::Active; }
-    //const std::string& getTargetId() const { return m_effect.targetId; }
 
 protected:
     IEffectTarget* findTarget(const std::string& id) const;
 
 private:
-    TriggerCondition m_condition;
-    MechanismEffect m_effect;
+    std::shared_ptr<const TriggerPrototype> m_prototype;
     float m_effectTimer;
+    float m_effectValue;        // the prototype's value, or what its value expression gave last
+    float m_periodTimer = 0.0f;
+    glm::vec2 m_platformStart{ 0.0f };  // where a platform effect started moving from
+    CircleCollider m_range;
+    int m_occupants = 0;    // actors inside the range, kept by overlap events
+    ScriptSignal m_overlapSignal;
+    ScriptScheduler::ScriptId m_durationScript = ScriptScheduler::INVALID_SCRIPT;
+    double m_effectStartedAt = 0.0;
+    DoorMechanism* m_targetDoor = nullptr;
+    bool m_conditionMet = false;
+    bool m_conditionFresh = false;     // set by the batch, used by the next check
 
     std::unordered_map<std::string, IEffectTarget*> m_targets;
 
+    bool needsPolling() const;
     void applyEffect();
     void removeEffect();
+    MechanismEffect& overrideEffect();
+    void startDuration(float remaining);
+    ScriptTask runDuration(float seconds);
     void applyPeriodicEffect(float deltaTime);
     void handleMovementEffect(float deltaTime);
     glm::vec2 calculateMovementPosition(float progress);
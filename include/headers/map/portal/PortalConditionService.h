@@ -0,0 +1,53 @@
+#pragma once
+#include "../../core/GameState.h"
+#include "../MapTypes.h"
+#include <cstdint>
+#include <vector>
+
+class Area;
+
+// Keeps PortalCondition::isMet current for every loaded portal. Conditions are
+// indexed by the GameState values they read (a key, a quest, the level, or
+// whatever a compiled expression loads); a change to one of those values
+// queues only the conditions that read it, and update() re-tests the queue.
+// Checking a portal is then a flag read, however complex its condition.
+// Conditions that read the player's position can't be cached, they are
+// tested when the portal is entered. Main thread only.
+class PortalConditionService {
+public:
+    PortalConditionService();
+    ~PortalConditionService();
+    PortalConditionService(const PortalConditionService&) = delete;
+    PortalConditionService& operator=(const PortalConditionService&) = delete;
+
+    // Indexes and tests the area's portals; remove the area before destroying it
+    void addArea(Area& area);
+    void removeArea(const Area* area);
+
+    // Re-tests the conditions whose inputs changed since the last call
+    void update();
+
+    static bool isOpen(const PortalData& portal);
+
+    size_t getConditionCount() const { return m_entries.size(); }
+    // Conditions tested since startup, for profiling
+    size_t getEvaluationCount() const { return m_evaluations; }
+
+private:
+    struct Entry {
+        Area* area;
+        uint32_t portalIndex;
+        bool queued;
+    };
+
+    std::vector<Entry> m_entries;
+    std::vector<std::vector<uint32_t>> m_readers;   // GameState id -> entries reading it
+    std::vector<uint32_t> m_queue;
+    GameState::ListenerId m_listener;
+    size_t m_evaluations = 0;
+
+    void indexEntry(uint32_t entry);
+    void rebuildIndex();
+    void onValueChanged(GameState::VarId id);
+    void evaluate(const Entry& entry);
+};
@@ -8,9 +8,10 @@ public:
     static bool checkPortalTrigger(const BoxCollider* playerCollider,
         const std::vector<PortalData>& portals,
         PortalData& outPortal);
+    // Tests the condition from scratch; PortalConditionService caches the result
+    static bool checkPortalConditions(const PortalData& portal);
 
 private:
     static bool isInPortalRange(const BoxCollider* playerCollider,
         const PortalData& portal);
-    static bool checkPortalConditions(const PortalData& portal);
 };
\ No newline at end of file
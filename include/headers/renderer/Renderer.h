@@ -30,8 +30,12 @@ public:
     // Add texture rendering methods
     void drawTexturedQuad(const glm::vec2& position, const glm::vec2& size, const TextureData* texture, const glm::vec4& color = glm::vec4(1.0f));
     void drawRect(const glm::vec2& position, const glm::vec2& size, const glm::vec3& color, float alpha = 1.0f);
+    // Same in screen pixels, wherever the camera is; for overlays like the loading screen
+    void drawScreenRect(const glm::vec2& position, const glm::vec2& size, const glm::vec3& color, float alpha = 1.0f);
 
     void drawTexturedQuad(const TextureData* texture, const RenderProperties& props);
+    // Triangles already in world space, laid out like the quad (x, y, u, v)
+    void drawTexturedMesh(GLuint vao, GLsizei vertexCount, const TextureData* texture, const glm::vec4& color = glm::vec4(1.0f));
 
     void setScreenSize(const glm::vec2& size) { m_screenSize = size; }
     glm::vec2 getScreenSize() const { return m_screenSize; }
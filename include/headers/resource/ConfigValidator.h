@@ -13,4 +13,5 @@ private:
         const std::vector<std::string>& fields);
     static bool validateTriggerMechanism(const nlohmann::json& json);
     static bool validateSequenceMechanism(const nlohmann::json& json);
+    static bool validateMachineMechanism(const nlohmann::json& json);
 };
\ No newline at end of file
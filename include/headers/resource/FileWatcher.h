@@ -0,0 +1,51 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <chrono>
+#include <unordered_map>
+#include <unordered_set>
+
+// Recursive change notifications for a directory tree.
+// ReadDirectoryChangesW on Windows, inotify on Linux. Not thread safe,
+// meant to be polled from a single background thread.
+class FileWatcher {
+public:
+    using Clock = std::chrono::steady_clock;
+
+    FileWatcher() = default;
+    ~FileWatcher() { close(); }
+
+    FileWatcher(const FileWatcher&) = delete;
+    FileWatcher& operator=(const FileWatcher&) = delete;
+
+    bool open(const std::string& rootPath);
+    void close();
+    bool isOpen() const;
+
+    // Blocks up to timeoutMs for file system events and records changed files
+    void waitForEvents(int timeoutMs);
+
+    // Files that changed and then stayed quiet for at least debounce.
+    // Editors tend to save in several writes, this reports them once.
+    std::vector<std::string> takeSettledChanges(std::chrono::milliseconds debounce);
+
+private:
+    std::string m_rootPath;
+    std::unordered_map<std::string, Clock::time_point> m_pending;
+
+    void recordChange(const std::string& path);
+
+#ifdef _WIN32
+    void* m_directoryHandle = nullptr;
+    void* m_eventHandle = nullptr;
+    void* m_overlapped = nullptr;
+    std::vector<unsigned long> m_buffer;   // DWORD aligned for FILE_NOTIFY_INFORMATION
+
+    bool issueRead();
+#else
+    int m_fd = -1;
+    std::unordered_map<int, std::string> m_watchPaths;
+
+    void addWatchRecursive(const std::string& directory);
+#endif
+};
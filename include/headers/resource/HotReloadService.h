@@ -0,0 +1,65 @@
+#pragma once
+#include "FileWatcher.h"
+#include "TextureData.h"
+#include "../map/AreaDefinition.h"
+#include "../map/mechanism/MechanismStateTable.h"
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Watches resources/ while the game runs and reloads what changed.
+// Files are decoded and parsed on a background thread; the results are
+// applied on the main thread by applyPendingReloads() between frames.
+class HotReloadService {
+public:
+    static HotReloadService& getInstance() {
+        static HotReloadService instance;
+        return instance;
+    }
+
+    bool start(const std::string& resourceRoot);
+    void stop();
+    bool isRunning() const { return m_running; }
+
+    // Main thread, once per frame before anything touches textures or areas
+    void applyPendingReloads();
+
+private:
+    HotReloadService() = default;
+    ~HotReloadService() { stop(); }
+    HotReloadService(const HotReloadService&) = delete;
+    HotReloadService& operator=(const HotReloadService&) = delete;
+
+    enum class ReloadKind {
+        Texture,
+        Area,
+        Machine
+    };
+
+    struct PendingReload {
+        ReloadKind kind;
+        std::string path;
+        std::string areaId;     // or the machine name
+        DecodedTexture texture;
+        AreaDefinition area;
+        std::shared_ptr<const MechanismStateTable> machine;
+    };
+
+    std::string m_resourceRoot;
+    FileWatcher m_watcher;
+    std::thread m_worker;
+    std::atomic<bool> m_running{ false };
+
+    std::mutex m_mutex;
+    std::vector<PendingReload> m_pending;
+
+    void workerLoop();
+    void processChange(const std::string& path);
+    void queueReload(PendingReload&& reload);
+
+    static constexpr int POLL_INTERVAL_MS = 50;
+    static constexpr std::chrono::milliseconds DEBOUNCE{ 200 };
+};
@@ -0,0 +1,31 @@
+#pragma once
+#include <string>
+#include <cstddef>
+
+// Read-only memory mapping of a whole file.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile() { close(); }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool open(const std::string& path);
+    void close();
+
+    const unsigned char* data() const { return m_data; }
+    size_t size() const { return m_size; }
+    bool isOpen() const { return m_data != nullptr; }
+
+private:
+    const unsigned char* m_data = nullptr;
+    size_t m_size = 0;
+
+#ifdef _WIN32
+    void* m_fileHandle = nullptr;
+    void* m_mappingHandle = nullptr;
+#else
+    int m_fd = -1;
+#endif
+};
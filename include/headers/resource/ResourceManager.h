@@ -28,6 +28,15 @@ public:
     bool loadTexture(const std::string& name, const std::string& path);
     void unloadTexture(const std::string& name);
     TextureData* getTexture(const std::string& name);
+    size_t getTextureMemoryUsage(const std::string& name) const;
+
+    // Uploads pixels decoded elsewhere (prefetch workers), GL thread only
+    bool loadTextureFromDecoded(const std::string& name, const std::string& path, const DecodedTexture& texture);
+
+    // Hot reload: decoding may run on any thread, reloading must run on the GL thread
+    bool decodeTexture(const std::string& path, DecodedTexture& outTexture) const;
+    int reloadTexturesFromFile(const std::string& path, const DecodedTexture& texture);
+    static std::string normalizePath(const std::string& path);
 
     bool preloadResources(const std::string& configPath);
     void createResourceDirectories();
@@ -49,6 +58,14 @@ public:
         return getBasePath() + "maps/areas/" + mapId + ".json";
     }
 
+    static std::string getCookedMapPath(const std::string& mapId) {
+        return getBasePath() + "maps/cooked/" + mapId + ".area";
+    }
+
+    static std::string getTileMapPath(const std::string& tileMapId) {
+        return getBasePath() + "maps/tilemaps/" + tileMapId + ".json";
+    }
+
     static std::string getMechanismPath(const std::string& type, const std::string& id) {
         return getBasePath() + "maps/mechanisms/" + type + "/" + id + ".json";
     }
@@ -57,6 +74,10 @@ public:
         return getBasePath() + "audio/" + type + "/";
     }
 
+    static std::string getConfigPath(const std::string& name) {
+        return getBasePath() + "config/" + name;
+    }
+
     // Config loading
     bool loadMapConfig(const std::string& mapId, nlohmann::json& outJson);
     bool loadMechanismConfig(const std::string& type,
@@ -65,8 +86,13 @@ public:
 
     // Audio resources management
     bool loadSound(const std::string& name, const std::string& path);
+    // Startup split: reading the file may run on any thread, registering the
+    // in-memory copy with irrKlang stays on the main thread
+    bool readSoundFile(const std::string& path, std::vector<char>& outData) const;
+    bool loadSoundFromMemory(const std::string& name, const std::string& path, const std::vector<char>& data);
     void unloadSound(const std::string& name);
 
+    bool hasSound(const std::string& name) const { return m_sounds.count(name) != 0; }
     irrklang::ISoundSource* getSound(const std::string& name) {
         auto it = m_sounds.find(name);
         if (it == m_sounds.end()) {
@@ -100,6 +126,8 @@ private:
     // Texture loading utilities
     unsigned char* loadTextureData(const std::string& path, int& width, int& height, int& channels);
     void freeTextureData(unsigned char* data);
+    void createTexture(const std::string& name, const std::string& resolvedPath,
+        const unsigned char* pixels, int width, int height, int channels);
     bool loadJsonFile(const std::string& path, nlohmann::json& outJson);
     bool loadPreloadConfig(const std::string& configPath, PreloadConfig& config);
     GLenum getGLFormat(int channels);
@@ -1,6 +1,7 @@
 #pragma once
 #include <glad/glad.h>
 #include <string>
+#include <vector>
 #include <glm/glm.hpp>
 
 struct TextureRegion {
@@ -30,6 +31,15 @@ struct TextureData {
     int height;
     int channels;
     std::string name;
+    std::string sourcePath;     // normalized file path, used to match hot reload events
 
     TextureData() : id(0), width(0), height(0), channels(0) {}
+};
+
+// Pixels decoded off the GL thread, uploaded later by ResourceManager
+struct DecodedTexture {
+    std::vector<unsigned char> pixels;
+    int width = 0;
+    int height = 0;
+    int channels = 0;
 };
\ No newline at end of file
@@ -1,5 +1,6 @@
 #include <cmath>
 #include "../../../include/headers/character/LevelSystem.h"
+#include "../../../include/headers/core/GameState.h"
 
 const std::array<float, 3> LevelSystem::LEVEL_MULTIPLIERS = { 1.25f, 1.95f, 2.65f };
 
@@ -21,6 +22,9 @@ bool LevelSystem::gainExperience(uint32_t exp) {
         leveledUp = true;
     }
 
+    if (leveledUp) {
+        publishLevel();
+    }
     return leveledUp;
 }
 
@@ -28,9 +32,21 @@ bool LevelSystem::setBaseLevel(int level) {
     if (level < 1 || level > MAX_BASE_LEVEL) return false;
     m_baseLevel = level;
     m_currentExp = 0;
+    publishLevel();
     return true;
 }
 
+void LevelSystem::setPublishesLevel(bool publish) {
+    m_publishesLevel = publish;
+    publishLevel();
+}
+
+void LevelSystem::publishLevel() const {
+    if (m_publishesLevel) {
+        GameState::getInstance().setLevel(m_baseLevel);
+    }
+}
+
 uint32_t LevelSystem::getRequiredExp() const {
     return calculateRequiredExp(m_baseLevel);
 }
@@ -1,5 +1,7 @@
 #include <algorithm>
 #include "../../../include/headers/collision/BoxCollider.h"
+#include "../../../include/headers/collision/CollisionManager.h"
+#include "../../../include/headers/collision/NarrowPhase.h"
 #include "../../../include/headers/CommonDefines.h"
 
 BoxCollider::BoxCollider(const glm::vec2& pos, const glm::vec2& size) {
@@ -68,19 +70,18 @@ bool BoxCollider::isColliding(const ICollider* other) const {
         return false;
     }
 
-    auto otherLayer = other->getCollisionLayer();
-
-    // Layer mask check
-    if (!(m_layer.mask & otherLayer.layer)) {
+    // Layer matrix and mask check
+    if (!CollisionManager::getInstance().shouldCollide(m_layer, other->getCollisionLayer())) {
         return false;
     }
 
-    const BoxCollider* boxOther = dynamic_cast<const BoxCollider*>(other);
-    if (!boxOther || !boxOther->isInBounds()) {
-        return false;
+    // Shape tag instead of dynamic_cast, box pairs stay on the direct path
+    if (other->getShape() == ColliderShape::Box) {
+        const BoxCollider* boxOther = static_cast<const BoxCollider*>(other);
+        return boxOther->isInBounds() && checkOverlap(boxOther);
     }
 
-    return checkOverlap(boxOther);
+    return NarrowPhase::overlaps(*this, *other);
 }
 
 CollisionManifold BoxCollider::checkCollision(const ICollider* other) const {
@@ -88,12 +89,16 @@ CollisionManifold BoxCollider::checkCollision(const ICollider* other) const {
         return CollisionManifold(false);
     }
 
-    if (!(m_layer.mask & other->getCollisionLayer().layer)) {
+    if (!CollisionManager::getInstance().shouldCollide(m_layer, other->getCollisionLayer())) {
         return CollisionManifold(false);
     }
 
-    const BoxCollider* boxOther = dynamic_cast<const BoxCollider*>(other);
-    if (!boxOther || !boxOther->isInBounds()) {
+    if (other->getShape() != ColliderShape::Box) {
+        return NarrowPhase::collide(*this, *other);
+    }
+
+    const BoxCollider* boxOther = static_cast<const BoxCollider*>(other);
+    if (!boxOther->isInBounds()) {
         return CollisionManifold(false);
     }
 
@@ -123,4 +128,4 @@ CollisionManifold BoxCollider::checkCollision(const ICollider* other) const {
     }
 
     return CollisionManifold(false);
-}
\ No newline at end of file
+}
@@ -0,0 +1,58 @@
+#include "../../../include/headers/collision/CapsuleCollider.h"
+#include "../../../include/headers/collision/CollisionManager.h"
+#include "../../../include/headers/collision/NarrowPhase.h"
+#include "../../../include/headers/CommonDefines.h"
+#include <algorithm>
+#include <cmath>
+
+CapsuleCollider::CapsuleCollider(const glm::vec2& center, float halfLength, float radius, float rotation)
+    : ICollider(ColliderShape::Capsule)
+    , m_center(center)
+    , m_halfLength(std::max(halfLength, 0.0f))
+    , m_radius(radius > 0.0f ? radius : 1.0f)
+    , m_rotation(rotation) {
+    if (!(radius > 0.0f)) {
+        DEBUG_LOG_WARN("Invalid radius in CapsuleCollider. Using 1.");
+    }
+}
+
+void CapsuleCollider::getSegment(glm::vec2& outStart, glm::vec2& outEnd) const {
+    glm::vec2 axis(std::cos(m_rotation) * m_halfLength, std::sin(m_rotation) * m_halfLength);
+    outStart = m_center - axis;
+    outEnd = m_center + axis;
+}
+
+Aabb CapsuleCollider::getBounds() const {
+    glm::vec2 start, end;
+    getSegment(start, end);
+    return Aabb(glm::min(start, end) - glm::vec2(m_radius), glm::max(start, end) + glm::vec2(m_radius));
+}
+
+void CapsuleCollider::setPosition(const glm::vec2& pos) {
+    m_center += pos - getBounds().min;
+}
+
+void CapsuleCollider::setSize(const glm::vec2& size) {
+    if (!(size.x > 0.0f) || !(size.y > 0.0f)) {
+        DEBUG_LOG_WARN("Invalid size in CapsuleCollider.");
+        return;
+    }
+    glm::vec2 topLeft = getBounds().min;
+    m_radius = std::min(size.x, size.y) * 0.5f;
+    m_halfLength = std::max(size.x * 0.5f - m_radius, 0.0f);
+    setPosition(topLeft);
+}
+
+bool CapsuleCollider::isColliding(const ICollider* other) const {
+    if (!other || !CollisionManager::getInstance().shouldCollide(m_layer, other->getCollisionLayer())) {
+        return false;
+    }
+    return NarrowPhase::overlaps(*this, *other);
+}
+
+CollisionManifold CapsuleCollider::checkCollision(const ICollider* other) const {
+    if (!other || !CollisionManager::getInstance().shouldCollide(m_layer, other->getCollisionLayer())) {
+        return CollisionManifold(false);
+    }
+    return NarrowPhase::collide(*this, *other);
+}
@@ -0,0 +1,71 @@
+#include "../../../include/headers/collision/CharacterController.h"
+#include "../../../include/headers/collision/CollisionManager.h"
+
+namespace {
+    constexpr float MIN_MOVE = 1e-4f;
+}
+
+CharacterController::CharacterController(BoxCollider& collider)
+    : m_collider(collider)
+    , m_solidMask(collider.getCollisionLayer().mask) {
+}
+
+glm::vec2 CharacterController::move(const CollisionWorld& world, const glm::vec2& delta) {
+    m_contacts.clear();
+    glm::vec2 start = m_collider.getPosition();
+
+    // Layers the matrix says the character never touches are dropped too
+    uint32_t solidMask = m_solidMask & CollisionManager::getInstance().getCollisionMask(m_collider.getCollisionLayer().layer);
+    depenetrate(world, solidMask);
+
+    glm::vec2 remaining = delta;
+    for (int i = 0; i < m_maxIterations; ++i) {
+        if (glm::dot(remaining, remaining) < MIN_MOVE * MIN_MOVE) break;
+
+        Aabb box = m_collider.getBounds();
+        RaycastHit hit;
+        if (!world.shapeCast(box, remaining, solidMask, hit, &m_collider, SKIN_WIDTH)) {
+            m_collider.setPosition(box.min + remaining);
+            break;
+        }
+
+        // Stop at the surface, keep a skin away from it, and slide what is left along it
+        m_collider.setPosition(hit.point + hit.normal * SKIN_WIDTH);
+
+        CharacterContact contact;
+        contact.collider = hit.collider;
+        contact.normal = hit.normal;
+        contact.time = hit.fraction;
+        m_contacts.push_back(contact);
+
+        remaining *= 1.0f - hit.fraction;
+        remaining -= hit.normal * glm::dot(remaining, hit.normal);
+    }
+
+    return m_collider.getPosition() - start;
+}
+
+void CharacterController::depenetrate(const CollisionWorld& world, uint32_t solidMask) {
+    for (int i = 0; i < m_maxIterations; ++i) {
+        m_penetrations.clear();
+        world.collide(m_collider, m_penetrations);
+
+        const ColliderContact* deepest = nullptr;
+        for (const auto& contact : m_penetrations) {
+            if (!(contact.collider->getCollisionLayer().layer & solidMask)) continue;
+            if (!deepest || contact.manifold.penetration > deepest->manifold.penetration) {
+                deepest = &contact;
+            }
+        }
+        if (!deepest) return;
+
+        // Manifold normals point from the character into the obstacle
+        glm::vec2 normal = -deepest->manifold.normal;
+        m_collider.setPosition(m_collider.getPosition() + normal * (deepest->manifold.penetration + SKIN_WIDTH));
+
+        CharacterContact contact;
+        contact.collider = deepest->collider;
+        contact.normal = normal;
+        m_contacts.push_back(contact);
+    }
+}
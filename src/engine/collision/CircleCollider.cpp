@@ -0,0 +1,44 @@
+#include "../../../include/headers/collision/CircleCollider.h"
+#include "../../../include/headers/collision/CollisionManager.h"
+#include "../../../include/headers/collision/NarrowPhase.h"
+#include "../../../include/headers/CommonDefines.h"
+#include <algorithm>
+
+CircleCollider::CircleCollider(const glm::vec2& center, float radius)
+    : ICollider(ColliderShape::Circle)
+    , m_center(center)
+    , m_radius(1.0f) {
+    setRadius(radius);
+}
+
+void CircleCollider::setRadius(float radius) {
+    if (!(radius > 0.0f)) {
+        DEBUG_LOG_WARN("Invalid radius in CircleCollider.");
+        return;
+    }
+    m_radius = radius;
+}
+
+void CircleCollider::setPosition(const glm::vec2& pos) {
+    m_center = pos + glm::vec2(m_radius);
+}
+
+void CircleCollider::setSize(const glm::vec2& size) {
+    glm::vec2 topLeft = getPosition();
+    setRadius(std::min(size.x, size.y) * 0.5f);
+    m_center = topLeft + glm::vec2(m_radius);
+}
+
+bool CircleCollider::isColliding(const ICollider* other) const {
+    if (!other || !CollisionManager::getInstance().shouldCollide(m_layer, other->getCollisionLayer())) {
+        return false;
+    }
+    return NarrowPhase::overlaps(*this, *other);
+}
+
+CollisionManifold CircleCollider::checkCollision(const ICollider* other) const {
+    if (!other || !CollisionManager::getInstance().shouldCollide(m_layer, other->getCollisionLayer())) {
+        return CollisionManifold(false);
+    }
+    return NarrowPhase::collide(*this, *other);
+}
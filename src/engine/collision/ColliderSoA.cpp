@@ -0,0 +1,290 @@
+#include "../../../include/headers/collision/ColliderSoA.h"
+#include <algorithm>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define COLLISION_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#include <intrin.h>
+#define COLLISION_TARGET_AVX2
+#else
+#define COLLISION_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace {
+    struct SoAView {
+        const float* minX;
+        const float* minY;
+        const float* maxX;
+        const float* maxY;
+        const uint32_t* layers;
+        size_t count;
+    };
+
+    size_t overlapScalar(const SoAView& view, size_t begin, const Aabb& box, uint32_t mask, bool strict,
+        uint32_t* outSlots, size_t found) {
+        for (size_t i = begin; i < view.count; ++i) {
+            if (!(view.layers[i] & mask)) continue;
+
+            bool hit = strict
+                ? (view.minX[i] < box.max.x && view.maxX[i] > box.min.x && view.minY[i] < box.max.y && view.maxY[i] > box.min.y)
+                : (view.minX[i] <= box.max.x && view.maxX[i] >= box.min.x && view.minY[i] <= box.max.y && view.maxY[i] >= box.min.y);
+            if (hit) {
+                outSlots[found++] = static_cast<uint32_t>(i);
+            }
+        }
+        return found;
+    }
+
+#ifdef COLLISION_SIMD_X86
+    size_t overlapSse2(const SoAView& view, const Aabb& box, uint32_t mask, bool strict, uint32_t* outSlots) {
+        const __m128 boxMinX = _mm_set1_ps(box.min.x);
+        const __m128 boxMinY = _mm_set1_ps(box.min.y);
+        const __m128 boxMaxX = _mm_set1_ps(box.max.x);
+        const __m128 boxMaxY = _mm_set1_ps(box.max.y);
+        const __m128i layerMask = _mm_set1_epi32(static_cast<int>(mask));
+        const __m128i zero = _mm_setzero_si128();
+
+        size_t found = 0;
+        size_t i = 0;
+        for (; i + 4 <= view.count; i += 4) {
+            __m128 minX = _mm_loadu_ps(view.minX + i);
+            __m128 minY = _mm_loadu_ps(view.minY + i);
+            __m128 maxX = _mm_loadu_ps(view.maxX + i);
+            __m128 maxY = _mm_loadu_ps(view.maxY + i);
+
+            __m128 overlap = strict
+                ? _mm_and_ps(_mm_and_ps(_mm_cmplt_ps(minX, boxMaxX), _mm_cmpgt_ps(maxX, boxMinX)),
+                    _mm_and_ps(_mm_cmplt_ps(minY, boxMaxY), _mm_cmpgt_ps(maxY, boxMinY)))
+                : _mm_and_ps(_mm_and_ps(_mm_cmple_ps(minX, boxMaxX), _mm_cmpge_ps(maxX, boxMinX)),
+                    _mm_and_ps(_mm_cmple_ps(minY, boxMaxY), _mm_cmpge_ps(maxY, boxMinY)));
+
+            __m128i layers = _mm_loadu_si128(reinterpret_cast<const __m128i*>(view.layers + i));
+            __m128i layerMiss = _mm_cmpeq_epi32(_mm_and_si128(layers, layerMask), zero);
+            int bits = _mm_movemask_ps(_mm_andnot_ps(_mm_castsi128_ps(layerMiss), overlap));
+
+            for (uint32_t lane = 0; bits; ++lane, bits >>= 1) {
+                if (bits & 1) outSlots[found++] = static_cast<uint32_t>(i) + lane;
+            }
+        }
+        return overlapScalar(view, i, box, mask, strict, outSlots, found);
+    }
+
+    COLLISION_TARGET_AVX2
+    size_t overlapAvx2(const SoAView& view, const Aabb& box, uint32_t mask, bool strict, uint32_t* outSlots) {
+        const __m256 boxMinX = _mm256_set1_ps(box.min.x);
+        const __m256 boxMinY = _mm256_set1_ps(box.min.y);
+        const __m256 boxMaxX = _mm256_set1_ps(box.max.x);
+        const __m256 boxMaxY = _mm256_set1_ps(box.max.y);
+        const __m256i layerMask = _mm256_set1_epi32(static_cast<int>(mask));
+        const __m256i zero = _mm256_setzero_si256();
+
+        size_t found = 0;
+        size_t i = 0;
+        for (; i + 8 <= view.count; i += 8) {
+            __m256 minX = _mm256_loadu_ps(view.minX + i);
+            __m256 minY = _mm256_loadu_ps(view.minY + i);
+            __m256 maxX = _mm256_loadu_ps(view.maxX + i);
+            __m256 maxY = _mm256_loadu_ps(view.maxY + i);
+
+            // The compare predicate has to be an immediate
+            __m256 overlap;
+            if (strict) {
+                overlap = _mm256_and_ps(
+                    _mm256_and_ps(_mm256_cmp_ps(minX, boxMaxX, _CMP_LT_OQ), _mm256_cmp_ps(boxMinX, maxX, _CMP_LT_OQ)),
+                    _mm256_and_ps(_mm256_cmp_ps(minY, boxMaxY, _CMP_LT_OQ), _mm256_cmp_ps(boxMinY, maxY, _CMP_LT_OQ)));
+            }
+            else {
+                overlap = _mm256_and_ps(
+                    _mm256_and_ps(_mm256_cmp_ps(minX, boxMaxX, _CMP_LE_OQ), _mm256_cmp_ps(boxMinX, maxX, _CMP_LE_OQ)),
+                    _mm256_and_ps(_mm256_cmp_ps(minY, boxMaxY, _CMP_LE_OQ), _mm256_cmp_ps(boxMinY, maxY, _CMP_LE_OQ)));
+            }
+
+            __m256i layers = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(view.layers + i));
+            __m256i layerMiss = _mm256_cmpeq_epi32(_mm256_and_si256(layers, layerMask), zero);
+            int bits = _mm256_movemask_ps(_mm256_andnot_ps(_mm256_castsi256_ps(layerMiss), overlap));
+
+            for (uint32_t lane = 0; bits; ++lane, bits >>= 1) {
+                if (bits & 1) outSlots[found++] = static_cast<uint32_t>(i) + lane;
+            }
+        }
+        return overlapScalar(view, i, box, mask, strict, outSlots, found);
+    }
+
+    bool cpuSupportsAvx2() {
+#if defined(_MSC_VER)
+        int info[4];
+        __cpuid(info, 0);
+        if (info[0] < 7) return false;
+
+        __cpuid(info, 1);
+        bool osSavesYmm = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 6) == 6;
+        if (!osSavesYmm) return false;
+
+        __cpuidex(info, 7, 0);
+        return (info[1] & (1 << 5)) != 0;
+#else
+        return __builtin_cpu_supports("avx2");
+#endif
+    }
+#endif
+
+    CollisionKernel detectKernel() {
+#ifdef COLLISION_SIMD_X86
+        return cpuSupportsAvx2() ? CollisionKernel::Avx2 : CollisionKernel::Sse2;
+#else
+        return CollisionKernel::Scalar;
+#endif
+    }
+
+    CollisionKernel g_kernel = detectKernel();
+}
+
+CollisionKernel ColliderSoA::getKernel() {
+    return g_kernel;
+}
+
+bool ColliderSoA::setKernel(CollisionKernel kernel) {
+    if (kernel > detectKernel()) {
+        return false;
+    }
+    g_kernel = kernel;
+    return true;
+}
+
+const char* ColliderSoA::getKernelName(CollisionKernel kernel) {
+    switch (kernel) {
+    case CollisionKernel::Avx2: return "avx2";
+    case CollisionKernel::Sse2: return "sse2";
+    default: return "scalar";
+    }
+}
+
+uint32_t ColliderSoA::add(const Aabb& bounds, uint32_t layer, uint32_t id) {
+    m_minX.push_back(bounds.min.x);
+    m_minY.push_back(bounds.min.y);
+    m_maxX.push_back(bounds.max.x);
+    m_maxY.push_back(bounds.max.y);
+    m_layers.push_back(layer);
+    m_ids.push_back(id);
+    return static_cast<uint32_t>(m_ids.size() - 1);
+}
+
+void ColliderSoA::setBounds(uint32_t slot, const Aabb& bounds) {
+    m_minX[slot] = bounds.min.x;
+    m_minY[slot] = bounds.min.y;
+    m_maxX[slot] = bounds.max.x;
+    m_maxY[slot] = bounds.max.y;
+}
+
+Aabb ColliderSoA::getBounds(uint32_t slot) const {
+    return Aabb(glm::vec2(m_minX[slot], m_minY[slot]), glm::vec2(m_maxX[slot], m_maxY[slot]));
+}
+
+void ColliderSoA::removeSlot(uint32_t slot) {
+    size_t last = m_ids.size() - 1;
+    m_minX[slot] = m_minX[last];
+    m_minY[slot] = m_minY[last];
+    m_maxX[slot] = m_maxX[last];
+    m_maxY[slot] = m_maxY[last];
+    m_layers[slot] = m_layers[last];
+    m_ids[slot] = m_ids[last];
+
+    m_minX.pop_back();
+    m_minY.pop_back();
+    m_maxX.pop_back();
+    m_maxY.pop_back();
+    m_layers.pop_back();
+    m_ids.pop_back();
+}
+
+int ColliderSoA::findSlot(uint32_t id) const {
+    auto it = std::find(m_ids.begin(), m_ids.end(), id);
+    return it != m_ids.end() ? static_cast<int>(it - m_ids.begin()) : -1;
+}
+
+void ColliderSoA::clear() {
+    m_minX.clear();
+    m_minY.clear();
+    m_maxX.clear();
+    m_maxY.clear();
+    m_layers.clear();
+    m_ids.clear();
+}
+
+size_t ColliderSoA::findOverlappingSlots(const Aabb& bounds, uint32_t mask, bool strict, uint32_t* outSlots) const {
+    SoAView view{ m_minX.data(), m_minY.data(), m_maxX.data(), m_maxY.data(), m_layers.data(), m_ids.size() };
+
+    switch (g_kernel) {
+#ifdef COLLISION_SIMD_X86
+    case CollisionKernel::Avx2:
+        return overlapAvx2(view, bounds, mask, strict, outSlots);
+    case CollisionKernel::Sse2:
+        return overlapSse2(view, bounds, mask, strict, outSlots);
+#endif
+    default:
+        return overlapScalar(view, 0, bounds, mask, strict, outSlots, 0);
+    }
+}
+
+void ColliderSoA::queryOverlaps(const Aabb& bounds, uint32_t mask, std::vector<uint32_t>& outIds) const {
+    if (m_ids.empty()) return;
+
+    size_t offset = outIds.size();
+    outIds.resize(offset + m_ids.size());
+    size_t found = findOverlappingSlots(bounds, mask, false, outIds.data() + offset);
+    outIds.resize(offset + found);
+
+    for (size_t i = offset; i < outIds.size(); ++i) {
+        outIds[i] = m_ids[outIds[i]];
+    }
+}
+
+void ColliderSoA::computeManifolds(const Aabb& bounds, uint32_t mask, std::vector<BoxContact>& outContacts) const {
+    if (m_ids.empty()) return;
+
+    // Slots go into a per thread scratch buffer, hits are rare compared to tests
+    thread_local std::vector<uint32_t> slots;
+    slots.resize(m_ids.size());
+    size_t found = findOverlappingSlots(bounds, mask, true, slots.data());
+
+    for (size_t i = 0; i < found; ++i) {
+        uint32_t slot = slots[i];
+        outContacts.push_back({ m_ids[slot], computeManifold(bounds, getBounds(slot)) });
+    }
+}
+
+void ColliderSoA::raycast(const glm::vec2& origin, const glm::vec2& direction, float maxDistance, uint32_t mask,
+    std::vector<BoxRayHit>& outHits) const {
+    for (size_t slot = 0; slot < m_ids.size(); ++slot) {
+        if (!(m_layers[slot] & mask)) continue;
+
+        float entry;
+        Aabb box(glm::vec2(m_minX[slot], m_minY[slot]), glm::vec2(m_maxX[slot], m_maxY[slot]));
+        if (box.intersectsRay(origin, direction, maxDistance, entry)) {
+            outHits.push_back({ m_ids[slot], entry });
+        }
+    }
+}
+
+CollisionManifold ColliderSoA::computeManifold(const Aabb& a, const Aabb& b) {
+    glm::vec2 overlap(
+        std::min(a.max.x, b.max.x) - std::max(a.min.x, b.min.x),
+        std::min(a.max.y, b.max.y) - std::max(a.min.y, b.min.y)
+    );
+    if (overlap.x <= 0.0f || overlap.y <= 0.0f) {
+        return CollisionManifold(false);
+    }
+
+    CollisionManifold manifold(true);
+    if (overlap.x < overlap.y) {
+        manifold.normal.x = (a.min.x + a.max.x < b.min.x + b.max.x) ? 1.0f : -1.0f;
+        manifold.penetration = overlap.x;
+    }
+    else {
+        manifold.normal.y = (a.min.y + a.max.y < b.min.y + b.max.y) ? 1.0f : -1.0f;
+        manifold.penetration = overlap.y;
+    }
+    return manifold;
+}
@@ -0,0 +1,201 @@
+#include "../../../include/headers/collision/CollisionManager.h"
+#include "../../../include/headers/CommonDefines.h"
+#include "../../../include/nlohmann/json.hpp"
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+namespace {
+    const char* const BUILTIN_LAYER_NAMES[] = {
+        "Player", "Trigger", "Door", "Portal", "Wall", "Item", "Enemy", "Weapon"
+    };
+}
+
+CollisionManager::CollisionManager() {
+    for (int i = 0; i < MAX_LAYERS; ++i) {
+        m_layerNames[i] = i < static_cast<int>(std::size(BUILTIN_LAYER_NAMES))
+            ? BUILTIN_LAYER_NAMES[i]
+            : "Layer" + std::to_string(i);
+    }
+    resetToDefaults();
+}
+
+int CollisionManager::getLayerIndex(uint32_t layers) {
+    if (layers == 0) return -1;
+    int index = 0;
+    while (!(layers & 1u)) {
+        layers >>= 1;
+        ++index;
+    }
+    return index;
+}
+
+const std::string& CollisionManager::getLayerName(int index) const {
+    static const std::string none = "None";
+    return index >= 0 && index < MAX_LAYERS ? m_layerNames[index] : none;
+}
+
+int CollisionManager::findLayer(const std::string& name) const {
+    for (int i = 0; i < MAX_LAYERS; ++i) {
+        if (m_layerNames[i] == name) return i;
+    }
+    return -1;
+}
+
+void CollisionManager::setLayerCollision(CollisionLayerBits layer1, CollisionLayerBits layer2, bool shouldCollide) {
+    setLayerCollision(getLayerIndex(static_cast<uint32_t>(layer1)), getLayerIndex(static_cast<uint32_t>(layer2)), shouldCollide);
+}
+
+void CollisionManager::setLayerCollision(int index1, int index2, bool shouldCollide) {
+    if (index1 < 0 || index1 >= MAX_LAYERS || index2 < 0 || index2 >= MAX_LAYERS) {
+        DEBUG_LOG_WARN("Collision layer index out of range: " << index1 << ", " << index2);
+        return;
+    }
+
+    // Both directions, the matrix stays symmetric
+    if (shouldCollide) {
+        m_collisionMatrix[index1] |= 1u << index2;
+        m_collisionMatrix[index2] |= 1u << index1;
+    }
+    else {
+        m_collisionMatrix[index1] &= ~(1u << index2);
+        m_collisionMatrix[index2] &= ~(1u << index1);
+    }
+}
+
+void CollisionManager::resetToDefaults() {
+    m_collisionMatrix.fill(0);
+
+    const std::pair<CollisionLayerBits, uint32_t> defaults[] = {
+        { CollisionLayerBits::Player, CollisionMasks::Player },
+        { CollisionLayerBits::Trigger, CollisionMasks::Trigger },
+        { CollisionLayerBits::Door, CollisionMasks::Door },
+        { CollisionLayerBits::Portal, CollisionMasks::Portal },
+        { CollisionLayerBits::Wall, CollisionMasks::Wall },
+        { CollisionLayerBits::Enemy, CollisionMasks::Enemy },
+    };
+    for (const auto& [layer, mask] : defaults) {
+        int index = getLayerIndex(static_cast<uint32_t>(layer));
+        for (int other = 0; other < MAX_LAYERS; ++other) {
+            if (mask & (1u << other)) setLayerCollision(index, other, true);
+        }
+    }
+}
+
+bool CollisionManager::loadFromFile(const std::string& path) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        DEBUG_LOG("No collision layer config at " << path << ", using defaults");
+        return false;
+    }
+
+    nlohmann::json config;
+    try {
+        file >> config;
+    }
+    catch (const nlohmann::json::exception& e) {
+        DEBUG_LOG_ERROR("Failed to parse " << path << ": " << e.what());
+        return false;
+    }
+
+    if (!config.contains("pairs") || !config["pairs"].is_array()) {
+        DEBUG_LOG_ERROR(path << ": missing \"pairs\" array");
+        return false;
+    }
+
+    std::array<std::string, MAX_LAYERS> names = m_layerNames;
+    if (config.contains("layers") && config["layers"].is_object()) {
+        for (const auto& [name, value] : config["layers"].items()) {
+            int index = value.is_number_integer() ? value.get<int>() : -1;
+            if (index < 0 || index >= MAX_LAYERS) {
+                DEBUG_LOG_WARN(path << ": layer " << name << " needs an index between 0 and 31");
+                continue;
+            }
+            names[index] = name;
+        }
+    }
+
+    auto find = [&names](const nlohmann::json& value) {
+        if (!value.is_string()) return -1;
+        auto it = std::find(names.begin(), names.end(), value.get<std::string>());
+        return it != names.end() ? static_cast<int>(it - names.begin()) : -1;
+    };
+
+    std::vector<std::pair<int, int>> pairs;
+    for (const auto& pair : config["pairs"]) {
+        if (!pair.is_array() || pair.size() != 2) {
+            DEBUG_LOG_WARN(path << ": skipping pair " << pair.dump() << ", expected [\"LayerA\", \"LayerB\"]");
+            continue;
+        }
+        int index1 = find(pair[0]);
+        int index2 = find(pair[1]);
+        if (index1 < 0 || index2 < 0) {
+            DEBUG_LOG_WARN(path << ": skipping pair " << pair.dump() << ", unknown layer");
+            continue;
+        }
+        pairs.emplace_back(index1, index2);
+    }
+
+    m_layerNames = names;
+    m_collisionMatrix.fill(0);
+    for (const auto& [index1, index2] : pairs) {
+        setLayerCollision(index1, index2, true);
+    }
+    std::cout << "Loaded " << pairs.size() << " collision layer pairs from " << path << std::endl;
+    return true;
+}
+
+uint32_t CollisionManager::getCollisionMask(uint32_t layers) const {
+    uint32_t mask = 0;
+    while (layers) {
+        int index = getLayerIndex(layers);
+        mask |= m_collisionMatrix[index];
+        layers &= layers - 1;
+    }
+    return mask;
+}
+
+CollisionLayer CollisionManager::getDefaultLayer(CollisionLayerBits type) const {
+    int index = getLayerIndex(static_cast<uint32_t>(type));
+    if (index < 0 || type == CollisionLayerBits::All) {
+        return CollisionLayer();
+    }
+    return CollisionLayer(type, m_collisionMatrix[index]);
+}
+
+void CollisionManager::recordPairTest(uint32_t layers1, uint32_t layers2) {
+    int index1 = getLayerIndex(layers1);
+    int index2 = getLayerIndex(layers2);
+    if (index1 < 0 || index2 < 0) return;
+    if (index1 > index2) std::swap(index1, index2);
+    m_pairTests[index1 * MAX_LAYERS + index2].fetch_add(1, std::memory_order_relaxed);
+}
+
+void CollisionManager::resetPairTestCounts() {
+    for (auto& count : m_pairTests) {
+        count.store(0, std::memory_order_relaxed);
+    }
+}
+
+void CollisionManager::logPairTestCounts() const {
+    struct PairCount {
+        int index1;
+        int index2;
+        uint32_t count;
+    };
+    std::vector<PairCount> counts;
+    for (int i = 0; i < MAX_LAYERS; ++i) {
+        for (int j = i; j < MAX_LAYERS; ++j) {
+            uint32_t count = m_pairTests[i * MAX_LAYERS + j].load(std::memory_order_relaxed);
+            if (count > 0) counts.push_back({ i, j, count });
+        }
+    }
+    std::sort(counts.begin(), counts.end(), [](const PairCount& a, const PairCount& b) { return a.count > b.count; });
+
+    std::cout << "Collision pair tests by layer:" << std::endl;
+    for (const auto& pair : counts) {
+        std::cout << "  " << m_layerNames[pair.index1] << " / " << m_layerNames[pair.index2]
+            << ": " << pair.count << std::endl;
+    }
+}
@@ -0,0 +1,437 @@
+#include "../../../include/headers/collision/CollisionWorld.h"
+#include "../../../include/headers/collision/CollisionManager.h"
+#include "../../../include/headers/collision/NarrowPhase.h"
+#include "../../../include/headers/core/JobSystem.h"
+#include <algorithm>
+#include <iostream>
+#include <limits>
+
+namespace {
+    constexpr size_t RAYS_PER_JOB = 64;
+
+    struct AxisSweep {
+        float entry;    // share of the cast where the box starts overlapping on this axis
+        float exit;     // and where it stops
+        float gap;      // distance to the obstacle along the cast, negative when already inside
+        bool hit;       // false when the axes never overlap
+    };
+
+    AxisSweep sweepAxis(float moverMin, float moverMax, float obstacleMin, float obstacleMax, float delta) {
+        constexpr float INF = std::numeric_limits<float>::infinity();
+        if (delta > 0.0f) {
+            float gap = obstacleMin - moverMax;
+            return { gap / delta, (obstacleMax - moverMin) / delta, gap, true };
+        }
+        if (delta < 0.0f) {
+            float gap = moverMin - obstacleMax;
+            return { gap / -delta, (obstacleMin - moverMax) / delta, gap, true };
+        }
+        // Not moving on this axis: overlapping now means overlapping for the whole cast.
+        // Touching does not count, so sliding along a wall is not a hit.
+        bool overlapping = moverMax > obstacleMin && moverMin < obstacleMax;
+        return { -INF, INF, -INF, overlapping };
+    }
+}
+
+CollisionWorld::CollisionWorld(float cellSize)
+    : m_grid(cellSize) {
+}
+
+CollisionWorld::BodyId CollisionWorld::allocateBody() {
+    if (!m_freeBodies.empty()) {
+        BodyId id = m_freeBodies.back();
+        m_freeBodies.pop_back();
+        return id;
+    }
+    m_bodies.emplace_back();
+    return static_cast<BodyId>(m_bodies.size() - 1);
+}
+
+void CollisionWorld::insertProxy(BodyId id, const Aabb& bounds) {
+    CollisionBody& body = m_bodies[id];
+    if (body.isDynamic) {
+        body.treeProxy = m_dynamicTree.createProxy(bounds, id);
+        m_dynamicBodies.push_back(id);
+    }
+    else {
+        uint32_t layer = body.collider
+            ? body.collider->getCollisionLayer().layer
+            : static_cast<uint32_t>(CollisionLayerBits::Portal);
+        body.proxy = m_grid.insert(bounds, id, layer);
+    }
+}
+
+void CollisionWorld::removeProxy(BodyId id) {
+    CollisionBody& body = m_bodies[id];
+    if (body.isDynamic) {
+        m_dynamicTree.destroyProxy(body.treeProxy);
+        body.treeProxy = DynamicAabbTree::NULL_NODE;
+        auto it = std::find(m_dynamicBodies.begin(), m_dynamicBodies.end(), id);
+        if (it != m_dynamicBodies.end()) {
+            *it = m_dynamicBodies.back();
+            m_dynamicBodies.pop_back();
+        }
+    }
+    else {
+        m_grid.remove(body.proxy);
+        body.proxy = SpatialHashGrid::INVALID_PROXY;
+    }
+}
+
+CollisionWorld::BodyId CollisionWorld::addCollider(ICollider* collider, CollisionBodyKind kind) {
+    auto existing = m_bodyByCollider.find(collider);
+    if (existing != m_bodyByCollider.end()) {
+        updateCollider(collider);
+        return existing->second;
+    }
+
+    BodyId id = allocateBody();
+    CollisionBody& body = m_bodies[id];
+    body = CollisionBody();
+    body.kind = kind;
+    body.collider = collider;
+    body.isDynamic = collider->isMoving();
+    insertProxy(id, collider->getBounds());
+
+    m_bodyByCollider[collider] = id;
+    return id;
+}
+
+CollisionWorld::BodyId CollisionWorld::addPortal(const Aabb& bounds, size_t portalIndex) {
+    BodyId id = allocateBody();
+    CollisionBody& body = m_bodies[id];
+    body = CollisionBody();
+    body.kind = CollisionBodyKind::Portal;
+    body.portalIndex = portalIndex;
+    insertProxy(id, bounds);
+    return id;
+}
+
+void CollisionWorld::removeCollider(const ICollider* collider) {
+    // Only the pointer is used as a key, the collider may already be gone
+    auto it = m_bodyByCollider.find(collider);
+    if (it == m_bodyByCollider.end()) return;
+
+    removeProxy(it->second);
+    m_bodies[it->second] = CollisionBody();
+    m_freeBodies.push_back(it->second);
+    m_bodyByCollider.erase(it);
+}
+
+void CollisionWorld::clear() {
+    m_grid.clear();
+    m_dynamicTree.clear();
+    m_dynamicBodies.clear();
+    m_bodies.clear();
+    m_freeBodies.clear();
+    m_bodyByCollider.clear();
+}
+
+void CollisionWorld::updateCollider(const ICollider* collider) {
+    auto it = m_bodyByCollider.find(collider);
+    if (it == m_bodyByCollider.end()) return;
+
+    BodyId id = it->second;
+    CollisionBody& body = m_bodies[id];
+    Aabb bounds = collider->getBounds();
+
+    if (body.isDynamic != collider->isMoving()) {
+        removeProxy(id);
+        body.isDynamic = collider->isMoving();
+        insertProxy(id, bounds);
+        return;
+    }
+
+    if (body.isDynamic) {
+        const Aabb& previous = m_dynamicTree.getBounds(body.treeProxy);
+        if (bounds != previous) {
+            m_dynamicTree.moveProxy(body.treeProxy, bounds, bounds.min - previous.min);
+        }
+    }
+    else if (bounds != m_grid.getBounds(body.proxy)) {
+        m_grid.update(body.proxy, bounds);
+    }
+}
+
+void CollisionWorld::gather(const Aabb& bounds, std::vector<uint32_t>& outIds, uint32_t mask) const {
+    m_grid.query(bounds, outIds, mask);
+
+    // The tree tests fat boxes, keep only real overlaps
+    size_t treeBegin = outIds.size();
+    m_dynamicTree.query(bounds, outIds);
+    outIds.erase(std::remove_if(outIds.begin() + treeBegin, outIds.end(), [&](uint32_t id) {
+        const CollisionBody& body = m_bodies[id];
+        if (body.collider && !(body.collider->getCollisionLayer().layer & mask)) return true;
+        return !m_dynamicTree.getBounds(body.treeProxy).overlaps(bounds);
+    }), outIds.end());
+}
+
+void CollisionWorld::query(const Aabb& bounds, std::vector<const CollisionBody*>& outBodies) const {
+    // Queries run every frame per actor and may run on workers, ids go into a per thread scratch buffer
+    thread_local std::vector<uint32_t> ids;
+    ids.clear();
+    gather(bounds, ids);
+    for (uint32_t id : ids) {
+        outBodies.push_back(&m_bodies[id]);
+    }
+}
+
+void CollisionWorld::queryColliders(const ICollider& mover, std::vector<ICollider*>& outColliders) const {
+    auto& layers = CollisionManager::getInstance();
+    const CollisionLayer& moverLayer = mover.getCollisionLayer();
+
+    thread_local std::vector<uint32_t> ids;
+    ids.clear();
+    gather(mover.getBounds(), ids, layers.getQueryMask(moverLayer));
+
+    for (uint32_t id : ids) {
+        const CollisionBody& body = m_bodies[id];
+        if (!body.collider || body.collider == &mover) continue;
+        layers.recordPairTest(moverLayer.layer, body.collider->getCollisionLayer().layer);
+        outColliders.push_back(body.collider);
+    }
+}
+
+void CollisionWorld::collide(const ICollider& mover, std::vector<ColliderContact>& outContacts) const {
+    auto& layers = CollisionManager::getInstance();
+    const CollisionLayer& moverLayer = mover.getCollisionLayer();
+    Aabb bounds = mover.getBounds();
+    uint32_t mask = layers.getQueryMask(moverLayer);
+
+    // The grid kernels work on bounds, which is exact only for box pairs;
+    // other shapes get their bounds hit confirmed by the narrow phase
+    bool moverIsBox = mover.getShape() == ColliderShape::Box;
+
+    thread_local std::vector<BoxContact> contacts;
+    contacts.clear();
+    m_grid.collide(bounds, mask, contacts);
+    for (const auto& contact : contacts) {
+        const CollisionBody& body = m_bodies[contact.id];
+        if (!body.collider || body.collider == &mover) continue;
+        layers.recordPairTest(moverLayer.layer, body.collider->getCollisionLayer().layer);
+
+        if (moverIsBox && body.collider->getShape() == ColliderShape::Box) {
+            outContacts.push_back({ body.collider, contact.manifold });
+            continue;
+        }
+        CollisionManifold manifold = NarrowPhase::collide(mover, *body.collider);
+        if (manifold.hasCollision) {
+            outContacts.push_back({ body.collider, manifold });
+        }
+    }
+
+    thread_local std::vector<uint32_t> ids;
+    ids.clear();
+    m_dynamicTree.query(bounds, ids);
+    for (uint32_t id : ids) {
+        const CollisionBody& body = m_bodies[id];
+        if (!body.collider || body.collider == &mover) continue;
+        if (!(mask & body.collider->getCollisionLayer().layer)) continue;
+        layers.recordPairTest(moverLayer.layer, body.collider->getCollisionLayer().layer);
+
+        CollisionManifold manifold = moverIsBox && body.collider->getShape() == ColliderShape::Box
+            ? ColliderSoA::computeManifold(bounds, m_dynamicTree.getBounds(body.treeProxy))
+            : NarrowPhase::collide(mover, *body.collider);
+        if (manifold.hasCollision) {
+            outContacts.push_back({ body.collider, manifold });
+        }
+    }
+}
+
+void CollisionWorld::queryPortals(const Aabb& bounds, std::vector<size_t>& outPortalIndices) const {
+    thread_local std::vector<uint32_t> ids;
+    ids.clear();
+    gather(bounds, ids);
+    for (uint32_t id : ids) {
+        if (m_bodies[id].kind == CollisionBodyKind::Portal) {
+            outPortalIndices.push_back(m_bodies[id].portalIndex);
+        }
+    }
+}
+
+void CollisionWorld::queryPairs(std::vector<CollisionPair>& outPairs) const {
+    auto& layers = CollisionManager::getInstance();
+
+    // The matrix already passed in the broadphase; either collider's own mask may accept the pair
+    auto masksAccept = [&layers](const CollisionBody& a, const CollisionBody& b) {
+        if (!a.collider || !b.collider) return true;
+        const auto& layerA = a.collider->getCollisionLayer();
+        const auto& layerB = b.collider->getCollisionLayer();
+        if ((layerA.mask & layerB.layer) == 0 && (layerB.mask & layerA.layer) == 0) return false;
+        layers.recordPairTest(layerA.layer, layerB.layer);
+        return true;
+    };
+
+    thread_local std::vector<uint32_t> ids;
+    for (BodyId movingId : m_dynamicBodies) {
+        const CollisionBody& moving = m_bodies[movingId];
+        const Aabb& bounds = m_dynamicTree.getBounds(moving.treeProxy);
+        uint32_t movingLayer = moving.collider->getCollisionLayer().layer;
+        uint32_t matrixMask = layers.getCollisionMask(movingLayer);
+
+        ids.clear();
+        m_grid.query(bounds, ids, matrixMask);
+        for (uint32_t id : ids) {
+            if (masksAccept(moving, m_bodies[id])) {
+                outPairs.push_back({ &moving, &m_bodies[id] });
+            }
+        }
+
+        // Moving vs moving, each pair reported once from the lower id
+        ids.clear();
+        m_dynamicTree.query(bounds, ids);
+        for (uint32_t id : ids) {
+            if (id <= movingId) continue;
+            const CollisionBody& other = m_bodies[id];
+            if (!m_dynamicTree.getBounds(other.treeProxy).overlaps(bounds)) continue;
+            if (!(matrixMask & other.collider->getCollisionLayer().layer)) continue;
+            if (masksAccept(moving, other)) {
+                outPairs.push_back({ &moving, &other });
+            }
+        }
+    }
+}
+
+bool CollisionWorld::raycast(const glm::vec2& origin, const glm::vec2& direction, float maxDistance, uint32_t mask,
+    RaycastHit& outHit) const {
+    outHit = RaycastHit();
+    float length = glm::length(direction);
+    if (!(length > 0.0f) || !(maxDistance > 0.0f)) return false;
+
+    // Everything the callback needs behind one reference, so the std::function stays allocation free
+    struct RayState {
+        glm::vec2 origin;
+        glm::vec2 direction;
+        uint32_t mask;
+        float best;
+        RaycastHit* hit;
+    } state{ origin, direction / length, mask, maxDistance, &outHit };
+
+    auto visit = [this, &state](uint32_t id, float) {
+        ICollider* collider = m_bodies[id].collider;
+        if (!collider || !(collider->getCollisionLayer().layer & state.mask)) return state.best;
+
+        float distance;
+        glm::vec2 normal;
+        if (NarrowPhase::raycast(*collider, state.origin, state.direction, state.best, distance, normal) && distance < state.best) {
+            state.best = distance;
+            state.hit->collider = collider;
+            state.hit->normal = normal;
+        }
+        return state.best;
+    };
+    m_grid.raycast(origin, state.direction, maxDistance, mask, visit);
+    m_dynamicTree.raycast(origin, state.direction, state.best, visit);
+
+    if (!outHit.collider) return false;
+    outHit.distance = state.best;
+    outHit.fraction = state.best / maxDistance;
+    outHit.point = origin + state.direction * state.best;
+    return true;
+}
+
+void CollisionWorld::raycastAll(const glm::vec2& origin, const glm::vec2& direction, float maxDistance, uint32_t mask,
+    std::vector<RaycastHit>& outHits) const {
+    float length = glm::length(direction);
+    if (!(length > 0.0f) || !(maxDistance > 0.0f)) return;
+
+    struct RayState {
+        glm::vec2 origin;
+        glm::vec2 direction;
+        uint32_t mask;
+        float maxDistance;
+        std::vector<RaycastHit>* hits;
+    } state{ origin, direction / length, mask, maxDistance, &outHits };
+    size_t offset = outHits.size();
+
+    auto visit = [this, &state](uint32_t id, float) {
+        ICollider* collider = m_bodies[id].collider;
+        if (!collider || !(collider->getCollisionLayer().layer & state.mask)) return state.maxDistance;
+
+        RaycastHit hit;
+        if (NarrowPhase::raycast(*collider, state.origin, state.direction, state.maxDistance, hit.distance, hit.normal)) {
+            hit.collider = collider;
+            hit.fraction = hit.distance / state.maxDistance;
+            hit.point = state.origin + state.direction * hit.distance;
+            state.hits->push_back(hit);
+        }
+        return state.maxDistance;
+    };
+    m_grid.raycast(origin, state.direction, maxDistance, mask, visit);
+    m_dynamicTree.raycast(origin, state.direction, maxDistance, visit);
+
+    // Boxes on a cell boundary can be reported by both cells
+    auto begin = outHits.begin() + offset;
+    std::sort(begin, outHits.end(), [](const RaycastHit& a, const RaycastHit& b) {
+        return a.collider != b.collider ? a.collider < b.collider : a.distance < b.distance;
+    });
+    outHits.erase(std::unique(begin, outHits.end(),
+        [](const RaycastHit& a, const RaycastHit& b) { return a.collider == b.collider; }), outHits.end());
+    std::sort(outHits.begin() + offset, outHits.end(),
+        [](const RaycastHit& a, const RaycastHit& b) { return a.distance < b.distance; });
+}
+
+bool CollisionWorld::shapeCast(const Aabb& box, const glm::vec2& delta, uint32_t mask, RaycastHit& outHit,
+    const ICollider* ignore, float skin) const {
+    outHit = RaycastHit();
+    float length = glm::length(delta);
+    if (!(length > 0.0f)) return false;
+
+    thread_local std::vector<uint32_t> ids;
+    ids.clear();
+    gather(Aabb(glm::min(box.min, box.min + delta), glm::max(box.max, box.max + delta)), ids);
+
+    float best = 1.0f;
+    for (uint32_t id : ids) {
+        ICollider* collider = m_bodies[id].collider;
+        if (!collider || collider == ignore) continue;
+        if (!(collider->getCollisionLayer().layer & mask)) continue;
+
+        Aabb obstacle = collider->getBounds();
+        AxisSweep x = sweepAxis(box.min.x, box.max.x, obstacle.min.x, obstacle.max.x, delta.x);
+        AxisSweep y = sweepAxis(box.min.y, box.max.y, obstacle.min.y, obstacle.max.y, delta.y);
+        if (!x.hit || !y.hit) continue;
+
+        bool hitOnX = x.entry > y.entry;
+        const AxisSweep& axis = hitOnX ? x : y;
+        float entry = axis.entry;
+        float exit = std::min(x.exit, y.exit);
+
+        if (entry >= exit || exit <= 0.0f || entry > best) continue;
+        if (entry < 0.0f) {
+            if (axis.gap < -skin) continue;
+            entry = 0.0f;
+        }
+        if (outHit.collider && entry == best) continue;
+
+        best = entry;
+        outHit.collider = collider;
+        outHit.normal = hitOnX ? glm::vec2(delta.x > 0.0f ? -1.0f : 1.0f, 0.0f)
+                               : glm::vec2(0.0f, delta.y > 0.0f ? -1.0f : 1.0f);
+    }
+
+    if (!outHit.collider) return false;
+    outHit.fraction = best;
+    outHit.distance = best * length;
+    outHit.point = box.min + delta * best;
+    return true;
+}
+
+void CollisionWorld::raycastBatch(const std::vector<RayQuery>& rays, std::vector<RaycastHit>& outHits) const {
+    outHits.resize(rays.size());
+    JobSystem::getInstance().parallelFor(rays.size(), RAYS_PER_JOB, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            const RayQuery& ray = rays[i];
+            raycast(ray.origin, ray.direction, ray.maxDistance, ray.mask, outHits[i]);
+        }
+    });
+}
+
+void CollisionWorld::logStats(const std::string& label) const {
+    DynamicAabbTree::Quality quality = m_dynamicTree.computeQuality();
+    std::cout << "Collision world " << label << ": "
+        << m_grid.getProxyCount() << " static bodies in " << m_grid.getCellCount() << " cells, "
+        << quality.leafCount << " moving bodies (tree height " << quality.height
+        << ", max balance " << quality.maxBalance
+        << ", area ratio " << quality.areaRatio << ")" << std::endl;
+}
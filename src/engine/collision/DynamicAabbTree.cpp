@@ -0,0 +1,359 @@
+#include "../../../include/headers/collision/DynamicAabbTree.h"
+#include <algorithm>
+#include <cstdlib>
+
+namespace {
+    Aabb combine(const Aabb& a, const Aabb& b) {
+        return Aabb(glm::min(a.min, b.min), glm::max(a.max, b.max));
+    }
+
+    float perimeter(const Aabb& box) {
+        glm::vec2 extent = box.max - box.min;
+        return 2.0f * (extent.x + extent.y);
+    }
+}
+
+DynamicAabbTree::DynamicAabbTree(float fatMargin, float displacementMultiplier)
+    : m_fatMargin(fatMargin)
+    , m_displacementMultiplier(displacementMultiplier) {
+}
+
+DynamicAabbTree::ProxyId DynamicAabbTree::allocateNode() {
+    if (m_freeList == NULL_NODE) {
+        m_nodes.emplace_back();
+        m_nodes.back().height = 0;
+        return static_cast<ProxyId>(m_nodes.size() - 1);
+    }
+
+    ProxyId node = m_freeList;
+    m_freeList = m_nodes[node].parent;
+    m_nodes[node] = Node();
+    m_nodes[node].height = 0;
+    return node;
+}
+
+void DynamicAabbTree::freeNode(ProxyId node) {
+    m_nodes[node].parent = m_freeList;
+    m_nodes[node].child1 = NULL_NODE;
+    m_nodes[node].child2 = NULL_NODE;
+    m_nodes[node].height = -1;
+    m_freeList = node;
+}
+
+void DynamicAabbTree::clear() {
+    m_nodes.clear();
+    m_root = NULL_NODE;
+    m_freeList = NULL_NODE;
+    m_leafCount = 0;
+}
+
+Aabb DynamicAabbTree::fatten(const Aabb& bounds, const glm::vec2& displacement) const {
+    Aabb fat(bounds.min - glm::vec2(m_fatMargin), bounds.max + glm::vec2(m_fatMargin));
+
+    // Stretch towards where the collider is heading so steady movers reinsert less often
+    glm::vec2 predicted = displacement * m_displacementMultiplier;
+    if (predicted.x < 0.0f) fat.min.x += predicted.x; else fat.max.x += predicted.x;
+    if (predicted.y < 0.0f) fat.min.y += predicted.y; else fat.max.y += predicted.y;
+    return fat;
+}
+
+DynamicAabbTree::ProxyId DynamicAabbTree::createProxy(const Aabb& bounds, uint32_t userData) {
+    ProxyId leaf = allocateNode();
+    m_nodes[leaf].bounds = bounds;
+    m_nodes[leaf].fatBounds = fatten(bounds, glm::vec2(0.0f));
+    m_nodes[leaf].userData = userData;
+
+    insertLeaf(leaf);
+    ++m_leafCount;
+    return leaf;
+}
+
+void DynamicAabbTree::destroyProxy(ProxyId proxy) {
+    if (proxy < 0 || proxy >= static_cast<ProxyId>(m_nodes.size()) || m_nodes[proxy].height != 0) return;
+
+    removeLeaf(proxy);
+    freeNode(proxy);
+    --m_leafCount;
+}
+
+bool DynamicAabbTree::moveProxy(ProxyId proxy, const Aabb& bounds, const glm::vec2& displacement) {
+    Node& node = m_nodes[proxy];
+    node.bounds = bounds;
+    if (node.fatBounds.contains(bounds)) {
+        return false;
+    }
+
+    removeLeaf(proxy);
+    m_nodes[proxy].fatBounds = fatten(bounds, displacement);
+    insertLeaf(proxy);
+    return true;
+}
+
+void DynamicAabbTree::insertLeaf(ProxyId leaf) {
+    if (m_root == NULL_NODE) {
+        m_root = leaf;
+        m_nodes[leaf].parent = NULL_NODE;
+        return;
+    }
+
+    // Walk down picking the child that grows the least (surface area heuristic)
+    const Aabb leafBounds = m_nodes[leaf].fatBounds;
+    ProxyId index = m_root;
+    while (!m_nodes[index].isLeaf()) {
+        const Node& node = m_nodes[index];
+        float area = perimeter(node.fatBounds);
+        float combinedArea = perimeter(combine(node.fatBounds, leafBounds));
+
+        // Cost of pairing the leaf with this node, and of pushing it further down
+        float cost = 2.0f * combinedArea;
+        float inheritanceCost = 2.0f * (combinedArea - area);
+
+        auto descendCost = [&](ProxyId child) {
+            const Node& childNode = m_nodes[child];
+            float grown = perimeter(combine(leafBounds, childNode.fatBounds));
+            if (childNode.isLeaf()) {
+                return grown + inheritanceCost;
+            }
+            return grown - perimeter(childNode.fatBounds) + inheritanceCost;
+        };
+
+        float cost1 = descendCost(node.child1);
+        float cost2 = descendCost(node.child2);
+        if (cost < cost1 && cost < cost2) {
+            break;
+        }
+        index = cost1 < cost2 ? node.child1 : node.child2;
+    }
+
+    ProxyId sibling = index;
+    ProxyId oldParent = m_nodes[sibling].parent;
+    ProxyId newParent = allocateNode();
+    m_nodes[newParent].parent = oldParent;
+    m_nodes[newParent].fatBounds = combine(leafBounds, m_nodes[sibling].fatBounds);
+    m_nodes[newParent].height = m_nodes[sibling].height + 1;
+    m_nodes[newParent].child1 = sibling;
+    m_nodes[newParent].child2 = leaf;
+    m_nodes[sibling].parent = newParent;
+    m_nodes[leaf].parent = newParent;
+
+    if (oldParent == NULL_NODE) {
+        m_root = newParent;
+    }
+    else if (m_nodes[oldParent].child1 == sibling) {
+        m_nodes[oldParent].child1 = newParent;
+    }
+    else {
+        m_nodes[oldParent].child2 = newParent;
+    }
+
+    refitAncestors(m_nodes[leaf].parent);
+}
+
+void DynamicAabbTree::removeLeaf(ProxyId leaf) {
+    if (leaf == m_root) {
+        m_root = NULL_NODE;
+        return;
+    }
+
+    ProxyId parent = m_nodes[leaf].parent;
+    ProxyId grandParent = m_nodes[parent].parent;
+    ProxyId sibling = m_nodes[parent].child1 == leaf ? m_nodes[parent].child2 : m_nodes[parent].child1;
+
+    if (grandParent == NULL_NODE) {
+        m_root = sibling;
+        m_nodes[sibling].parent = NULL_NODE;
+        freeNode(parent);
+        return;
+    }
+
+    // The sibling takes the parent's place
+    if (m_nodes[grandParent].child1 == parent) {
+        m_nodes[grandParent].child1 = sibling;
+    }
+    else {
+        m_nodes[grandParent].child2 = sibling;
+    }
+    m_nodes[sibling].parent = grandParent;
+    freeNode(parent);
+
+    refitAncestors(grandParent);
+}
+
+void DynamicAabbTree::refitAncestors(ProxyId index) {
+    while (index != NULL_NODE) {
+        index = balance(index);
+
+        Node& node = m_nodes[index];
+        const Node& child1 = m_nodes[node.child1];
+        const Node& child2 = m_nodes[node.child2];
+        node.height = 1 + std::max(child1.height, child2.height);
+        node.fatBounds = combine(child1.fatBounds, child2.fatBounds);
+
+        index = node.parent;
+    }
+}
+
+// Rotates the taller grandchild up when the subtree under index is unbalanced.
+// Returns the node now sitting where index was.
+DynamicAabbTree::ProxyId DynamicAabbTree::balance(ProxyId indexA) {
+    Node& a = m_nodes[indexA];
+    if (a.isLeaf() || a.height < 2) {
+        return indexA;
+    }
+
+    ProxyId indexB = a.child1;
+    ProxyId indexC = a.child2;
+    int balanceFactor = m_nodes[indexC].height - m_nodes[indexB].height;
+
+    auto rotateUp = [&](ProxyId indexUp, ProxyId indexOther, bool upIsChild2) {
+        Node& up = m_nodes[indexUp];
+        ProxyId indexF = up.child1;
+        ProxyId indexG = up.child2;
+
+        // Up takes A's place
+        up.child1 = indexA;
+        up.parent = a.parent;
+        a.parent = indexUp;
+
+        if (up.parent != NULL_NODE) {
+            if (m_nodes[up.parent].child1 == indexA) {
+                m_nodes[up.parent].child1 = indexUp;
+            }
+            else {
+                m_nodes[up.parent].child2 = indexUp;
+            }
+        }
+        else {
+            m_root = indexUp;
+        }
+
+        // The taller grandchild stays under up, the shorter one moves to A
+        ProxyId keep = m_nodes[indexF].height > m_nodes[indexG].height ? indexF : indexG;
+        ProxyId give = keep == indexF ? indexG : indexF;
+
+        up.child2 = keep;
+        if (upIsChild2) {
+            a.child2 = give;
+        }
+        else {
+            a.child1 = give;
+        }
+        m_nodes[give].parent = indexA;
+
+        a.fatBounds = combine(m_nodes[indexOther].fatBounds, m_nodes[give].fatBounds);
+        up.fatBounds = combine(a.fatBounds, m_nodes[keep].fatBounds);
+        a.height = 1 + std::max(m_nodes[indexOther].height, m_nodes[give].height);
+        up.height = 1 + std::max(a.height, m_nodes[keep].height);
+        return indexUp;
+    };
+
+    if (balanceFactor > 1) {
+        return rotateUp(indexC, indexB, true);
+    }
+    if (balanceFactor < -1) {
+        return rotateUp(indexB, indexC, false);
+    }
+    return indexA;
+}
+
+void DynamicAabbTree::query(const Aabb& bounds, std::vector<uint32_t>& outUserData) const {
+    if (m_root == NULL_NODE) return;
+
+    ProxyId stackBuffer[64];
+    std::vector<ProxyId> overflow;
+    int stackSize = 0;
+    stackBuffer[stackSize++] = m_root;
+
+    while (stackSize > 0 || !overflow.empty()) {
+        ProxyId index;
+        if (!overflow.empty()) {
+            index = overflow.back();
+            overflow.pop_back();
+        }
+        else {
+            index = stackBuffer[--stackSize];
+        }
+
+        const Node& node = m_nodes[index];
+        if (!node.fatBounds.overlaps(bounds)) continue;
+
+        if (node.isLeaf()) {
+            outUserData.push_back(node.userData);
+            continue;
+        }
+
+        for (ProxyId child : { node.child1, node.child2 }) {
+            if (stackSize < 64) {
+                stackBuffer[stackSize++] = child;
+            }
+            else {
+                overflow.push_back(child);
+            }
+        }
+    }
+}
+
+void DynamicAabbTree::raycast(const glm::vec2& origin, const glm::vec2& direction, float maxDistance,
+    const RayCallback& callback) const {
+    if (m_root == NULL_NODE) return;
+
+    ProxyId stackBuffer[64];
+    std::vector<ProxyId> overflow;
+    int stackSize = 0;
+    stackBuffer[stackSize++] = m_root;
+
+    while (stackSize > 0 || !overflow.empty()) {
+        ProxyId index;
+        if (!overflow.empty()) {
+            index = overflow.back();
+            overflow.pop_back();
+        }
+        else {
+            index = stackBuffer[--stackSize];
+        }
+
+        const Node& node = m_nodes[index];
+        float entry;
+        if (!node.fatBounds.intersectsRay(origin, direction, maxDistance, entry)) continue;
+
+        if (node.isLeaf()) {
+            if (node.bounds.intersectsRay(origin, direction, maxDistance, entry)) {
+                maxDistance = std::min(maxDistance, callback(node.userData, entry));
+            }
+            continue;
+        }
+
+        for (ProxyId child : { node.child1, node.child2 }) {
+            if (stackSize < 64) {
+                stackBuffer[stackSize++] = child;
+            }
+            else {
+                overflow.push_back(child);
+            }
+        }
+    }
+}
+
+DynamicAabbTree::Quality DynamicAabbTree::computeQuality() const {
+    Quality quality;
+    quality.leafCount = m_leafCount;
+    if (m_root == NULL_NODE) return quality;
+
+    quality.height = m_nodes[m_root].height;
+    float rootArea = perimeter(m_nodes[m_root].fatBounds);
+    float totalArea = 0.0f;
+
+    for (const Node& node : m_nodes) {
+        if (node.height < 0) continue;
+        ++quality.nodeCount;
+        totalArea += perimeter(node.fatBounds);
+
+        if (!node.isLeaf()) {
+            int difference = std::abs(m_nodes[node.child2].height - m_nodes[node.child1].height);
+            quality.maxBalance = std::max(quality.maxBalance, difference);
+        }
+    }
+
+    quality.areaRatio = rootArea > 0.0f ? totalArea / rootArea : 0.0f;
+    return quality;
+}
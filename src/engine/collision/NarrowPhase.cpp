@@ -0,0 +1,401 @@
+#include "../../../include/headers/collision/NarrowPhase.h"
+#include "../../../include/headers/collision/BoxCollider.h"
+#include "../../../include/headers/collision/CircleCollider.h"
+#include "../../../include/headers/collision/CapsuleCollider.h"
+#include "../../../include/headers/collision/OrientedBoxCollider.h"
+#include "../../../include/headers/collision/PolygonCollider.h"
+#include "../../../include/headers/collision/ColliderSoA.h"
+#include <cfloat>
+#include <cmath>
+
+namespace {
+    using CollideFn = CollisionManifold(*)(const ICollider& a, const ICollider& b);
+
+    constexpr float AXIS_EPSILON = 1e-8f;
+
+    CollisionManifold flip(CollisionManifold manifold) {
+        manifold.normal = -manifold.normal;
+        return manifold;
+    }
+
+    CollisionManifold boxBox(const ICollider& a, const ICollider& b) {
+        return ColliderSoA::computeManifold(a.getBounds(), b.getBounds());
+    }
+
+    CollisionManifold circleCircle(const ICollider& a, const ICollider& b) {
+        const auto& circleA = static_cast<const CircleCollider&>(a);
+        const auto& circleB = static_cast<const CircleCollider&>(b);
+
+        glm::vec2 delta = circleB.getCenter() - circleA.getCenter();
+        float radii = circleA.getRadius() + circleB.getRadius();
+        float distanceSquared = glm::dot(delta, delta);
+        if (distanceSquared >= radii * radii) {
+            return CollisionManifold(false);
+        }
+
+        float distance = std::sqrt(distanceSquared);
+        CollisionManifold manifold(true);
+        manifold.normal = distance > 0.0f ? delta / distance : glm::vec2(1.0f, 0.0f);
+        manifold.penetration = radii - distance;
+        return manifold;
+    }
+
+    CollisionManifold circleBox(const ICollider& a, const ICollider& b) {
+        const auto& circle = static_cast<const CircleCollider&>(a);
+        const Aabb box = b.getBounds();
+        const glm::vec2 center = circle.getCenter();
+        const float radius = circle.getRadius();
+
+        glm::vec2 closest = glm::clamp(center, box.min, box.max);
+        glm::vec2 delta = closest - center;
+        float distanceSquared = glm::dot(delta, delta);
+
+        CollisionManifold manifold(true);
+        if (distanceSquared > 0.0f) {
+            if (distanceSquared >= radius * radius) {
+                return CollisionManifold(false);
+            }
+            float distance = std::sqrt(distanceSquared);
+            manifold.normal = delta / distance;
+            manifold.penetration = radius - distance;
+            return manifold;
+        }
+
+        // Center inside the box: leave through the nearest face
+        float left = center.x - box.min.x;
+        float right = box.max.x - center.x;
+        float top = center.y - box.min.y;
+        float bottom = box.max.y - center.y;
+        float nearest = std::min(std::min(left, right), std::min(top, bottom));
+
+        if (nearest == left) manifold.normal = glm::vec2(1.0f, 0.0f);
+        else if (nearest == right) manifold.normal = glm::vec2(-1.0f, 0.0f);
+        else if (nearest == top) manifold.normal = glm::vec2(0.0f, 1.0f);
+        else manifold.normal = glm::vec2(0.0f, -1.0f);
+        manifold.penetration = radius + nearest;
+        return manifold;
+    }
+
+    CollisionManifold boxCircle(const ICollider& a, const ICollider& b) {
+        return flip(circleBox(b, a));
+    }
+
+    CollisionManifold convexConvex(const ICollider& a, const ICollider& b) {
+        return NarrowPhase::collideConvex(NarrowPhase::toConvexShape(a), NarrowPhase::toConvexShape(b));
+    }
+
+    bool raycastBox(const Aabb& box, const glm::vec2& origin, const glm::vec2& direction, float maxDistance,
+        float& outDistance, glm::vec2& outNormal) {
+        if (origin.x > box.min.x && origin.x < box.max.x && origin.y > box.min.y && origin.y < box.max.y) {
+            return false;
+        }
+
+        float entry;
+        if (!box.intersectsRay(origin, direction, maxDistance, entry)) {
+            return false;
+        }
+
+        // The entry face is the one on the axis whose slab was entered last
+        glm::vec2 point = origin + direction * entry;
+        float distanceX = direction.x > 0.0f ? std::abs(point.x - box.min.x) : std::abs(point.x - box.max.x);
+        float distanceY = direction.y > 0.0f ? std::abs(point.y - box.min.y) : std::abs(point.y - box.max.y);
+        if (direction.x != 0.0f && (direction.y == 0.0f || distanceX <= distanceY)) {
+            outNormal = glm::vec2(direction.x > 0.0f ? -1.0f : 1.0f, 0.0f);
+        }
+        else {
+            outNormal = glm::vec2(0.0f, direction.y > 0.0f ? -1.0f : 1.0f);
+        }
+        outDistance = entry;
+        return true;
+    }
+
+    bool raycastCircle(const glm::vec2& center, float radius, const glm::vec2& origin, const glm::vec2& direction,
+        float maxDistance, float& outDistance, glm::vec2& outNormal) {
+        glm::vec2 offset = origin - center;
+        float b = glm::dot(offset, direction);
+        float c = glm::dot(offset, offset) - radius * radius;
+        if (c <= 0.0f || b > 0.0f) {
+            return false;   // inside, or outside and pointing away
+        }
+
+        float discriminant = b * b - c;
+        if (discriminant < 0.0f) {
+            return false;
+        }
+
+        float distance = -b - std::sqrt(discriminant);
+        if (distance > maxDistance) {
+            return false;
+        }
+        outDistance = std::max(distance, 0.0f);
+        outNormal = (origin + direction * outDistance - center) / radius;
+        return true;
+    }
+
+    // Cyrus-Beck clipping against the edge planes; winding does not matter
+    bool raycastPolygon(const glm::vec2* vertices, int count, const glm::vec2& origin, const glm::vec2& direction,
+        float maxDistance, float& outDistance, glm::vec2& outNormal) {
+        if (count < 3) return false;
+
+        glm::vec2 centroid(0.0f);
+        for (int i = 0; i < count; ++i) centroid += vertices[i];
+        centroid /= static_cast<float>(count);
+
+        float entry = -FLT_MAX;
+        float exit = maxDistance;
+        glm::vec2 entryNormal(0.0f);
+
+        for (int i = 0; i < count; ++i) {
+            glm::vec2 edge = vertices[(i + 1) % count] - vertices[i];
+            glm::vec2 normal(edge.y, -edge.x);
+            if (glm::dot(normal, vertices[i] - centroid) < 0.0f) normal = -normal;
+
+            float numerator = glm::dot(normal, vertices[i] - origin);
+            float denominator = glm::dot(normal, direction);
+            if (denominator == 0.0f) {
+                if (numerator < 0.0f) return false;     // parallel and outside this edge
+                continue;
+            }
+
+            float t = numerator / denominator;
+            if (denominator < 0.0f) {
+                if (t > entry) {
+                    entry = t;
+                    entryNormal = normal;
+                }
+            }
+            else {
+                exit = std::min(exit, t);
+            }
+            if (entry > exit) return false;
+        }
+
+        if (entry < 0.0f) {
+            return false;   // starts inside, or the polygon is behind the ray
+        }
+        outDistance = entry;
+        outNormal = glm::normalize(entryNormal);
+        return true;
+    }
+
+    constexpr int SHAPE_COUNT = static_cast<int>(ColliderShape::Count);
+
+    // Row = shape of a, column = shape of b
+    const CollideFn COLLIDE_TABLE[SHAPE_COUNT][SHAPE_COUNT] = {
+        //               Box           Circle        Capsule       OrientedBox   Polygon
+        /* Box */      { boxBox,       boxCircle,    convexConvex, convexConvex, convexConvex },
+        /* Circle */   { circleBox,    circleCircle, convexConvex, convexConvex, convexConvex },
+        /* Capsule */  { convexConvex, convexConvex, convexConvex, convexConvex, convexConvex },
+        /* OBB */      { convexConvex, convexConvex, convexConvex, convexConvex, convexConvex },
+        /* Polygon */  { convexConvex, convexConvex, convexConvex, convexConvex, convexConvex },
+    };
+}
+
+CollisionManifold NarrowPhase::collide(const ICollider& a, const ICollider& b) {
+    return COLLIDE_TABLE[static_cast<int>(a.getShape())][static_cast<int>(b.getShape())](a, b);
+}
+
+bool NarrowPhase::overlaps(const ICollider& a, const ICollider& b) {
+    if (a.getShape() == ColliderShape::Box && b.getShape() == ColliderShape::Box) {
+        return a.getBounds().overlaps(b.getBounds());
+    }
+    return collide(a, b).hasCollision;
+}
+
+ConvexShape NarrowPhase::toConvexShape(const ICollider& collider) {
+    ConvexShape shape;
+    switch (collider.getShape()) {
+    case ColliderShape::Box: {
+        Aabb bounds = collider.getBounds();
+        shape.vertices[0] = bounds.min;
+        shape.vertices[1] = glm::vec2(bounds.max.x, bounds.min.y);
+        shape.vertices[2] = bounds.max;
+        shape.vertices[3] = glm::vec2(bounds.min.x, bounds.max.y);
+        shape.count = 4;
+        break;
+    }
+    case ColliderShape::Circle: {
+        const auto& circle = static_cast<const CircleCollider&>(collider);
+        shape.vertices[0] = circle.getCenter();
+        shape.count = 1;
+        shape.radius = circle.getRadius();
+        break;
+    }
+    case ColliderShape::Capsule: {
+        const auto& capsule = static_cast<const CapsuleCollider&>(collider);
+        capsule.getSegment(shape.vertices[0], shape.vertices[1]);
+        shape.count = 2;
+        shape.radius = capsule.getRadius();
+        break;
+    }
+    case ColliderShape::OrientedBox:
+        static_cast<const OrientedBoxCollider&>(collider).getVertices(shape.vertices);
+        shape.count = 4;
+        break;
+    case ColliderShape::Polygon: {
+        const auto& polygon = static_cast<const PolygonCollider&>(collider);
+        polygon.getWorldVertices(shape.vertices);
+        shape.count = polygon.getVertexCount();
+        break;
+    }
+    default:
+        break;
+    }
+    return shape;
+}
+
+CollisionManifold NarrowPhase::collideConvex(const ConvexShape& a, const ConvexShape& b) {
+    if (a.count == 0 || b.count == 0) {
+        return CollisionManifold(false);
+    }
+
+    // Bounds reject first, most broadphase candidates fail here
+    auto bounds = [](const ConvexShape& shape) {
+        Aabb result{ shape.vertices[0], shape.vertices[0] };
+        for (int i = 1; i < shape.count; ++i) {
+            result.min = glm::min(result.min, shape.vertices[i]);
+            result.max = glm::max(result.max, shape.vertices[i]);
+        }
+        result.min -= glm::vec2(shape.radius);
+        result.max += glm::vec2(shape.radius);
+        return result;
+    };
+    Aabb boundsA = bounds(a);
+    Aabb boundsB = bounds(b);
+    if (boundsA.max.x <= boundsB.min.x || boundsB.max.x <= boundsA.min.x ||
+        boundsA.max.y <= boundsB.min.y || boundsB.max.y <= boundsA.min.y) {
+        return CollisionManifold(false);
+    }
+
+    constexpr int MAX_AXES = 2 * ConvexShape::MAX_VERTICES + ConvexShape::MAX_VERTICES * ConvexShape::MAX_VERTICES;
+    glm::vec2 axes[MAX_AXES];
+    int axisCount = 0;
+
+    auto addAxis = [&](const glm::vec2& direction) {
+        float lengthSquared = glm::dot(direction, direction);
+        if (lengthSquared > AXIS_EPSILON) {
+            axes[axisCount++] = direction / std::sqrt(lengthSquared);
+        }
+    };
+
+    // Face normals; a segment has a single one
+    for (const ConvexShape* shape : { &a, &b }) {
+        if (shape->count < 2) continue;
+        int edges = shape->count == 2 ? 1 : shape->count;
+        for (int i = 0; i < edges; ++i) {
+            glm::vec2 edge = shape->vertices[(i + 1) % shape->count] - shape->vertices[i];
+            addAxis(glm::vec2(-edge.y, edge.x));
+        }
+    }
+
+    // Rounded shapes can also be separated along the line between two vertices
+    if (a.radius > 0.0f || b.radius > 0.0f) {
+        for (int i = 0; i < a.count; ++i) {
+            for (int j = 0; j < b.count; ++j) {
+                addAxis(b.vertices[j] - a.vertices[i]);
+            }
+        }
+    }
+
+    if (axisCount == 0) {
+        axes[axisCount++] = glm::vec2(1.0f, 0.0f);     // concentric circles
+    }
+
+    auto project = [](const ConvexShape& shape, const glm::vec2& axis, float& outMin, float& outMax) {
+        outMin = outMax = glm::dot(shape.vertices[0], axis);
+        for (int i = 1; i < shape.count; ++i) {
+            float projection = glm::dot(shape.vertices[i], axis);
+            outMin = std::min(outMin, projection);
+            outMax = std::max(outMax, projection);
+        }
+        outMin -= shape.radius;
+        outMax += shape.radius;
+    };
+
+    float bestPenetration = FLT_MAX;
+    glm::vec2 bestNormal(0.0f);
+
+    for (int i = 0; i < axisCount; ++i) {
+        float minA, maxA, minB, maxB;
+        project(a, axes[i], minA, maxA);
+        project(b, axes[i], minB, maxB);
+
+        // How far a has to move against the axis, or along it, to get out
+        float alongAxis = maxA - minB;
+        float againstAxis = maxB - minA;
+        if (alongAxis <= 0.0f || againstAxis <= 0.0f) {
+            return CollisionManifold(false);
+        }
+
+        if (alongAxis < bestPenetration) {
+            bestPenetration = alongAxis;
+            bestNormal = axes[i];
+        }
+        if (againstAxis < bestPenetration) {
+            bestPenetration = againstAxis;
+            bestNormal = -axes[i];
+        }
+    }
+
+    CollisionManifold manifold(true);
+    manifold.normal = bestNormal;
+    manifold.penetration = bestPenetration;
+    return manifold;
+}
+
+bool NarrowPhase::raycast(const ICollider& collider, const glm::vec2& origin, const glm::vec2& direction,
+    float maxDistance, float& outDistance, glm::vec2& outNormal) {
+    switch (collider.getShape()) {
+    case ColliderShape::Box:
+        return raycastBox(collider.getBounds(), origin, direction, maxDistance, outDistance, outNormal);
+    case ColliderShape::Circle: {
+        const auto& circle = static_cast<const CircleCollider&>(collider);
+        return raycastCircle(circle.getCenter(), circle.getRadius(), origin, direction, maxDistance, outDistance, outNormal);
+    }
+    case ColliderShape::Capsule: {
+        // Union of the two end circles and the rectangle between them
+        const auto& capsule = static_cast<const CapsuleCollider&>(collider);
+        glm::vec2 start, end;
+        capsule.getSegment(start, end);
+        float radius = capsule.getRadius();
+
+        glm::vec2 segment = end - start;
+        float lengthSquared = glm::dot(segment, segment);
+        float along = lengthSquared > 0.0f ? glm::clamp(glm::dot(origin - start, segment) / lengthSquared, 0.0f, 1.0f) : 0.0f;
+        glm::vec2 closest = start + segment * along;
+        if (glm::dot(origin - closest, origin - closest) <= radius * radius) {
+            return false;
+        }
+
+        bool hit = false;
+        float best = maxDistance;
+        float distance;
+        glm::vec2 normal;
+        for (const glm::vec2& cap : { start, end }) {
+            if (raycastCircle(cap, radius, origin, direction, best, distance, normal)) {
+                hit = true;
+                best = distance;
+                outNormal = normal;
+            }
+        }
+        if (lengthSquared > 0.0f) {
+            glm::vec2 side = glm::vec2(-segment.y, segment.x) * (radius / std::sqrt(lengthSquared));
+            glm::vec2 rectangle[4] = { start + side, end + side, end - side, start - side };
+            if (raycastPolygon(rectangle, 4, origin, direction, best, distance, normal)) {
+                hit = true;
+                best = distance;
+                outNormal = normal;
+            }
+        }
+        outDistance = best;
+        return hit;
+    }
+    case ColliderShape::OrientedBox:
+    case ColliderShape::Polygon: {
+        ConvexShape shape = toConvexShape(collider);
+        return raycastPolygon(shape.vertices, shape.count, origin, direction, maxDistance, outDistance, outNormal);
+    }
+    default:
+        return false;
+    }
+}
@@ -0,0 +1,63 @@
+#include "../../../include/headers/collision/OrientedBoxCollider.h"
+#include "../../../include/headers/collision/CollisionManager.h"
+#include "../../../include/headers/collision/NarrowPhase.h"
+#include "../../../include/headers/CommonDefines.h"
+#include <cmath>
+
+OrientedBoxCollider::OrientedBoxCollider(const glm::vec2& center, const glm::vec2& halfExtents, float rotation)
+    : ICollider(ColliderShape::OrientedBox)
+    , m_center(center)
+    , m_halfExtents(halfExtents)
+    , m_rotation(rotation) {
+    if (!(halfExtents.x > 0.0f) || !(halfExtents.y > 0.0f)) {
+        DEBUG_LOG_WARN("Invalid extents in OrientedBoxCollider. Using default size.");
+        m_halfExtents = glm::vec2(0.5f);
+    }
+}
+
+void OrientedBoxCollider::getVertices(glm::vec2 outVertices[4]) const {
+    glm::vec2 axisX(std::cos(m_rotation), std::sin(m_rotation));
+    glm::vec2 axisY(-axisX.y, axisX.x);
+    glm::vec2 extentX = axisX * m_halfExtents.x;
+    glm::vec2 extentY = axisY * m_halfExtents.y;
+
+    outVertices[0] = m_center - extentX - extentY;
+    outVertices[1] = m_center + extentX - extentY;
+    outVertices[2] = m_center + extentX + extentY;
+    outVertices[3] = m_center - extentX + extentY;
+}
+
+Aabb OrientedBoxCollider::getBounds() const {
+    float c = std::abs(std::cos(m_rotation));
+    float s = std::abs(std::sin(m_rotation));
+    glm::vec2 extent(c * m_halfExtents.x + s * m_halfExtents.y, s * m_halfExtents.x + c * m_halfExtents.y);
+    return Aabb(m_center - extent, m_center + extent);
+}
+
+void OrientedBoxCollider::setPosition(const glm::vec2& pos) {
+    m_center += pos - getBounds().min;
+}
+
+void OrientedBoxCollider::setSize(const glm::vec2& size) {
+    if (!(size.x > 0.0f) || !(size.y > 0.0f)) {
+        DEBUG_LOG_WARN("Invalid size in OrientedBoxCollider.");
+        return;
+    }
+    glm::vec2 topLeft = getBounds().min;
+    m_halfExtents = size * 0.5f;
+    setPosition(topLeft);
+}
+
+bool OrientedBoxCollider::isColliding(const ICollider* other) const {
+    if (!other || !CollisionManager::getInstance().shouldCollide(m_layer, other->getCollisionLayer())) {
+        return false;
+    }
+    return NarrowPhase::overlaps(*this, *other);
+}
+
+CollisionManifold OrientedBoxCollider::checkCollision(const ICollider* other) const {
+    if (!other || !CollisionManager::getInstance().shouldCollide(m_layer, other->getCollisionLayer())) {
+        return CollisionManifold(false);
+    }
+    return NarrowPhase::collide(*this, *other);
+}
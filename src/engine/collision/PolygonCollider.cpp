@@ -0,0 +1,112 @@
+#include "../../../include/headers/collision/PolygonCollider.h"
+#include "../../../include/headers/collision/CollisionManager.h"
+#include "../../../include/headers/collision/NarrowPhase.h"
+#include "../../../include/headers/CommonDefines.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+    float cross(const glm::vec2& o, const glm::vec2& a, const glm::vec2& b) {
+        return (a.x - o.x) * (b.y - o.y) - (a.y - o.y) * (b.x - o.x);
+    }
+
+    // Monotone chain hull, drops collinear and duplicate points
+    std::vector<glm::vec2> convexHull(std::vector<glm::vec2> points) {
+        std::sort(points.begin(), points.end(), [](const glm::vec2& a, const glm::vec2& b) {
+            return a.x < b.x || (a.x == b.x && a.y < b.y);
+        });
+        if (points.size() < 3) return points;
+
+        std::vector<glm::vec2> hull(points.size() * 2);
+        size_t k = 0;
+        for (size_t i = 0; i < points.size(); ++i) {
+            while (k >= 2 && cross(hull[k - 2], hull[k - 1], points[i]) <= 0.0f) --k;
+            hull[k++] = points[i];
+        }
+        for (size_t i = points.size() - 1, lower = k + 1; i > 0; --i) {
+            while (k >= lower && cross(hull[k - 2], hull[k - 1], points[i - 1]) <= 0.0f) --k;
+            hull[k++] = points[i - 1];
+        }
+        hull.resize(k - 1);
+        return hull;
+    }
+}
+
+PolygonCollider::PolygonCollider(const glm::vec2& center, const std::vector<glm::vec2>& localVertices, float rotation)
+    : ICollider(ColliderShape::Polygon)
+    , m_center(center)
+    , m_rotation(rotation) {
+    if (localVertices.empty() || !setVertices(localVertices)) {
+        m_localVertices = { {-0.5f, -0.5f}, {0.5f, -0.5f}, {0.5f, 0.5f}, {-0.5f, 0.5f} };
+    }
+}
+
+bool PolygonCollider::setVertices(const std::vector<glm::vec2>& localVertices) {
+    std::vector<glm::vec2> hull = convexHull(localVertices);
+    if (hull.size() < 3 || hull.size() > static_cast<size_t>(MAX_VERTICES)) {
+        DEBUG_LOG_WARN("PolygonCollider needs 3 to " << MAX_VERTICES << " hull vertices, got " << hull.size());
+        return false;
+    }
+    m_localVertices = std::move(hull);
+    return true;
+}
+
+void PolygonCollider::getWorldVertices(glm::vec2* outVertices) const {
+    float c = std::cos(m_rotation);
+    float s = std::sin(m_rotation);
+    for (size_t i = 0; i < m_localVertices.size(); ++i) {
+        const glm::vec2& local = m_localVertices[i];
+        outVertices[i] = m_center + glm::vec2(c * local.x - s * local.y, s * local.x + c * local.y);
+    }
+}
+
+Aabb PolygonCollider::getBounds() const {
+    glm::vec2 vertices[MAX_VERTICES];
+    getWorldVertices(vertices);
+
+    Aabb bounds(vertices[0], vertices[0]);
+    for (int i = 1; i < getVertexCount(); ++i) {
+        bounds.min = glm::min(bounds.min, vertices[i]);
+        bounds.max = glm::max(bounds.max, vertices[i]);
+    }
+    return bounds;
+}
+
+void PolygonCollider::setPosition(const glm::vec2& pos) {
+    m_center += pos - getBounds().min;
+}
+
+void PolygonCollider::setSize(const glm::vec2& size) {
+    if (!(size.x > 0.0f) || !(size.y > 0.0f)) {
+        DEBUG_LOG_WARN("Invalid size in PolygonCollider.");
+        return;
+    }
+
+    glm::vec2 localMin = m_localVertices[0];
+    glm::vec2 localMax = m_localVertices[0];
+    for (const auto& vertex : m_localVertices) {
+        localMin = glm::min(localMin, vertex);
+        localMax = glm::max(localMax, vertex);
+    }
+
+    glm::vec2 topLeft = getBounds().min;
+    glm::vec2 scale = size / glm::max(localMax - localMin, glm::vec2(1e-6f));
+    for (auto& vertex : m_localVertices) {
+        vertex *= scale;
+    }
+    setPosition(topLeft);
+}
+
+bool PolygonCollider::isColliding(const ICollider* other) const {
+    if (!other || !CollisionManager::getInstance().shouldCollide(m_layer, other->getCollisionLayer())) {
+        return false;
+    }
+    return NarrowPhase::overlaps(*this, *other);
+}
+
+CollisionManifold PolygonCollider::checkCollision(const ICollider* other) const {
+    if (!other || !CollisionManager::getInstance().shouldCollide(m_layer, other->getCollisionLayer())) {
+        return CollisionManifold(false);
+    }
+    return NarrowPhase::collide(*this, *other);
+}
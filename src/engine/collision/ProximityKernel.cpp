@@ -0,0 +1,166 @@
+#include "../../../include/headers/collision/ProximityKernel.h"
+#include "../../../include/headers/collision/ColliderSoA.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+#define PROXIMITY_SIMD_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER)
+#define PROXIMITY_TARGET_AVX2
+#else
+#define PROXIMITY_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace {
+    struct CircleView {
+        const float* centerX;
+        const float* centerY;
+        const float* radiusSquared;
+        size_t count;
+    };
+
+    void circlesScalar(const CircleView& view, size_t begin, const Aabb& box, uint64_t* outBits) {
+        for (size_t i = begin; i < view.count; ++i) {
+            float dx = std::min(std::max(view.centerX[i], box.min.x), box.max.x) - view.centerX[i];
+            float dy = std::min(std::max(view.centerY[i], box.min.y), box.max.y) - view.centerY[i];
+            if (dx * dx + dy * dy < view.radiusSquared[i]) {
+                outBits[i / 64] |= uint64_t(1) << (i % 64);
+            }
+        }
+    }
+
+#ifdef PROXIMITY_SIMD_X86
+    void circlesSse2(const CircleView& view, const Aabb& box, uint64_t* outBits) {
+        const __m128 boxMinX = _mm_set1_ps(box.min.x);
+        const __m128 boxMinY = _mm_set1_ps(box.min.y);
+        const __m128 boxMaxX = _mm_set1_ps(box.max.x);
+        const __m128 boxMaxY = _mm_set1_ps(box.max.y);
+
+        size_t i = 0;
+        for (; i + 4 <= view.count; i += 4) {
+            __m128 centerX = _mm_loadu_ps(view.centerX + i);
+            __m128 centerY = _mm_loadu_ps(view.centerY + i);
+
+            // Closest point of the box to each center
+            __m128 dx = _mm_sub_ps(_mm_min_ps(_mm_max_ps(centerX, boxMinX), boxMaxX), centerX);
+            __m128 dy = _mm_sub_ps(_mm_min_ps(_mm_max_ps(centerY, boxMinY), boxMaxY), centerY);
+            __m128 distanceSquared = _mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy));
+
+            uint64_t bits = static_cast<uint64_t>(_mm_movemask_ps(_mm_cmplt_ps(distanceSquared, _mm_loadu_ps(view.radiusSquared + i))));
+            outBits[i / 64] |= bits << (i % 64);
+        }
+        circlesScalar(view, i, box, outBits);
+    }
+
+    PROXIMITY_TARGET_AVX2
+    void circlesAvx2(const CircleView& view, const Aabb& box, uint64_t* outBits) {
+        const __m256 boxMinX = _mm256_set1_ps(box.min.x);
+        const __m256 boxMinY = _mm256_set1_ps(box.min.y);
+        const __m256 boxMaxX = _mm256_set1_ps(box.max.x);
+        const __m256 boxMaxY = _mm256_set1_ps(box.max.y);
+
+        size_t i = 0;
+        for (; i + 8 <= view.count; i += 8) {
+            __m256 centerX = _mm256_loadu_ps(view.centerX + i);
+            __m256 centerY = _mm256_loadu_ps(view.centerY + i);
+
+            __m256 dx = _mm256_sub_ps(_mm256_min_ps(_mm256_max_ps(centerX, boxMinX), boxMaxX), centerX);
+            __m256 dy = _mm256_sub_ps(_mm256_min_ps(_mm256_max_ps(centerY, boxMinY), boxMaxY), centerY);
+            __m256 distanceSquared = _mm256_add_ps(_mm256_mul_ps(dx, dx), _mm256_mul_ps(dy, dy));
+
+            __m256 hit = _mm256_cmp_ps(distanceSquared, _mm256_loadu_ps(view.radiusSquared + i), _CMP_LT_OQ);
+            uint64_t bits = static_cast<uint64_t>(_mm256_movemask_ps(hit));
+            outBits[i / 64] |= bits << (i % 64);
+        }
+        circlesScalar(view, i, box, outBits);
+    }
+#endif
+}
+
+void ProximityHits::reset(size_t circleCount, size_t actorCount) {
+    m_circleCount = circleCount;
+    m_actorCount = actorCount;
+    m_wordsPerActor = (circleCount + 63) / 64;
+    m_words.assign(m_wordsPerActor * actorCount, 0);
+}
+
+size_t ProximityHits::countHits() const {
+    size_t count = 0;
+    for (uint64_t word : m_words) {
+        for (; word; word &= word - 1) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+uint32_t ProximityKernel::add(const glm::vec2& center, float radius, uint32_t id) {
+    m_centerX.push_back(center.x);
+    m_centerY.push_back(center.y);
+    m_radiusSquared.push_back(radius * radius);
+    m_ids.push_back(id);
+    return static_cast<uint32_t>(m_ids.size() - 1);
+}
+
+void ProximityKernel::setCircle(uint32_t slot, const glm::vec2& center, float radius) {
+    m_centerX[slot] = center.x;
+    m_centerY[slot] = center.y;
+    m_radiusSquared[slot] = radius * radius;
+}
+
+void ProximityKernel::removeSlot(uint32_t slot) {
+    size_t last = m_ids.size() - 1;
+    m_centerX[slot] = m_centerX[last];
+    m_centerY[slot] = m_centerY[last];
+    m_radiusSquared[slot] = m_radiusSquared[last];
+    m_ids[slot] = m_ids[last];
+
+    m_centerX.pop_back();
+    m_centerY.pop_back();
+    m_radiusSquared.pop_back();
+    m_ids.pop_back();
+}
+
+int ProximityKernel::findSlot(uint32_t id) const {
+    auto it = std::find(m_ids.begin(), m_ids.end(), id);
+    return it != m_ids.end() ? static_cast<int>(it - m_ids.begin()) : -1;
+}
+
+void ProximityKernel::clear() {
+    m_centerX.clear();
+    m_centerY.clear();
+    m_radiusSquared.clear();
+    m_ids.clear();
+}
+
+void ProximityKernel::test(const Aabb* actors, size_t actorCount, ProximityHits& outHits) const {
+    outHits.reset(m_ids.size(), actorCount);
+    if (m_ids.empty()) return;
+
+    for (size_t actor = 0; actor < actorCount; ++actor) {
+        testCircles(m_centerX.data(), m_centerY.data(), m_radiusSquared.data(), m_ids.size(),
+            actors[actor], outHits.getRow(actor));
+    }
+}
+
+void ProximityKernel::testCircles(const float* centerX, const float* centerY, const float* radiusSquared, size_t count,
+    const Aabb& box, uint64_t* outBits) {
+    std::memset(outBits, 0, ((count + 63) / 64) * sizeof(uint64_t));
+
+    CircleView view{ centerX, centerY, radiusSquared, count };
+    switch (ColliderSoA::getKernel()) {
+#ifdef PROXIMITY_SIMD_X86
+    case CollisionKernel::Avx2:
+        circlesAvx2(view, box, outBits);
+        break;
+    case CollisionKernel::Sse2:
+        circlesSse2(view, box, outBits);
+        break;
+#endif
+    default:
+        circlesScalar(view, 0, box, outBits);
+        break;
+    }
+}
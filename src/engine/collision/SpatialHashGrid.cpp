@@ -0,0 +1,226 @@
+#include "../../../include/headers/collision/SpatialHashGrid.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+SpatialHashGrid::SpatialHashGrid(float cellSize)
+    : m_cellSize(cellSize > 0.0f ? cellSize : 128.0f)
+    , m_inverseCellSize(1.0f / m_cellSize) {
+}
+
+SpatialHashGrid::CellRange SpatialHashGrid::getCellRange(const Aabb& bounds) const {
+    CellRange range;
+    range.minX = static_cast<int>(std::floor(bounds.min.x * m_inverseCellSize));
+    range.minY = static_cast<int>(std::floor(bounds.min.y * m_inverseCellSize));
+    range.maxX = static_cast<int>(std::floor(bounds.max.x * m_inverseCellSize));
+    range.maxY = static_cast<int>(std::floor(bounds.max.y * m_inverseCellSize));
+    return range;
+}
+
+void SpatialHashGrid::addToCell(int x, int y, ProxyId proxy) {
+    if (m_occupied.maxX < m_occupied.minX) {
+        m_occupied = { x, y, x, y };
+    }
+    else {
+        m_occupied.minX = std::min(m_occupied.minX, x);
+        m_occupied.minY = std::min(m_occupied.minY, y);
+        m_occupied.maxX = std::max(m_occupied.maxX, x);
+        m_occupied.maxY = std::max(m_occupied.maxY, y);
+    }
+    m_cells[cellKey(x, y)].add(m_proxies[proxy].bounds, m_proxies[proxy].layer, proxy);
+}
+
+void SpatialHashGrid::removeFromCell(int x, int y, ProxyId proxy) {
+    auto it = m_cells.find(cellKey(x, y));
+    if (it == m_cells.end()) return;
+
+    auto& bucket = it->second;
+    int slot = bucket.findSlot(proxy);
+    if (slot >= 0) {
+        bucket.removeSlot(static_cast<uint32_t>(slot));
+    }
+    if (bucket.empty()) {
+        m_cells.erase(it);
+    }
+}
+
+void SpatialHashGrid::setCellBounds(int x, int y, ProxyId proxy, const Aabb& bounds) {
+    auto it = m_cells.find(cellKey(x, y));
+    if (it == m_cells.end()) return;
+
+    int slot = it->second.findSlot(proxy);
+    if (slot >= 0) {
+        it->second.setBounds(static_cast<uint32_t>(slot), bounds);
+    }
+}
+
+SpatialHashGrid::ProxyId SpatialHashGrid::insert(const Aabb& bounds, uint32_t userData, uint32_t layer) {
+    ProxyId id;
+    if (!m_freeProxies.empty()) {
+        id = m_freeProxies.back();
+        m_freeProxies.pop_back();
+    }
+    else {
+        id = static_cast<ProxyId>(m_proxies.size());
+        m_proxies.emplace_back();
+    }
+
+    Proxy& proxy = m_proxies[id];
+    proxy.bounds = bounds;
+    proxy.cells = getCellRange(bounds);
+    proxy.userData = userData;
+    proxy.layer = layer;
+    proxy.alive = true;
+
+    for (int y = proxy.cells.minY; y <= proxy.cells.maxY; ++y) {
+        for (int x = proxy.cells.minX; x <= proxy.cells.maxX; ++x) {
+            addToCell(x, y, id);
+        }
+    }
+    return id;
+}
+
+void SpatialHashGrid::update(ProxyId id, const Aabb& bounds) {
+    if (id >= m_proxies.size() || !m_proxies[id].alive) return;
+
+    Proxy& proxy = m_proxies[id];
+    proxy.bounds = bounds;
+
+    CellRange newCells = getCellRange(bounds);
+    CellRange oldCells = proxy.cells;
+    for (int y = oldCells.minY; y <= oldCells.maxY; ++y) {
+        for (int x = oldCells.minX; x <= oldCells.maxX; ++x) {
+            if (newCells.contains(x, y)) {
+                setCellBounds(x, y, id, bounds);
+            }
+            else {
+                removeFromCell(x, y, id);
+            }
+        }
+    }
+    if (newCells == oldCells) return;
+
+    for (int y = newCells.minY; y <= newCells.maxY; ++y) {
+        for (int x = newCells.minX; x <= newCells.maxX; ++x) {
+            if (!oldCells.contains(x, y)) addToCell(x, y, id);
+        }
+    }
+    proxy.cells = newCells;
+}
+
+void SpatialHashGrid::remove(ProxyId id) {
+    if (id >= m_proxies.size() || !m_proxies[id].alive) return;
+
+    Proxy& proxy = m_proxies[id];
+    for (int y = proxy.cells.minY; y <= proxy.cells.maxY; ++y) {
+        for (int x = proxy.cells.minX; x <= proxy.cells.maxX; ++x) {
+            removeFromCell(x, y, id);
+        }
+    }
+    proxy.alive = false;
+    m_freeProxies.push_back(id);
+}
+
+void SpatialHashGrid::clear() {
+    m_proxies.clear();
+    m_freeProxies.clear();
+    m_cells.clear();
+    m_occupied = CellRange();
+}
+
+void SpatialHashGrid::query(const Aabb& bounds, std::vector<uint32_t>& outUserData, uint32_t mask) const {
+    CellRange range = getCellRange(bounds);
+    thread_local std::vector<ProxyId> found;
+    found.clear();
+
+    for (int y = range.minY; y <= range.maxY; ++y) {
+        for (int x = range.minX; x <= range.maxX; ++x) {
+            auto it = m_cells.find(cellKey(x, y));
+            if (it != m_cells.end()) {
+                it->second.queryOverlaps(bounds, mask, found);
+            }
+        }
+    }
+
+    // A proxy spanning several queried cells shows up once per cell; no shared
+    // visit marks so concurrent queries stay safe
+    std::sort(found.begin(), found.end());
+    found.erase(std::unique(found.begin(), found.end()), found.end());
+
+    for (ProxyId id : found) {
+        outUserData.push_back(m_proxies[id].userData);
+    }
+}
+
+void SpatialHashGrid::collide(const Aabb& bounds, uint32_t mask, std::vector<BoxContact>& outContacts) const {
+    CellRange range = getCellRange(bounds);
+    size_t offset = outContacts.size();
+
+    for (int y = range.minY; y <= range.maxY; ++y) {
+        for (int x = range.minX; x <= range.maxX; ++x) {
+            auto it = m_cells.find(cellKey(x, y));
+            if (it != m_cells.end()) {
+                it->second.computeManifolds(bounds, mask, outContacts);
+            }
+        }
+    }
+
+    auto begin = outContacts.begin() + offset;
+    std::sort(begin, outContacts.end(), [](const BoxContact& a, const BoxContact& b) { return a.id < b.id; });
+    outContacts.erase(std::unique(begin, outContacts.end(),
+        [](const BoxContact& a, const BoxContact& b) { return a.id == b.id; }), outContacts.end());
+
+    for (auto it = outContacts.begin() + offset; it != outContacts.end(); ++it) {
+        it->id = m_proxies[it->id].userData;
+    }
+}
+
+void SpatialHashGrid::raycast(const glm::vec2& origin, const glm::vec2& direction, float maxDistance, uint32_t mask,
+    const RayCallback& callback) const {
+    if (m_cells.empty() || !(maxDistance > 0.0f) || (direction.x == 0.0f && direction.y == 0.0f)) return;
+
+    // Skip the empty space before the occupied cells, and never walk past them
+    Aabb occupied(glm::vec2(static_cast<float>(m_occupied.minX), static_cast<float>(m_occupied.minY)) * m_cellSize,
+        glm::vec2(static_cast<float>(m_occupied.maxX + 1), static_cast<float>(m_occupied.maxY + 1)) * m_cellSize);
+    float start;
+    if (!occupied.intersectsRay(origin, direction, maxDistance, start)) return;
+
+    glm::vec2 startPoint = origin + direction * start;
+    int x = std::clamp(static_cast<int>(std::floor(startPoint.x * m_inverseCellSize)), m_occupied.minX, m_occupied.maxX);
+    int y = std::clamp(static_cast<int>(std::floor(startPoint.y * m_inverseCellSize)), m_occupied.minY, m_occupied.maxY);
+    int stepX = direction.x > 0.0f ? 1 : (direction.x < 0.0f ? -1 : 0);
+    int stepY = direction.y > 0.0f ? 1 : (direction.y < 0.0f ? -1 : 0);
+
+    // Distance along the ray to the cell's far boundary on each axis; computed
+    // from the cell index every step so rounding does not build up
+    auto boundary = [this](int cell, int step, float from, float delta) {
+        if (step == 0) return std::numeric_limits<float>::infinity();
+        return (static_cast<float>(cell + (step > 0 ? 1 : 0)) * m_cellSize - from) / delta;
+    };
+
+    // Box entry points and cell boundaries are computed differently, keep a little slack
+    const float tolerance = m_cellSize * 1e-4f;
+    float cellEnter = 0.0f;
+    thread_local std::vector<BoxRayHit> hits;
+
+    while (true) {
+        float exitX = boundary(x, stepX, origin.x, direction.x);
+        float exitY = boundary(y, stepY, origin.y, direction.y);
+        float cellExit = std::min(exitX, exitY);
+
+        auto it = m_cells.find(cellKey(x, y));
+        if (it != m_cells.end()) {
+            hits.clear();
+            it->second.raycast(origin, direction, maxDistance, mask, hits);
+            for (const BoxRayHit& hit : hits) {
+                if (hit.distance < cellEnter - tolerance || hit.distance > cellExit + tolerance) continue;
+                maxDistance = std::min(maxDistance, callback(m_proxies[hit.id].userData, hit.distance));
+            }
+        }
+
+        if (cellExit >= maxDistance) break;
+        if (exitX < exitY) x += stepX; else y += stepY;
+        if (x < m_occupied.minX || x > m_occupied.maxX || y < m_occupied.minY || y > m_occupied.maxY) break;
+        cellEnter = cellExit;
+    }
+}
@@ -0,0 +1,220 @@
+#include "../../../include/headers/collision/TriggerVolumeService.h"
+#include "../../../include/headers/collision/CollisionManager.h"
+#include "../../../include/headers/collision/CircleCollider.h"
+#include "../../../include/headers/collision/NarrowPhase.h"
+#include "../../../include/headers/CommonDefines.h"
+#include <algorithm>
+
+namespace {
+    int countTrailingZeros(uint64_t bits) {
+        int count = 0;
+        while (!(bits & 1u)) {
+            bits >>= 1;
+            ++count;
+        }
+        return count;
+    }
+}
+
+bool TriggerVolumeService::Pair::operator<(const Pair& other) const {
+    if (actor != other.actor) return std::less<const ICollider*>()(actor, other.actor);
+    return volume < other.volume;
+}
+
+TriggerVolumeService::VolumeId TriggerVolumeService::allocateVolume() {
+    if (!m_freeVolumes.empty()) {
+        VolumeId id = m_freeVolumes.back();
+        m_freeVolumes.pop_back();
+        return id;
+    }
+    m_volumes.emplace_back();
+    return static_cast<VolumeId>(m_volumes.size() - 1);
+}
+
+TriggerVolumeService::VolumeId TriggerVolumeService::addVolume(const ICollider* shape, Listener listener) {
+    if (!shape) {
+        DEBUG_LOG_WARN("Ignoring trigger volume without a shape");
+        return INVALID_VOLUME;
+    }
+
+    VolumeId id = allocateVolume();
+    Volume& volume = m_volumes[id];
+    volume.shape = shape;
+    volume.layer = shape->getCollisionLayer().layer;
+    volume.listener = std::move(listener);
+    volume.alive = true;
+
+    if (shape->getShape() == ColliderShape::Circle) {
+        const auto* circle = static_cast<const CircleCollider*>(shape);
+        volume.isCircle = true;
+        m_circles.add(circle->getCenter(), circle->getRadius(), id);
+    }
+    else {
+        volume.proxy = m_tree.createProxy(shape->getBounds(), id);
+    }
+    return id;
+}
+
+TriggerVolumeService::VolumeId TriggerVolumeService::addVolume(const Aabb& bounds, uint32_t layer, Listener listener) {
+    VolumeId id = allocateVolume();
+    Volume& volume = m_volumes[id];
+    volume.shape = nullptr;
+    volume.bounds = bounds;
+    volume.layer = layer;
+    volume.listener = std::move(listener);
+    volume.alive = true;
+    volume.proxy = m_tree.createProxy(bounds, id);
+    return id;
+}
+
+void TriggerVolumeService::removeVolume(VolumeId id) {
+    if (id >= m_volumes.size() || !m_volumes[id].alive) return;
+
+    Volume& volume = m_volumes[id];
+    if (volume.isCircle) {
+        m_circles.removeSlot(static_cast<uint32_t>(m_circles.findSlot(id)));
+    }
+    else {
+        m_tree.destroyProxy(volume.proxy);
+    }
+    volume = Volume();
+    m_freeVolumes.push_back(id);
+
+    m_pairs.erase(std::remove_if(m_pairs.begin(), m_pairs.end(),
+        [id](const Pair& pair) { return pair.volume == id; }), m_pairs.end());
+}
+
+void TriggerVolumeService::updateVolume(VolumeId id) {
+    if (id >= m_volumes.size() || !m_volumes[id].alive) return;
+
+    Volume& volume = m_volumes[id];
+    if (!volume.shape) return;
+    volume.layer = volume.shape->getCollisionLayer().layer;
+
+    if (volume.isCircle) {
+        const auto* circle = static_cast<const CircleCollider*>(volume.shape);
+        m_circles.setCircle(static_cast<uint32_t>(m_circles.findSlot(id)), circle->getCenter(), circle->getRadius());
+        return;
+    }
+
+    Aabb bounds = volume.shape->getBounds();
+    const Aabb& previous = m_tree.getBounds(volume.proxy);
+    if (bounds.min == previous.min && bounds.max == previous.max) return;
+
+    m_tree.moveProxy(volume.proxy, bounds, bounds.min - previous.min);
+}
+
+void TriggerVolumeService::addActor(const ICollider* actor) {
+    if (actor && !hasActor(actor)) {
+        m_actors.push_back(actor);
+    }
+}
+
+void TriggerVolumeService::removeActor(const ICollider* actor) {
+    auto it = std::find(m_actors.begin(), m_actors.end(), actor);
+    if (it == m_actors.end()) return;
+    m_actors.erase(it);
+
+    auto first = std::stable_partition(m_pairs.begin(), m_pairs.end(),
+        [actor](const Pair& pair) { return pair.actor != actor; });
+    std::vector<Pair> exited(first, m_pairs.end());
+    m_pairs.erase(first, m_pairs.end());
+
+    for (const auto& pair : exited) {
+        dispatch(OverlapEventType::Exit, pair);
+    }
+}
+
+bool TriggerVolumeService::hasActor(const ICollider* actor) const {
+    return std::find(m_actors.begin(), m_actors.end(), actor) != m_actors.end();
+}
+
+bool TriggerVolumeService::isOverlapping(const Volume& volume, const ICollider& actor) const {
+    if (!CollisionManager::getInstance().canLayersCollide(volume.layer, actor.getCollisionLayer().layer)) {
+        return false;
+    }
+    if (!volume.shape) {
+        return volume.bounds.overlaps(actor.getBounds());
+    }
+    return NarrowPhase::overlaps(*volume.shape, actor);
+}
+
+void TriggerVolumeService::update() {
+    m_currentPairs.clear();
+
+    // Circles: every volume against every actor's bounds in one SIMD batch
+    if (!m_circles.empty() && !m_actors.empty()) {
+        m_actorBounds.clear();
+        for (const ICollider* actor : m_actors) {
+            m_actorBounds.push_back(actor->getBounds());
+        }
+        m_circles.test(m_actorBounds.data(), m_actorBounds.size(), m_circleHits);
+
+        auto& layers = CollisionManager::getInstance();
+        for (size_t actor = 0; actor < m_actors.size(); ++actor) {
+            uint32_t actorLayer = m_actors[actor]->getCollisionLayer().layer;
+            const uint64_t* row = m_circleHits.getRow(actor);
+            for (size_t word = 0; word < m_circleHits.getWordsPerActor(); ++word) {
+                for (uint64_t bits = row[word]; bits; bits &= bits - 1) {
+                    size_t slot = word * 64 + static_cast<size_t>(countTrailingZeros(bits));
+                    VolumeId id = m_circles.getId(static_cast<uint32_t>(slot));
+                    if (layers.canLayersCollide(m_volumes[id].layer, actorLayer)) {
+                        m_currentPairs.push_back({ m_actors[actor], id });
+                    }
+                }
+            }
+        }
+    }
+
+    for (const ICollider* actor : m_actors) {
+        Aabb bounds = actor->getBounds();
+
+        m_candidates.clear();
+        m_tree.query(bounds, m_candidates);
+        for (uint32_t id : m_candidates) {
+            const Volume& volume = m_volumes[id];
+            if (!m_tree.getBounds(volume.proxy).overlaps(bounds)) continue;
+            if (isOverlapping(volume, *actor)) {
+                m_currentPairs.push_back({ actor, id });
+            }
+        }
+    }
+    std::sort(m_currentPairs.begin(), m_currentPairs.end());
+
+    // Both lists are sorted, one merge tells entered, stayed and exited apart
+    size_t previous = 0;
+    size_t current = 0;
+    while (previous < m_pairs.size() || current < m_currentPairs.size()) {
+        if (current == m_currentPairs.size() ||
+            (previous < m_pairs.size() && m_pairs[previous] < m_currentPairs[current])) {
+            dispatch(OverlapEventType::Exit, m_pairs[previous++]);
+        }
+        else if (previous == m_pairs.size() || m_currentPairs[current] < m_pairs[previous]) {
+            dispatch(OverlapEventType::Enter, m_currentPairs[current++]);
+        }
+        else {
+            dispatch(OverlapEventType::Stay, m_currentPairs[current]);
+            ++previous;
+            ++current;
+        }
+    }
+
+    m_pairs.swap(m_currentPairs);
+}
+
+void TriggerVolumeService::clear() {
+    m_tree.clear();
+    m_circles.clear();
+    m_volumes.clear();
+    m_freeVolumes.clear();
+    m_actors.clear();
+    m_pairs.clear();
+    m_currentPairs.clear();
+}
+
+void TriggerVolumeService::dispatch(OverlapEventType type, const Pair& pair) const {
+    const Volume& volume = m_volumes[pair.volume];
+    if (volume.listener) {
+        volume.listener({ type, pair.volume, pair.actor });
+    }
+}
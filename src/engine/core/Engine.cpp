@@ -9,13 +9,22 @@
 #include "../../../include/headers/input/InputMapper.h"
 #include "../../../include/headers/collision/CollisionTypes.h"
 #include "../../../include/headers/collision/BoxCollider.h"
+#include "../../../include/headers/collision/CollisionManager.h"
 #include "../../../include/headers/CommonDefines.h"
+#include "../../../include/headers/resource/HotReloadService.h"
+#include "../../../include/headers/core/JobSystem.h"
+#include "../../../include/headers/core/TaskGraph.h"
+#include "../../../include/headers/core/GameState.h"
 
 void framebuffer_size_callback(GLFWwindow* window, int width, int height) {
     Renderer::getInstance().onWindowResize(width, height);
 }
 
 bool Engine::initialize(const std::string& windowTitle, int width, int height) {
+    // Startup timeline, written out once the first game frame is on screen
+    m_startupTrace = std::make_unique<TraceRecorder>();
+    auto startupBegin = TraceRecorder::Clock::now();
+
     // Initialize GLFW
     if (!glfwInit()) {
         DEBUG_LOG_ERROR("Failed to initialize GLFW");
@@ -72,12 +81,51 @@ bool Engine::initialize(const std::string& windowTitle, int width, int height) {
             static_cast<uint32_t>(CollisionLayerBits::Door) |    // 0x0004
             static_cast<uint32_t>(CollisionLayerBits::Trigger)   // 0x0002
         );
+        m_characterController = std::make_unique<CharacterController>(*m_playerCollider);
         //DEBUG_LOG("Player collider initialized - Size: (" << colliderSize.x << ", " << colliderSize.y << ")");
     }
 
+    JobSystem::getInstance().initialize();
+
     auto& resourceManager = ResourceManager::getInstance();
     resourceManager.createResourceDirectories();
     resourceManager.initialize();
+    // Keeps the built-in layer matrix when there is no config
+    CollisionManager::getInstance().loadFromFile(ResourceManager::getConfigPath("collision_layers.json"));
+
+    // Shaders compile here, on the GL thread, because the progress screen needs them
+    Renderer::getInstance().initialize(width, height);
+    glfwSetFramebufferSizeCallback(m_window, framebuffer_size_callback);
+
+    auto* camera = Renderer::getInstance().getCamera();
+    camera->setFollowSpeed(4.0f);
+    camera->setZoom(1.0f);
+
+    m_startupTrace->addSpan("window, GL context, shaders", "main", startupBegin, TraceRecorder::Clock::now());
+
+    // Put something on screen before any asset work starts
+    m_startupScreen = std::make_unique<LoadingScreen>();
+    m_startupScreen->show("Starting...");
+    renderStartupFrame(0.0f);
+    m_startupTrace->addInstant("first loading frame");
+
+    if (!runStartupTasks()) {
+        std::cerr << "Failed to load test_area_1" << std::endl;
+        return false;
+    }
+
+    m_startupScreen.reset();
+    MapManager::getInstance().changeArea("test_area_1", glm::vec2(100.0f, 300.0f));
+
+#ifdef _DEBUG
+    HotReloadService::getInstance().start(ResourceManager::getBasePath());
+#endif
+
+    return true;
+}
+
+bool Engine::runStartupTasks() {
+    auto& resourceManager = ResourceManager::getInstance();
 
     const std::vector<std::pair<std::string, std::string>> texturesToLoad = {
         {"portal", "resources/textures/portal/portal.png"},
@@ -94,26 +142,106 @@ bool Engine::initialize(const std::string& windowTitle, int width, int height) {
     {"door", "resources/audio/sfx/door.wav"}
     };
 
-    for (const auto& [name, path] : texturesToLoad) {
+    const std::string startAreaId = "test_area_1";
+
+    // Workers decode, read and parse into these slots; the main thread tasks that
+    // depend on them do the GL uploads and irrKlang registration
+    std::vector<DecodedTexture> decodedTextures(texturesToLoad.size());
+    std::vector<std::vector<char>> soundData(soundsToLoad.size());
+    std::vector<std::string> areaIds = MapManager::findAreaIds();
+    std::vector<AreaDefinition> areaDefinitions(areaIds.size());
+    std::vector<char> areaParsed(areaIds.size(), 0);   // not vector<bool>, workers write neighbouring slots
+
+    TaskGraph graph;
+    std::vector<TaskGraph::TaskId> characterUploads;
+
+    for (size_t i = 0; i < texturesToLoad.size(); ++i) {
+        const auto& [name, path] = texturesToLoad[i];
         if (!std::filesystem::exists(path)) {
             DEBUG_LOG_WARN("Texture file not found: " << path);
             continue;
         }
-        if (!resourceManager.loadTexture(name, path)) {
-            DEBUG_LOG_ERROR("Failed to load texture: " << name);
+
+        auto decode = graph.add("decode " + name, TaskThread::Worker, [&, i]() {
+            return resourceManager.decodeTexture(resourceManager.resolvePath(texturesToLoad[i].second), decodedTextures[i]);
+        });
+        auto upload = graph.add("upload " + name, TaskThread::Main, [&, i]() {
+            bool loaded = resourceManager.loadTextureFromDecoded(texturesToLoad[i].first, texturesToLoad[i].second, decodedTextures[i]);
+            decodedTextures[i] = DecodedTexture();
+            return loaded;
+        }, { decode });
+
+        if (name == "characterwalk" || name == "characteridle") {
+            characterUploads.push_back(upload);
         }
     }
 
-    for (const auto& [name, path] : soundsToLoad) {
+    for (size_t i = 0; i < soundsToLoad.size(); ++i) {
+        const auto& [name, path] = soundsToLoad[i];
         if (!std::filesystem::exists(path)) {
             DEBUG_LOG_WARN("Sound file not found: " << path);
             continue;
         }
-        if (!resourceManager.loadSound(name, path)) {
-            DEBUG_LOG_ERROR("Failed to load sound: " << name);
+
+        auto read = graph.add("read " + name, TaskThread::Worker, [&, i]() {
+            return resourceManager.readSoundFile(soundsToLoad[i].second, soundData[i]);
+        });
+        graph.add("register " + name, TaskThread::Main, [&, i]() {
+            bool loaded = resourceManager.loadSoundFromMemory(soundsToLoad[i].first, soundsToLoad[i].second, soundData[i]);
+            soundData[i].clear();
+            return loaded;
+        }, { read });
+    }
+
+    // Every area is parsed for the portal graph, only the start area gets built.
+    // A broken file elsewhere just leaves its area out of the graph; failing the
+    // task would skip the critical build below.
+    std::vector<TaskGraph::TaskId> areaParses;
+    for (size_t i = 0; i < areaIds.size(); ++i) {
+        areaParses.push_back(graph.add("parse " + areaIds[i], TaskThread::Worker, [&, i]() {
+            areaParsed[i] = MapManager::loadAreaDefinition(areaIds[i], areaDefinitions[i]);
+            return areaParsed[i] || areaIds[i] != startAreaId;
+        }));
+    }
+
+    graph.add("build " + startAreaId, TaskThread::Main, [&]() {
+        auto& mapManager = MapManager::getInstance();
+        const AreaDefinition* startDefinition = nullptr;
+        for (size_t i = 0; i < areaIds.size(); ++i) {
+            if (!areaParsed[i]) continue;
+            mapManager.setAreaPortals(areaIds[i], areaDefinitions[i].portals);
+            if (areaIds[i] == startAreaId) {
+                startDefinition = &areaDefinitions[i];
+            }
+        }
+        std::cout << "Area graph built with " << mapManager.getAreaGraph().getAreaCount() << " areas" << std::endl;
+
+        if (!startDefinition) {
+            std::cerr << "Failed to load area definition for: " << startAreaId << std::endl;
+            return false;
         }
+        return mapManager.loadArea(startAreaId, *startDefinition);
+    }, areaParses, true);
+
+    graph.add("character animations", TaskThread::Main, [this]() {
+        setupCharacterAnimations();
+        return true;
+    }, characterUploads);
+
+    // Failed dependencies skip the animation task, it still has to run with whatever loaded
+    bool success = graph.run(m_startupTrace.get(), [this](float progress) { renderStartupFrame(progress); });
+    if (!m_animationController) {
+        setupCharacterAnimations();
     }
 
+    graph.logCriticalPath();
+    std::cout << "Startup tasks finished after " << m_startupTrace->getElapsedMs() << " ms" << std::endl;
+    return success;
+}
+
+void Engine::setupCharacterAnimations() {
+    auto& resourceManager = ResourceManager::getInstance();
+
     m_animationController = std::make_unique<AnimationController>();
     m_isWalking = false;
     m_currentState = CharacterState::Idle;
@@ -147,34 +275,23 @@ bool Engine::initialize(const std::string& windowTitle, int width, int height) {
     if (m_animationController) {
         m_animationController->playAnimation("idle");
     }
+}
 
-    Renderer::getInstance().initialize(width, height);
-
-    auto* camera = Renderer::getInstance().getCamera();
-    camera->setFollowSpeed(4.0f);
-    camera->setZoom(1.0f);
+void Engine::renderStartupFrame(float progress) {
+    glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+    glClear(GL_COLOR_BUFFER_BIT);
 
-    // load and switch to test aera
-    auto& mapManager = MapManager::getInstance();
-    if (!mapManager.loadArea("test_area_1", ResourceManager::getMapPath("test_area_1"))) {
-        std::cerr << "Failed to load test_area_1" << std::endl;
-        return false;
+    if (m_startupScreen) {
+        m_startupScreen->setProgress(progress);
+        m_startupScreen->render();
     }
-    if (!mapManager.loadArea("test_area_2", ResourceManager::getMapPath("test_area_2"))) {
-        std::cerr << "Failed to load test_area_2" << std::endl;
-        return false;
-    }
-
-    mapManager.changeArea("test_area_1", glm::vec2(100.0f, 300.0f));
-
-    glfwSetFramebufferSizeCallback(m_window, framebuffer_size_callback);
 
-    return true;
+    glfwSwapBuffers(m_window);
+    glfwPollEvents();
 }
 
 void Engine::handleMovement(float deltaTime) {
     glm::vec2 moveDirection(0.0f);
-    bool directionChanged = false;
 
     if (InputManager::getInstance().isKeyPressed(GLFW_KEY_UP))
         moveDirection.y -= 1.0f;
@@ -182,55 +299,27 @@ void Engine::handleMovement(float deltaTime) {
         moveDirection.y += 1.0f;
     if (InputManager::getInstance().isKeyPressed(GLFW_KEY_LEFT)) {
         moveDirection.x -= 1.0f;
-        bool wasFlipped = m_spriteFlipX;
         m_spriteFlipX = true;
-        directionChanged = (wasFlipped != m_spriteFlipX);
     }
     if (InputManager::getInstance().isKeyPressed(GLFW_KEY_RIGHT)) {
         moveDirection.x += 1.0f;
-        bool wasFlipped = m_spriteFlipX;
         m_spriteFlipX = false;
-        directionChanged = (wasFlipped != m_spriteFlipX);
-    }
-
-    if (glm::length(moveDirection) > 0.0f || directionChanged) {
-        if (glm::length(moveDirection) > 0.0f) {
-            moveDirection = glm::normalize(moveDirection);
-            glm::vec2 nextPosition = m_playerPosition + moveDirection * m_moveSpeed * deltaTime;
-            glm::vec2 nextColliderPos = nextPosition + getColliderOffset();
-
-            // save original position
-            glm::vec2 originalPosition = m_playerPosition;
-            glm::vec2 originalColliderPos = m_playerCollider->getPosition();
-
-            // try to move
-            m_playerCollider->setPosition(nextColliderPos);
-
-            bool canMove = true;
-            if (auto* currentArea = MapManager::getInstance().getCurrentArea()) {
-                for (const auto& [id, mechanism] : currentArea->getMechanisms()) {
-                    if (auto* mechCollider = mechanism->getCollider()) {
-                        if (m_playerCollider->isColliding(mechCollider)) {
-                            canMove = false;
-                            break;
-                        }
-                    }
-                }
-            }
+    }
 
-            if (canMove) {
-                m_playerPosition = nextPosition;
-            }
-            else {
-                m_playerPosition = originalPosition;
-                m_playerCollider->setPosition(originalColliderPos);
-            }
-        }
+    glm::vec2 delta(0.0f);
+    if (glm::length(moveDirection) > 0.0f) {
+        delta = glm::normalize(moveDirection) * m_moveSpeed * deltaTime;
+    }
 
-        // ǷƶɹҪײλ
-        glm::vec2 finalColliderPos = m_playerPosition + getColliderOffset();
-        m_playerCollider->setPosition(finalColliderPos);
+    // Runs every frame, even without input, so a door or platform that moved
+    // into the player pushes them out
+    if (auto* currentArea = MapManager::getInstance().getCurrentArea()) {
+        m_characterController->move(currentArea->getCollisionWorld(), delta);
+    }
+    else {
+        m_playerCollider->setPosition(m_playerCollider->getPosition() + delta);
     }
+    m_playerPosition = m_playerCollider->getPosition() - getColliderOffset();
 }
 
 void Engine::processInput() {
@@ -240,12 +329,12 @@ void Engine::processInput() {
 }
 
 void Engine::update(float deltaTime) {
+    // Swap in anything hot reloaded since the last frame
+    HotReloadService::getInstance().applyPendingReloads();
+
     // Update input manager
     InputManager::getInstance().update();
 
-    // Handle movement
-    handleMovement(deltaTime);
-
     // Update animation
     if (m_animationController) {
         glm::vec2 moveDirection(0.0f);
@@ -270,17 +359,24 @@ void Engine::update(float deltaTime) {
 
     MapManager::getInstance().update(deltaTime);
 
+    // Mechanisms may have moved their colliders (platforms, doors) during the updates above
+    if (auto* currentArea = MapManager::getInstance().getCurrentArea()) {
+        currentArea->syncMechanismColliders();
+    }
+
+    // Sweep the player against this frame's colliders
+    handleMovement(deltaTime);
+
     // Update camera
     glm::vec2 targetPos = m_playerPosition + m_cameraOffset;
     Renderer::getInstance().getCamera()->setTarget(targetPos);
     Renderer::getInstance().getCamera()->updateFollow(deltaTime);
 
     Renderer::getInstance().updateCamera(deltaTime);
-    // Handle collisions
-    handleCollisions();
 
-    // Handle portal transitions
+    // Overlap events for where the player ended up: triggers, then portals
     auto& mapManager = MapManager::getInstance();
+    mapManager.updateTriggerVolumes(m_playerCollider);
     if (mapManager.handlePortalTransition(m_playerCollider)) {
         std::cout << "Portal transition triggered" << std::endl;
     }
@@ -322,16 +418,8 @@ void Engine::render() {
     }
 
     if (auto* currentArea = MapManager::getInstance().getCurrentArea()) {
-        for (const auto& [id, mechanism] : currentArea->getMechanisms()) {
-            if (auto* collider = mechanism->getCollider()) {
-                glm::vec3 color;
-                if (id.find("door") != std::string::npos) {
-                    color = glm::vec3(1.0f, 0.0f, 0.0f);  // door
-                }
-                else if (id.find("trigger") != std::string::npos) {
-                    color = glm::vec3(1.0f, 1.0f, 0.0f);  // trigger
-                }
-
+        auto drawMechanism = [](const IMechanism& mechanism, const glm::vec3& color) {
+            if (auto* collider = mechanism.getCollider()) {
                 Renderer::getInstance().drawRect(
                     collider->getPosition(),
                     collider->getSize(),
@@ -339,7 +427,17 @@ void Engine::render() {
                     0.3f  // transparency
                 );
             }
-        }
+        };
+        const auto& mechanisms = currentArea->getMechanisms();
+        mechanisms.getDoors().forEach([&](const DoorMechanism& door) {
+            drawMechanism(door, glm::vec3(1.0f, 0.0f, 0.0f));
+        });
+        mechanisms.getTriggers().forEach([&](const TriggerMechanism& trigger) {
+            drawMechanism(trigger, glm::vec3(1.0f, 1.0f, 0.0f));
+        });
+        mechanisms.getMachines().forEach([&](const StateMachineMechanism& machine) {
+            drawMechanism(machine, glm::vec3(0.0f, 1.0f, 1.0f));
+        });
     }
 
     glfwSwapBuffers(m_window);
@@ -355,11 +453,29 @@ void Engine::run() {
         update(deltaTime);
         render();
 
+        if (m_startupTrace) {
+            finishStartupTrace();
+        }
+
         glfwPollEvents();
     }
 }
 
+void Engine::finishStartupTrace() {
+    m_startupTrace->addInstant("first game frame");
+    std::cout << "Time to first frame: " << m_startupTrace->getElapsedMs() << " ms" << std::endl;
+
+    std::string tracePath = ResourceManager::getInstance().resolvePath("startup_trace.json");
+    if (m_startupTrace->writeChromeTrace(tracePath)) {
+        std::cout << "Startup trace written to " << tracePath << std::endl;
+    }
+    m_startupTrace.reset();
+}
+
 void Engine::shutdown() {
+    HotReloadService::getInstance().stop();
+    JobSystem::getInstance().shutdown();
+
     if (m_window) {
         glfwDestroyWindow(m_window);
         m_window = nullptr;
@@ -367,46 +483,25 @@ void Engine::shutdown() {
     glfwTerminate();
     InputManager::getInstance().shutdown();
     Renderer::getInstance().shutdown();
+    m_characterController.reset();
     delete m_playerCollider;
+    m_playerCollider = nullptr;
     for (auto* collider : m_colliders) {
         delete collider;
     }
     m_colliders.clear();
+
+#ifdef _DEBUG
+    CollisionManager::getInstance().logPairTestCounts();
+#endif
 }
 
-void Engine::handleCollisions() {
+ExpressionEnvironment Engine::getExpressionEnvironment() const {
     if (!m_playerCollider) {
-        DEBUG_LOG_ERROR("Player collider is null!");
-        return;
-    }
-
-    const glm::vec2 SPRITE_SIZE(100.0f, 64.0f);
-    const float COLLIDER_SCALE = 0.7f;
-    glm::vec2 colliderSize = SPRITE_SIZE * COLLIDER_SCALE;
-    glm::vec2 colliderOffset = (SPRITE_SIZE - colliderSize) * 0.5f;
-
-    if (auto* currentArea = MapManager::getInstance().getCurrentArea()) {
-        for (const auto& [id, mechanism] : currentArea->getMechanisms()) {
-            if (auto* mechCollider = mechanism->getCollider()) {
-                CollisionManifold manifold = m_playerCollider->checkCollision(mechCollider);
-                if (manifold.hasCollision) {
-                    //DEBUG_LOG("Collision detected with mechanism: " << id);
-                    m_playerPosition += manifold.normal * manifold.penetration;
-                    m_playerCollider->setPosition(m_playerPosition + colliderOffset);
-                }
-            }
-        }
-    }
-
-    for (const auto* collider : m_colliders) {
-        if (collider == m_playerCollider) continue;
-
-        CollisionManifold manifold = m_playerCollider->checkCollision(collider);
-        if (manifold.hasCollision) {
-            m_playerPosition += manifold.normal * manifold.penetration;
-            m_playerCollider->setPosition(m_playerPosition + colliderOffset);
-        }
+        return ExpressionEnvironment::capture(GameState::getInstance(), nullptr);
     }
+    glm::vec2 center = m_playerCollider->getPosition() + m_playerCollider->getSize() * 0.5f;
+    return ExpressionEnvironment::capture(GameState::getInstance(), &center);
 }
 
 BoxCollider* Engine::getPlayerCollider() {
@@ -419,6 +514,13 @@ BoxCollider* Engine::getPlayerCollider() {
     return m_playerCollider;
 }
 
+void Engine::setPlayerPosition(const glm::vec2& position) {
+    m_playerPosition = position;
+    if (m_playerCollider) {
+        m_playerCollider->setPosition(position + getColliderOffset());
+    }
+}
+
 glm::vec2 Engine::getColliderOffset() const {
     return glm::vec2(
         (SPRITE_SIZE.x - COLLIDER_SIZE.x) * 0.5f,  // ˮƽ
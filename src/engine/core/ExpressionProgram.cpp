@@ -0,0 +1,485 @@
+#include "../../../include/headers/core/ExpressionProgram.h"
+#include "../../../include/headers/core/GameState.h"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+
+namespace {
+    float applyUnary(ExpressionOp op, float value) {
+        switch (op) {
+        case ExpressionOp::Neg: return -value;
+        case ExpressionOp::Not: return value == 0.0f ? 1.0f : 0.0f;
+        case ExpressionOp::Abs: return std::fabs(value);
+        case ExpressionOp::Bool: return value != 0.0f ? 1.0f : 0.0f;
+        default: return 0.0f;
+        }
+    }
+
+    float applyBinary(ExpressionOp op, float lhs, float rhs) {
+        switch (op) {
+        case ExpressionOp::Add: return lhs + rhs;
+        case ExpressionOp::Sub: return lhs - rhs;
+        case ExpressionOp::Mul: return lhs * rhs;
+        case ExpressionOp::Div: return rhs != 0.0f ? lhs / rhs : 0.0f;
+        case ExpressionOp::Min: return std::min(lhs, rhs);
+        case ExpressionOp::Max: return std::max(lhs, rhs);
+        case ExpressionOp::Less: return lhs < rhs ? 1.0f : 0.0f;
+        case ExpressionOp::LessEqual: return lhs <= rhs ? 1.0f : 0.0f;
+        case ExpressionOp::Greater: return lhs > rhs ? 1.0f : 0.0f;
+        case ExpressionOp::GreaterEqual: return lhs >= rhs ? 1.0f : 0.0f;
+        case ExpressionOp::Equal: return lhs == rhs ? 1.0f : 0.0f;
+        case ExpressionOp::NotEqual: return lhs != rhs ? 1.0f : 0.0f;
+        default: return 0.0f;
+        }
+    }
+
+    float distanceToPlayer(const ExpressionEnvironment& environment, const ExpressionContext& context) {
+        if (!environment.hasPlayer) return std::numeric_limits<float>::max();
+        return glm::length(environment.playerPosition - context.origin);
+    }
+}
+
+// Recursive descent over the source, folding constants as nodes are built,
+// then one pass that assigns registers by nesting depth.
+class ExpressionCompiler {
+public:
+    explicit ExpressionCompiler(const std::string& source) : m_source(source) {}
+
+    std::shared_ptr<const ExpressionProgram> compile(std::string* outError) {
+        auto program = std::make_shared<ExpressionProgram>();
+        program->m_source = m_source;
+        m_program = program.get();
+
+        int root = -1;
+        if (m_source.size() > ExpressionProgram::MAX_SOURCE_LENGTH) {
+            fail("expression is longer than " + std::to_string(ExpressionProgram::MAX_SOURCE_LENGTH) + " characters");
+        }
+        else {
+            next();
+            root = parseExpression(0);
+            if (m_error.empty() && m_token.kind != TokenKind::End) {
+                fail("unexpected '" + m_token.text + "'");
+            }
+        }
+
+        if (m_error.empty()) {
+            const Node& node = m_nodes[root];
+            program->m_isConstant = node.kind == NodeKind::Const;
+            program->m_constantValue = node.value;
+            emit(root, 0);
+            push(ExpressionOp::Return, 0);
+            if (program->m_code.size() > ExpressionProgram::MAX_INSTRUCTIONS) {
+                fail("needs " + std::to_string(program->m_code.size()) + " instructions, the budget is " +
+                    std::to_string(ExpressionProgram::MAX_INSTRUCTIONS));
+            }
+        }
+
+        if (!m_error.empty()) {
+            if (outError) *outError = m_error;
+            return nullptr;
+        }
+        return program;
+    }
+
+private:
+    enum class TokenKind { End, Number, String, Name, Symbol };
+
+    struct Token {
+        TokenKind kind = TokenKind::End;
+        std::string text;
+        float number = 0.0f;
+    };
+
+    enum class NodeKind { Const, Var, Input, Unary, Binary, And, Or };
+
+    struct Node {
+        NodeKind kind;
+        ExpressionOp op = ExpressionOp::Return;
+        float value = 0.0f;
+        int lhs = -1;
+        int rhs = -1;
+        uint32_t var = 0;
+    };
+
+    struct Operator {
+        const char* symbol;
+        int precedence;
+        NodeKind kind;
+        ExpressionOp op;
+    };
+
+    static constexpr Operator BINARY_OPERATORS[] = {
+        { "||", 1, NodeKind::Or, ExpressionOp::Return },
+        { "&&", 2, NodeKind::And, ExpressionOp::Return },
+        { "==", 3, NodeKind::Binary, ExpressionOp::Equal },
+        { "!=", 3, NodeKind::Binary, ExpressionOp::NotEqual },
+        { "<=", 4, NodeKind::Binary, ExpressionOp::LessEqual },
+        { ">=", 4, NodeKind::Binary, ExpressionOp::GreaterEqual },
+        { "<", 4, NodeKind::Binary, ExpressionOp::Less },
+        { ">", 4, NodeKind::Binary, ExpressionOp::Greater },
+        { "+", 5, NodeKind::Binary, ExpressionOp::Add },
+        { "-", 5, NodeKind::Binary, ExpressionOp::Sub },
+        { "*", 6, NodeKind::Binary, ExpressionOp::Mul },
+        { "/", 6, NodeKind::Binary, ExpressionOp::Div }
+    };
+
+    const std::string& m_source;
+    size_t m_pos = 0;
+    Token m_token;
+    std::vector<Node> m_nodes;
+    ExpressionProgram* m_program = nullptr;
+    std::string m_error;
+
+    void fail(const std::string& message) {
+        if (m_error.empty()) m_error = message;
+    }
+
+    void next() {
+        while (m_pos < m_source.size() && std::isspace(static_cast<unsigned char>(m_source[m_pos]))) ++m_pos;
+
+        m_token = Token();
+        if (m_pos >= m_source.size()) return;
+
+        char c = m_source[m_pos];
+        if (std::isdigit(static_cast<unsigned char>(c)) || c == '.') {
+            const char* begin = m_source.c_str() + m_pos;
+            char* end = nullptr;
+            m_token.kind = TokenKind::Number;
+            m_token.number = std::strtof(begin, &end);
+            if (end == begin) {
+                fail("malformed number");
+                m_pos = m_source.size();
+                return;
+            }
+            m_token.text.assign(begin, end - begin);
+            m_pos += end - begin;
+        }
+        else if (std::isalpha(static_cast<unsigned char>(c)) || c == '_') {
+            size_t start = m_pos;
+            while (m_pos < m_source.size() &&
+                (std::isalnum(static_cast<unsigned char>(m_source[m_pos])) || m_source[m_pos] == '_')) {
+                ++m_pos;
+            }
+            m_token.kind = TokenKind::Name;
+            m_token.text = m_source.substr(start, m_pos - start);
+        }
+        else if (c == '"' || c == '\'') {
+            size_t end = m_source.find(c, m_pos + 1);
+            if (end == std::string::npos) {
+                fail("unterminated string");
+                m_pos = m_source.size();
+                return;
+            }
+            m_token.kind = TokenKind::String;
+            m_token.text = m_source.substr(m_pos + 1, end - m_pos - 1);
+            m_pos = end + 1;
+        }
+        else {
+            static const char* TWO_CHARACTER[] = { "||", "&&", "==", "!=", "<=", ">=" };
+            m_token.kind = TokenKind::Symbol;
+            m_token.text = std::string(1, c);
+            for (const char* symbol : TWO_CHARACTER) {
+                if (m_source.compare(m_pos, 2, symbol) == 0) {
+                    m_token.text = symbol;
+                    break;
+                }
+            }
+            m_pos += m_token.text.size();
+        }
+    }
+
+    bool accept(const char* symbol) {
+        if (m_token.kind == TokenKind::Symbol && m_token.text == symbol) {
+            next();
+            return true;
+        }
+        return false;
+    }
+
+    void expect(const char* symbol) {
+        if (!accept(symbol)) fail(std::string("expected '") + symbol + "'");
+    }
+
+    int add(const Node& node) {
+        m_nodes.push_back(node);
+        return static_cast<int>(m_nodes.size()) - 1;
+    }
+
+    int constant(float value) {
+        Node node{ NodeKind::Const };
+        node.value = value;
+        return add(node);
+    }
+
+    bool isConst(int index) const { return m_nodes[index].kind == NodeKind::Const; }
+
+    int unary(ExpressionOp op, int operand) {
+        if (isConst(operand)) return constant(applyUnary(op, m_nodes[operand].value));
+
+        Node node{ NodeKind::Unary, op };
+        node.lhs = operand;
+        return add(node);
+    }
+
+    int binary(NodeKind kind, ExpressionOp op, int lhs, int rhs) {
+        if (kind == NodeKind::Binary) {
+            if (isConst(lhs) && isConst(rhs)) return constant(applyBinary(op, m_nodes[lhs].value, m_nodes[rhs].value));
+        }
+        else if (isConst(lhs)) {
+            // A constant left side decides the result or drops out
+            bool truthy = m_nodes[lhs].value != 0.0f;
+            if (kind == NodeKind::And && !truthy) return constant(0.0f);
+            if (kind == NodeKind::Or && truthy) return constant(1.0f);
+            return unary(ExpressionOp::Bool, rhs);
+        }
+
+        Node node{ kind, op };
+        node.lhs = lhs;
+        node.rhs = rhs;
+        return add(node);
+    }
+
+    int parseExpression(int minPrecedence) {
+        int lhs = parseUnary();
+        while (m_error.empty() && m_token.kind == TokenKind::Symbol) {
+            const Operator* match = nullptr;
+            for (const auto& candidate : BINARY_OPERATORS) {
+                if (m_token.text == candidate.symbol) {
+                    match = &candidate;
+                    break;
+                }
+            }
+            if (!match || match->precedence <= minPrecedence) break;
+
+            next();
+            int rhs = parseExpression(match->precedence);
+            if (!m_error.empty()) break;
+            lhs = binary(match->kind, match->op, lhs, rhs);
+        }
+        return lhs;
+    }
+
+    int parseUnary() {
+        if (accept("!")) return unary(ExpressionOp::Not, parseUnary());
+        if (accept("-")) return unary(ExpressionOp::Neg, parseUnary());
+        return parsePrimary();
+    }
+
+    int parsePrimary() {
+        if (m_token.kind == TokenKind::Number) {
+            float value = m_token.number;
+            next();
+            return constant(value);
+        }
+        if (accept("(")) {
+            int inner = parseExpression(0);
+            expect(")");
+            return inner;
+        }
+        if (m_token.kind != TokenKind::Name) {
+            fail(m_token.kind == TokenKind::End ? "unexpected end of expression" : "unexpected '" + m_token.text + "'");
+            return constant(0.0f);
+        }
+
+        std::string name = m_token.text;
+        next();
+        if (m_token.kind == TokenKind::Symbol && m_token.text == "(") {
+            next();
+            return parseCall(name);
+        }
+
+        if (name == "true") return constant(1.0f);
+        if (name == "false") return constant(0.0f);
+        if (name == "level") return variable("level");
+        if (name == "distance") return input(ExpressionOp::LoadDistance);
+        if (name == "time") return input(ExpressionOp::LoadTime);
+        if (name == "occupied") return input(ExpressionOp::LoadOccupied);
+
+        fail("unknown name '" + name + "'");
+        return constant(0.0f);
+    }
+
+    int parseCall(const std::string& name) {
+        if (name == "key" || name == "quest" || name == "flag" || name == "counter") {
+            if (m_token.kind != TokenKind::String) {
+                fail(name + "() takes a quoted name");
+                return constant(0.0f);
+            }
+            std::string argument = m_token.text;
+            next();
+            expect(")");
+
+            if (name == "key") return variable(GameState::keyName(argument));
+            if (name == "quest") return variable(GameState::questName(argument));
+            if (name == "flag") return variable(GameState::flagName(argument));
+            return variable(GameState::counterName(argument));
+        }
+
+        if (name == "abs") {
+            int operand = parseExpression(0);
+            expect(")");
+            return unary(ExpressionOp::Abs, operand);
+        }
+
+        if (name == "min" || name == "max") {
+            int lhs = parseExpression(0);
+            expect(",");
+            int rhs = parseExpression(0);
+            expect(")");
+            return binary(NodeKind::Binary, name == "min" ? ExpressionOp::Min : ExpressionOp::Max, lhs, rhs);
+        }
+
+        fail("unknown function '" + name + "'");
+        return constant(0.0f);
+    }
+
+    int variable(const std::string& name) {
+        Node node{ NodeKind::Var };
+        node.var = GameState::getInstance().intern(name);
+        return add(node);
+    }
+
+    int input(ExpressionOp op) {
+        m_program->m_readsContext = true;
+        return add(Node{ NodeKind::Input, op });
+    }
+
+    void push(ExpressionOp op, size_t dst, size_t a = 0, size_t b = 0) {
+        m_program->m_code.push_back({ op, static_cast<uint8_t>(dst), static_cast<uint8_t>(a), static_cast<uint8_t>(b) });
+    }
+
+    size_t poolIndex(std::vector<float>& pool, float value) {
+        auto it = std::find(pool.begin(), pool.end(), value);
+        if (it != pool.end()) return it - pool.begin();
+        pool.push_back(value);
+        return pool.size() - 1;
+    }
+
+    size_t varIndex(uint32_t var) {
+        auto& vars = m_program->m_vars;
+        auto it = std::find(vars.begin(), vars.end(), var);
+        if (it != vars.end()) return it - vars.begin();
+        vars.push_back(var);
+        return vars.size() - 1;
+    }
+
+    void emit(int index, size_t reg) {
+        if (!m_error.empty()) return;
+        if (reg >= ExpressionProgram::MAX_REGISTERS) {
+            fail("nested too deeply, at most " + std::to_string(ExpressionProgram::MAX_REGISTERS) + " registers");
+            return;
+        }
+        // Beyond the budget the program is rejected anyway, and the 8 bit operands could wrap
+        if (m_program->m_code.size() > ExpressionProgram::MAX_INSTRUCTIONS) return;
+
+        const Node node = m_nodes[index];
+        switch (node.kind) {
+        case NodeKind::Const:
+            push(ExpressionOp::LoadConst, reg, poolIndex(m_program->m_constants, node.value));
+            break;
+        case NodeKind::Var:
+            push(ExpressionOp::LoadVar, reg, varIndex(node.var));
+            break;
+        case NodeKind::Input:
+            push(node.op, reg);
+            break;
+        case NodeKind::Unary:
+            emit(node.lhs, reg);
+            push(node.op, reg, reg);
+            break;
+        case NodeKind::Binary:
+            emit(node.lhs, reg);
+            emit(node.rhs, reg + 1);
+            push(node.op, reg, reg, reg + 1);
+            break;
+        case NodeKind::And:
+        case NodeKind::Or: {
+            // Short circuit: the left value, already 0 or 1, is the result when the jump is taken
+            emit(node.lhs, reg);
+            push(ExpressionOp::Bool, reg, reg);
+            size_t jump = m_program->m_code.size();
+            push(node.kind == NodeKind::And ? ExpressionOp::JumpIfFalse : ExpressionOp::JumpIfTrue, reg);
+            emit(node.rhs, reg);
+            push(ExpressionOp::Bool, reg, reg);
+            m_program->m_code[jump].a = static_cast<uint8_t>(std::min<size_t>(m_program->m_code.size() - jump - 1, 255));
+            break;
+        }
+        }
+    }
+};
+
+constexpr ExpressionCompiler::Operator ExpressionCompiler::BINARY_OPERATORS[];
+
+ExpressionEnvironment ExpressionEnvironment::capture(const GameState& state, const glm::vec2* playerPosition) {
+    ExpressionEnvironment environment;
+    environment.values = state.getValues();
+    environment.valueCount = state.getValueCount();
+    if (playerPosition) {
+        environment.playerPosition = *playerPosition;
+        environment.hasPlayer = true;
+    }
+    return environment;
+}
+
+std::shared_ptr<const ExpressionProgram> ExpressionProgram::compile(const std::string& source, std::string* outError) {
+    return ExpressionCompiler(source).compile(outError);
+}
+
+float ExpressionProgram::evaluate(const ExpressionEnvironment& environment, const ExpressionContext& context) const {
+    if (m_isConstant) return m_constantValue;
+
+    float r[MAX_REGISTERS];
+    const size_t size = m_code.size();
+    size_t pc = 0;
+
+    // Jumps only go forward, so this is at most one pass over the code
+    while (pc < size) {
+        const ExpressionInstruction& in = m_code[pc++];
+        switch (in.op) {
+        case ExpressionOp::LoadConst:
+            r[in.dst] = m_constants[in.a];
+            break;
+        case ExpressionOp::LoadVar: {
+            uint32_t var = m_vars[in.a];
+            r[in.dst] = var < environment.valueCount ? environment.values[var] : 0.0f;
+            break;
+        }
+        case ExpressionOp::LoadDistance:
+            r[in.dst] = distanceToPlayer(environment, context);
+            break;
+        case ExpressionOp::LoadTime:
+            r[in.dst] = context.time;
+            break;
+        case ExpressionOp::LoadOccupied:
+            r[in.dst] = context.occupied ? 1.0f : 0.0f;
+            break;
+        case ExpressionOp::Neg:
+        case ExpressionOp::Not:
+        case ExpressionOp::Abs:
+        case ExpressionOp::Bool:
+            r[in.dst] = applyUnary(in.op, r[in.a]);
+            break;
+        case ExpressionOp::JumpIfFalse:
+            if (r[in.dst] == 0.0f) pc += in.a;
+            break;
+        case ExpressionOp::JumpIfTrue:
+            if (r[in.dst] != 0.0f) pc += in.a;
+            break;
+        case ExpressionOp::Return:
+            return r[in.dst];
+        default:
+            r[in.dst] = applyBinary(in.op, r[in.a], r[in.b]);
+            break;
+        }
+    }
+    return 0.0f;
+}
+
+void ExpressionProgram::evaluateBatch(const ExpressionEnvironment& environment, const ExpressionProgram* const* programs,
+    const ExpressionContext* contexts, size_t count, uint8_t* outResults) {
+    for (size_t i = 0; i < count; ++i) {
+        outResults[i] = programs[i] && programs[i]->evaluate(environment, contexts[i]) != 0.0f ? 1 : 0;
+    }
+}
@@ -0,0 +1,55 @@
+#include "../../../include/headers/core/GameState.h"
+#include <algorithm>
+
+GameState::VarId GameState::intern(const std::string& name) {
+    auto it = m_ids.find(name);
+    if (it != m_ids.end()) {
+        return it->second;
+    }
+
+    VarId id = static_cast<VarId>(m_values.size());
+    m_ids.emplace(name, id);
+    m_names.push_back(name);
+    m_values.push_back(0.0f);
+    return id;
+}
+
+void GameState::setValue(VarId id, float value) {
+    if (id >= m_values.size() || m_values[id] == value) return;
+
+    m_values[id] = value;
+    ++m_revision;
+    notifyChanged(id);
+}
+
+float GameState::getValue(const std::string& name) const {
+    auto it = m_ids.find(name);
+    return it != m_ids.end() ? m_values[it->second] : 0.0f;
+}
+
+void GameState::reset() {
+    ++m_revision;
+    for (VarId id = 0; id < m_values.size(); ++id) {
+        if (m_values[id] != 0.0f) {
+            m_values[id] = 0.0f;
+            notifyChanged(id);
+        }
+    }
+}
+
+GameState::ListenerId GameState::addChangeListener(ChangeListener listener) {
+    ListenerId id = m_nextListener++;
+    m_listeners.emplace_back(id, std::move(listener));
+    return id;
+}
+
+void GameState::removeChangeListener(ListenerId id) {
+    m_listeners.erase(std::remove_if(m_listeners.begin(), m_listeners.end(),
+        [id](const auto& entry) { return entry.first == id; }), m_listeners.end());
+}
+
+void GameState::notifyChanged(VarId id) {
+    for (const auto& [listenerId, listener] : m_listeners) {
+        listener(id);
+    }
+}
@@ -0,0 +1,137 @@
+#include "../../../include/headers/core/JobSystem.h"
+#include "../../../include/headers/CommonDefines.h"
+#include <algorithm>
+#include <chrono>
+#include <memory>
+
+void JobSystem::initialize(size_t workerCount) {
+    if (!m_workers.empty()) return;
+
+    if (workerCount == 0) {
+        unsigned int hardwareThreads = std::thread::hardware_concurrency();
+        workerCount = hardwareThreads > 1 ? hardwareThreads - 1 : 1;
+    }
+
+    m_stopping = false;
+    m_workers.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; ++i) {
+        m_workers.emplace_back(&JobSystem::workerLoop, this);
+    }
+    DEBUG_LOG("JobSystem started " << workerCount << " workers");
+}
+
+void JobSystem::shutdown() {
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_workers.empty()) return;
+        m_stopping = true;
+    }
+    m_condition.notify_all();
+
+    for (auto& worker : m_workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    m_workers.clear();
+
+    // Queued jobs that never ran are dropped
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_queue = {};
+}
+
+void JobSystem::submit(Job job, int priority) {
+    if (m_workers.empty()) {
+        job();
+        return;
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_queue.push({ priority, m_sequence++, std::move(job) });
+    }
+    m_condition.notify_one();
+}
+
+void JobSystem::workerLoop() {
+    for (;;) {
+        Job job;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_condition.wait(lock, [this]() { return m_stopping || !m_queue.empty(); });
+            if (m_stopping) return;
+
+            job = std::move(const_cast<QueuedJob&>(m_queue.top()).job);
+            m_queue.pop();
+        }
+        job();
+    }
+}
+
+void JobSystem::parallelFor(size_t count, size_t grainSize,
+    const std::function<void(size_t begin, size_t end)>& fn) {
+    if (count == 0) return;
+    grainSize = std::max<size_t>(grainSize, 1);
+
+    size_t chunkCount = (count + grainSize - 1) / grainSize;
+    if (m_workers.empty() || chunkCount == 1) {
+        fn(0, count);
+        return;
+    }
+
+    struct ParallelState {
+        std::atomic<size_t> nextChunk{ 0 };
+        std::atomic<size_t> finishedChunks{ 0 };
+    };
+    auto state = std::make_shared<ParallelState>();
+
+    // Helpers that start after the caller finished everything simply find no chunk left,
+    // so fn is only ever called while the caller is still waiting
+    auto runChunks = [state, &fn, count, grainSize, chunkCount]() {
+        for (;;) {
+            size_t chunk = state->nextChunk.fetch_add(1);
+            if (chunk >= chunkCount) return;
+
+            size_t begin = chunk * grainSize;
+            fn(begin, std::min(begin + grainSize, count));
+            state->finishedChunks.fetch_add(1, std::memory_order_release);
+        }
+    };
+
+    size_t helpers = std::min(m_workers.size(), chunkCount - 1);
+    for (size_t i = 0; i < helpers; ++i) {
+        submit(runChunks, -1);
+    }
+
+    runChunks();
+    while (state->finishedChunks.load(std::memory_order_acquire) < chunkCount) {
+        std::this_thread::yield();
+    }
+}
+
+void JobSystem::submitMainThread(Job job) {
+    std::lock_guard<std::mutex> lock(m_mainThreadMutex);
+    m_mainThreadJobs.push_back(std::move(job));
+}
+
+size_t JobSystem::runMainThreadJobs(double budgetMs) {
+    auto start = std::chrono::steady_clock::now();
+    size_t executed = 0;
+
+    for (;;) {
+        Job job;
+        {
+            std::lock_guard<std::mutex> lock(m_mainThreadMutex);
+            if (m_mainThreadJobs.empty()) break;
+            job = std::move(m_mainThreadJobs.front());
+            m_mainThreadJobs.pop_front();
+        }
+
+        job();
+        ++executed;
+
+        double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (elapsedMs >= budgetMs) break;
+    }
+    return executed;
+}
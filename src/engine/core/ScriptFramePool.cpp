@@ -0,0 +1,39 @@
+#include "../../../include/headers/core/ScriptFramePool.h"
+#include <new>
+
+void* ScriptFramePool::allocate(size_t size) {
+    ++m_liveFrames;
+    if (size == 0 || size > MAX_POOLED_SIZE) {
+        return ::operator new(size);
+    }
+
+    size_t index = sizeClass(size);
+    if (FreeFrame* frame = m_free[index]) {
+        m_free[index] = frame->next;
+        return frame;
+    }
+
+    size_t bytes = (index + 1) * SIZE_CLASS;
+    if (m_blockUsed + bytes > BLOCK_SIZE) {
+        // The tail of the old block is dropped, at most one frame's worth
+        m_blocks.push_back(std::make_unique<std::byte[]>(BLOCK_SIZE));
+        m_blockUsed = 0;
+    }
+    void* frame = m_blocks.back().get() + m_blockUsed;
+    m_blockUsed += bytes;
+    return frame;
+}
+
+void ScriptFramePool::deallocate(void* frame, size_t size) {
+    if (!frame) return;
+    --m_liveFrames;
+    if (size == 0 || size > MAX_POOLED_SIZE) {
+        ::operator delete(frame);
+        return;
+    }
+
+    size_t index = sizeClass(size);
+    auto* free = static_cast<FreeFrame*>(frame);
+    free->next = m_free[index];
+    m_free[index] = free;
+}
@@ -0,0 +1,196 @@
+#include "../../../include/headers/core/ScriptScheduler.h"
+#include <algorithm>
+
+void ScriptDelay::await_suspend(ScriptTask::Handle handle) const {
+    handle.promise().scheduler->sleep(handle, seconds);
+}
+
+ScriptSignal::ScriptSignal(ScriptSignal&& other) noexcept
+    : m_waiters(std::move(other.m_waiters)) {
+    other.m_waiters.clear();
+    adoptWaiters();
+}
+
+ScriptSignal& ScriptSignal::operator=(ScriptSignal&& other) noexcept {
+    if (this != &other) {
+        for (auto waiter : m_waiters) {
+            waiter.promise().signal = nullptr;
+        }
+        m_waiters = std::move(other.m_waiters);
+        other.m_waiters.clear();
+        adoptWaiters();
+    }
+    return *this;
+}
+
+ScriptSignal::~ScriptSignal() {
+    // Waiters stay suspended until their owner cancels them
+    for (auto waiter : m_waiters) {
+        waiter.promise().signal = nullptr;
+    }
+}
+
+void ScriptSignal::notify() {
+    if (m_waiters.empty()) return;
+
+    std::vector<ScriptTask::Handle> waiters;
+    waiters.swap(m_waiters);
+    for (auto waiter : waiters) {
+        waiter.promise().signal = nullptr;
+        waiter.promise().scheduler->makeReady(waiter);
+    }
+}
+
+void ScriptSignal::Awaiter::await_suspend(ScriptTask::Handle handle) {
+    handle.promise().signal = &signal;
+    signal.m_waiters.push_back(handle);
+}
+
+void ScriptSignal::detach(ScriptTask::Handle handle) {
+    auto it = std::find(m_waiters.begin(), m_waiters.end(), handle);
+    if (it != m_waiters.end()) {
+        *it = m_waiters.back();
+        m_waiters.pop_back();
+    }
+}
+
+void ScriptSignal::adoptWaiters() {
+    for (auto waiter : m_waiters) {
+        waiter.promise().signal = this;
+    }
+}
+
+ScriptScheduler::ScriptId ScriptScheduler::start(ScriptTask task, const void* owner) {
+    ScriptTask::Handle handle = task.release();
+    if (!handle) return INVALID_SCRIPT;
+
+    uint32_t slot;
+    if (!m_freeSlots.empty()) {
+        slot = m_freeSlots.back();
+        m_freeSlots.pop_back();
+    }
+    else {
+        slot = static_cast<uint32_t>(m_slots.size());
+        m_slots.emplace_back();
+    }
+
+    Slot& entry = m_slots[slot];
+    entry.handle = handle;
+    entry.owner = owner;
+    entry.cancelled = false;
+    ++m_scriptCount;
+
+    auto& promise = handle.promise();
+    promise.scheduler = this;
+    promise.slot = slot;
+    promise.generation = entry.generation;
+
+    ScriptId id = makeId(slot, entry.generation);
+    resume(id);
+    return isRunning(id) ? id : INVALID_SCRIPT;
+}
+
+bool ScriptScheduler::cancel(ScriptId id) {
+    if (!findSlot(id)) return false;
+
+    uint32_t slot = static_cast<uint32_t>(id & 0xFFFFFFFFu);
+    if (m_slots[slot].handle == m_current) {
+        m_slots[slot].cancelled = true;
+        return true;
+    }
+    destroy(slot);
+    return true;
+}
+
+size_t ScriptScheduler::cancelOwned(const void* owner) {
+    if (!owner) return 0;
+
+    size_t cancelled = 0;
+    for (uint32_t slot = 0; slot < m_slots.size(); ++slot) {
+        if (m_slots[slot].handle && m_slots[slot].owner == owner) {
+            cancel(makeId(slot, m_slots[slot].generation));
+            ++cancelled;
+        }
+    }
+    return cancelled;
+}
+
+void ScriptScheduler::update(float deltaTime) {
+    m_fired.clear();
+    m_timers.advance(deltaTime, m_fired);
+    for (void* payload : m_fired) {
+        auto handle = ScriptTask::Handle::from_address(payload);
+        handle.promise().timer = TimerWheel::INVALID_TIMER;
+        makeReady(handle);
+    }
+    if (m_ready.empty()) return;
+
+    // Scripts signalled while these run wait for the next update
+    m_resuming.swap(m_ready);
+    for (ScriptId id : m_resuming) {
+        resume(id);
+    }
+    m_resuming.clear();
+}
+
+void ScriptScheduler::clear() {
+    for (uint32_t slot = 0; slot < m_slots.size(); ++slot) {
+        if (m_slots[slot].handle) {
+            destroy(slot);
+        }
+    }
+    m_timers.clear();
+    m_ready.clear();
+}
+
+const ScriptScheduler::Slot* ScriptScheduler::findSlot(ScriptId id) const {
+    uint32_t slot = static_cast<uint32_t>(id & 0xFFFFFFFFu);
+    uint32_t generation = static_cast<uint32_t>(id >> 32);
+    if (slot >= m_slots.size()) return nullptr;
+
+    const Slot& entry = m_slots[slot];
+    return entry.handle && entry.generation == generation ? &entry : nullptr;
+}
+
+void ScriptScheduler::sleep(ScriptTask::Handle handle, float seconds) {
+    handle.promise().timer = m_timers.schedule(seconds, handle.address());
+}
+
+void ScriptScheduler::makeReady(ScriptTask::Handle handle) {
+    const auto& promise = handle.promise();
+    m_ready.push_back(makeId(promise.slot, promise.generation));
+}
+
+void ScriptScheduler::resume(ScriptId id) {
+    // Stale ids belong to scripts cancelled after they became ready
+    if (!findSlot(id)) return;
+
+    uint32_t slot = static_cast<uint32_t>(id & 0xFFFFFFFFu);
+    ScriptTask::Handle handle = m_slots[slot].handle;
+    ScriptTask::Handle previous = std::exchange(m_current, handle);
+    handle.resume();
+    m_current = previous;
+
+    if (handle.done() || m_slots[slot].cancelled) {
+        destroy(slot);
+    }
+}
+
+void ScriptScheduler::destroy(uint32_t slot) {
+    Slot& entry = m_slots[slot];
+    auto& promise = entry.handle.promise();
+    if (promise.timer != TimerWheel::INVALID_TIMER) {
+        m_timers.cancel(promise.timer);
+    }
+    if (promise.signal) {
+        promise.signal->detach(entry.handle);
+    }
+
+    entry.handle.destroy();
+    entry.handle = nullptr;
+    entry.owner = nullptr;
+    entry.cancelled = false;
+    ++entry.generation;
+    m_freeSlots.push_back(slot);
+    --m_scriptCount;
+}
@@ -0,0 +1,166 @@
+#include "../../../include/headers/core/TaskGraph.h"
+#include "../../../include/headers/core/JobSystem.h"
+#include "../../../include/headers/CommonDefines.h"
+#include <deque>
+#include <iostream>
+
+TaskGraph::TaskId TaskGraph::add(const std::string& name, TaskThread thread, TaskFunction fn,
+    const std::vector<TaskId>& dependencies, bool critical) {
+    TaskId id = m_tasks.size();
+
+    Task task;
+    task.name = name;
+    task.thread = thread;
+    task.fn = std::move(fn);
+    task.dependencies = dependencies;
+    task.critical = critical;
+    task.remainingDependencies = dependencies.size();
+    m_tasks.push_back(std::move(task));
+
+    for (TaskId dependency : dependencies) {
+        m_tasks[dependency].dependents.push_back(id);
+    }
+    return id;
+}
+
+bool TaskGraph::execute(Task& task, TraceRecorder* trace) {
+    task.start = TraceRecorder::Clock::now();
+    bool success = task.fn ? task.fn() : true;
+    task.end = TraceRecorder::Clock::now();
+
+    if (trace) {
+        trace->addSpan(task.name, task.thread == TaskThread::Main ? "main" : "worker", task.start, task.end);
+    }
+    if (!success) {
+        DEBUG_LOG_WARN("Startup task failed: " << task.name);
+    }
+    return success;
+}
+
+bool TaskGraph::run(TraceRecorder* trace, const std::function<void(float)>& pump) {
+    std::deque<TaskId> mainReady;
+    size_t finished = 0;
+    bool criticalFailed = false;
+
+    // Tasks are handed out from here only, workers just report back through m_completed
+    std::function<void(TaskId)> schedule = [&](TaskId id) {
+        Task& task = m_tasks[id];
+        if (task.dependencyFailed) {
+            task.state = TaskState::Skipped;
+            if (task.critical) criticalFailed = true;
+            std::lock_guard<std::mutex> lock(m_completedMutex);
+            m_completed.push_back(id);
+            return;
+        }
+
+        if (task.thread == TaskThread::Main) {
+            mainReady.push_back(id);
+            return;
+        }
+
+        JobSystem::getInstance().submit([this, id, trace]() {
+            Task& workerTask = m_tasks[id];
+            bool success = execute(workerTask, trace);
+            {
+                std::lock_guard<std::mutex> lock(m_completedMutex);
+                workerTask.state = success ? TaskState::Done : TaskState::Failed;
+                m_completed.push_back(id);
+            }
+            m_completedCondition.notify_one();
+        });
+    };
+
+    auto complete = [&](TaskId id) {
+        ++finished;
+        Task& task = m_tasks[id];
+        if (task.state == TaskState::Failed && task.critical) {
+            criticalFailed = true;
+        }
+        for (TaskId dependentId : task.dependents) {
+            Task& dependent = m_tasks[dependentId];
+            if (task.state != TaskState::Done) {
+                dependent.dependencyFailed = true;
+            }
+            if (--dependent.remainingDependencies == 0) {
+                schedule(dependentId);
+            }
+        }
+    };
+
+    auto progress = [&]() {
+        return m_tasks.empty() ? 1.0f : static_cast<float>(finished) / static_cast<float>(m_tasks.size());
+    };
+
+    for (TaskId id = 0; id < m_tasks.size(); ++id) {
+        if (m_tasks[id].remainingDependencies == 0) {
+            schedule(id);
+        }
+    }
+
+    while (finished < m_tasks.size()) {
+        std::vector<TaskId> completed;
+        {
+            std::unique_lock<std::mutex> lock(m_completedMutex);
+            if (m_completed.empty() && mainReady.empty()) {
+                // Wake up at display rate so the progress screen keeps animating
+                m_completedCondition.wait_for(lock, std::chrono::milliseconds(16));
+            }
+            completed.swap(m_completed);
+        }
+        for (TaskId id : completed) {
+            complete(id);
+        }
+
+        if (!mainReady.empty()) {
+            TaskId id = mainReady.front();
+            mainReady.pop_front();
+            Task& task = m_tasks[id];
+            task.state = execute(task, trace) ? TaskState::Done : TaskState::Failed;
+            complete(id);
+        }
+
+        if (pump) {
+            pump(progress());
+        }
+    }
+
+    return !criticalFailed;
+}
+
+std::vector<TaskGraph::TaskId> TaskGraph::getCriticalPath() const {
+    std::vector<TaskId> path;
+    if (m_tasks.empty()) return path;
+
+    TaskId current = 0;
+    for (TaskId id = 1; id < m_tasks.size(); ++id) {
+        if (m_tasks[id].end > m_tasks[current].end) current = id;
+    }
+
+    // Walk back through whichever dependency finished last, that's what the task waited on
+    while (true) {
+        path.push_back(current);
+        const Task& task = m_tasks[current];
+        if (task.dependencies.empty()) break;
+
+        TaskId latest = task.dependencies.front();
+        for (TaskId dependency : task.dependencies) {
+            if (m_tasks[dependency].end > m_tasks[latest].end) latest = dependency;
+        }
+        current = latest;
+    }
+
+    return std::vector<TaskId>(path.rbegin(), path.rend());
+}
+
+void TaskGraph::logCriticalPath() const {
+    std::vector<TaskId> path = getCriticalPath();
+    if (path.empty()) return;
+
+    std::cout << "Startup critical path:";
+    for (TaskId id : path) {
+        const Task& task = m_tasks[id];
+        double ms = std::chrono::duration<double, std::milli>(task.end - task.start).count();
+        std::cout << (id == path.front() ? " " : " -> ") << task.name << " (" << ms << " ms)";
+    }
+    std::cout << std::endl;
+}
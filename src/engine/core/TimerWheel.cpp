@@ -0,0 +1,78 @@
+#include "../../../include/headers/core/TimerWheel.h"
+#include <algorithm>
+#include <cmath>
+
+TimerWheel::TimerWheel(float tickSeconds, size_t slotCount)
+    : m_tickSeconds(tickSeconds > 0.0f ? tickSeconds : 1.0f / 60.0f)
+    , m_slots(std::max<size_t>(slotCount, 1)) {
+}
+
+TimerWheel::TimerId TimerWheel::schedule(float delay, void* payload) {
+    // Measured from the current time, not the current tick, so a timer never fires early
+    uint64_t due = static_cast<uint64_t>(std::ceil((m_time + std::max(delay, 0.0f)) / m_tickSeconds));
+    uint64_t deadline = std::max(due, m_currentTick + 1);
+
+    TimerId id;
+    if (!m_freeTimers.empty()) {
+        id = m_freeTimers.back();
+        m_freeTimers.pop_back();
+    }
+    else {
+        id = static_cast<TimerId>(m_timers.size());
+        m_timers.emplace_back();
+    }
+
+    m_timers[id] = { deadline, payload, true };
+    m_slots[deadline % m_slots.size()].push_back(id);
+    ++m_pending;
+    return id;
+}
+
+bool TimerWheel::cancel(TimerId id) {
+    if (id >= m_timers.size() || !m_timers[id].alive) return false;
+
+    // The slot entry goes when advance() next visits it
+    m_timers[id].alive = false;
+    m_timers[id].payload = nullptr;
+    --m_pending;
+    return true;
+}
+
+void TimerWheel::clear() {
+    for (auto& slot : m_slots) {
+        slot.clear();
+    }
+    m_timers.clear();
+    m_freeTimers.clear();
+    m_pending = 0;
+}
+
+void TimerWheel::advance(float deltaTime, std::vector<void*>& outFired) {
+    m_time += deltaTime;
+    uint64_t target = static_cast<uint64_t>(m_time / m_tickSeconds);
+    if (target <= m_currentTick) return;
+
+    // A jump of a whole turn or more visits every slot once
+    uint64_t steps = std::min<uint64_t>(target - m_currentTick, m_slots.size());
+    for (uint64_t step = 1; step <= steps; ++step) {
+        auto& slot = m_slots[(m_currentTick + step) % m_slots.size()];
+        for (size_t i = 0; i < slot.size();) {
+            TimerId id = slot[i];
+            Timer& timer = m_timers[id];
+            if (timer.alive && timer.deadline > target) {
+                ++i;    // a later round
+                continue;
+            }
+
+            if (timer.alive) {
+                outFired.push_back(timer.payload);
+                timer.alive = false;
+                --m_pending;
+            }
+            m_freeTimers.push_back(id);
+            slot[i] = slot.back();
+            slot.pop_back();
+        }
+    }
+    m_currentTick = target;
+}
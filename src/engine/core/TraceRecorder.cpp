@@ -0,0 +1,70 @@
+#include "../../../include/headers/core/TraceRecorder.h"
+#include "../../../include/nlohmann/json.hpp"
+#include "../../../include/headers/CommonDefines.h"
+#include <fstream>
+
+TraceRecorder::TraceRecorder(Clock::time_point origin)
+    : m_origin(origin) {
+    // Claim index 0 for the thread that creates the recorder
+    m_threadIndices[std::this_thread::get_id()] = 0;
+}
+
+int TraceRecorder::getThreadIndex() {
+    auto result = m_threadIndices.emplace(std::this_thread::get_id(), static_cast<int>(m_threadIndices.size()));
+    return result.first->second;
+}
+
+double TraceRecorder::toMicroseconds(Clock::time_point when) const {
+    return std::chrono::duration<double, std::micro>(when - m_origin).count();
+}
+
+double TraceRecorder::getElapsedMs(Clock::time_point when) const {
+    return std::chrono::duration<double, std::milli>(when - m_origin).count();
+}
+
+void TraceRecorder::addSpan(const std::string& name, const std::string& category,
+    Clock::time_point start, Clock::time_point end) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_events.push_back({ name, category, toMicroseconds(start), toMicroseconds(end) - toMicroseconds(start), getThreadIndex() });
+}
+
+void TraceRecorder::addInstant(const std::string& name, Clock::time_point when) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_events.push_back({ name, "marker", toMicroseconds(when), -1.0, getThreadIndex() });
+}
+
+bool TraceRecorder::writeChromeTrace(const std::string& path) const {
+    nlohmann::json events = nlohmann::json::array();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    for (const auto& [threadId, index] : m_threadIndices) {
+        events.push_back({
+            { "name", "thread_name" }, { "ph", "M" }, { "pid", 1 }, { "tid", index },
+            { "args", { { "name", index == 0 ? std::string("main") : "worker " + std::to_string(index) } } }
+        });
+    }
+
+    for (const auto& event : m_events) {
+        nlohmann::json entry = {
+            { "name", event.name }, { "cat", event.category },
+            { "pid", 1 }, { "tid", event.threadIndex }, { "ts", event.startUs }
+        };
+        if (event.durationUs < 0.0) {
+            entry["ph"] = "i";
+            entry["s"] = "g";
+        }
+        else {
+            entry["ph"] = "X";
+            entry["dur"] = event.durationUs;
+        }
+        events.push_back(std::move(entry));
+    }
+
+    std::ofstream file(path);
+    if (!file) {
+        DEBUG_LOG_ERROR("Failed to write trace: " << path);
+        return false;
+    }
+    file << nlohmann::json{ { "traceEvents", events }, { "displayTimeUnit", "ms" } }.dump();
+    return true;
+}
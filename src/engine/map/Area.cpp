@@ -4,6 +4,7 @@
 #include "../../../include/headers/resource/ResourceManager.h"
 #include "../../../include/headers/map/BackgroundLayer.h"
 #include "../../../include/headers/map/ObjectLayer.h"
+#include "../../../include/headers/map/TileLayer.h"
 #include "../../../include/headers/map/mechanism/DoorMechanism.h"
 #include "../../../include/headers/map/mechanism/TriggerMechanism.h"
 #include "../../../include/headers/CommonDefines.h"
@@ -23,6 +24,7 @@ void Area::addPortal(const PortalData& portal) {
         << " Position: (" << portal.position.x << ", " << portal.position.y << ")"
         << " Size: (" << portal.size.x << ", " << portal.size.y << ")" << std::endl;
 
+    m_collisionWorld.addPortal(Aabb::fromPositionSize(portal.position, portal.size), m_portals.size());
     m_portals.push_back(portal);
 }
 
@@ -37,6 +39,7 @@ bool Area::hasPortalTo(const std::string& areaId) const {
 
 void Area::addCollider(std::unique_ptr<BoxCollider> collider) {
     if (collider) {
+        m_collisionWorld.addCollider(collider.get(), CollisionBodyKind::Static);
         m_colliders.push_back(std::move(collider));
     }
 }
@@ -48,87 +51,66 @@ void Area::update(float deltaTime) {
         lastMechanismCount = m_mechanisms.size();
     }
 
-    for (auto& [id, mechanism] : m_mechanisms) {
-        mechanism->update(deltaTime);
-    }
+    m_mechanisms.update(deltaTime);
 }
 
 void Area::render() {
     if (m_layerRenderer) {
         m_layerRenderer->render();
-
-        for (const auto& [id, mechanism] : m_mechanisms) {
-            if (auto* door = dynamic_cast<DoorMechanism*>(mechanism.get())) {
-                door->render();
-            }
-            else if (auto* trigger = dynamic_cast<TriggerMechanism*>(mechanism.get())) {
-                trigger->render();
-            }
-        }
+        renderMechanisms();
     }
 }
 
 void Area::renderMechanisms() {
-    for (const auto& [id, mechanism] : m_mechanisms) {
-
-        if (auto* door = dynamic_cast<DoorMechanism*>(mechanism.get())) {
-            door->render();
-        }
-        else if (auto* trigger = dynamic_cast<TriggerMechanism*>(mechanism.get())) {
-            trigger->render();
-        }
-        else {
-            std::cout << "Failed to cast mechanism to any known type" << std::endl;
-        }
-    }
+    // Sequences have nothing to draw
+    m_mechanisms.getDoors().forEach([](DoorMechanism& door) { door.render(); });
+    m_mechanisms.getTriggers().forEach([](TriggerMechanism& trigger) { trigger.render(); });
+    m_mechanisms.getMachines().forEach([](StateMachineMechanism& machine) { machine.render(); });
 }
 
 void Area::addMechanism(std::unique_ptr<IMechanism> mechanism) {
     if (mechanism) {
         DEBUG_LOG("Adding mechanism " << mechanism->getId() << " to area " << m_data.id);
-        m_mechanisms[mechanism->getId()] = std::move(mechanism);
+        if (IMechanism* existing = m_mechanisms.find(mechanism->getId())) {
+            unregisterMechanismCollider(*existing);
+            m_mechanisms.remove(existing->getId());
+        }
+        if (IMechanism* stored = m_mechanisms.add(std::move(mechanism))) {
+            registerMechanismCollider(*stored);
+        }
     }
 }
 
 IMechanism* Area::getMechanism(const std::string& id) {
-    auto it = m_mechanisms.find(id);
-    return it != m_mechanisms.end() ? it->second.get() : nullptr;
+    return m_mechanisms.find(id);
 }
 
 void Area::activateMechanismInRange(const glm::vec2& position, float radius) {
     float radiusSquared = radius * radius;
 
-    for (auto& [id, mechanism] : m_mechanisms) {
-        if (auto* collider = mechanism->getCollider()) {
-            glm::vec2 mechanismPos = collider->getPosition();
-
-            float distanceSquared = glm::length(position - mechanismPos);
-            distanceSquared *= distanceSquared;
-
-            if (distanceSquared <= radiusSquared) {
-                mechanism->activate();
+    m_mechanisms.forEach([&](IMechanism& mechanism) {
+        if (auto* collider = mechanism.getCollider()) {
+            glm::vec2 offset = collider->getPosition() - position;
+            if (glm::dot(offset, offset) <= radiusSquared) {
+                mechanism.activate();
             }
         }
-    }
+    });
 }
 
 void Area::updateMechanisms(float deltaTime) {
-    for (auto& [id, mechanism] : m_mechanisms) {
-        mechanism->update(deltaTime);
-    }
+    m_mechanisms.update(deltaTime);
 }
 
 bool Area::loadResources() {
     if (!loadBackgroundTexture()) return false;
-    if (!loadMechanismConfigs()) return false;
-
-    const std::vector<std::pair<std::string, std::string>> soundsToLoad = {
-        {m_data.id + "_bgm", "resources/audio/bgm/" + m_data.id + ".wav"},
-        {m_data.id + "_ambient", "resources/audio/ambient/" + m_data.id + ".wav"}
-    };
+    if (!loadTilesetTextures()) return false;
 
     auto& resourceManager = ResourceManager::getInstance();
-    for (const auto& [name, path] : soundsToLoad) {
+    for (const auto& [name, path] : getSoundFiles(m_data.id)) {
+        // Streamed areas arrive with their sounds registered already
+        if (resourceManager.hasSound(name)) continue;
+
         if (std::filesystem::exists(path)) {
             if (!resourceManager.loadSound(name, path)) {
                 DEBUG_LOG_ERROR("Failed to load sound: " << name);
@@ -141,6 +123,13 @@ bool Area::loadResources() {
     return true;
 }
 
+std::vector<std::pair<std::string, std::string>> Area::getSoundFiles(const std::string& areaId) {
+    return {
+        {areaId + "_bgm", "resources/audio/bgm/" + areaId + ".wav"},
+        {areaId + "_ambient", "resources/audio/ambient/" + areaId + ".wav"}
+    };
+}
+
 void Area::unloadResources() {
     // Clear the layer renderer
     if (m_layerRenderer) {
@@ -152,6 +141,9 @@ void Area::unloadResources() {
     resourceManager.unloadTexture(m_data.id + "_bg");
 
     // Clear portals and colliders
+    for (const auto& collider : m_colliders) {
+        m_collisionWorld.removeCollider(collider.get());
+    }
     m_colliders.clear();
 }
 
@@ -173,18 +165,26 @@ bool Area::loadBackgroundTexture() {
     return resourceManager.loadTexture(textureName, texPath);
 }
 
-bool Area::loadMechanismConfigs() {
-    nlohmann::json mechJson;
-    if (!ResourceManager::getInstance().loadMechanismConfig("triggers", m_data.id, mechJson)) {
-        return false;
-    }
-
-    for (const auto& mech : mechJson["mechanisms"]) {
+bool Area::loadTilesetTextures() {
+    // Tilesets are shared between areas, so unloadResources leaves them loaded
+    auto& resourceManager = ResourceManager::getInstance();
+    for (const auto& layer : m_tileLayers) {
+        std::string textureName = "tileset_" + layer.tileset;
+        if (resourceManager.getTexture(textureName)) continue;
+
+        std::string texPath = ResourceManager::getTexturePath("tilesets") + layer.tileset + ".png";
+        if (!resourceManager.loadTexture(textureName, texPath)) {
+            DEBUG_LOG_ERROR("Failed to load tileset " << layer.tileset << " for area: " << m_data.id);
+            return false;
+        }
     }
-
     return true;
 }
 
+void Area::addTileLayer(const TileLayerData& layer) {
+    m_tileLayers.push_back(layer);
+}
+
 bool Area::initializeRenderer() {
     m_layerRenderer = std::make_unique<LayerRenderer>();
 
@@ -203,9 +203,19 @@ bool Area::initializeRenderer() {
         DEBUG_LOG_WARN("No background texture found for: " << m_data.id + "_bg");
     }
 
+    // tiles
+    for (const auto& layerData : m_tileLayers) {
+        auto* tileset = ResourceManager::getInstance().getTexture("tileset_" + layerData.tileset);
+        auto tileLayer = std::make_unique<TileLayer>(layerData, tileset);
+        tileLayer->setZOrder(1);
+        DEBUG_LOG("Tile layer " << layerData.name << ": " << layerData.width << "x" << layerData.height <<
+            " tiles in " << tileLayer->getChunkCount() << " chunks");
+        m_layerRenderer->addLayer(std::move(tileLayer));
+    }
+
     // object (moving platform)
     auto objectLayer = std::make_unique<ObjectLayer>();
-    objectLayer->setZOrder(1);
+    objectLayer->setZOrder(2);
     objectLayer->setViewport(glm::vec2(0.0f), glm::vec2(800.0f, 600.0f));
 
 
@@ -228,6 +238,81 @@ bool Area::initializeRenderer() {
     return true;
 }
 
-void Area::setMechanisms(std::unordered_map<std::string, std::unique_ptr<IMechanism>>&& mechanisms) {
-    m_mechanisms = std::move(mechanisms);
+void Area::registerMechanismCollider(IMechanism& mechanism) {
+    if (auto* collider = mechanism.getCollider()) {
+        m_collisionWorld.addCollider(collider, CollisionBodyKind::Mechanism);
+        m_mechanismColliders[&mechanism] = collider;
+    }
+
+    if (isMachineType(mechanism.getType())) {
+        auto* machine = static_cast<StateMachineMechanism*>(&mechanism);
+        const ICollider* body = machine->getCollider();
+        if (!body || !machine->usesOverlap()) return;
+
+        TriggerVolumeService::VolumeId volume = m_triggerVolumes.addVolume(body, [machine](const OverlapEvent& event) {
+            machine->onOverlap(event);
+        });
+        m_triggerRanges[&mechanism] = { nullptr, volume };
+        return;
+    }
+
+    if (mechanism.getType() != MechanismType::Trigger) return;
+    auto* trigger = static_cast<TriggerMechanism*>(&mechanism);
+
+    trigger->syncRangeVolume();
+    const ICollider* range = trigger->getRangeVolume();
+    if (!range) return;
+
+    TriggerVolumeService::VolumeId volume = m_triggerVolumes.addVolume(range, [this, trigger](const OverlapEvent& event) {
+        trigger->onOverlap(event);
+
+        // Someone standing in range keeps the target door open
+        if (event.type != OverlapEventType::Exit) {
+            if (auto* door = trigger->getTargetDoor()) {
+                door->activate();
+            }
+        }
+    });
+    m_triggerRanges[&mechanism] = { trigger, volume };
+}
+
+void Area::unregisterMechanismCollider(const IMechanism& mechanism) {
+    auto it = m_mechanismColliders.find(&mechanism);
+    if (it != m_mechanismColliders.end()) {
+        m_collisionWorld.removeCollider(it->second);
+        m_mechanismColliders.erase(it);
+    }
+
+    auto range = m_triggerRanges.find(&mechanism);
+    if (range != m_triggerRanges.end()) {
+        m_triggerVolumes.removeVolume(range->second.volume);
+        m_triggerRanges.erase(range);
+    }
+}
+
+void Area::syncMechanismColliders() {
+    // Sleeping mechanisms can't have touched their colliders
+    for (IMechanism* mechanism : m_mechanisms.getTicked()) {
+        const ICollider* current = mechanism->getCollider();
+        auto it = m_mechanismColliders.find(mechanism);
+        const ICollider* registered = it != m_mechanismColliders.end() ? it->second : nullptr;
+
+        if (current != registered) {
+            unregisterMechanismCollider(*mechanism);
+            registerMechanismCollider(*mechanism);
+            continue;
+        }
+        if (current) {
+            m_collisionWorld.updateCollider(current);
+        }
+
+        // Only platforms carry their trigger range along
+        auto range = m_triggerRanges.find(mechanism);
+        if (range != m_triggerRanges.end() && current && current->isMoving()) {
+            if (range->second.trigger) {
+                range->second.trigger->syncRangeVolume();
+            }
+            m_triggerVolumes.updateVolume(range->second.volume);
+        }
+    }
 }
\ No newline at end of file
@@ -0,0 +1,480 @@
+#include "../../../include/headers/map/AreaCooker.h"
+#include "../../../include/headers/map/AreaSaxLoader.h"
+#include "../../../include/headers/resource/ResourceManager.h"
+#include "../../../include/headers/resource/MappedFile.h"
+#include "../../../include/headers/collision/CollisionTypes.h"
+#include "../../../include/headers/CommonDefines.h"
+#include <unordered_map>
+#include <filesystem>
+#include <fstream>
+#include <cstring>
+#include <limits>
+
+namespace {
+    class StringTableBuilder {
+    public:
+        CookedStringRef add(const std::string& value) {
+            auto it = m_offsets.find(value);
+            if (it != m_offsets.end()) {
+                return { it->second, static_cast<uint32_t>(value.size()) };
+            }
+
+            uint32_t offset = static_cast<uint32_t>(m_data.size());
+            m_data.insert(m_data.end(), value.begin(), value.end());
+            m_offsets.emplace(value, offset);
+            return { offset, static_cast<uint32_t>(value.size()) };
+        }
+
+        const std::vector<char>& data() const { return m_data; }
+
+    private:
+        std::vector<char> m_data;
+        std::unordered_map<std::string, uint32_t> m_offsets;
+    };
+
+    template<typename T>
+    void appendRecords(std::vector<unsigned char>& blob, const std::vector<T>& records) {
+        if (records.empty()) return;
+        const auto* bytes = reinterpret_cast<const unsigned char*>(records.data());
+        blob.insert(blob.end(), bytes, bytes + records.size() * sizeof(T));
+    }
+
+    bool isRangeValid(uint32_t offset, uint32_t count, size_t recordSize, size_t blobSize) {
+        uint64_t end = static_cast<uint64_t>(offset) + static_cast<uint64_t>(count) * recordSize;
+        return end <= blobSize && offset % 4 == 0;
+    }
+
+    class StringTableReader {
+    public:
+        StringTableReader(const char* data, uint32_t size) : m_data(data), m_size(size) {}
+
+        bool read(const CookedStringRef& ref, std::string& out) const {
+            if (static_cast<uint64_t>(ref.offset) + ref.length > m_size) {
+                return false;
+            }
+            out.assign(m_data + ref.offset, ref.length);
+            return true;
+        }
+
+    private:
+        const char* m_data;
+        uint32_t m_size;
+    };
+}
+
+bool AreaCooker::loadJsonDefinition(const std::string& areaId, AreaDefinition& outDefinition) {
+    if (!AreaSaxLoader::loadAreaFile(ResourceManager::getMapPath(areaId), outDefinition)) {
+        std::cerr << "Failed to parse area data for: " << areaId << std::endl;
+        return false;
+    }
+
+    // The trigger file is only used when the area file doesn't list its own mechanisms
+    std::string triggerPath = ResourceManager::getMechanismPath("triggers", areaId);
+    if (outDefinition.mechanisms.empty() && std::filesystem::exists(triggerPath)) {
+        if (!AreaSaxLoader::loadMechanismFile(triggerPath, outDefinition.mechanisms)) {
+            DEBUG_LOG_WARN("Failed to load mechanism config for area: " << areaId);
+        }
+    }
+
+    if (!outDefinition.tilemap.empty()) {
+        if (!TileMapLoader::loadTiled(ResourceManager::getTileMapPath(outDefinition.tilemap), outDefinition.tileLayers)) {
+            DEBUG_LOG_WARN("Failed to load tile map " << outDefinition.tilemap << " for area: " << areaId);
+        }
+
+        // Solid tiles become walls, merged so a long wall is one collider instead of one per tile
+        for (const auto& layer : outDefinition.tileLayers) {
+            for (const TileRect& rect : TileMapLoader::mergeSolidTiles(layer)) {
+                ColliderDefinition collider;
+                collider.position = layer.origin + glm::vec2(rect.x, rect.y) * layer.tileSize;
+                collider.size = glm::vec2(rect.width, rect.height) * layer.tileSize;
+                collider.layer = static_cast<uint32_t>(CollisionLayerBits::Wall);
+                collider.mask = CollisionMasks::Wall;
+                outDefinition.colliders.push_back(collider);
+            }
+        }
+    }
+
+    return true;
+}
+
+int64_t AreaCooker::getSourceTimestamp(const std::string& areaId, const std::string& tilemap) {
+    int64_t newest = 0;
+    std::vector<std::string> sources = {
+        ResourceManager::getMapPath(areaId),
+        ResourceManager::getMechanismPath("triggers", areaId)
+    };
+    if (!tilemap.empty()) {
+        sources.push_back(ResourceManager::getTileMapPath(tilemap));
+    }
+
+    for (const auto& path : sources) {
+        std::error_code ec;
+        auto writeTime = std::filesystem::last_write_time(path, ec);
+        if (!ec) {
+            newest = std::max(newest, static_cast<int64_t>(writeTime.time_since_epoch().count()));
+        }
+    }
+    return newest;
+}
+
+bool AreaCooker::writeCookedArea(const AreaDefinition& definition, int64_t sourceTimestamp,
+    std::vector<unsigned char>& outBlob) {
+    StringTableBuilder strings;
+
+    CookedAreaRecord areaRecord{};
+    areaRecord.id = strings.add(definition.data.id);
+    areaRecord.name = strings.add(definition.data.name);
+    areaRecord.type = static_cast<int32_t>(definition.data.type);
+    areaRecord.flags = (definition.data.isUnlocked ? COOKED_AREA_UNLOCKED : 0u) |
+        (definition.data.isDiscovered ? COOKED_AREA_DISCOVERED : 0u);
+    areaRecord.bounds[0] = definition.data.bounds.position.x;
+    areaRecord.bounds[1] = definition.data.bounds.position.y;
+    areaRecord.bounds[2] = definition.data.bounds.size.x;
+    areaRecord.bounds[3] = definition.data.bounds.size.y;
+    areaRecord.tilemap = strings.add(definition.tilemap);
+
+    std::vector<CookedPortalRecord> portals;
+    portals.reserve(definition.portals.size());
+    for (const auto& portal : definition.portals) {
+        CookedPortalRecord record{};
+        record.targetAreaId = strings.add(portal.targetAreaId);
+        record.position[0] = portal.position.x;
+        record.position[1] = portal.position.y;
+        record.size[0] = portal.size.x;
+        record.size[1] = portal.size.y;
+        record.targetPosition[0] = portal.targetPosition.x;
+        record.targetPosition[1] = portal.targetPosition.y;
+        record.flags = portal.isLocked ? COOKED_PORTAL_LOCKED : 0u;
+        record.conditionType = static_cast<int32_t>(portal.condition.type);
+        record.conditionExpression = strings.add(portal.condition.expression);
+        portals.push_back(record);
+    }
+
+    std::vector<CookedColliderRecord> colliders;
+    colliders.reserve(definition.colliders.size());
+    for (const auto& collider : definition.colliders) {
+        CookedColliderRecord record{};
+        record.position[0] = collider.position.x;
+        record.position[1] = collider.position.y;
+        record.size[0] = collider.size.x;
+        record.size[1] = collider.size.y;
+        record.layer = collider.layer;
+        record.mask = collider.mask;
+        colliders.push_back(record);
+    }
+
+    std::vector<CookedMechanismRecord> mechanisms;
+    std::vector<CookedStringRef> steps;
+    mechanisms.reserve(definition.mechanisms.size());
+    for (const auto& mechanism : definition.mechanisms) {
+        CookedMechanismRecord record{};
+        record.id = strings.add(mechanism.id);
+        record.type = static_cast<int32_t>(mechanism.type);
+        record.flags = (mechanism.condition.requiresPlayerPresence ? COOKED_MECH_REQUIRES_PLAYER : 0u) |
+            (mechanism.condition.requiresInteraction ? COOKED_MECH_REQUIRES_INTERACTION : 0u);
+        record.position[0] = mechanism.position.x;
+        record.position[1] = mechanism.position.y;
+        record.size[0] = mechanism.size.x;
+        record.size[1] = mechanism.size.y;
+        record.triggerRadius = mechanism.condition.triggerRadius;
+        record.effectType = static_cast<int32_t>(mechanism.effect.type);
+        record.effectTargetId = strings.add(mechanism.effect.targetId);
+        record.effectValue = mechanism.effect.value;
+        record.effectDuration = mechanism.effect.duration;
+        record.effectDirection[0] = mechanism.effect.direction.x;
+        record.effectDirection[1] = mechanism.effect.direction.y;
+        record.conditionExpression = strings.add(mechanism.condition.expression);
+        record.valueExpression = strings.add(mechanism.effect.valueExpression);
+        record.timeLimit = mechanism.timeLimit;
+        record.firstStep = static_cast<uint32_t>(steps.size());
+        record.stepCount = static_cast<uint32_t>(mechanism.sequence.size());
+        for (const auto& step : mechanism.sequence) {
+            steps.push_back(strings.add(step));
+        }
+        record.machine = strings.add(mechanism.machine);
+        mechanisms.push_back(record);
+    }
+
+    std::vector<CookedTileLayerRecord> tileLayers;
+    std::vector<uint32_t> tiles;
+    tileLayers.reserve(definition.tileLayers.size());
+    for (const auto& layer : definition.tileLayers) {
+        CookedTileLayerRecord record{};
+        record.name = strings.add(layer.name);
+        record.tileset = strings.add(layer.tileset);
+        record.width = layer.width;
+        record.height = layer.height;
+        record.tileSize[0] = layer.tileSize.x;
+        record.tileSize[1] = layer.tileSize.y;
+        record.origin[0] = layer.origin.x;
+        record.origin[1] = layer.origin.y;
+        record.tilesetColumns = layer.tilesetColumns;
+        record.tilesetRows = layer.tilesetRows;
+        record.firstTile = static_cast<uint32_t>(tiles.size());
+        tiles.insert(tiles.end(), layer.tiles.begin(), layer.tiles.end());
+        tileLayers.push_back(record);
+    }
+
+    CookedAreaHeader header{};
+    header.magic = COOKED_AREA_MAGIC;
+    header.version = COOKED_AREA_VERSION;
+    header.sourceTimeLow = static_cast<uint32_t>(static_cast<uint64_t>(sourceTimestamp) & 0xFFFFFFFFu);
+    header.sourceTimeHigh = static_cast<uint32_t>(static_cast<uint64_t>(sourceTimestamp) >> 32);
+
+    // Laid out in size_t, the header's 32 bit fields are filled in once the blob is known to fit
+    size_t offset = sizeof(CookedAreaHeader) + sizeof(CookedAreaRecord);
+    const size_t portalOffset = offset;
+    offset += portals.size() * sizeof(CookedPortalRecord);
+    const size_t colliderOffset = offset;
+    offset += colliders.size() * sizeof(CookedColliderRecord);
+    const size_t mechanismOffset = offset;
+    offset += mechanisms.size() * sizeof(CookedMechanismRecord);
+    const size_t stepOffset = offset;
+    offset += steps.size() * sizeof(CookedStringRef);
+    const size_t tileLayerOffset = offset;
+    offset += tileLayers.size() * sizeof(CookedTileLayerRecord);
+    const size_t tileOffset = offset;
+    offset += tiles.size() * sizeof(uint32_t);
+    const size_t stringOffset = offset;
+    const size_t totalSize = offset + strings.data().size();
+    if (totalSize > std::numeric_limits<uint32_t>::max()) {
+        return false;
+    }
+
+    header.portalOffset = static_cast<uint32_t>(portalOffset);
+    header.portalCount = static_cast<uint32_t>(portals.size());
+    header.colliderOffset = static_cast<uint32_t>(colliderOffset);
+    header.colliderCount = static_cast<uint32_t>(colliders.size());
+    header.mechanismOffset = static_cast<uint32_t>(mechanismOffset);
+    header.mechanismCount = static_cast<uint32_t>(mechanisms.size());
+    header.stepOffset = static_cast<uint32_t>(stepOffset);
+    header.stepCount = static_cast<uint32_t>(steps.size());
+    header.tileLayerOffset = static_cast<uint32_t>(tileLayerOffset);
+    header.tileLayerCount = static_cast<uint32_t>(tileLayers.size());
+    header.tileOffset = static_cast<uint32_t>(tileOffset);
+    header.tileCount = static_cast<uint32_t>(tiles.size());
+    header.stringOffset = static_cast<uint32_t>(stringOffset);
+    header.stringSize = static_cast<uint32_t>(strings.data().size());
+    header.totalSize = static_cast<uint32_t>(totalSize);
+
+    outBlob.clear();
+    outBlob.reserve(header.totalSize);
+    const auto* headerBytes = reinterpret_cast<const unsigned char*>(&header);
+    outBlob.insert(outBlob.end(), headerBytes, headerBytes + sizeof(header));
+    const auto* areaBytes = reinterpret_cast<const unsigned char*>(&areaRecord);
+    outBlob.insert(outBlob.end(), areaBytes, areaBytes + sizeof(areaRecord));
+    appendRecords(outBlob, portals);
+    appendRecords(outBlob, colliders);
+    appendRecords(outBlob, mechanisms);
+    appendRecords(outBlob, steps);
+    appendRecords(outBlob, tileLayers);
+    appendRecords(outBlob, tiles);
+    outBlob.insert(outBlob.end(), strings.data().begin(), strings.data().end());
+
+    return outBlob.size() == header.totalSize;
+}
+
+bool AreaCooker::cookArea(const std::string& areaId) {
+    AreaDefinition definition;
+    if (!loadJsonDefinition(areaId, definition)) {
+        return false;
+    }
+
+    std::vector<unsigned char> blob;
+    if (!writeCookedArea(definition, getSourceTimestamp(areaId, definition.tilemap), blob)) {
+        DEBUG_LOG_ERROR("Failed to build cooked data for area: " << areaId);
+        return false;
+    }
+
+    std::string outPath = ResourceManager::getCookedMapPath(areaId);
+    std::error_code ec;
+    std::filesystem::create_directories(std::filesystem::path(outPath).parent_path(), ec);
+
+    std::ofstream file(outPath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Failed to write cooked area: " << outPath << std::endl;
+        return false;
+    }
+    file.write(reinterpret_cast<const char*>(blob.data()), static_cast<std::streamsize>(blob.size()));
+
+    std::cout << "Cooked area " << areaId << " (" << definition.portals.size() << " portals, "
+        << definition.colliders.size() << " colliders, " << definition.mechanisms.size()
+        << " mechanisms, " << definition.tileLayers.size() << " tile layers, " << blob.size() << " bytes)" << std::endl;
+    return file.good();
+}
+
+int AreaCooker::cookAllAreas() {
+    std::filesystem::path areaDir = ResourceManager::getBasePath() + "maps/areas";
+    if (!std::filesystem::exists(areaDir)) {
+        std::cerr << "No area directory found: " << areaDir.string() << std::endl;
+        return 0;
+    }
+
+    int cooked = 0;
+    for (const auto& entry : std::filesystem::directory_iterator(areaDir)) {
+        if (!entry.is_regular_file() || entry.path().extension() != ".json") continue;
+
+        std::string areaId = entry.path().stem().string();
+        if (cookArea(areaId)) {
+            ++cooked;
+        }
+        else {
+            std::cerr << "Failed to cook area: " << areaId << std::endl;
+        }
+    }
+    return cooked;
+}
+
+bool CookedAreaLoader::loadArea(const std::string& areaId, AreaDefinition& outDefinition) {
+    std::string path = ResourceManager::getCookedMapPath(areaId);
+    if (!std::filesystem::exists(path)) {
+        return false;
+    }
+
+    MappedFile file;
+    if (!file.open(path)) {
+        return false;
+    }
+
+    int64_t cookedTimestamp = 0;
+    AreaDefinition definition;
+    if (!readBlob(file.data(), file.size(), definition, &cookedTimestamp)) {
+        DEBUG_LOG_WARN("Ignoring invalid cooked area: " << path);
+        return false;
+    }
+
+    // Sources edited after cooking win, shipping builds without JSON just use the blob
+    if (AreaCooker::getSourceTimestamp(areaId, definition.tilemap) > cookedTimestamp) {
+        DEBUG_LOG("Cooked area " << areaId << " is stale, falling back to JSON");
+        return false;
+    }
+
+    if (definition.data.id != areaId) {
+        DEBUG_LOG_WARN("Cooked area id mismatch: " << definition.data.id << " != " << areaId);
+        return false;
+    }
+
+    outDefinition = std::move(definition);
+    return true;
+}
+
+bool CookedAreaLoader::readBlob(const unsigned char* data, size_t size, AreaDefinition& outDefinition,
+    int64_t* outSourceTimestamp) {
+    if (!data || size < sizeof(CookedAreaHeader) + sizeof(CookedAreaRecord)) {
+        return false;
+    }
+
+    CookedAreaHeader header;
+    std::memcpy(&header, data, sizeof(header));
+    if (header.magic != COOKED_AREA_MAGIC || header.version != COOKED_AREA_VERSION ||
+        header.totalSize != size) {
+        return false;
+    }
+
+    if (!isRangeValid(header.portalOffset, header.portalCount, sizeof(CookedPortalRecord), size) ||
+        !isRangeValid(header.colliderOffset, header.colliderCount, sizeof(CookedColliderRecord), size) ||
+        !isRangeValid(header.mechanismOffset, header.mechanismCount, sizeof(CookedMechanismRecord), size) ||
+        !isRangeValid(header.stepOffset, header.stepCount, sizeof(CookedStringRef), size) ||
+        !isRangeValid(header.tileLayerOffset, header.tileLayerCount, sizeof(CookedTileLayerRecord), size) ||
+        !isRangeValid(header.tileOffset, header.tileCount, sizeof(uint32_t), size) ||
+        static_cast<uint64_t>(header.stringOffset) + header.stringSize > size) {
+        return false;
+    }
+
+    StringTableReader strings(reinterpret_cast<const char*>(data + header.stringOffset), header.stringSize);
+
+    const auto* areaRecord = reinterpret_cast<const CookedAreaRecord*>(data + sizeof(CookedAreaHeader));
+    AreaData& areaData = outDefinition.data;
+    if (!strings.read(areaRecord->id, areaData.id) || !strings.read(areaRecord->name, areaData.name) ||
+        !strings.read(areaRecord->tilemap, outDefinition.tilemap)) {
+        return false;
+    }
+    areaData.type = static_cast<AreaType>(areaRecord->type);
+    areaData.isUnlocked = (areaRecord->flags & COOKED_AREA_UNLOCKED) != 0;
+    areaData.isDiscovered = (areaRecord->flags & COOKED_AREA_DISCOVERED) != 0;
+    areaData.bounds.position = glm::vec2(areaRecord->bounds[0], areaRecord->bounds[1]);
+    areaData.bounds.size = glm::vec2(areaRecord->bounds[2], areaRecord->bounds[3]);
+
+    const auto* portals = reinterpret_cast<const CookedPortalRecord*>(data + header.portalOffset);
+    outDefinition.portals.resize(header.portalCount);
+    for (uint32_t i = 0; i < header.portalCount; ++i) {
+        const auto& record = portals[i];
+        auto& portal = outDefinition.portals[i];
+        if (!strings.read(record.targetAreaId, portal.targetAreaId)) return false;
+        portal.position = glm::vec2(record.position[0], record.position[1]);
+        portal.size = glm::vec2(record.size[0], record.size[1]);
+        portal.targetPosition = glm::vec2(record.targetPosition[0], record.targetPosition[1]);
+        portal.isLocked = (record.flags & COOKED_PORTAL_LOCKED) != 0;
+        portal.condition.type = static_cast<PortalConditionType>(record.conditionType);
+        if (!strings.read(record.conditionExpression, portal.condition.expression)) return false;
+    }
+
+    const auto* colliders = reinterpret_cast<const CookedColliderRecord*>(data + header.colliderOffset);
+    outDefinition.colliders.resize(header.colliderCount);
+    for (uint32_t i = 0; i < header.colliderCount; ++i) {
+        const auto& record = colliders[i];
+        auto& collider = outDefinition.colliders[i];
+        collider.position = glm::vec2(record.position[0], record.position[1]);
+        collider.size = glm::vec2(record.size[0], record.size[1]);
+        collider.layer = record.layer;
+        collider.mask = record.mask;
+    }
+
+    const auto* steps = reinterpret_cast<const CookedStringRef*>(data + header.stepOffset);
+    const auto* mechanisms = reinterpret_cast<const CookedMechanismRecord*>(data + header.mechanismOffset);
+    outDefinition.mechanisms.resize(header.mechanismCount);
+    for (uint32_t i = 0; i < header.mechanismCount; ++i) {
+        const auto& record = mechanisms[i];
+        auto& mechanism = outDefinition.mechanisms[i];
+        if (!strings.read(record.id, mechanism.id)) return false;
+        mechanism.type = static_cast<MechanismType>(record.type);
+        mechanism.position = glm::vec2(record.position[0], record.position[1]);
+        mechanism.size = glm::vec2(record.size[0], record.size[1]);
+
+        mechanism.condition.requiresPlayerPresence = (record.flags & COOKED_MECH_REQUIRES_PLAYER) != 0;
+        mechanism.condition.requiresInteraction = (record.flags & COOKED_MECH_REQUIRES_INTERACTION) != 0;
+        mechanism.condition.triggerRadius = record.triggerRadius;
+
+        mechanism.effect.type = static_cast<EffectType>(record.effectType);
+        if (!strings.read(record.effectTargetId, mechanism.effect.targetId)) return false;
+        mechanism.effect.value = record.effectValue;
+        mechanism.effect.duration = record.effectDuration;
+        mechanism.effect.direction = glm::vec2(record.effectDirection[0], record.effectDirection[1]);
+        if (!strings.read(record.conditionExpression, mechanism.condition.expression)) return false;
+        if (!strings.read(record.valueExpression, mechanism.effect.valueExpression)) return false;
+
+        mechanism.timeLimit = record.timeLimit;
+        if (static_cast<uint64_t>(record.firstStep) + record.stepCount > header.stepCount) return false;
+        mechanism.sequence.resize(record.stepCount);
+        for (uint32_t step = 0; step < record.stepCount; ++step) {
+            if (!strings.read(steps[record.firstStep + step], mechanism.sequence[step])) return false;
+        }
+        if (!strings.read(record.machine, mechanism.machine)) return false;
+    }
+
+    const auto* tiles = reinterpret_cast<const uint32_t*>(data + header.tileOffset);
+    const auto* tileLayers = reinterpret_cast<const CookedTileLayerRecord*>(data + header.tileLayerOffset);
+    outDefinition.tileLayers.resize(header.tileLayerCount);
+    for (uint32_t i = 0; i < header.tileLayerCount; ++i) {
+        const auto& record = tileLayers[i];
+        auto& layer = outDefinition.tileLayers[i];
+        if (!strings.read(record.name, layer.name) || !strings.read(record.tileset, layer.tileset)) return false;
+        if (record.width <= 0 || record.height <= 0) return false;
+        uint64_t tileCount = static_cast<uint64_t>(record.width) * static_cast<uint64_t>(record.height);
+        if (record.firstTile + tileCount > header.tileCount) return false;
+
+        layer.width = record.width;
+        layer.height = record.height;
+        layer.tileSize = glm::vec2(record.tileSize[0], record.tileSize[1]);
+        layer.origin = glm::vec2(record.origin[0], record.origin[1]);
+        layer.tilesetColumns = record.tilesetColumns;
+        layer.tilesetRows = record.tilesetRows;
+        layer.tiles.assign(tiles + record.firstTile, tiles + record.firstTile + tileCount);
+    }
+
+    if (outSourceTimestamp) {
+        *outSourceTimestamp = static_cast<int64_t>(
+            (static_cast<uint64_t>(header.sourceTimeHigh) << 32) | header.sourceTimeLow);
+    }
+    return true;
+}
@@ -0,0 +1,64 @@
+#include "../../../include/headers/map/AreaGraph.h"
+#include <algorithm>
+#include <deque>
+#include <unordered_set>
+
+void AreaGraph::setArea(const std::string& areaId, const std::vector<PortalData>& portals) {
+    auto& edges = m_edges[areaId];
+    edges.clear();
+    edges.reserve(portals.size());
+
+    for (const auto& portal : portals) {
+        if (portal.targetAreaId.empty() || portal.targetAreaId == areaId) continue;
+        edges.push_back({ portal.targetAreaId, portal.position + portal.size * 0.5f });
+    }
+}
+
+const std::vector<AreaGraphEdge>* AreaGraph::getEdges(const std::string& areaId) const {
+    auto it = m_edges.find(areaId);
+    return it != m_edges.end() ? &it->second : nullptr;
+}
+
+std::vector<AreaGraph::ReachableArea> AreaGraph::collectWithinHops(const std::string& startAreaId,
+    int maxHops, const glm::vec2& fromPosition) const {
+    std::vector<ReachableArea> result;
+    const auto* startEdges = getEdges(startAreaId);
+    if (!startEdges || maxHops <= 0) return result;
+
+    std::vector<const AreaGraphEdge*> exits;
+    exits.reserve(startEdges->size());
+    for (const auto& edge : *startEdges) {
+        exits.push_back(&edge);
+    }
+    std::sort(exits.begin(), exits.end(), [&fromPosition](const AreaGraphEdge* a, const AreaGraphEdge* b) {
+        return glm::length(a->portalCenter - fromPosition) < glm::length(b->portalCenter - fromPosition);
+    });
+
+    std::unordered_set<std::string> visited{ startAreaId };
+    std::deque<size_t> frontier;
+
+    for (const auto* exit : exits) {
+        if (visited.insert(exit->targetAreaId).second) {
+            result.push_back({ exit->targetAreaId, 1, exit->portalCenter });
+            frontier.push_back(result.size() - 1);
+        }
+    }
+
+    while (!frontier.empty()) {
+        ReachableArea current = result[frontier.front()];
+        frontier.pop_front();
+        if (current.hops >= maxHops) continue;
+
+        const auto* edges = getEdges(current.areaId);
+        if (!edges) continue;
+
+        for (const auto& edge : *edges) {
+            if (visited.insert(edge.targetAreaId).second) {
+                result.push_back({ edge.targetAreaId, current.hops + 1, current.exitPortal });
+                frontier.push_back(result.size() - 1);
+            }
+        }
+    }
+
+    return result;
+}
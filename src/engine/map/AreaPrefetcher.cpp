@@ -0,0 +1,145 @@
+#include "../../../include/headers/map/AreaPrefetcher.h"
+#include "../../../include/headers/map/MapManager.h"
+#include "../../../include/headers/core/JobSystem.h"
+#include "../../../include/headers/resource/ResourceManager.h"
+#include "../../../include/headers/CommonDefines.h"
+#include <algorithm>
+#include <filesystem>
+
+AreaPrefetcher::AreaPrefetcher()
+    : m_shared(std::make_shared<SharedState>()) {
+}
+
+void AreaPrefetcher::update(const AreaGraph& graph, const std::string& currentAreaId,
+    const glm::vec2& playerPosition, const std::function<bool(const std::string&)>& isResident) {
+    bool areaChanged = currentAreaId != m_plannedAreaId;
+    bool playerMoved = glm::length(playerPosition - m_plannedPosition) >= m_settings.replanDistance;
+    bool graphChanged = graph.getAreaCount() != m_plannedGraphSize;
+
+    if (areaChanged || playerMoved || graphChanged) {
+        plan(graph, currentAreaId, playerPosition, isResident);
+    }
+    submitLoads(isResident);
+}
+
+void AreaPrefetcher::plan(const AreaGraph& graph, const std::string& currentAreaId,
+    const glm::vec2& playerPosition, const std::function<bool(const std::string&)>& isResident) {
+    m_plannedAreaId = currentAreaId;
+    m_plannedPosition = playerPosition;
+    m_plannedGraphSize = graph.getAreaCount();
+
+    auto reachable = graph.collectWithinHops(currentAreaId, m_settings.maxHops, playerPosition);
+
+    m_wanted.clear();
+    m_queue.clear();
+    for (auto& area : reachable) {
+        m_wanted.insert(area.areaId);
+        if (!isResident(area.areaId) && !isLoading(area.areaId)) {
+            m_queue.push_back(std::move(area));
+        }
+    }
+
+    // Best candidate at the back so submitLoads can pop it
+    std::sort(m_queue.begin(), m_queue.end(), [&playerPosition, this](const auto& a, const auto& b) {
+        float scoreA = getScore(a) + glm::length(a.exitPortal - playerPosition);
+        float scoreB = getScore(b) + glm::length(b.exitPortal - playerPosition);
+        return scoreA > scoreB;
+    });
+}
+
+float AreaPrefetcher::getScore(const AreaGraph::ReachableArea& area) const {
+    return static_cast<float>(area.hops - 1) * m_settings.hopPenalty;
+}
+
+void AreaPrefetcher::submitLoads(const std::function<bool(const std::string&)>& isResident) {
+    while (!m_queue.empty() && static_cast<int>(m_inFlight.size()) < m_settings.maxInFlight) {
+        AreaGraph::ReachableArea next = std::move(m_queue.back());
+        m_queue.pop_back();
+        if (isResident(next.areaId) || isLoading(next.areaId)) continue;
+
+        m_inFlight.insert(next.areaId);
+        DEBUG_LOG("Prefetching area " << next.areaId << " (" << next.hops << " hops)");
+
+        int priority = static_cast<int>(getScore(next) + glm::length(next.exitPortal - m_plannedPosition));
+        std::shared_ptr<SharedState> shared = m_shared;
+        std::string areaId = next.areaId;
+
+        JobSystem::getInstance().submit([shared, areaId]() {
+            PrefetchedArea result;
+            result.areaId = areaId;
+            result.success = MapManager::loadAreaDefinition(areaId, result.definition);
+
+            if (result.success) {
+                collectResources(result);
+                for (auto& texture : result.textures) {
+                    decodeTexture(texture);
+                }
+                for (auto& sound : result.sounds) {
+                    readSound(sound);
+                }
+            }
+
+            std::lock_guard<std::mutex> lock(shared->mutex);
+            shared->ready.push_back(std::move(result));
+        }, priority);
+    }
+}
+
+void AreaPrefetcher::collectResources(PrefetchedArea& area) {
+    const std::string& areaId = area.areaId;
+
+    // Same files Area::loadResources and MapManager::preloadAreaResources would read
+    std::string backgroundDir = ResourceManager::getTexturePath("backgrounds");
+    for (const auto& path : { backgroundDir + areaId + "_bg.png", backgroundDir + areaId + ".png" }) {
+        if (std::filesystem::exists(path)) {
+            area.textures.push_back({ areaId + "_bg", path });
+            break;
+        }
+    }
+
+    for (const auto& layer : area.definition.tileLayers) {
+        std::string name = "tileset_" + layer.tileset;
+        bool listed = std::any_of(area.textures.begin(), area.textures.end(),
+            [&name](const StreamedTexture& texture) { return texture.name == name; });
+        std::string path = ResourceManager::getTexturePath("tilesets") + layer.tileset + ".png";
+        if (!listed && std::filesystem::exists(path)) {
+            area.textures.push_back({ name, path });
+        }
+    }
+
+    for (const auto& [name, path] : Area::getSoundFiles(areaId)) {
+        if (std::filesystem::exists(path)) {
+            area.sounds.push_back({ name, path });
+        }
+    }
+}
+
+bool AreaPrefetcher::decodeTexture(StreamedTexture& texture) {
+    return ResourceManager::getInstance().decodeTexture(texture.path, texture.decoded);
+}
+
+bool AreaPrefetcher::readSound(StreamedSound& sound) {
+    return ResourceManager::getInstance().readSoundFile(sound.path, sound.data);
+}
+
+bool AreaPrefetcher::takeReady(PrefetchedArea& outArea) {
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> lock(m_shared->mutex);
+            if (m_shared->ready.empty()) return false;
+            outArea = std::move(m_shared->ready.front());
+            m_shared->ready.pop_front();
+        }
+
+        m_inFlight.erase(outArea.areaId);
+        if (!outArea.success) {
+            DEBUG_LOG_WARN("Prefetch failed for area: " << outArea.areaId);
+            continue;
+        }
+        if (!isWanted(outArea.areaId)) {
+            // Player went elsewhere while it loaded
+            continue;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,734 @@
+#include "../../../include/headers/map/AreaSaxLoader.h"
+#include "../../../include/headers/resource/MappedFile.h"
+#include "../../../include/nlohmann/json.hpp"
+#include "../../../include/headers/CommonDefines.h"
+#include <iterator>
+#include <cstring>
+#include <iostream>
+
+namespace {
+    using json = nlohmann::json;
+
+    // Plain char iterator that publishes how far the parser has read,
+    // so semantic errors raised from SAX callbacks can report line/column.
+    class TrackingIterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using value_type = char;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const char*;
+        using reference = const char&;
+
+        TrackingIterator(const char* current, const char** cursor) : m_current(current), m_cursor(cursor) {}
+
+        reference operator*() const { return *m_current; }
+        TrackingIterator& operator++() {
+            *m_cursor = ++m_current;
+            return *this;
+        }
+        TrackingIterator operator++(int) {
+            TrackingIterator previous = *this;
+            ++(*this);
+            return previous;
+        }
+        bool operator==(const TrackingIterator& other) const { return m_current == other.m_current; }
+        bool operator!=(const TrackingIterator& other) const { return m_current != other.m_current; }
+
+    private:
+        const char* m_current;
+        const char** m_cursor;
+    };
+
+    enum class Scope : uint8_t {
+        Root,
+        Bounds,
+        Portals,
+        Portal,
+        Mechanisms,
+        Mechanism,
+        Position,
+        Size,
+        Sequence,
+        Colliders,
+        Collider,
+        Skip
+    };
+
+    enum Field : uint8_t {
+        F_None,
+        F_Id, F_Name, F_Type, F_Unlocked, F_Bounds, F_Portals, F_Mechanisms, F_Colliders,
+        F_X, F_Y, F_Width, F_Height,
+        F_TargetArea, F_TargetX, F_TargetY, F_Locked,
+        F_Position, F_Size, F_RequiresPlayer, F_Radius, F_EffectType, F_TargetId,
+        F_Value, F_Duration, F_Sequence, F_TimeLimit, F_Machine, F_Condition, F_ValueExpression,
+        F_Layer, F_Mask, F_Tilemap,
+        F_Count
+    };
+
+    enum class ValueKind : uint8_t { Number, Bool, String, Object, Array };
+
+    struct FieldInfo {
+        const char* name;
+        ValueKind kind;
+    };
+
+    constexpr FieldInfo FIELD_INFO[F_Count] = {
+        { "", ValueKind::Number },
+        { "id", ValueKind::String }, { "name", ValueKind::String }, { "type", ValueKind::Number },
+        { "unlocked", ValueKind::Bool }, { "bounds", ValueKind::Object }, { "portals", ValueKind::Array },
+        { "mechanisms", ValueKind::Array }, { "colliders", ValueKind::Array },
+        { "x", ValueKind::Number }, { "y", ValueKind::Number }, { "width", ValueKind::Number }, { "height", ValueKind::Number },
+        { "targetArea", ValueKind::String }, { "targetX", ValueKind::Number }, { "targetY", ValueKind::Number },
+        { "locked", ValueKind::Bool },
+        { "position", ValueKind::Object }, { "size", ValueKind::Object }, { "requiresPlayer", ValueKind::Bool },
+        { "radius", ValueKind::Number }, { "effectType", ValueKind::Number }, { "targetId", ValueKind::String },
+        { "value", ValueKind::Number }, { "duration", ValueKind::Number }, { "sequence", ValueKind::Array },
+        { "timeLimit", ValueKind::Number }, { "machine", ValueKind::String },
+        { "condition", ValueKind::String }, { "valueExpression", ValueKind::String },
+        { "layer", ValueKind::Number }, { "mask", ValueKind::Number }, { "tilemap", ValueKind::String }
+    };
+
+    constexpr Field ROOT_FIELDS[] = { F_Id, F_Name, F_Type, F_Unlocked, F_Bounds, F_Portals, F_Mechanisms, F_Colliders, F_Tilemap };
+    constexpr Field RECT_FIELDS[] = { F_X, F_Y, F_Width, F_Height };
+    constexpr Field POINT_FIELDS[] = { F_X, F_Y };
+    constexpr Field PORTAL_FIELDS[] = { F_TargetArea, F_X, F_Y, F_Width, F_Height, F_TargetX, F_TargetY, F_Locked, F_Condition };
+    constexpr Field MECHANISM_FIELDS[] = { F_Id, F_Type, F_Position, F_Size, F_RequiresPlayer, F_Radius,
+        F_EffectType, F_TargetId, F_Value, F_Duration, F_Sequence, F_TimeLimit, F_Machine,
+        F_Condition, F_ValueExpression };
+    constexpr Field COLLIDER_FIELDS[] = { F_X, F_Y, F_Width, F_Height, F_Layer, F_Mask };
+
+    constexpr uint64_t bit(Field field) { return 1ull << field; }
+
+    constexpr uint64_t AREA_REQUIRED = bit(F_Id) | bit(F_Name) | bit(F_Type) | bit(F_Bounds);
+    constexpr uint64_t RECT_REQUIRED = bit(F_X) | bit(F_Y) | bit(F_Width) | bit(F_Height);
+    constexpr uint64_t POINT_REQUIRED = bit(F_X) | bit(F_Y);
+    constexpr uint64_t PORTAL_TARGET_REQUIRED = bit(F_TargetArea) | bit(F_TargetX) | bit(F_TargetY);
+    constexpr uint64_t MECHANISM_REQUIRED = bit(F_Id) | bit(F_Type);
+    constexpr uint64_t MECHANISM_PLACEMENT = bit(F_Position) | bit(F_Size);
+    constexpr uint64_t TRIGGER_REQUIRED = bit(F_RequiresPlayer) | bit(F_Radius) | bit(F_EffectType) |
+        bit(F_TargetId) | bit(F_Value) | bit(F_Duration);
+    constexpr uint64_t SEQUENCE_REQUIRED = bit(F_Sequence);
+    constexpr uint64_t MACHINE_REQUIRED = bit(F_Machine);
+
+    template<size_t N>
+    Field findField(const Field(&fields)[N], const std::string& key) {
+        for (Field field : fields) {
+            const char* name = FIELD_INFO[field].name;
+            if (key.size() == std::strlen(name) && std::memcmp(key.data(), name, key.size()) == 0) {
+                return field;
+            }
+        }
+        return F_None;
+    }
+
+    const char* kindName(ValueKind kind) {
+        switch (kind) {
+        case ValueKind::Number: return "a number";
+        case ValueKind::Bool: return "a boolean";
+        case ValueKind::String: return "a string";
+        case ValueKind::Object: return "an object";
+        case ValueKind::Array: return "an array";
+        }
+        return "a value";
+    }
+
+    class AreaSaxHandler {
+    public:
+        AreaSaxHandler(const char* begin, const char** cursor, AreaDefinition* area,
+            std::vector<MechanismDefinition>* mechanisms, std::vector<AreaLoadIssue>& issues)
+            : m_begin(begin)
+            , m_cursor(cursor)
+            , m_area(area)
+            , m_mechanisms(area ? &area->mechanisms : mechanisms)
+            , m_issues(issues) {
+            m_stack.reserve(8);
+        }
+
+        bool failed() const { return m_failed; }
+        bool finished() const { return m_finished; }
+
+        // SAX interface
+        bool null() { return onValue(nullptr, ValueKind::Number, true); }
+        bool boolean(bool value) { return onValue(&value, ValueKind::Bool); }
+        bool number_integer(json::number_integer_t value) {
+            double number = static_cast<double>(value);
+            return onValue(&number, ValueKind::Number);
+        }
+        bool number_unsigned(json::number_unsigned_t value) {
+            double number = static_cast<double>(value);
+            return onValue(&number, ValueKind::Number);
+        }
+        bool number_float(json::number_float_t value, const json::string_t&) {
+            double number = static_cast<double>(value);
+            return onValue(&number, ValueKind::Number);
+        }
+        bool string(json::string_t& value) { return onValue(&value, ValueKind::String); }
+        bool binary(json::binary_t&) { return onValue(nullptr, ValueKind::String, true); }
+
+        bool key(json::string_t& key) {
+            m_field = lookup(top().scope, key);
+            return true;
+        }
+
+        bool start_object(std::size_t) {
+            if (m_stack.empty()) {
+                push(Scope::Root, F_None);
+                return true;
+            }
+
+            Frame& parent = top();
+            switch (parent.scope) {
+            case Scope::Skip:
+                push(Scope::Skip, F_None);
+                return true;
+            case Scope::Portals:
+                ++parent.count;
+                m_area->portals.emplace_back();
+                push(Scope::Portal, F_None);
+                return true;
+            case Scope::Mechanisms:
+                ++parent.count;
+                m_mechanisms->emplace_back();
+                push(Scope::Mechanism, F_None);
+                return true;
+            case Scope::Colliders:
+                ++parent.count;
+                m_area->colliders.emplace_back();
+                push(Scope::Collider, F_None);
+                return true;
+            case Scope::Sequence:
+                ++parent.count;
+                if (!checkElementKind(parent.scope, ValueKind::Object)) return false;
+                push(Scope::Skip, F_None);
+                return true;
+            default:
+                break;
+            }
+
+            Scope child = Scope::Skip;
+            if (parent.scope == Scope::Root && m_field == F_Bounds && m_area) child = Scope::Bounds;
+            else if (parent.scope == Scope::Mechanism && m_field == F_Position) child = Scope::Position;
+            else if (parent.scope == Scope::Mechanism && m_field == F_Size) child = Scope::Size;
+
+            if (child == Scope::Skip && !checkKind(ValueKind::Object)) {
+                return false;
+            }
+
+            Field opened = m_field;
+            markSeen();
+            push(child, opened);
+            return true;
+        }
+
+        bool end_object() {
+            // validate while the object is still on the stack so issues carry its path
+            bool keepGoing = finishObject(top());
+            m_stack.pop_back();
+            return keepGoing;
+        }
+
+        bool start_array(std::size_t) {
+            if (m_stack.empty()) {
+                return fatal(m_area ? "Area file must be an object" : "Mechanism file must be an object");
+            }
+
+            Frame& parent = top();
+            if (parent.scope == Scope::Skip) {
+                push(Scope::Skip, F_None);
+                return true;
+            }
+            if (isArrayScope(parent.scope)) {
+                ++parent.count;
+                if (!checkElementKind(parent.scope, ValueKind::Array)) return false;
+                push(Scope::Skip, F_None);
+                return true;
+            }
+
+            Scope child = Scope::Skip;
+            if (parent.scope == Scope::Root) {
+                if (m_field == F_Portals && m_area) child = Scope::Portals;
+                else if (m_field == F_Mechanisms) child = Scope::Mechanisms;
+                else if (m_field == F_Colliders && m_area) child = Scope::Colliders;
+            }
+            else if (parent.scope == Scope::Mechanism && m_field == F_Sequence) {
+                child = Scope::Sequence;
+            }
+
+            if (child == Scope::Skip && !checkKind(ValueKind::Array)) {
+                return false;
+            }
+
+            Field opened = m_field;
+            markSeen();
+            push(child, opened);
+            return true;
+        }
+
+        bool end_array() {
+            m_stack.pop_back();
+            return true;
+        }
+
+        bool parse_error(std::size_t position, const std::string&, const nlohmann::detail::exception& ex) {
+            AreaLoadIssue issue;
+            locate(position, issue.line, issue.column);
+            issue.path = currentPath(false);
+            issue.message = ex.what();
+            issue.isFatal = true;
+            m_issues.push_back(std::move(issue));
+            m_failed = true;
+            return false;
+        }
+
+    private:
+        struct Frame {
+            Scope scope;
+            Field key;          // field of the parent object that opened this frame
+            uint32_t count;     // elements seen so far, for arrays
+            uint64_t seen;      // fields seen so far, for objects
+            bool valid;
+        };
+
+        const char* m_begin;
+        const char** m_cursor;
+        AreaDefinition* m_area;
+        std::vector<MechanismDefinition>* m_mechanisms;
+        std::vector<AreaLoadIssue>& m_issues;
+
+        std::vector<Frame> m_stack;
+        Field m_field = F_None;
+        bool m_failed = false;
+        bool m_finished = false;
+
+        // Where locate() stopped counting lines
+        size_t m_locatedOffset = 0;
+        size_t m_locatedLine = 1;
+        size_t m_locatedLineStart = 0;
+
+        Frame& top() { return m_stack.back(); }
+
+        void push(Scope scope, Field key) {
+            m_stack.push_back({ scope, key, 0, 0, true });
+            m_field = F_None;
+        }
+
+        static bool isArrayScope(Scope scope) {
+            return scope == Scope::Portals || scope == Scope::Mechanisms ||
+                scope == Scope::Colliders || scope == Scope::Sequence;
+        }
+
+        Field lookup(Scope scope, const std::string& key) const {
+            switch (scope) {
+            case Scope::Root:
+                return m_area ? findField(ROOT_FIELDS, key) : (key == "mechanisms" ? F_Mechanisms : F_None);
+            case Scope::Bounds: return findField(RECT_FIELDS, key);
+            case Scope::Portal: return findField(PORTAL_FIELDS, key);
+            case Scope::Mechanism: return findField(MECHANISM_FIELDS, key);
+            case Scope::Position:
+            case Scope::Size: return findField(POINT_FIELDS, key);
+            case Scope::Collider: return findField(COLLIDER_FIELDS, key);
+            default: return F_None;
+            }
+        }
+
+        void markSeen() {
+            if (m_field != F_None) {
+                top().seen |= bit(m_field);
+            }
+        }
+
+        // Checks the pending field of the current object accepts a value of the given kind
+        bool checkKind(ValueKind kind) {
+            if (m_field == F_None || FIELD_INFO[m_field].kind == kind) {
+                return true;
+            }
+            return invalidate(std::string("Expected ") + kindName(FIELD_INFO[m_field].kind) +
+                ", got " + kindName(kind));
+        }
+
+        bool checkElementKind(Scope arrayScope, ValueKind kind) {
+            ValueKind expected = arrayScope == Scope::Sequence ? ValueKind::String : ValueKind::Object;
+            if (kind == expected) return true;
+
+            std::string message = std::string("Expected ") + kindName(expected) + ", got " + kindName(kind);
+            if (arrayScope == Scope::Sequence) {
+                // the owning mechanism is one below the sequence array
+                report(message, false);
+                m_stack[m_stack.size() - 2].valid = false;
+                return true;
+            }
+            report(message + ", skipping", false);
+            return true;
+        }
+
+        // Marks the current object invalid; the area header itself is fatal
+        bool invalidate(const std::string& message) {
+            Scope scope = top().scope;
+            if (scope == Scope::Root || scope == Scope::Bounds) {
+                return fatal(message);
+            }
+            report(message, false);
+            top().valid = false;
+            return true;
+        }
+
+        bool onValue(const void* value, ValueKind kind, bool isNullOrBinary = false) {
+            if (m_stack.empty()) {
+                return fatal(m_area ? "Area file must be an object" : "Mechanism file must be an object");
+            }
+
+            Frame& frame = top();
+            if (frame.scope == Scope::Skip) return true;
+
+            if (isArrayScope(frame.scope)) {
+                ++frame.count;
+                if (isNullOrBinary) kind = ValueKind::Number;
+                if (!checkElementKind(frame.scope, kind)) return false;
+                if (frame.scope == Scope::Sequence && kind == ValueKind::String) {
+                    m_mechanisms->back().sequence.push_back(*static_cast<const std::string*>(value));
+                }
+                return true;
+            }
+
+            if (m_field == F_None) return true;
+            if (isNullOrBinary || FIELD_INFO[m_field].kind != kind) {
+                bool keepGoing = isNullOrBinary
+                    ? invalidate(std::string("Expected ") + kindName(FIELD_INFO[m_field].kind) + ", got null")
+                    : checkKind(kind);
+                markSeen();
+                m_field = F_None;
+                return keepGoing;
+            }
+
+            markSeen();
+            if (kind == ValueKind::Number) assignNumber(*static_cast<const double*>(value));
+            else if (kind == ValueKind::Bool) assignBool(*static_cast<const bool*>(value));
+            else assignString(*static_cast<const std::string*>(value));
+            m_field = F_None;
+            return true;
+        }
+
+        void assignNumber(double value) {
+            float number = static_cast<float>(value);
+            switch (top().scope) {
+            case Scope::Root:
+                if (m_field == F_Type) m_area->data.type = static_cast<AreaType>(static_cast<int>(value));
+                break;
+            case Scope::Bounds: {
+                AreaBounds& bounds = m_area->data.bounds;
+                if (m_field == F_X) bounds.position.x = number;
+                else if (m_field == F_Y) bounds.position.y = number;
+                else if (m_field == F_Width) bounds.size.x = number;
+                else if (m_field == F_Height) bounds.size.y = number;
+                break;
+            }
+            case Scope::Portal: {
+                PortalData& portal = m_area->portals.back();
+                if (m_field == F_X) portal.position.x = number;
+                else if (m_field == F_Y) portal.position.y = number;
+                else if (m_field == F_Width) portal.size.x = number;
+                else if (m_field == F_Height) portal.size.y = number;
+                else if (m_field == F_TargetX) portal.targetPosition.x = number;
+                else if (m_field == F_TargetY) portal.targetPosition.y = number;
+                break;
+            }
+            case Scope::Mechanism: {
+                MechanismDefinition& mechanism = m_mechanisms->back();
+                if (m_field == F_Type) mechanism.type = static_cast<MechanismType>(static_cast<int>(value));
+                else if (m_field == F_Radius) mechanism.condition.triggerRadius = number;
+                else if (m_field == F_EffectType) mechanism.effect.type = static_cast<EffectType>(static_cast<int>(value));
+                else if (m_field == F_Value) mechanism.effect.value = number;
+                else if (m_field == F_Duration) mechanism.effect.duration = number;
+                else if (m_field == F_TimeLimit) mechanism.timeLimit = number;
+                break;
+            }
+            case Scope::Position:
+            case Scope::Size: {
+                MechanismDefinition& mechanism = m_mechanisms->back();
+                glm::vec2& target = top().scope == Scope::Position ? mechanism.position : mechanism.size;
+                if (m_field == F_X) target.x = number;
+                else if (m_field == F_Y) target.y = number;
+                break;
+            }
+            case Scope::Collider: {
+                ColliderDefinition& collider = m_area->colliders.back();
+                if (m_field == F_X) collider.position.x = number;
+                else if (m_field == F_Y) collider.position.y = number;
+                else if (m_field == F_Width) collider.size.x = number;
+                else if (m_field == F_Height) collider.size.y = number;
+                else if (m_field == F_Layer) collider.layer = static_cast<uint32_t>(value);
+                else if (m_field == F_Mask) collider.mask = static_cast<uint32_t>(value);
+                break;
+            }
+            default:
+                break;
+            }
+        }
+
+        void assignBool(bool value) {
+            switch (top().scope) {
+            case Scope::Root:
+                if (m_field == F_Unlocked) m_area->data.isUnlocked = value;
+                break;
+            case Scope::Portal:
+                if (m_field == F_Locked) m_area->portals.back().isLocked = value;
+                break;
+            case Scope::Mechanism:
+                if (m_field == F_RequiresPlayer) m_mechanisms->back().condition.requiresPlayerPresence = value;
+                break;
+            default:
+                break;
+            }
+        }
+
+        void assignString(const std::string& value) {
+            switch (top().scope) {
+            case Scope::Root:
+                if (m_field == F_Id) m_area->data.id = value;
+                else if (m_field == F_Name) m_area->data.name = value;
+                else if (m_field == F_Tilemap) m_area->tilemap = value;
+                break;
+            case Scope::Portal:
+                if (m_field == F_TargetArea) m_area->portals.back().targetAreaId = value;
+                else if (m_field == F_Condition) {
+                    m_area->portals.back().condition.type = PortalConditionType::Custom;
+                    m_area->portals.back().condition.expression = value;
+                }
+                break;
+            case Scope::Mechanism:
+                if (m_field == F_Id) m_mechanisms->back().id = value;
+                else if (m_field == F_TargetId) m_mechanisms->back().effect.targetId = value;
+                else if (m_field == F_Machine) m_mechanisms->back().machine = value;
+                else if (m_field == F_Condition) m_mechanisms->back().condition.expression = value;
+                else if (m_field == F_ValueExpression) m_mechanisms->back().effect.valueExpression = value;
+                break;
+            default:
+                break;
+            }
+        }
+
+        bool finishObject(const Frame& frame) {
+            switch (frame.scope) {
+            case Scope::Root:
+                m_finished = true;
+                if (m_area && (frame.seen & AREA_REQUIRED) != AREA_REQUIRED) {
+                    return fatal("Missing required fields in area data (id, name, type, bounds)");
+                }
+                if (!m_area && !(frame.seen & bit(F_Mechanisms))) {
+                    report("Missing mechanisms array", false);
+                }
+                return !m_failed;
+            case Scope::Bounds:
+                if ((frame.seen & RECT_REQUIRED) != RECT_REQUIRED) {
+                    return fatal("Missing required fields in bounds data");
+                }
+                return !m_failed;
+            case Scope::Position:
+            case Scope::Size:
+                if ((frame.seen & POINT_REQUIRED) != POINT_REQUIRED) {
+                    report("Missing x or y", false);
+                }
+                if ((frame.seen & POINT_REQUIRED) != POINT_REQUIRED || !frame.valid) {
+                    m_stack[m_stack.size() - 2].valid = false;
+                }
+                return true;
+            case Scope::Portal:
+                finishPortal(frame);
+                return true;
+            case Scope::Mechanism:
+                finishMechanism(frame);
+                return true;
+            case Scope::Collider:
+                if ((frame.seen & RECT_REQUIRED) != RECT_REQUIRED || !frame.valid) {
+                    report("Collider missing required fields, skipping", false);
+                    m_area->colliders.pop_back();
+                }
+                return true;
+            default:
+                return true;
+            }
+        }
+
+        void finishPortal(const Frame& frame) {
+            const PortalData& portal = m_area->portals.back();
+            const char* problem = nullptr;
+
+            if ((frame.seen & RECT_REQUIRED) != RECT_REQUIRED) {
+                problem = "Portal data missing required fields, skipping";
+            }
+            else if ((frame.seen & PORTAL_TARGET_REQUIRED) != PORTAL_TARGET_REQUIRED || !frame.valid) {
+                problem = "Portal target missing or invalid, skipping";
+            }
+            else if (portal.position.x < 0 || portal.position.y < 0 ||
+                portal.size.x <= 0 || portal.size.y <= 0) {
+                problem = "Invalid portal data detected, skipping";
+            }
+
+            if (problem) {
+                report(problem, false);
+                m_area->portals.pop_back();
+            }
+        }
+
+        void finishMechanism(const Frame& frame) {
+            const MechanismDefinition& mechanism = m_mechanisms->back();
+            std::string problem;
+
+            if ((frame.seen & MECHANISM_REQUIRED) != MECHANISM_REQUIRED) {
+                problem = "Mechanism missing id or type";
+            }
+            else if (mechanism.type != MechanismType::Sequence &&
+                (frame.seen & MECHANISM_PLACEMENT) != MECHANISM_PLACEMENT) {
+                problem = "Mechanism " + mechanism.id + " is missing position or size";
+            }
+            else if (mechanism.type == MechanismType::Trigger &&
+                (frame.seen & TRIGGER_REQUIRED) != TRIGGER_REQUIRED) {
+                problem = "Trigger " + mechanism.id + " missing requiresPlayer, radius, effectType, targetId, value or duration";
+            }
+            else if (mechanism.type == MechanismType::Sequence &&
+                (frame.seen & SEQUENCE_REQUIRED) != SEQUENCE_REQUIRED) {
+                problem = "Sequence " + mechanism.id + " missing sequence";
+            }
+            else if (isMachineType(mechanism.type) &&
+                (frame.seen & MACHINE_REQUIRED) != MACHINE_REQUIRED) {
+                problem = "Mechanism " + mechanism.id + " missing machine";
+            }
+            else if (!frame.valid) {
+                problem = "Mechanism " + mechanism.id + " has invalid fields";
+            }
+
+            if (!problem.empty()) {
+                report(problem + ", skipping", false);
+                m_mechanisms->pop_back();
+            }
+        }
+
+        bool fatal(const std::string& message) {
+            report(message, true);
+            m_failed = true;
+            return false;
+        }
+
+        void report(const std::string& message, bool isFatal) {
+            AreaLoadIssue issue;
+            locate(static_cast<size_t>(*m_cursor - m_begin), issue.line, issue.column);
+            issue.path = currentPath(true);
+            issue.message = message;
+            issue.isFatal = isFatal;
+            m_issues.push_back(std::move(issue));
+        }
+
+        // Offsets only grow while parsing, so each call carries on from the last one
+        void locate(size_t offset, size_t& line, size_t& column) {
+            if (offset < m_locatedOffset) {
+                m_locatedOffset = 0;
+                m_locatedLine = 1;
+                m_locatedLineStart = 0;
+            }
+            for (size_t i = m_locatedOffset; i < offset; ++i) {
+                if (m_begin[i] == '\n') {
+                    ++m_locatedLine;
+                    m_locatedLineStart = i + 1;
+                }
+            }
+            m_locatedOffset = offset;
+            line = m_locatedLine;
+            column = offset - m_locatedLineStart + 1;
+        }
+
+        std::string currentPath(bool includePendingField) const {
+            std::string path;
+            for (size_t i = 1; i < m_stack.size(); ++i) {
+                const Frame& parent = m_stack[i - 1];
+                if (isArrayScope(parent.scope)) {
+                    path += "/" + std::to_string(parent.count - 1);
+                }
+                else {
+                    path += "/";
+                    path += FIELD_INFO[m_stack[i].key].name;
+                }
+            }
+            if (includePendingField && !m_stack.empty() && m_field != F_None) {
+                path += "/";
+                path += FIELD_INFO[m_field].name;
+            }
+            return path.empty() ? "/" : path;
+        }
+    };
+
+    bool runParser(const char* data, size_t size, AreaDefinition* area,
+        std::vector<MechanismDefinition>* mechanisms, std::vector<AreaLoadIssue>& issues) {
+        const char* cursor = data;
+        AreaSaxHandler handler(data, &cursor, area, mechanisms, issues);
+
+        TrackingIterator first(data, &cursor);
+        TrackingIterator last(data + size, &cursor);
+        bool parsed = json::sax_parse(first, last, &handler);
+
+        return parsed && !handler.failed() && handler.finished();
+    }
+
+    void logIssues(const std::string& source, const std::vector<AreaLoadIssue>& issues) {
+        for (const auto& issue : issues) {
+            if (issue.isFatal) {
+                std::cerr << AreaSaxLoader::formatIssue(source, issue) << std::endl;
+            }
+            else {
+                std::cout << AreaSaxLoader::formatIssue(source, issue) << std::endl;
+            }
+        }
+    }
+}
+
+bool AreaSaxLoader::parseArea(const char* data, size_t size, AreaDefinition& outDefinition,
+    std::vector<AreaLoadIssue>* outIssues) {
+    std::vector<AreaLoadIssue> localIssues;
+    return runParser(data, size, &outDefinition, nullptr, outIssues ? *outIssues : localIssues);
+}
+
+bool AreaSaxLoader::parseMechanisms(const char* data, size_t size, std::vector<MechanismDefinition>& outMechanisms,
+    std::vector<AreaLoadIssue>* outIssues) {
+    std::vector<AreaLoadIssue> localIssues;
+    return runParser(data, size, nullptr, &outMechanisms, outIssues ? *outIssues : localIssues);
+}
+
+bool AreaSaxLoader::loadAreaFile(const std::string& path, AreaDefinition& outDefinition,
+    std::vector<AreaLoadIssue>* outIssues) {
+    MappedFile file;
+    if (!file.open(path)) {
+        DEBUG_LOG_ERROR("Failed to open file: " << path);
+        return false;
+    }
+
+    std::vector<AreaLoadIssue> issues;
+    bool success = parseArea(reinterpret_cast<const char*>(file.data()), file.size(), outDefinition, &issues);
+    logIssues(path, issues);
+
+    if (outIssues) {
+        outIssues->insert(outIssues->end(), issues.begin(), issues.end());
+    }
+    return success;
+}
+
+bool AreaSaxLoader::loadMechanismFile(const std::string& path, std::vector<MechanismDefinition>& outMechanisms,
+    std::vector<AreaLoadIssue>* outIssues) {
+    MappedFile file;
+    if (!file.open(path)) {
+        DEBUG_LOG_ERROR("Failed to open file: " << path);
+        return false;
+    }
+
+    std::vector<AreaLoadIssue> issues;
+    bool success = parseMechanisms(reinterpret_cast<const char*>(file.data()), file.size(), outMechanisms, &issues);
+    logIssues(path, issues);
+
+    if (outIssues) {
+        outIssues->insert(outIssues->end(), issues.begin(), issues.end());
+    }
+    return success;
+}
+
+std::string AreaSaxLoader::formatIssue(const std::string& source, const AreaLoadIssue& issue) {
+    return source + ":" + std::to_string(issue.line) + ":" + std::to_string(issue.column) +
+        ": " + issue.path + ": " + issue.message;
+}
@@ -0,0 +1,70 @@
+#include "../../../include/headers/map/AreaStreamer.h"
+#include "../../../include/headers/map/MapManager.h"
+#include "../../../include/headers/core/JobSystem.h"
+#include "../../../include/headers/CommonDefines.h"
+
+namespace {
+    // Prefetch jobs are ranked by distance, never below zero
+    constexpr int STREAM_PRIORITY = -1;
+}
+
+void AreaStreamer::start(const std::string& areaId) {
+    m_areaId = areaId;
+    m_shared = std::make_shared<SharedState>();
+    m_shared->area.areaId = areaId;
+
+    std::shared_ptr<SharedState> shared = m_shared;
+    JobSystem::getInstance().submit([shared]() { parse(shared); }, STREAM_PRIORITY);
+}
+
+size_t AreaStreamer::getJobCount() const {
+    return m_shared ? m_shared->jobCount.load(std::memory_order_acquire) : 0;
+}
+
+size_t AreaStreamer::getFinishedJobCount() const {
+    return m_shared ? m_shared->finishedJobs.load(std::memory_order_acquire) : 0;
+}
+
+bool AreaStreamer::takeResult(PrefetchedArea& outArea) {
+    if (!m_shared) return false;
+
+    // Finished first: the parse job raises the count before it counts itself done
+    size_t finished = m_shared->finishedJobs.load(std::memory_order_acquire);
+    if (finished != m_shared->jobCount.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    outArea = std::move(m_shared->area);
+    m_shared.reset();
+    return true;
+}
+
+void AreaStreamer::parse(const std::shared_ptr<SharedState>& shared) {
+    PrefetchedArea& area = shared->area;
+    area.success = MapManager::loadAreaDefinition(area.areaId, area.definition);
+    if (!area.success) {
+        DEBUG_LOG_ERROR("Failed to load area definition for: " << area.areaId);
+        shared->finishedJobs.fetch_add(1, std::memory_order_release);
+        return;
+    }
+
+    // Sized before any job starts, every job writes its own slot
+    AreaPrefetcher::collectResources(area);
+    shared->jobCount.fetch_add(area.textures.size() + area.sounds.size(), std::memory_order_release);
+
+    auto& jobs = JobSystem::getInstance();
+    for (size_t i = 0; i < area.textures.size(); ++i) {
+        jobs.submit([shared, i]() {
+            AreaPrefetcher::decodeTexture(shared->area.textures[i]);
+            shared->finishedJobs.fetch_add(1, std::memory_order_release);
+        }, STREAM_PRIORITY);
+    }
+    for (size_t i = 0; i < area.sounds.size(); ++i) {
+        jobs.submit([shared, i]() {
+            AreaPrefetcher::readSound(shared->area.sounds[i]);
+            shared->finishedJobs.fetch_add(1, std::memory_order_release);
+        }, STREAM_PRIORITY);
+    }
+
+    shared->finishedJobs.fetch_add(1, std::memory_order_release);
+}
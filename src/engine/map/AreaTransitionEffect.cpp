@@ -12,6 +12,7 @@ void AreaTransitionEffect::start(float duration) {
     m_duration = duration;
     m_progress = 0.0f;
     m_isFinished = false;
+    m_isActive = true;
 }
 
 void AreaTransitionEffect::update(float deltaTime) {
@@ -25,7 +26,7 @@ void AreaTransitionEffect::update(float deltaTime) {
 }
 
 void AreaTransitionEffect::render() {
-    if (m_isFinished) return;
+    if (!m_isActive) return;
 
     switch (m_type) {
     case Type::FADE:
@@ -42,7 +43,7 @@ void AreaTransitionEffect::renderFade() {
 
     // ȾȫɫΣʹprogressΪalphaֵ
     glm::vec4 color(0.0f, 0.0f, 0.0f, m_progress);
-    renderer.drawRect(glm::vec2(0.0f), renderer.getScreenSize(), glm::vec3(color));
+    renderer.drawScreenRect(glm::vec2(0.0f), renderer.getScreenSize(), glm::vec3(color), color.a);
 }
 
 void AreaTransitionEffect::renderSlide() {
@@ -51,5 +52,5 @@ void AreaTransitionEffect::renderSlide() {
 
     // 󻬶Ч
     float offset = screenSize.x * (1.0f - m_progress);
-    renderer.drawRect(glm::vec2(offset, 0.0f), screenSize, glm::vec3(0.0f));
+    renderer.drawScreenRect(glm::vec2(offset, 0.0f), screenSize, glm::vec3(0.0f));
 }
\ No newline at end of file
@@ -44,7 +44,8 @@ void LayerRenderer::setViewport(const glm::vec2& position, const glm::vec2& size
 }
 
 void LayerRenderer::sortLayers() {
-    std::sort(m_layers.begin(), m_layers.end(),
+    // Stable, layers sharing a z order draw in the order they were added
+    std::stable_sort(m_layers.begin(), m_layers.end(),
         [](const auto& a, const auto& b) {
             return a->getZOrder() < b->getZOrder();
         });
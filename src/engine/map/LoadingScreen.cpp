@@ -36,9 +36,10 @@ void LoadingScreen::setProgress(float progress) {
 void LoadingScreen::renderBackground() {
     auto& renderer = Renderer::getInstance();
     auto screenSize = renderer.getScreenSize();
+    if (m_backgroundColor.a <= 0.0f) return;
 
-    renderer.drawRect(glm::vec2(0.0f), screenSize,
-        glm::vec3(m_backgroundColor));
+    renderer.drawScreenRect(glm::vec2(0.0f), screenSize,
+        glm::vec3(m_backgroundColor), m_backgroundColor.a);
 }
 
 void LoadingScreen::renderProgressBar() {
@@ -54,11 +55,11 @@ void LoadingScreen::renderProgressBar() {
     );
 
     // Background bar
-    renderer.drawRect(barPos, glm::vec2(barWidth, barHeight),
+    renderer.drawScreenRect(barPos, glm::vec2(barWidth, barHeight),
         glm::vec3(0.2f));
 
     // Progress bar
-    renderer.drawRect(barPos,
+    renderer.drawScreenRect(barPos,
         glm::vec2(barWidth * m_progress, barHeight),
         glm::vec3(m_progressBarColor));
 }
@@ -7,124 +7,36 @@
 #include "../../../include/headers/map/mechanism/SequenceMechanism.h"
 #include <iostream>
 #include "../../../include/headers/resource/ConfigValidator.h"
-#include "../../../include/headers/map/portal/PortalSystem.h"
 #include "../../../include/headers/map/LoadingScreen.h"
 #include "../../../include/headers/map/mechanism/DoorMechanism.h"
+#include "../../../include/headers/map/mechanism/StateMachineLibrary.h"
 #include "../../../include/headers/Engine.h"
 #include "../../../include/headers/CommonDefines.h"
 #include "../../../include/headers/audio/AudioManager.h"
+#include "../../../include/headers/map/AreaCooker.h"
+#include "../../../include/headers/core/JobSystem.h"
+#include <algorithm>
+#include <chrono>
 
 using json = nlohmann::json;
 
-bool MapManager::loadAreaData(const std::string& filePath, AreaData& outData) {
-    try {
-        std::ifstream file(filePath);
-        if (!file.is_open()) {
-            return false;
-        }
-
-        json j;
-        file >> j;
-
-        outData.id = j["id"].get<std::string>();
-        outData.name = j["name"].get<std::string>();
-        outData.type = static_cast<AreaType>(j["type"].get<int>());
-        outData.isUnlocked = j["unlocked"].get<bool>();
-
-        auto& bounds = j["bounds"];
-        outData.bounds.position.x = bounds["x"].get<float>();
-        outData.bounds.position.y = bounds["y"].get<float>();
-        outData.bounds.size.x = bounds["width"].get<float>();
-        outData.bounds.size.y = bounds["height"].get<float>();
-
-        if (j.contains("portals")) {
-            for (const auto& portalJson : j["portals"]) {
-                PortalData portal;
-                portal.targetAreaId = portalJson["targetArea"].get<std::string>();
-                portal.position.x = portalJson["x"].get<float>();
-                portal.position.y = portalJson["y"].get<float>();
-                portal.size.x = portalJson["width"].get<float>();
-                portal.size.y = portalJson["height"].get<float>();
-                portal.targetPosition.x = portalJson["targetX"].get<float>();
-                portal.targetPosition.y = portalJson["targetY"].get<float>();
-                portal.isLocked = portalJson["locked"].get<bool>();
-
-                m_areas[outData.id]->addPortal(portal);
-            }
-        }
-
-        if (j.contains("mechanisms")) {
-            auto area = m_areas[outData.id].get();
-
-            for (const auto& mechJson : j["mechanisms"]) {
-                auto type = static_cast<MechanismType>(mechJson["type"].get<int>());
-                std::string mechId = mechJson["id"].get<std::string>();
-
-                std::unique_ptr<IMechanism> mechanism;
-
-                switch (type) {
-                case MechanismType::Trigger: {
-                    TriggerCondition condition;
-                    condition.requiresPlayerPresence = mechJson["requiresPlayer"].get<bool>();
-                    condition.triggerRadius = mechJson["radius"].get<float>();
-
-                    MechanismEffect effect;
-                    effect.type = static_cast<EffectType>(mechJson["effectType"].get<int>());
-                    effect.targetId = mechJson["targetId"].get<std::string>();
-                    effect.value = mechJson["value"].get<float>();
-                    effect.duration = mechJson["duration"].get<float>();
-
-                    mechanism = std::make_unique<TriggerMechanism>(mechId, condition, effect);
-                    break;
-                }
-
-                case MechanismType::Sequence: {
-                    std::vector<std::string> sequence;
-                    for (const auto& step : mechJson["sequence"]) {
-                        sequence.push_back(step.get<std::string>());
-                    }
-
-                    auto seqMech = std::make_unique<SequenceMechanism>(mechId, sequence);
-                    if (mechJson.contains("timeLimit")) {
-                        seqMech->setTimeLimit(mechJson["timeLimit"].get<float>());
-                    }
-
-                    mechanism = std::move(seqMech);
-                    break;
-                }
-                }
-
-                if (mechJson.contains("collider")) {
-                    auto& colliderJson = mechJson["collider"];
-                    auto collider = std::make_unique<BoxCollider>(
-                        glm::vec2(colliderJson["x"].get<float>(),
-                            colliderJson["y"].get<float>()),
-                        glm::vec2(colliderJson["width"].get<float>(),
-                            colliderJson["height"].get<float>())
-                    );
-                    mechanism->setCollider(std::move(collider));
-                }
-
-                area->addMechanism(std::move(mechanism));
-            }
-        }
+namespace {
+    constexpr float TRANSITION_FADE_SECONDS = 0.5f;
 
+    // Empty source means no expression; a broken one is logged and comes back null
+    bool compileExpression(const std::string& owner, const std::string& source,
+        std::shared_ptr<const ExpressionProgram>& outProgram) {
+        outProgram.reset();
+        if (source.empty()) return true;
 
-        if (j.contains("colliders")) {
-            for (const auto& colliderJson : j["colliders"]) {
-                auto collider = std::make_unique<BoxCollider>(
-                    glm::vec2(colliderJson["x"].get<float>(), colliderJson["y"].get<float>()),
-                    glm::vec2(colliderJson["width"].get<float>(), colliderJson["height"].get<float>())
-                );
-                m_areas[outData.id]->addCollider(std::move(collider));
-            }
+        std::string error;
+        outProgram = ExpressionProgram::compile(source, &error);
+        if (!outProgram) {
+            DEBUG_LOG_ERROR(owner << ": expression \"" << source << "\" " << error);
+            return false;
         }
-
         return true;
     }
-    catch (const json::exception& e) {
-        return false;
-    }
 }
 
 bool MapManager::loadArea(const std::string& areaId, const std::string& filePath) {
@@ -132,269 +44,302 @@ bool MapManager::loadArea(const std::string& areaId, const std::string& filePath
 
     auto it = m_areas.find(areaId);
     if (it != m_areas.end()) {
-        auto mechanisms = std::move(it->second->getMechanisms());
+        return it->second->initializeRenderer();
+    }
 
-        if (!it->second->initializeRenderer()) {
-            return false;
-        }
-        it->second->setMechanisms(std::move(mechanisms));
-        return true;
+    AreaDefinition definition;
+    if (!loadAreaDefinition(areaId, definition)) {
+        std::cerr << "Failed to load area definition for: " << areaId << std::endl;
+        return false;
     }
 
+    return loadArea(areaId, definition);
+}
+
+bool MapManager::loadArea(const std::string& areaId, const AreaDefinition& definition) {
+    if (m_areas.find(areaId) != m_areas.end()) {
+        return true;
+    }
 
-    AreaData areaData;
-    nlohmann::json jsonData;
-    nlohmann::json areaJson;
+    m_areaGraph.setArea(areaId, definition.portals);
 
-    if (!ResourceManager::getInstance().loadMapConfig(areaId, areaJson)) {
-        std::cerr << "Failed to load map config for: " << areaId << std::endl;
+    auto area = buildArea(areaId, definition);
+    if (!area) {
         return false;
     }
 
-    std::cout << "Parsing area data for: " << areaId << std::endl;
-    if (!parseAreaData(areaJson, areaData)) {
-        std::cerr << "Failed to parse area data for: " << areaId << std::endl;
+    m_areas[areaId] = std::move(area);
+    std::cout << "Successfully loaded area: " << areaId << std::endl;
+    return true;
+}
+
+bool MapManager::reloadArea(const std::string& areaId, const AreaDefinition& definition) {
+    m_areaGraph.setArea(areaId, definition.portals);
+
+    auto it = m_areas.find(areaId);
+    if (it == m_areas.end()) {
+        // Not loaded yet, it will pick up the new file when it is
         return false;
     }
 
-    auto area = std::make_unique<Area>(areaData);
-
-    if (!area->loadResources()) {
-        std::cerr << "Failed to load resources for area: " << areaId << std::endl;
+    auto area = buildArea(areaId, definition);
+    if (!area) {
+        std::cerr << "Hot reload of area " << areaId << " failed, keeping the old one" << std::endl;
         return false;
     }
 
-    if (areaJson.contains("portals")) {
-        std::cout << "Loading portals for area: " << areaId << std::endl;
-        for (const auto& portalJson : areaJson["portals"]) {
-            try {
-                PortalData portal;
-                if (!portalJson.contains("x") || !portalJson.contains("y") ||
-                    !portalJson.contains("width") || !portalJson.contains("height")) {
-                    std::cout << "Portal data missing required fields, skipping..." << std::endl;
-                    continue;
-                }
+    Area* previous = it->second.get();
+    area->setDiscovered(previous->isDiscovered());
+    area->setUnlocked(previous->isUnlocked());
 
-                portal.targetAreaId = portalJson["targetArea"].get<std::string>();
-                portal.position.x = portalJson["x"].get<float>();
-                portal.position.y = portalJson["y"].get<float>();
-                portal.size.x = portalJson["width"].get<float>();
-                portal.size.y = portalJson["height"].get<float>();
-                portal.targetPosition.x = portalJson["targetX"].get<float>();
-                portal.targetPosition.y = portalJson["targetY"].get<float>();
-                portal.isLocked = portalJson.value("locked", false);
+    int restored = 0;
+    area->getMechanisms().forEach([&](IMechanism& mechanism) {
+        IMechanism* old = previous->getMechanism(mechanism.getId());
+        if (old && old->getType() == mechanism.getType()) {
+            mechanism.restoreState(*old);
+            ++restored;
+        }
+    });
 
+    forgetArea(previous);
+    if (m_currentArea == previous) {
+        m_currentArea = area.get();
+        auto bounds = m_currentArea->getBounds();
+        Renderer::getInstance().getCamera()->setBounds(bounds.position, bounds.position + bounds.size);
+    }
+    it->second = std::move(area);
 
-                if (portal.position.x < 0 || portal.position.y < 0 ||
-                    portal.size.x <= 0 || portal.size.y <= 0) {
-                    std::cout << "Invalid portal data detected, skipping..." << std::endl;
-                    continue;
-                }
+    std::cout << "Reloaded area: " << areaId << " (" << restored << " mechanisms kept their state)" << std::endl;
+    return true;
+}
 
-                area->addPortal(portal);
-            }
-            catch (const std::exception& e) {
-                std::cout << "Error loading portal: " << e.what() << std::endl;
-                continue;
-            }
+int MapManager::reloadMachineUsers(const std::string& machine) {
+    // Read the definitions rather than the live mechanisms, so instances that failed
+    // to build against a broken machine come back once it is fixed
+    std::vector<std::pair<std::string, AreaDefinition>> users;
+    for (const auto& [areaId, area] : m_areas) {
+        AreaDefinition definition;
+        if (!loadAreaDefinition(areaId, definition)) continue;
+
+        bool usesMachine = std::any_of(definition.mechanisms.begin(), definition.mechanisms.end(),
+            [&machine](const MechanismDefinition& mechanism) {
+                return isMachineType(mechanism.type) && mechanism.machine == machine;
+            });
+        if (usesMachine) {
+            users.emplace_back(areaId, std::move(definition));
         }
     }
 
-    if (areaJson.contains("mechanisms")) {
-        DEBUG_LOG("Loading mechanisms for area: " << areaId);
-        for (const auto& mechData : areaJson["mechanisms"]) {
-            auto type = static_cast<MechanismType>(mechData["type"].get<int>());
-            auto id = mechData["id"].get<std::string>();
+    int reloaded = 0;
+    for (const auto& [areaId, definition] : users) {
+        if (reloadArea(areaId, definition)) ++reloaded;
+    }
+    return reloaded;
+}
 
+bool MapManager::loadAreaDefinition(const std::string& areaId, AreaDefinition& outDefinition) {
+    // Cooked blobs are preferred, the JSON stays the source of truth during development
+    if (CookedAreaLoader::loadArea(areaId, outDefinition)) {
+        DEBUG_LOG("Loaded cooked area: " << areaId);
+        return true;
+    }
 
-            if (area->getMechanism(id) != nullptr) {
-                DEBUG_LOG_WARN("Mechanism " << id << " already exists in area " << areaId);
-                continue;
-            }
+    std::cout << "Parsing area data for: " << areaId << std::endl;
+    return AreaCooker::loadJsonDefinition(areaId, outDefinition);
+}
 
-            std::unique_ptr<IMechanism> mechanism = createMechanism(type, mechData);
-            if (mechanism) {
-                DEBUG_LOG("Created mechanism: " << id);
-                area->addMechanism(std::move(mechanism));
-            }
-        }
+std::unique_ptr<Area> MapManager::buildArea(const std::string& areaId, const AreaDefinition& definition) {
+    auto area = std::make_unique<Area>(definition.data);
+    for (const auto& tileLayer : definition.tileLayers) {
+        area->addTileLayer(tileLayer);
     }
 
-    if (areaJson.contains("portals")) {
-        std::cout << "Loading portals for area: " << areaId << std::endl;
-        for (const auto& portalJson : areaJson["portals"]) {
-            PortalData portal;
+    if (!area->loadResources()) {
+        std::cerr << "Failed to load resources for area: " << areaId << std::endl;
+        return nullptr;
+    }
+
+    for (const auto& portal : definition.portals) {
+        PortalData compiled = portal;
+        compileExpression("Portal to " + portal.targetAreaId, portal.condition.expression, compiled.condition.program);
+        area->addPortal(compiled);
+    }
+    std::cout << "Area " << areaId << " now has "
+        << area->getPortals().size() << " portals" << std::endl;
+    subscribePortals(*area);
 
-            area->addPortal(portal);
+    DEBUG_LOG("Loading mechanisms for area: " << areaId);
+    for (const auto& mechDefinition : definition.mechanisms) {
+        if (area->getMechanism(mechDefinition.id) != nullptr) {
+            DEBUG_LOG_WARN("Mechanism " << mechDefinition.id << " already exists in area " << areaId);
+            continue;
         }
-        std::cout << "Area " << areaId << " now has "
-            << area->getPortals().size() << " portals" << std::endl;
+
+        std::unique_ptr<IMechanism> mechanism = createMechanism(mechDefinition);
+        if (mechanism) {
+            DEBUG_LOG("Created mechanism: " << mechDefinition.id);
+            area->addMechanism(std::move(mechanism));
+        }
+    }
+    if (size_t dangling = area->getMechanisms().validateLinks(areaId)) {
+        std::cerr << "Area " << areaId << " has " << dangling << " mechanism links that point nowhere" << std::endl;
+    }
+
+    for (const auto& colliderDefinition : definition.colliders) {
+        auto collider = std::make_unique<BoxCollider>(colliderDefinition.position, colliderDefinition.size);
+        collider->setCollisionLayer(colliderDefinition.layer);
+        collider->setCollisionMask(colliderDefinition.mask);
+        area->addCollider(std::move(collider));
     }
 
     if (!preloadAreaResources(areaId)) {
-        return false;
+        return nullptr;
     }
 
-    
     if (!area->initializeRenderer()) {
         std::cerr << "Failed to initialize renderer for area: " << areaId << std::endl;
-        return false;
+        return nullptr;
     }
 
-    loadMechanisms(area.get(), areaId);
-    loadColliders(area.get(), jsonData);
-
-    m_areas[areaId] = std::move(area);
-    std::cout << "Successfully loaded area: " << areaId << std::endl;
+    area->getCollisionWorld().logStats(areaId);
+    DEBUG_LOG("Area " << areaId << " mechanisms: " << area->getMechanisms().size() << " instances in " <<
+        area->getMechanisms().getInstanceBytes() / 1024 << " KB, " <<
+        MechanismPrototypes::getInstance().getTriggerPrototypeCount() << " trigger prototypes in " <<
+        MechanismPrototypes::getInstance().getSharedBytes() / 1024 << " KB shared by all areas");
+    m_portalConditions.addArea(*area);
 
-    return true;
+    return area;
 }
 
-bool MapManager::parseAreaData(const nlohmann::json& json, AreaData& outData) {
-    try {
-        if (!json.contains("id") || !json.contains("name") ||
-            !json.contains("type") || !json.contains("bounds")) {
-            std::cerr << "Missing required fields in area data" << std::endl;
-            return false;
-        }
-
-        outData.id = json["id"].get<std::string>();
-        outData.name = json["name"].get<std::string>();
-        outData.type = static_cast<AreaType>(json["type"].get<int>());
-        outData.isUnlocked = json.value("unlocked", true);  // true
+std::unique_ptr<IMechanism> MapManager::createMechanism(const MechanismDefinition& definition) {
+    DEBUG_LOG("Create Mechanism " << definition.id << " type:" << static_cast<int>(definition.type));
 
-        // Parse bounds
-        const auto& bounds = json["bounds"];
-        if (!bounds.contains("x") || !bounds.contains("y") ||
-            !bounds.contains("width") || !bounds.contains("height")) {
-            std::cerr << "Missing required fields in bounds data" << std::endl;
-            return false;
+    std::unique_ptr<IMechanism> mechanism;
+    switch (definition.type) {
+    case MechanismType::Door: {
+        mechanism = std::make_unique<DoorMechanism>(definition.id, definition.position, definition.size);
+        if (mechanism) {
+            auto collider = std::make_unique<BoxCollider>(definition.position, definition.size);
+            collider->setCollisionLayer(static_cast<uint32_t>(CollisionLayerBits::Door));
+            collider->setCollisionMask(static_cast<uint32_t>(CollisionLayerBits::Player));
+            collider->setMoving(true);
+            mechanism->setCollider(std::move(collider));
         }
-
-        outData.bounds.position = {
-            bounds["x"].get<float>(),
-            bounds["y"].get<float>()
-        };
-        outData.bounds.size = {
-            bounds["width"].get<float>(),
-            bounds["height"].get<float>()
-        };
-
-        return true;
+        break;
+    }
+    case MechanismType::Trigger: {
+        // Identical triggers share one prototype, expressions are compiled once for all of them
+        std::string error;
+        auto prototype = MechanismPrototypes::getInstance().internTrigger(definition.condition, definition.effect, &error);
+        if (!prototype) {
+            DEBUG_LOG_ERROR("Trigger " << definition.id << ": " << error);
+            DEBUG_LOG_WARN("Skipping trigger " << definition.id << ", its expressions don't compile");
+            break;
+        }
+        mechanism = std::make_unique<TriggerMechanism>(definition.id, std::move(prototype));
+        if (mechanism) {
+            auto collider = std::make_unique<BoxCollider>(definition.position, definition.size);
+            collider->setCollisionLayer(static_cast<uint32_t>(CollisionLayerBits::Trigger));
+            collider->setCollisionMask(static_cast<uint32_t>(CollisionLayerBits::Player));
+            // Platforms move every frame while the effect runs
+            collider->setMoving(definition.effect.type == EffectType::MovePlatform);
+            mechanism->setCollider(std::move(collider));
+        }
+        break;
     }
-    catch (const nlohmann::json::exception& e) {
-        std::cerr << "Area parsing error: " << e.what() << std::endl;
-        return false;
+    case MechanismType::Sequence: {
+        auto sequence = std::make_unique<SequenceMechanism>(definition.id, definition.sequence);
+        if (definition.timeLimit > 0.0f) {
+            sequence->setTimeLimit(definition.timeLimit);
+        }
+        mechanism = std::move(sequence);
+        break;
+    }
+    case MechanismType::Breakable:
+    case MechanismType::Trap:
+    case MechanismType::BuffZone:
+    case MechanismType::MovingPlatform: {
+        // Instances of a kind share one compiled table, the collider is set up by the machine
+        auto table = StateMachineLibrary::getInstance().getMachine(definition.machine);
+        if (!table) {
+            DEBUG_LOG_WARN("Mechanism " << definition.id << " uses unknown machine '" << definition.machine << "'");
+            break;
+        }
+        mechanism = std::make_unique<StateMachineMechanism>(definition.id, definition.type, std::move(table),
+            definition.position, definition.size);
+        break;
     }
-}
-
-void MapManager::loadMechanisms(Area* area, const std::string& areaId) {
-    if (!area) return;
-
-    nlohmann::json mechJson;
-    std::string mechPath = ResourceManager::getMechanismPath("triggers", areaId);
-
-    if (area->getMechanisms().size() > 0) {
-        DEBUG_LOG_WARN("Area " << areaId << " already has mechanisms loaded.");
-        return;
+    default:
+        DEBUG_LOG_WARN("Unsupported mechanism type for " << definition.id);
+        break;
     }
 
-    if (!std::filesystem::exists(mechPath)) {
-        DEBUG_LOG("No mechanism config found for area: " << areaId);
-        return;
-    }
+    return mechanism;
+}
 
-    if (!ResourceManager::getInstance().loadMechanismConfig("triggers", areaId, mechJson)) {
-        DEBUG_LOG_WARN("Failed to load mechanism config for area: " << areaId);
-        return; 
+void MapManager::subscribePortals(Area& area) {
+    const auto& portals = area.getPortals();
+    for (size_t i = 0; i < portals.size(); ++i) {
+        Aabb bounds = Aabb::fromPositionSize(portals[i].position, portals[i].size);
+        const Area* owner = &area;
+        area.getTriggerVolumes().addVolume(bounds, static_cast<uint32_t>(CollisionLayerBits::Portal),
+            [this, owner, i](const OverlapEvent& event) {
+                // Changing areas here would tear down the service that is dispatching
+                if (event.type == OverlapEventType::Enter && !m_pendingPortal.area) {
+                    m_pendingPortal = { owner, i };
+                }
+            });
     }
+}
 
-    for (const auto& mechData : mechJson["mechanisms"]) {
-        auto type = static_cast<MechanismType>(mechData["type"].get<int>());
-        auto id = mechData["id"].get<std::string>();
-
-        if (area->getMechanism(id) != nullptr) {
-            DEBUG_LOG_WARN("Mechanism " << id << " already exists in area " << areaId);
-            continue;
-        }
-
-        std::unique_ptr<IMechanism> mechanism = createMechanism(type, mechData);
-        if (mechanism) {
-            DEBUG_LOG("Adding mechanism " << id << " to area " << areaId);
-            area->addMechanism(std::move(mechanism));
-        }
+void MapManager::forgetArea(const Area* area) {
+    m_portalConditions.removeArea(area);
+    if (m_overlapArea == area) {
+        m_overlapArea = nullptr;
+        m_overlapActor = nullptr;
+    }
+    if (m_pendingPortal.area == area) {
+        m_pendingPortal = PendingPortal();
     }
 }
 
-std::unique_ptr<IMechanism> MapManager::createMechanism(MechanismType type, const nlohmann::json& mechData) {
-    try {
-        std::string id = mechData["id"].get<std::string>();
-        MechanismType mechType = static_cast<MechanismType>(mechData["type"].get<int>());
-
-        glm::vec2 position(
-            mechData["position"]["x"].get<float>(),
-            mechData["position"]["y"].get<float>()
-        );
-        glm::vec2 size(
-            mechData["size"]["x"].get<float>(),
-            mechData["size"]["y"].get<float>()
-        );
-
-        DEBUG_LOG("Create Mechanism " << id << " type:" << static_cast<int>(mechType));
-
-        std::unique_ptr<IMechanism> mechanism;
-        switch (mechType) {
-        case MechanismType::Door: {
-            mechanism = std::make_unique<DoorMechanism>(id, position, size);
-            if (mechanism) {
-                auto collider = std::make_unique<BoxCollider>(position, size);
-                collider->setCollisionLayer(static_cast<uint32_t>(CollisionLayerBits::Door));
-                collider->setCollisionMask(static_cast<uint32_t>(CollisionLayerBits::Player));
-                mechanism->setCollider(std::move(collider));
-            }
-            break;
+void MapManager::updateTriggerVolumes(const BoxCollider* playerCollider) {
+    // The player only ever stands in the current area; leaving one sends its exits
+    if (m_overlapArea != m_currentArea || m_overlapActor != playerCollider) {
+        if (m_overlapArea) {
+            m_overlapArea->getTriggerVolumes().removeActor(m_overlapActor);
         }
-        case MechanismType::Trigger: {
-            TriggerCondition condition;
-            condition.requiresPlayerPresence = mechData["requiresPlayer"].get<bool>();
-            condition.triggerRadius = mechData["radius"].get<float>();
-
-            MechanismEffect effect;
-            effect.type = static_cast<EffectType>(mechData["effectType"].get<int>());
-            effect.targetId = mechData["targetId"].get<std::string>();
-            effect.value = mechData["value"].get<float>();
-            effect.duration = mechData["duration"].get<float>();
-
-            mechanism = std::make_unique<TriggerMechanism>(id, condition, effect);
-            if (mechanism) {
-                auto collider = std::make_unique<BoxCollider>(position, size);
-                collider->setCollisionLayer(static_cast<uint32_t>(CollisionLayerBits::Trigger));
-                collider->setCollisionMask(static_cast<uint32_t>(CollisionLayerBits::Player));
-                mechanism->setCollider(std::move(collider));
-            }
-            break;
+        m_overlapArea = m_currentArea;
+        m_overlapActor = playerCollider;
+        if (m_overlapArea) {
+            m_overlapArea->getTriggerVolumes().addActor(playerCollider);
         }
-        }
-
-        return mechanism;
     }
-    catch (const nlohmann::json::exception& e) {
-        DEBUG_LOG_ERROR("JSON error in createMechanism: " << e.what());
-        return nullptr;
+
+    if (m_currentArea) {
+        m_currentArea->getTriggerVolumes().update();
     }
 }
 
 bool MapManager::handlePortalTransition(const BoxCollider* playerCollider) {
-    if (!m_currentArea || !playerCollider) return false;
+    if (!m_currentArea || !playerCollider || !m_pendingPortal.area) return false;
+
+    PendingPortal pending = m_pendingPortal;
+    m_pendingPortal = PendingPortal();
+    if (pending.area != m_currentArea) return false;
 
-    const auto& portals = m_currentArea->getPortals();
+    // Copied, the change may unload the area that owns it
+    PortalData portal = m_currentArea->getPortals()[pending.portalIndex];
 
-    PortalData triggeredPortal;
-    if (PortalSystem::checkPortalTrigger(playerCollider, portals, triggeredPortal)) {
-        return changeArea(triggeredPortal.targetAreaId, triggeredPortal.targetPosition);
+    // Picks up state changed by this frame's overlap events, e.g. a key handed out by a trigger
+    m_portalConditions.update();
+    if (!PortalConditionService::isOpen(portal)) {
+        DEBUG_LOG("Portal to " << portal.targetAreaId << " is closed");
+        return false;
     }
 
-    return false;
+    DEBUG_LOG("Portal triggered at: (" << portal.position.x << "," << portal.position.y << ")");
+    return changeArea(portal.targetAreaId, portal.targetPosition);
 }
 
 bool MapManager::changeArea(const std::string& areaId, const glm::vec2& position) {
@@ -407,45 +352,13 @@ bool MapManager::changeArea(const std::string& areaId, const glm::vec2& position
         (m_currentArea ? m_currentArea->getId() : "None") <<
         " to " << areaId);
 
-    if (m_currentArea) {
-        std::string currentBgm = m_currentArea->getId() + "_bgm";
-        std::string currentAmbient = m_currentArea->getId() + "_ambient";
-        auto& audio = AudioManager::getInstance();
-        audio.stopBGM();
-        audio.stopAllAmbient();
-    }
-
-    if (auto* area = m_areas[areaId].get()) {
-        auto bounds = area->getBounds();
-        auto* camera = Renderer::getInstance().getCamera();
-        camera->setBounds(bounds.position, bounds.position + bounds.size);
-    }
-
-    auto it = m_areas.find(areaId);
-    if (it == m_areas.end()) {
-        if (!loadArea(areaId, ResourceManager::getMapPath(areaId))) {
-            DEBUG_LOG_ERROR("Failed to load area: " << areaId);
-            return false;
-        }
-    }
-
-    auto area = m_areas[areaId].get();
-    DEBUG_LOG("Area mechanisms count before transition: " << area->getMechanisms().size());
-
-    if (!area->initializeRenderer()) {
-        return false;
+    // Normally prefetched already; its renderer was set up when it was built
+    if (m_areas.find(areaId) != m_areas.end()) {
+        finalizeAreaChange(areaId, position);
+        return true;
     }
 
-    DEBUG_LOG("Area mechanisms count after renderer init: " << area->getMechanisms().size());
-
-    m_currentArea = area;
-
-    std::string newBgm = areaId + "_bgm";
-    std::string newAmbient = areaId + "_ambient";
-    auto& audio = AudioManager::getInstance();
-    audio.playBGM(newBgm);
-    audio.playAmbient(newAmbient, 0.5f);
-
+    startAreaTransition(areaId, position);
     return true;
 }
 
@@ -465,45 +378,29 @@ bool MapManager::preloadAreaResources(const std::string& areaId) {
     return true;
 }
 
-void MapManager::loadColliders(Area* area, const nlohmann::json& json) {
-    if (!area || !json.contains("colliders")) return;
+void MapManager::update(float deltaTime) {
+    ++m_frameCounter;
 
-    try {
-        for (const auto& colliderJson : json["colliders"]) {
-            auto collider = std::make_unique<BoxCollider>(
-                glm::vec2(colliderJson["x"].get<float>(),
-                    colliderJson["y"].get<float>()),
-                glm::vec2(colliderJson["width"].get<float>(),
-                    colliderJson["height"].get<float>())
-            );
-            area->addCollider(std::move(collider));
-        }
+    if (m_isTransitioning) {
+        updateTransition(deltaTime);
     }
-    catch (const nlohmann::json::exception& e) {
-        std::cerr << "Error loading colliders: " << e.what() << std::endl;
+    else {
+        runInstalls();
     }
-}
 
-void MapManager::update(float deltaTime) {
     if (!m_currentArea) return;
 
+    m_areaLastUsed[m_currentArea->getId()] = m_frameCounter;
+
     auto* playerCollider = Engine::getInstance().getPlayerCollider();
-    if (!playerCollider) return;
-
-    for (auto& [id, mechanism] : m_currentArea->getMechanisms()) {
-        mechanism->update(deltaTime);
-
-        if (auto* trigger = dynamic_cast<TriggerMechanism*>(mechanism.get())) {
-            bool isInRange = trigger->isPlayerInRange(playerCollider);
-            if (isInRange) {
-                //DEBUG_LOG("trigger " << id << " was trigged");
-                if (auto* door = dynamic_cast<DoorMechanism*>(
-                    m_currentArea->getMechanism(trigger->getTargetId()))) {
-                    door->activate();
-                }
-            }
-        }
-    }
+    const auto& bounds = m_currentArea->getBounds();
+    updatePrefetch(playerCollider ? playerCollider->getPosition() : bounds.position + bounds.size * 0.5f);
+
+    // Only conditions whose game state changed since last frame are re-tested
+    m_portalConditions.update();
+
+    // Mechanisms are updated once per frame by Engine through Area::updateMechanisms,
+    // triggers open their doors from overlap events, see updateTriggerVolumes
 }
 
 void MapManager::render() {
@@ -519,54 +416,290 @@ void MapManager::render() {
 
 void MapManager::startAreaTransition(const std::string& areaId, const glm::vec2& position) {
     m_isTransitioning = true;
-    m_transitionEffect->start();
-    m_loadingScreen->show();
+    m_transitionAreaId = areaId;
+    m_transitionPosition = position;
 
-    m_currentArea = m_areas[areaId].get();
+    // The fade is the backdrop, the current area keeps rendering under it
+    m_transitionEffect->start(TRANSITION_FADE_SECONDS);
+    m_loadingScreen->setBackgroundColor(glm::vec4(0.0f));
+    m_loadingScreen->show();
 
-    // Start async resource loading
-    if (loadAreaResources(areaId)) {
-        finalizeAreaChange(areaId, position);
+    // A prefetched copy waiting for its install only needs to go first
+    auto queued = std::find_if(m_installs.begin(), m_installs.end(),
+        [&areaId](const AreaInstall& install) { return install.area.areaId == areaId; });
+    if (queued != m_installs.end()) {
+        AreaInstall install = std::move(*queued);
+        m_installs.erase(queued);
+        m_installs.push_front(std::move(install));
+        return;
     }
+
+    DEBUG_LOG("Area " << areaId << " was not prefetched, streaming it in");
+    m_streamer.start(areaId);
 }
 
-bool MapManager::loadAreaResources(const std::string& areaId) {
-    m_loadingScreen->setProgress(0.0f);
+void MapManager::updateTransition(float deltaTime) {
+    m_transitionEffect->update(deltaTime);
+    m_loadingScreen->update(deltaTime);
 
-    // Unload current area resources
-    unloadCurrentArea();
-    m_loadingScreen->setProgress(0.3f);
+    PrefetchedArea streamed;
+    if (m_streamer.takeResult(streamed) && streamed.success) {
+        m_installs.push_front({ std::move(streamed) });
+    }
+    runInstalls();
 
-    // Load new area resources
-    auto& area = m_areas[areaId];
-    if (!area->loadResources()) {
-        return false;
+    // Swapping here, in update, means no frame renders half of each area
+    if (m_areas.find(m_transitionAreaId) != m_areas.end()) {
+        finalizeAreaChange(m_transitionAreaId, m_transitionPosition);
+        return;
     }
-    m_loadingScreen->setProgress(0.7f);
 
-    // Initialize area systems
-    if (!area->initializeRenderer()) {
-        return false;
+    bool pending = m_streamer.isActive() || std::any_of(m_installs.begin(), m_installs.end(),
+        [this](const AreaInstall& install) { return install.area.areaId == m_transitionAreaId; });
+    if (!pending) {
+        DEBUG_LOG_ERROR("Failed to load area: " << m_transitionAreaId);
+        endTransition();
+        return;
     }
-    m_loadingScreen->setProgress(1.0f);
 
-    return true;
+    m_loadingScreen->setProgress(getTransitionProgress());
 }
 
-void MapManager::unloadCurrentArea() {
-    if (m_currentArea) {
-        m_currentArea->unloadResources();
+float MapManager::getTransitionProgress() const {
+    // Every worker job has one main thread step to match: parse and build,
+    // decode and upload, read and register
+    size_t steps = 0;
+    size_t finished = 0;
+    if (m_streamer.isActive()) {
+        steps = m_streamer.getJobCount();
+        finished = m_streamer.getFinishedJobCount();
+    }
+    else {
+        for (const auto& install : m_installs) {
+            if (install.area.areaId != m_transitionAreaId) continue;
+            steps = install.getStepCount();
+            finished = steps + install.getFinishedSteps();
+            break;
+        }
     }
+    return steps > 0 ? static_cast<float>(finished) / static_cast<float>(2 * steps) : 0.0f;
 }
 
 void MapManager::finalizeAreaChange(const std::string& areaId, const glm::vec2& position) {
+    auto& audio = AudioManager::getInstance();
+    if (m_currentArea) {
+        audio.stopBGM();
+        audio.stopAllAmbient();
+    }
+
     // Set new current area
     m_currentArea = m_areas[areaId].get();
+    auto bounds = m_currentArea->getBounds();
+    Renderer::getInstance().getCamera()->setBounds(bounds.position, bounds.position + bounds.size);
+
+    // Arrive where the portal points, before anything tests overlaps in the new area
+    Engine::getInstance().setPlayerPosition(position);
 
-    // Reset player position
-    // TODO: Add player position reset logic
+    audio.playBGM(areaId + "_bgm");
+    audio.playAmbient(areaId + "_ambient", 0.5f);
+
+    endTransition();
+}
 
-    // Hide loading screen
+void MapManager::endTransition() {
+    m_streamer.cancel();
+    m_transitionEffect->stop();
     m_loadingScreen->hide();
     m_isTransitioning = false;
-}
\ No newline at end of file
+    m_transitionAreaId.clear();
+}
+
+Area* MapManager::getArea(const std::string& areaId) const {
+    auto it = m_areas.find(areaId);
+    return it != m_areas.end() ? it->second.get() : nullptr;
+}
+
+bool MapManager::unloadArea(const std::string& areaId) {
+    auto it = m_areas.find(areaId);
+    if (it == m_areas.end()) return false;
+
+    if (it->second.get() == m_currentArea) {
+        DEBUG_LOG_WARN("Refusing to unload the current area: " << areaId);
+        return false;
+    }
+
+    it->second->unloadResources();
+    forgetArea(it->second.get());
+    m_areas.erase(it);
+    m_areaLastUsed.erase(areaId);
+
+    std::cout << "Unloaded area: " << areaId << std::endl;
+    return true;
+}
+
+std::vector<std::string> MapManager::findAreaIds() {
+    std::vector<std::string> areaIds;
+    std::error_code error;
+
+    // Cooked blobs can ship without their JSON, so look at both folders
+    for (const auto& folder : { std::string("maps/areas"), std::string("maps/cooked") }) {
+        for (const auto& entry : std::filesystem::directory_iterator(ResourceManager::getBasePath() + folder, error)) {
+            auto extension = entry.path().extension();
+            if (extension != ".json" && extension != ".area") continue;
+
+            std::string areaId = entry.path().stem().string();
+            if (std::find(areaIds.begin(), areaIds.end(), areaId) == areaIds.end()) {
+                areaIds.push_back(areaId);
+            }
+        }
+    }
+    return areaIds;
+}
+
+void MapManager::buildAreaGraph() {
+    std::vector<std::string> areaIds = findAreaIds();
+
+    std::vector<std::vector<PortalData>> portals(areaIds.size());
+    JobSystem::getInstance().parallelFor(areaIds.size(), 1, [&](size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            AreaDefinition definition;
+            if (loadAreaDefinition(areaIds[i], definition)) {
+                portals[i] = std::move(definition.portals);
+            }
+        }
+    });
+
+    m_areaGraph.clear();
+    for (size_t i = 0; i < areaIds.size(); ++i) {
+        m_areaGraph.setArea(areaIds[i], portals[i]);
+    }
+
+    std::cout << "Area graph built with " << m_areaGraph.getAreaCount() << " areas" << std::endl;
+}
+
+void MapManager::updatePrefetch(const glm::vec2& playerPosition) {
+    auto isResident = [this](const std::string& areaId) {
+        return m_areas.find(areaId) != m_areas.end();
+    };
+    m_prefetcher.update(m_areaGraph, m_currentArea->getId(), playerPosition, isResident);
+
+    // One area at a time, runInstalls spreads its uploads and build over frames
+    PrefetchedArea prefetched;
+    if (m_installs.empty() && m_prefetcher.takeReady(prefetched) && !isResident(prefetched.areaId)) {
+        m_installs.push_back({ std::move(prefetched) });
+    }
+
+    enforceMemoryBudget();
+}
+
+void MapManager::runInstalls() {
+    if (m_installs.empty()) return;
+
+    auto start = std::chrono::steady_clock::now();
+    double budgetMs = m_prefetcher.getSettings().installBudgetMs;
+
+    // At least one step a frame so installs always finish. Building can't be
+    // split, so it only ever runs as a frame's first step.
+    bool stepped = false;
+    while (!m_installs.empty()) {
+        double elapsedMs = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+        if (stepped && elapsedMs >= budgetMs) break;
+
+        AreaInstall& install = m_installs.front();
+        if (install.getFinishedSteps() + 1 < install.getStepCount()) {
+            runInstallStep(install);
+        }
+        else {
+            if (stepped) break;
+            PrefetchedArea area = std::move(install.area);
+            m_installs.pop_front();
+            installArea(area);
+        }
+        stepped = true;
+    }
+}
+
+void MapManager::runInstallStep(AreaInstall& install) {
+    auto& resourceManager = ResourceManager::getInstance();
+
+    if (install.nextTexture < install.area.textures.size()) {
+        StreamedTexture& texture = install.area.textures[install.nextTexture++];
+        if (!texture.decoded.pixels.empty()) {
+            resourceManager.loadTextureFromDecoded(texture.name, texture.path, texture.decoded);
+        }
+        texture.decoded = DecodedTexture();
+        return;
+    }
+
+    StreamedSound& sound = install.area.sounds[install.nextSound++];
+    if (!sound.data.empty() && !resourceManager.hasSound(sound.name)) {
+        resourceManager.loadSoundFromMemory(sound.name, sound.path, sound.data);
+    }
+    std::vector<char>().swap(sound.data);
+}
+
+void MapManager::installArea(PrefetchedArea& prefetched) {
+    const std::string& areaId = prefetched.areaId;
+    if (m_areas.find(areaId) != m_areas.end()) {
+        return;     // loaded another way in the meantime
+    }
+
+    m_areaGraph.setArea(areaId, prefetched.definition.portals);
+
+    auto area = buildArea(areaId, prefetched.definition);
+    if (!area) {
+        DEBUG_LOG_ERROR("Failed to build streamed area: " << areaId);
+        return;
+    }
+
+    m_areas[areaId] = std::move(area);
+    DEBUG_LOG("Streamed area ready: " << areaId);
+}
+
+size_t MapManager::getAreaMemoryUsage(const Area& area) const {
+    // Textures dominate; the rest is a rough per-object estimate
+    constexpr size_t OBJECT_ESTIMATE = 256;
+
+    size_t bytes = ResourceManager::getInstance().getTextureMemoryUsage(area.getId() + "_bg");
+    bytes += sizeof(Area);
+    bytes += (area.getPortals().size() + area.getColliders().size()) * OBJECT_ESTIMATE;
+    bytes += area.getMechanisms().getInstanceBytes();
+    for (const auto& tileLayer : area.getTileLayers()) {
+        // The grid plus, at worst, six 16 byte vertices per tile on the GPU
+        bytes += tileLayer.tiles.size() * (sizeof(uint32_t) + 6 * 4 * sizeof(float));
+    }
+    return bytes;
+}
+
+size_t MapManager::getResidentMemoryUsage() const {
+    size_t total = 0;
+    for (const auto& [id, area] : m_areas) {
+        total += getAreaMemoryUsage(*area);
+    }
+    return total;
+}
+
+void MapManager::enforceMemoryBudget() {
+    size_t budget = m_prefetcher.getSettings().memoryBudgetBytes;
+    size_t total = getResidentMemoryUsage();
+    if (total <= budget) return;
+
+    // Least recently visited first; the current area and anything in prefetch range stay
+    std::vector<std::pair<uint64_t, std::string>> candidates;
+    for (const auto& [id, area] : m_areas) {
+        if (area.get() == m_currentArea || m_prefetcher.isWanted(id)) continue;
+
+        auto used = m_areaLastUsed.find(id);
+        candidates.emplace_back(used != m_areaLastUsed.end() ? used->second : 0, id);
+    }
+    std::sort(candidates.begin(), candidates.end());
+
+    for (const auto& [lastUsed, id] : candidates) {
+        if (total <= budget) break;
+
+        size_t bytes = getAreaMemoryUsage(*m_areas[id]);
+        if (unloadArea(id)) {
+            total -= std::min(total, bytes);
+        }
+    }
+}
@@ -0,0 +1,137 @@
+#include "../../../include/headers/map/TileLayer.h"
+#include "../../../include/headers/renderer/Renderer.h"
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+
+namespace {
+    constexpr int FLOATS_PER_VERTEX = 4;
+    constexpr int VERTICES_PER_TILE = 6;
+}
+
+TileLayer::TileLayer(const TileLayerData& data, const TextureData* tileset)
+    : m_tileset(tileset)
+    , m_origin(data.origin)
+    , m_chunkSize(data.tileSize * static_cast<float>(CHUNK_TILES)) {
+    m_chunksX = (data.width + CHUNK_TILES - 1) / CHUNK_TILES;
+    m_chunksY = (data.height + CHUNK_TILES - 1) / CHUNK_TILES;
+
+    // Geometry is built up front, GL objects only once a chunk is first seen
+    m_chunks.resize(static_cast<size_t>(m_chunksX) * m_chunksY);
+    for (int chunkY = 0; chunkY < m_chunksY; ++chunkY) {
+        for (int chunkX = 0; chunkX < m_chunksX; ++chunkX) {
+            buildChunk(data, chunkX, chunkY, m_chunks[static_cast<size_t>(chunkY) * m_chunksX + chunkX]);
+        }
+    }
+}
+
+TileLayer::~TileLayer() {
+    for (auto& chunk : m_chunks) {
+        if (chunk.vao) glDeleteVertexArrays(1, &chunk.vao);
+        if (chunk.vbo) glDeleteBuffers(1, &chunk.vbo);
+    }
+}
+
+void TileLayer::update(float deltaTime) {
+    // Static geometry, nothing to update
+}
+
+void TileLayer::render() {
+    m_drawnChunks = 0;
+
+    auto& renderer = Renderer::getInstance();
+    Camera* camera = renderer.getCamera();
+    if (!m_tileset || !camera || m_chunks.empty()) return;
+
+    // Camera position is the view centre
+    glm::vec2 halfView = renderer.getScreenSize() * 0.5f / camera->getZoom();
+    glm::vec2 first = glm::floor((camera->getPosition() - halfView - m_origin) / m_chunkSize);
+    glm::vec2 last = glm::floor((camera->getPosition() + halfView - m_origin) / m_chunkSize);
+
+    int firstX = std::max(0, static_cast<int>(first.x));
+    int firstY = std::max(0, static_cast<int>(first.y));
+    int lastX = std::min(m_chunksX - 1, static_cast<int>(last.x));
+    int lastY = std::min(m_chunksY - 1, static_cast<int>(last.y));
+
+    for (int chunkY = firstY; chunkY <= lastY; ++chunkY) {
+        for (int chunkX = firstX; chunkX <= lastX; ++chunkX) {
+            Chunk& chunk = m_chunks[static_cast<size_t>(chunkY) * m_chunksX + chunkX];
+            if (chunk.vertexCount == 0) continue;
+
+            if (!chunk.vao) {
+                upload(chunk);
+            }
+            renderer.drawTexturedMesh(chunk.vao, chunk.vertexCount, m_tileset);
+            ++m_drawnChunks;
+        }
+    }
+}
+
+void TileLayer::buildChunk(const TileLayerData& data, int chunkX, int chunkY, Chunk& outChunk) const {
+    if (!m_tileset || m_tileset->width <= 0 || m_tileset->height <= 0) return;
+
+    const int columns = std::max(1, data.tilesetColumns);
+    const int rows = std::max(1, data.tilesetRows);
+    const uint32_t tileCount = static_cast<uint32_t>(columns * rows);
+
+    // Half a texel in from each tile edge so filtering never samples the neighbour tile
+    const glm::vec2 inset(0.5f / m_tileset->width, 0.5f / m_tileset->height);
+
+    const int beginX = chunkX * CHUNK_TILES;
+    const int beginY = chunkY * CHUNK_TILES;
+    const int endX = std::min(beginX + CHUNK_TILES, data.width);
+    const int endY = std::min(beginY + CHUNK_TILES, data.height);
+
+    outChunk.vertices.reserve(static_cast<size_t>(CHUNK_TILES) * CHUNK_TILES * VERTICES_PER_TILE * FLOATS_PER_VERTEX);
+    for (int y = beginY; y < endY; ++y) {
+        for (int x = beginX; x < endX; ++x) {
+            uint32_t tile = data.at(x, y);
+            if (tile == 0 || tile > tileCount) continue;
+
+            int column = static_cast<int>((tile - 1) % columns);
+            int row = static_cast<int>((tile - 1) / columns);
+
+            // Images are flipped on load, the tileset's top row is at v = 1
+            float u0 = static_cast<float>(column) / columns + inset.x;
+            float u1 = static_cast<float>(column + 1) / columns - inset.x;
+            float vTop = 1.0f - static_cast<float>(row) / rows - inset.y;
+            float vBottom = 1.0f - static_cast<float>(row + 1) / rows + inset.y;
+
+            glm::vec2 topLeft = data.origin + glm::vec2(x, y) * data.tileSize;
+            glm::vec2 bottomRight = topLeft + data.tileSize;
+
+            const float quad[VERTICES_PER_TILE * FLOATS_PER_VERTEX] = {
+                topLeft.x,     topLeft.y,       u0, vTop,
+                bottomRight.x, topLeft.y,       u1, vTop,
+                bottomRight.x, bottomRight.y,   u1, vBottom,
+                bottomRight.x, bottomRight.y,   u1, vBottom,
+                topLeft.x,     bottomRight.y,   u0, vBottom,
+                topLeft.x,     topLeft.y,       u0, vTop
+            };
+            outChunk.vertices.insert(outChunk.vertices.end(), std::begin(quad), std::end(quad));
+        }
+    }
+
+    outChunk.vertexCount = static_cast<GLsizei>(outChunk.vertices.size() / FLOATS_PER_VERTEX);
+    outChunk.vertices.shrink_to_fit();
+}
+
+void TileLayer::upload(Chunk& chunk) {
+    glGenVertexArrays(1, &chunk.vao);
+    glGenBuffers(1, &chunk.vbo);
+
+    glBindVertexArray(chunk.vao);
+    glBindBuffer(GL_ARRAY_BUFFER, chunk.vbo);
+    glBufferData(GL_ARRAY_BUFFER, chunk.vertices.size() * sizeof(float), chunk.vertices.data(), GL_STATIC_DRAW);
+
+    // Same layout as Renderer's quad: position, then texture coords
+    glVertexAttribPointer(0, 2, GL_FLOAT, GL_FALSE, FLOATS_PER_VERTEX * sizeof(float), (void*)0);
+    glEnableVertexAttribArray(0);
+    glVertexAttribPointer(1, 2, GL_FLOAT, GL_FALSE, FLOATS_PER_VERTEX * sizeof(float), (void*)(2 * sizeof(float)));
+    glEnableVertexAttribArray(1);
+    glBindVertexArray(0);
+
+    // The GPU copy is all that is drawn from now on
+    std::vector<float>().swap(chunk.vertices);
+    ++m_uploadedChunks;
+}
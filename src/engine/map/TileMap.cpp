@@ -0,0 +1,222 @@
+#include "../../../include/headers/map/TileMap.h"
+#include "../../../include/nlohmann/json.hpp"
+#include "../../../include/headers/CommonDefines.h"
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+
+using json = nlohmann::json;
+
+namespace {
+    // Tiled keeps flip and rotation flags in the top bits of a gid
+    constexpr uint32_t TILED_GID_MASK = 0x0FFFFFFFu;
+
+    struct TiledTileset {
+        uint32_t firstGid = 1;
+        uint32_t tileCount = 0;
+        int columns = 1;
+        std::string name;
+        std::vector<uint32_t> solidTiles;   // 1 based, like TileLayerData::tiles
+    };
+
+    bool getBoolProperty(const json& owner, const char* name) {
+        if (!owner.contains("properties")) return false;
+        for (const auto& property : owner["properties"]) {
+            if (property.value("name", "") == name) {
+                return property.value("value", false);
+            }
+        }
+        return false;
+    }
+
+    bool parseTileset(const json& tilesetJson, TiledTileset& outTileset) {
+        if (tilesetJson.contains("source")) {
+            DEBUG_LOG_WARN("External tileset " << tilesetJson["source"].get<std::string>() <<
+                " is not supported, embed it in the map");
+            return false;
+        }
+
+        outTileset.firstGid = tilesetJson.value("firstgid", 1u);
+        outTileset.tileCount = tilesetJson.value("tilecount", 0u);
+        outTileset.columns = std::max(1, tilesetJson.value("columns", 1));
+        outTileset.name = std::filesystem::path(tilesetJson.value("image", std::string())).stem().string();
+        if (outTileset.name.empty()) {
+            outTileset.name = tilesetJson.value("name", std::string());
+        }
+
+        if (tilesetJson.contains("tiles")) {
+            for (const auto& tile : tilesetJson["tiles"]) {
+                if (getBoolProperty(tile, "solid")) {
+                    outTileset.solidTiles.push_back(tile["id"].get<uint32_t>() + 1);
+                }
+            }
+        }
+        return true;
+    }
+
+    const TiledTileset* findTileset(const std::vector<TiledTileset>& tilesets, uint32_t gid) {
+        const TiledTileset* found = nullptr;
+        for (const auto& tileset : tilesets) {
+            if (tileset.firstGid <= gid && (!found || tileset.firstGid > found->firstGid)) {
+                found = &tileset;
+            }
+        }
+        return found;
+    }
+
+    bool parseLayer(const json& layerJson, const std::vector<TiledTileset>& tilesets,
+        const glm::vec2& tileSize, TileLayerData& outLayer) {
+        outLayer.name = layerJson.value("name", std::string());
+        if (layerJson.contains("chunks") || layerJson.value("encoding", std::string("csv")) != "csv") {
+            DEBUG_LOG_WARN("Tile layer " << outLayer.name << " is infinite or compressed, save it as a fixed size CSV layer");
+            return false;
+        }
+
+        outLayer.width = layerJson.value("width", 0);
+        outLayer.height = layerJson.value("height", 0);
+        const auto& data = layerJson["data"];
+        if (outLayer.width <= 0 || outLayer.height <= 0 ||
+            data.size() != static_cast<size_t>(outLayer.width) * outLayer.height) {
+            DEBUG_LOG_WARN("Tile layer " << outLayer.name << " has no data or the wrong amount of it");
+            return false;
+        }
+
+        outLayer.tileSize = tileSize;
+        outLayer.origin = glm::vec2(layerJson.value("x", 0) * tileSize.x + layerJson.value("offsetx", 0.0f),
+            layerJson.value("y", 0) * tileSize.y + layerJson.value("offsety", 0.0f));
+
+        // A layer draws from one tileset, the one its first tile uses
+        const TiledTileset* tileset = nullptr;
+        size_t foreign = 0;
+        outLayer.tiles.resize(data.size());
+        for (size_t i = 0; i < data.size(); ++i) {
+            uint32_t gid = data[i].get<uint32_t>() & TILED_GID_MASK;
+            if (gid == 0) {
+                outLayer.tiles[i] = 0;
+                continue;
+            }
+            if (!tileset) {
+                tileset = findTileset(tilesets, gid);
+                if (!tileset) return false;
+            }
+
+            uint32_t tile = gid - tileset->firstGid + 1;
+            if (gid < tileset->firstGid || (tileset->tileCount > 0 && tile > tileset->tileCount)) {
+                outLayer.tiles[i] = 0;
+                ++foreign;
+                continue;
+            }
+            outLayer.tiles[i] = tile;
+        }
+        if (foreign > 0) {
+            DEBUG_LOG_WARN("Tile layer " << outLayer.name << " dropped " << foreign << " tiles from a second tileset");
+        }
+        if (!tileset) {
+            return false;   // nothing to draw
+        }
+
+        outLayer.tileset = tileset->name;
+        outLayer.tilesetColumns = tileset->columns;
+        uint32_t tileCount = std::max<uint32_t>(tileset->tileCount, 1);
+        outLayer.tilesetRows = static_cast<int>((tileCount + tileset->columns - 1) / tileset->columns);
+
+        if (getBoolProperty(layerJson, "collision")) {
+            for (uint32_t tile = 1; tile <= tileCount; ++tile) {
+                outLayer.solidTiles.push_back(tile);
+            }
+        }
+        else {
+            outLayer.solidTiles = tileset->solidTiles;
+        }
+        return true;
+    }
+}
+
+bool TileMapLoader::loadTiled(const std::string& path, std::vector<TileLayerData>& outLayers) {
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Failed to open tile map: " << path << std::endl;
+        return false;
+    }
+
+    try {
+        json map = json::parse(file);
+        if (map.value("orientation", std::string("orthogonal")) != "orthogonal") {
+            DEBUG_LOG_ERROR("Tile map " << path << " is not orthogonal");
+            return false;
+        }
+
+        glm::vec2 tileSize(map.value("tilewidth", 32.0f), map.value("tileheight", 32.0f));
+
+        std::vector<TiledTileset> tilesets;
+        for (const auto& tilesetJson : map["tilesets"]) {
+            TiledTileset tileset;
+            if (parseTileset(tilesetJson, tileset)) {
+                tilesets.push_back(std::move(tileset));
+            }
+        }
+
+        for (const auto& layerJson : map["layers"]) {
+            if (layerJson.value("type", std::string()) != "tilelayer" || !layerJson.value("visible", true)) continue;
+
+            TileLayerData layer;
+            if (parseLayer(layerJson, tilesets, tileSize, layer)) {
+                outLayers.push_back(std::move(layer));
+            }
+        }
+        return true;
+    }
+    catch (const json::exception& e) {
+        DEBUG_LOG_ERROR("Tile map " << path << ": " << e.what());
+        return false;
+    }
+}
+
+std::vector<TileRect> TileMapLoader::mergeSolidTiles(const TileLayerData& layer) {
+    std::vector<TileRect> rects;
+    if (layer.solidTiles.empty()) return rects;
+
+    uint32_t maxTile = *std::max_element(layer.solidTiles.begin(), layer.solidTiles.end());
+    std::vector<uint8_t> isSolidTile(maxTile + 1, 0);
+    for (uint32_t tile : layer.solidTiles) {
+        isSolidTile[tile] = 1;
+    }
+
+    // 1 while a solid tile still needs covering
+    std::vector<uint8_t> open(layer.tiles.size());
+    for (size_t i = 0; i < layer.tiles.size(); ++i) {
+        uint32_t tile = layer.tiles[i];
+        open[i] = tile != 0 && tile <= maxTile && isSolidTile[tile];
+    }
+
+    const int width = layer.width;
+    auto isOpen = [&](int x, int y) { return open[static_cast<size_t>(y) * width + x] != 0; };
+
+    for (int y = 0; y < layer.height; ++y) {
+        for (int x = 0; x < width; ++x) {
+            if (!isOpen(x, y)) continue;
+
+            int runWidth = 1;
+            while (x + runWidth < width && isOpen(x + runWidth, y)) {
+                ++runWidth;
+            }
+
+            int runHeight = 1;
+            while (y + runHeight < layer.height) {
+                bool fullRow = true;
+                for (int dx = 0; dx < runWidth && fullRow; ++dx) {
+                    fullRow = isOpen(x + dx, y + runHeight);
+                }
+                if (!fullRow) break;
+                ++runHeight;
+            }
+
+            for (int dy = 0; dy < runHeight; ++dy) {
+                std::fill_n(open.begin() + static_cast<size_t>(y + dy) * width + x, runWidth, uint8_t(0));
+            }
+            rects.push_back({ x, y, runWidth, runHeight });
+        }
+    }
+    return rects;
+}
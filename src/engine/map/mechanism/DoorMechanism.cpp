@@ -1,17 +1,14 @@
 #include "../../../../include/headers/map/mechanism/DoorMechanism.h"
+#include "../../../../include/headers/collision/CollisionManager.h"
 #include "../../../../include/headers/CommonDefines.h"
 #include "../../../../include/headers/audio/AudioManager.h"
 
-DoorMechanism::DoorMechanism(const std::string& id, const glm::vec2& position, const glm::vec2& size)
+DoorMechanism::DoorMechanism(const std::string& id, const glm::vec2& position, const glm::vec2& size,
+    std::shared_ptr<const DoorPrototype> prototype)
     : IMechanism(id, MechanismType::Door)
+    , m_prototype(prototype ? std::move(prototype) : MechanismPrototypes::getInstance().getDefaultDoor())
     , m_doorState(DoorState::Closed)
     , m_transitionProgress(0.0f)
-    , m_transitionDuration(0.5f)
-    , m_openSpeed(DOOR_OPEN_SPEED)
-    , m_closeSpeed(DOOR_CLOSE_SPEED)
-    , m_closedColor(0.8f, 0.2f, 0.2f, 1.0f)
-    , m_openColor(0.2f, 0.8f, 0.2f, 0.5f)
-    , m_lockedColor(0.5f, 0.1f, 0.1f, 1.0f)
 {
     DEBUG_LOG("Creating door with size: (" << size.x << ", " << size.y << ") at position: ("<< position.x << ", " << position.y << ")");
     auto collider = std::make_unique<BoxCollider>(position, size);
@@ -30,7 +27,8 @@ void DoorMechanism::activate() {
     if (m_doorState == DoorState::Closed || m_doorState == DoorState::Closing) {
         AudioManager::getInstance().playSFX("door");
         m_doorState = DoorState::Opening;
-        m_state = MechanismState::Active;
+        setState(MechanismState::Active);
+        wake();
         DEBUG_LOG("Door is opening");
     }
 }
@@ -44,7 +42,8 @@ void DoorMechanism::deactivate() {
     if (m_doorState == DoorState::Open || m_doorState == DoorState::Opening) {
         DEBUG_LOG("Door is closing");
         m_doorState = DoorState::Closing;
-        m_state = MechanismState::Inactive;
+        setState(MechanismState::Inactive);
+        wake();
     }
 }
 
@@ -58,6 +57,17 @@ void DoorMechanism::reset()
 {
 }
 
+void DoorMechanism::restoreState(const IMechanism& previous) {
+    IMechanism::restoreState(previous);
+
+    const auto& door = static_cast<const DoorMechanism&>(previous);
+    m_doorState = door.m_doorState;
+    m_transitionProgress = door.m_transitionProgress;
+    updateCollider();
+    updateVisuals();
+    wake();
+}
+
 void DoorMechanism::updateDoorState(float deltaTime) {
     float targetProgress = 0.0f;
     float speed = 0.0f;
@@ -65,11 +75,11 @@ void DoorMechanism::updateDoorState(float deltaTime) {
     switch (m_doorState) {
     case DoorState::Opening:
         targetProgress = 1.0f;
-        speed = m_openSpeed;
+        speed = m_prototype->openSpeed;
         break;
     case DoorState::Closing:
         targetProgress = 0.0f;
-        speed = m_closeSpeed;
+        speed = m_prototype->closeSpeed;
         break;
     default:
         return;
@@ -93,7 +103,7 @@ void DoorMechanism::updateCollider() {
     auto doorLayer = CollisionManager::getInstance().getDefaultLayer(CollisionLayerBits::Door);
 
     if (m_doorState == DoorState::Open ||
-        (m_doorState == DoorState::Opening && m_transitionProgress >= COLLISION_DISABLE_THRESHOLD)) {
+        (m_doorState == DoorState::Opening && m_transitionProgress >= m_prototype->collisionDisableThreshold)) {
         collider->setCollisionLayer(static_cast<uint32_t>(CollisionLayerBits::None));
         collider->setCollisionMask(0);
         //DEBUG_LOG("Door " << getId() << " collision disabled");
@@ -111,9 +121,9 @@ void DoorMechanism::updateVisuals() {
 
 glm::vec4 DoorMechanism::getCurrentColor() const {
     if (m_doorState == DoorState::Locked) {
-        return m_lockedColor;
+        return m_prototype->lockedColor;
     }
-    return glm::mix(m_closedColor, m_openColor, m_transitionProgress);
+    return glm::mix(m_prototype->closedColor, m_prototype->openColor, m_transitionProgress);
 }
 
 void DoorMechanism::setLocked(bool locked) {
@@ -121,9 +131,12 @@ void DoorMechanism::setLocked(bool locked) {
         m_doorState = DoorState::Locked;
         m_transitionProgress = 0.0f;
         updateCollider();
+        wake();
     }
     else if (!locked && m_doorState == DoorState::Locked) {
         m_doorState = DoorState::Closed;
+        updateCollider();
+        wake();
     }
 }
 
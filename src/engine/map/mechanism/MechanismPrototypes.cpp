@@ -0,0 +1,119 @@
+#include "../../../../include/headers/map/mechanism/MechanismPrototypes.h"
+#include <algorithm>
+#include <cstring>
+#include <iterator>
+#include <type_traits>
+
+namespace {
+    template<typename T>
+    void appendValue(std::string& key, const T& value) {
+        static_assert(std::is_trivially_copyable<T>::value, "raw bytes only");
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        key.append(bytes, sizeof(T));
+    }
+
+    void appendString(std::string& key, const std::string& value) {
+        appendValue(key, static_cast<uint32_t>(value.size()));
+        key += value;
+    }
+
+    bool compile(const std::string& source, std::shared_ptr<const ExpressionProgram>& outProgram, std::string* outError) {
+        outProgram.reset();
+        if (source.empty()) return true;
+
+        std::string error;
+        outProgram = ExpressionProgram::compile(source, &error);
+        if (!outProgram && outError) {
+            *outError = "expression \"" + source + "\" " + error;
+        }
+        return outProgram != nullptr;
+    }
+
+    size_t stringBytes(const std::string& value) {
+        // Short strings live inside the object
+        return value.capacity() > 15 ? value.capacity() + 1 : 0;
+    }
+
+    size_t programBytes(const ExpressionProgram* program) {
+        return program ? sizeof(ExpressionProgram) + program->getInstructionCount() * sizeof(ExpressionInstruction) : 0;
+    }
+}
+
+std::shared_ptr<const TriggerPrototype> MechanismPrototypes::internTrigger(const TriggerCondition& condition,
+    const MechanismEffect& effect, std::string* outError) {
+    std::string key = makeKey(condition, effect);
+    auto it = m_triggers.find(key);
+    if (it != m_triggers.end()) {
+        if (auto shared = it->second.lock()) {
+            return shared;
+        }
+    }
+
+    auto prototype = std::make_shared<TriggerPrototype>();
+    prototype->condition = condition;
+    prototype->effect = effect;
+    if (!compile(condition.expression, prototype->condition.program, outError) ||
+        !compile(effect.valueExpression, prototype->effect.valueProgram, outError)) {
+        return nullptr;
+    }
+
+    m_triggers[std::move(key)] = prototype;
+    if (m_triggers.size() >= m_pruneAt) {
+        pruneExpired();
+    }
+    return prototype;
+}
+
+size_t MechanismPrototypes::getTriggerPrototypeCount() const {
+    size_t count = 0;
+    for (const auto& [key, prototype] : m_triggers) {
+        if (!prototype.expired()) ++count;
+    }
+    return count;
+}
+
+size_t MechanismPrototypes::getSharedBytes() const {
+    size_t bytes = sizeof(DoorPrototype);
+    for (const auto& [key, weak] : m_triggers) {
+        auto prototype = weak.lock();
+        if (!prototype) continue;
+
+        bytes += sizeof(TriggerPrototype) + stringBytes(key);
+        bytes += stringBytes(prototype->condition.expression) + programBytes(prototype->condition.program.get());
+        bytes += stringBytes(prototype->effect.targetId) + stringBytes(prototype->effect.valueExpression);
+        bytes += programBytes(prototype->effect.valueProgram.get());
+    }
+    return bytes;
+}
+
+std::string MechanismPrototypes::makeKey(const TriggerCondition& condition, const MechanismEffect& effect) {
+    // Everything the map data sets; compiled programs follow from the sources
+    std::string key;
+    key.reserve(128);
+    appendValue(key, condition.requiresPlayerPresence);
+    appendValue(key, condition.requiresInteraction);
+    appendValue(key, condition.triggerRadius);
+    appendString(key, condition.expression);
+
+    appendValue(key, effect.type);
+    appendString(key, effect.targetId);
+    appendValue(key, effect.duration);
+    appendValue(key, effect.value);
+    appendValue(key, effect.direction);
+    appendString(key, effect.valueExpression);
+    appendValue(key, effect.timing.isPeriodic);
+    appendValue(key, effect.timing.interval);
+    appendValue(key, effect.movement.startPos);
+    appendValue(key, effect.movement.endPos);
+    appendValue(key, effect.movement.speed);
+    appendValue(key, effect.movement.isLoop);
+    return key;
+}
+
+void MechanismPrototypes::pruneExpired() {
+    for (auto it = m_triggers.begin(); it != m_triggers.end();) {
+        it = it->second.expired() ? m_triggers.erase(it) : std::next(it);
+    }
+    m_pruneAt = std::max<size_t>(64, m_triggers.size() * 2);
+}
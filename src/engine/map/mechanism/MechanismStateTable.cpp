@@ -0,0 +1,189 @@
+#include "../../../../include/headers/map/mechanism/MechanismStateTable.h"
+#include "../../../../include/headers/CommonDefines.h"
+#include <algorithm>
+#include <unordered_map>
+
+namespace {
+    using json = nlohmann::json;
+
+    constexpr const char* BUILTIN_EVENTS[] = { "activate", "deactivate", "enter", "exit", "timeout" };
+    static_assert(sizeof(BUILTIN_EVENTS) / sizeof(BUILTIN_EVENTS[0]) == static_cast<size_t>(MachineEvent::Count),
+        "every MachineEvent needs a name");
+
+    bool readVec2(const json& value, glm::vec2& out) {
+        if (!value.is_object() || !value.contains("x") || !value.contains("y") ||
+            !value["x"].is_number() || !value["y"].is_number()) {
+            return false;
+        }
+        out = glm::vec2(value["x"].get<float>(), value["y"].get<float>());
+        return true;
+    }
+
+    // An absent field keeps its default, a present one has to have the right type
+    bool readNumber(const json& state, const char* key, float& out) {
+        if (!state.contains(key)) return true;
+        if (!state[key].is_number()) return false;
+        out = state[key].get<float>();
+        return true;
+    }
+
+    bool readFlag(const json& state, const char* key, uint8_t flag, uint8_t& flags) {
+        if (!state.contains(key)) return true;
+        if (!state[key].is_boolean()) return false;
+        if (state[key].get<bool>()) flags |= flag;
+        return true;
+    }
+
+    bool readColor(const json& value, glm::vec4& out) {
+        if (!value.is_array() || value.size() < 3 || value.size() > 4) return false;
+        for (const auto& channel : value) {
+            if (!channel.is_number()) return false;
+        }
+        out = glm::vec4(value[0].get<float>(), value[1].get<float>(), value[2].get<float>(),
+            value.size() == 4 ? value[3].get<float>() : 1.0f);
+        return true;
+    }
+}
+
+std::shared_ptr<const MechanismStateTable> MechanismStateTable::compile(const std::string& name, const json& definition) {
+    auto table = std::make_shared<MechanismStateTable>();
+    table->m_name = name;
+    bool valid = true;
+    auto fail = [&](const std::string& message) {
+        DEBUG_LOG_ERROR("Machine " << name << ": " << message);
+        valid = false;
+    };
+
+    if (!definition.is_object() || !definition.contains("states") || !definition["states"].is_array() || definition["states"].empty()) {
+        fail("needs a non-empty states array");
+        return nullptr;
+    }
+    if (definition["states"].size() > MAX_STATES) {
+        fail("has more than " + std::to_string(MAX_STATES) + " states");
+        return nullptr;
+    }
+
+    std::unordered_map<std::string, StateId> stateIds;
+    for (const auto& state : definition["states"]) {
+        if (!state.is_object() || !state.contains("name") || !state["name"].is_string()) {
+            fail("state " + std::to_string(table->m_states.size()) + " has no name");
+            continue;
+        }
+
+        std::string stateName = state["name"].get<std::string>();
+        if (!stateIds.emplace(stateName, static_cast<StateId>(table->m_states.size())).second) {
+            fail("state '" + stateName + "' is defined twice");
+            continue;
+        }
+
+        MachineStateInfo info;
+        if (!readNumber(state, "timeout", info.timeout)) fail("state '" + stateName + "' has a non-numeric timeout");
+        if (!readNumber(state, "moveTime", info.moveTime)) fail("state '" + stateName + "' has a non-numeric moveTime");
+        info.timeout = std::max(0.0f, info.timeout);
+        info.moveTime = std::max(0.0f, info.moveTime);
+        if (!readFlag(state, "solid", MACHINE_STATE_SOLID, info.flags) ||
+            !readFlag(state, "active", MACHINE_STATE_ACTIVE, info.flags) ||
+            !readFlag(state, "final", MACHINE_STATE_FINAL, info.flags)) {
+            fail("state '" + stateName + "' has a non-boolean solid, active or final flag");
+        }
+        if (state.contains("offset")) {
+            if (!readVec2(state["offset"], info.offset)) fail("state '" + stateName + "' has a malformed offset");
+            table->m_hasMovement = true;
+        }
+        if (state.contains("color") && !readColor(state["color"], info.color)) {
+            fail("state '" + stateName + "' has a malformed color");
+        }
+
+        table->m_states.push_back(info);
+        table->m_stateNames.push_back(std::move(stateName));
+    }
+    if (table->m_states.empty()) return nullptr;
+
+    for (const char* builtin : BUILTIN_EVENTS) {
+        table->m_eventNames.push_back(builtin);
+    }
+
+    // Events are interned before the table is sized, so custom names get stable ids
+    const json noTransitions = json::array();
+    const json& transitions = definition.contains("transitions") ? definition["transitions"] : noTransitions;
+    if (!transitions.is_array()) {
+        fail("transitions must be an array");
+        return nullptr;
+    }
+    for (const auto& transition : transitions) {
+        if (!transition.is_object() || !transition.contains("on") || !transition["on"].is_string()) continue;
+        std::string event = transition["on"].get<std::string>();
+        if (table->findEvent(event) < 0) {
+            table->m_eventNames.push_back(std::move(event));
+        }
+    }
+    if (table->m_eventNames.size() > MAX_EVENTS) {
+        fail("uses more than " + std::to_string(MAX_EVENTS) + " events");
+        return nullptr;
+    }
+
+    table->m_eventCount = table->m_eventNames.size();
+    table->m_transitions.assign(table->m_states.size() * table->m_eventCount, NO_TRANSITION);
+
+    // Wildcards first so explicit rows overwrite them
+    for (int pass = 0; pass < 2; ++pass) {
+        for (const auto& transition : transitions) {
+            if (!transition.is_object() || !transition.contains("from") || !transition.contains("on") ||
+                !transition.contains("to") || !transition["from"].is_string() || !transition["on"].is_string() ||
+                !transition["to"].is_string()) {
+                if (pass == 0) fail("transition needs from, on and to");
+                continue;
+            }
+
+            std::string from = transition["from"].get<std::string>();
+            bool wildcard = from == "*";
+            if (wildcard != (pass == 0)) continue;
+
+            std::string to = transition["to"].get<std::string>();
+            auto target = stateIds.find(to);
+            auto source = stateIds.find(from);
+            if (target == stateIds.end() || (!wildcard && source == stateIds.end())) {
+                fail("transition " + from + " -> " + to + " names an unknown state");
+                continue;
+            }
+
+            auto event = static_cast<EventId>(table->findEvent(transition["on"].get<std::string>()));
+            table->m_handledEvents |= uint64_t(1) << event;
+            for (size_t state = 0; state < table->m_states.size(); ++state) {
+                bool applies = wildcard ? !(table->m_states[state].flags & MACHINE_STATE_FINAL) : state == source->second;
+                if (applies) {
+                    table->m_transitions[state * table->m_eventCount + event] = static_cast<int16_t>(target->second);
+                }
+            }
+        }
+    }
+
+    if (definition.contains("initial")) {
+        auto initial = definition["initial"].is_string() ? stateIds.find(definition["initial"].get<std::string>()) : stateIds.end();
+        if (initial == stateIds.end()) {
+            fail("initial state is not one of the states");
+        }
+        else {
+            table->m_initial = initial->second;
+        }
+    }
+
+    for (size_t state = 0; state < table->m_states.size(); ++state) {
+        const MachineStateInfo& info = table->m_states[state];
+        if (info.timeout > 0.0f && table->getNext(static_cast<StateId>(state), static_cast<EventId>(MachineEvent::Timeout)) == NO_TRANSITION) {
+            DEBUG_LOG_WARN("Machine " << name << ": state '" << table->m_stateNames[state] << "' has a timeout but no timeout transition");
+        }
+    }
+
+    return valid ? table : nullptr;
+}
+
+int MechanismStateTable::findState(const std::string& name) const {
+    auto it = std::find(m_stateNames.begin(), m_stateNames.end(), name);
+    return it != m_stateNames.end() ? static_cast<int>(it - m_stateNames.begin()) : -1;
+}
+
+int MechanismStateTable::findEvent(const std::string& name) const {
+    auto it = std::find(m_eventNames.begin(), m_eventNames.end(), name);
+    return it != m_eventNames.end() ? static_cast<int>(it - m_eventNames.begin()) : -1;
+}
@@ -0,0 +1,299 @@
+#include "../../../../include/headers/map/mechanism/MechanismStore.h"
+#include "../../../../include/headers/Engine.h"
+#include "../../../../include/headers/CommonDefines.h"
+#include <algorithm>
+#include <iostream>
+
+namespace {
+    // Entity effects address IEffectTargets registered at runtime, not mechanisms
+    bool needsMechanismTarget(EffectType type) {
+        return type == EffectType::None || type == EffectType::OpenGate;
+    }
+}
+
+IMechanism* MechanismStore::add(std::unique_ptr<IMechanism> mechanism) {
+    if (!mechanism) return nullptr;
+
+    // The pools hold values: the mechanism is moved in and the husk dropped
+    IMechanism* stored = nullptr;
+    switch (mechanism->getType()) {
+    case MechanismType::Door:
+        remove(mechanism->getId());
+        stored = m_doors.add(std::move(static_cast<DoorMechanism&>(*mechanism)));
+        break;
+    case MechanismType::Trigger:
+        remove(mechanism->getId());
+        stored = m_triggers.add(std::move(static_cast<TriggerMechanism&>(*mechanism)));
+        break;
+    case MechanismType::Sequence:
+        remove(mechanism->getId());
+        stored = m_sequences.add(std::move(static_cast<SequenceMechanism&>(*mechanism)));
+        break;
+    case MechanismType::Breakable:
+    case MechanismType::Trap:
+    case MechanismType::BuffZone:
+    case MechanismType::MovingPlatform:
+        remove(mechanism->getId());
+        stored = m_machines.add(std::move(static_cast<StateMachineMechanism&>(*mechanism)));
+        break;
+    default:
+        DEBUG_LOG_WARN("No pool for mechanism " << mechanism->getId() << " of type " << static_cast<int>(mechanism->getType()));
+        return nullptr;
+    }
+
+    m_index[stored->getId()] = stored;
+    // One update to settle, then it sleeps if it has nothing to do
+    stored->getSchedule() = IMechanism::Schedule();
+    stored->getSchedule().scheduler = this;
+    wake(*stored);
+
+    if (stored->getType() == MechanismType::Trigger) {
+        linkTrigger(static_cast<TriggerMechanism&>(*stored));
+    }
+    resolveDependents(stored->getId());
+    return stored;
+}
+
+bool MechanismStore::remove(const std::string& id) {
+    auto it = m_index.find(id);
+    if (it == m_index.end()) return false;
+
+    IMechanism* mechanism = it->second;
+    m_index.erase(it);
+    if (mechanism->getType() == MechanismType::Trigger) {
+        unlinkTrigger(static_cast<TriggerMechanism&>(*mechanism));
+    }
+    resolveDependents(id);
+    unschedule(*mechanism);
+
+    switch (mechanism->getType()) {
+    case MechanismType::Door:
+        return m_doors.remove(static_cast<DoorMechanism*>(mechanism));
+    case MechanismType::Trigger:
+        return m_triggers.remove(static_cast<TriggerMechanism*>(mechanism));
+    case MechanismType::Sequence:
+        return m_sequences.remove(static_cast<SequenceMechanism*>(mechanism));
+    case MechanismType::Breakable:
+    case MechanismType::Trap:
+    case MechanismType::BuffZone:
+    case MechanismType::MovingPlatform:
+        return m_machines.remove(static_cast<StateMachineMechanism*>(mechanism));
+    default:
+        return false;
+    }
+}
+
+void MechanismStore::clear() {
+    m_scripts.clear();
+    m_index.clear();
+    m_dependents.clear();
+    m_awakeDoors.clear();
+    m_awakeTriggers.clear();
+    m_awakeSequences.clear();
+    m_awakeMachines.clear();
+    m_ticked.clear();
+    m_timers.clear();
+    m_doors.clear();
+    m_triggers.clear();
+    m_sequences.clear();
+    m_machines.clear();
+}
+
+IMechanism* MechanismStore::find(const std::string& id) const {
+    auto it = m_index.find(id);
+    return it != m_index.end() ? it->second : nullptr;
+}
+
+void MechanismStore::update(float deltaTime) {
+    m_fired.clear();
+    m_timers.advance(deltaTime, m_fired);
+    for (void* payload : m_fired) {
+        auto* mechanism = static_cast<IMechanism*>(payload);
+        mechanism->getSchedule().timer = TimerWheel::INVALID_TIMER;
+        wake(*mechanism);
+    }
+    m_scripts.update(deltaTime);
+
+    m_ticked.clear();
+    tick(m_awakeDoors, deltaTime);
+    evaluateConditions();
+    tick(m_awakeTriggers, deltaTime);
+    tick(m_awakeSequences, deltaTime);
+    tick(m_awakeMachines, deltaTime);
+}
+
+template<typename T>
+void MechanismStore::tick(std::vector<T*>& awake, float deltaTime) {
+    double now = m_timers.getTime();
+
+    // Mechanisms woken while this runs wait for the next frame
+    size_t count = awake.size();
+    for (size_t i = 0; i < count; ++i) {
+        T* mechanism = awake[i];
+        auto& schedule = mechanism->getSchedule();
+        float step = schedule.timed ? static_cast<float>(now - schedule.lastUpdate) : deltaTime;
+        schedule.timed = false;
+        schedule.lastUpdate = now;
+
+        // The mechanism classes are final, so these calls bind at compile time
+        mechanism->update(step);
+        m_ticked.push_back(mechanism);
+    }
+
+    size_t kept = 0;
+    for (size_t i = 0; i < awake.size(); ++i) {
+        T* mechanism = awake[i];
+        if (i < count && mechanism->isDormant()) {
+            mechanism->getSchedule().awake = false;
+            continue;
+        }
+        awake[kept++] = mechanism;
+    }
+    awake.resize(kept);
+}
+
+void MechanismStore::evaluateConditions() {
+    m_conditionOwners.clear();
+    m_conditionPrograms.clear();
+    m_conditionContexts.clear();
+    for (TriggerMechanism* trigger : m_awakeTriggers) {
+        const ExpressionProgram* program = trigger->getConditionProgram();
+        if (!program || !trigger->isActive()) continue;
+
+        m_conditionOwners.push_back(trigger);
+        m_conditionPrograms.push_back(program);
+        m_conditionContexts.push_back(trigger->getExpressionContext());
+    }
+    if (m_conditionOwners.empty()) return;
+
+    // One environment for the whole frame instead of a lookup per trigger
+    m_conditionResults.resize(m_conditionOwners.size());
+    ExpressionProgram::evaluateBatch(Engine::getInstance().getExpressionEnvironment(), m_conditionPrograms.data(),
+        m_conditionContexts.data(), m_conditionOwners.size(), m_conditionResults.data());
+    for (size_t i = 0; i < m_conditionOwners.size(); ++i) {
+        m_conditionOwners[i]->setConditionResult(m_conditionResults[i] != 0);
+    }
+}
+
+void MechanismStore::wake(IMechanism& mechanism) {
+    auto& schedule = mechanism.getSchedule();
+    if (schedule.awake || schedule.scheduler != this) return;
+    schedule.awake = true;
+
+    switch (mechanism.getType()) {
+    case MechanismType::Door:
+        m_awakeDoors.push_back(static_cast<DoorMechanism*>(&mechanism));
+        break;
+    case MechanismType::Trigger:
+        m_awakeTriggers.push_back(static_cast<TriggerMechanism*>(&mechanism));
+        break;
+    case MechanismType::Sequence:
+        m_awakeSequences.push_back(static_cast<SequenceMechanism*>(&mechanism));
+        break;
+    case MechanismType::Breakable:
+    case MechanismType::Trap:
+    case MechanismType::BuffZone:
+    case MechanismType::MovingPlatform:
+        m_awakeMachines.push_back(static_cast<StateMachineMechanism*>(&mechanism));
+        break;
+    default:
+        schedule.awake = false;
+        break;
+    }
+}
+
+void MechanismStore::wakeAfter(IMechanism& mechanism, float delay) {
+    auto& schedule = mechanism.getSchedule();
+    if (schedule.scheduler != this) return;
+
+    // One pending timer per mechanism, the latest request wins
+    m_timers.cancel(schedule.timer);
+    schedule.timer = m_timers.schedule(delay, &mechanism);
+    schedule.timed = true;
+}
+
+void MechanismStore::unschedule(IMechanism& mechanism) {
+    auto& schedule = mechanism.getSchedule();
+    m_timers.cancel(schedule.timer);
+    m_scripts.cancelOwned(&mechanism);
+
+    auto erase = [&mechanism](auto& list) {
+        list.erase(std::remove(list.begin(), list.end(), &mechanism), list.end());
+    };
+    erase(m_awakeDoors);
+    erase(m_awakeTriggers);
+    erase(m_awakeSequences);
+    erase(m_awakeMachines);
+    erase(m_ticked);
+    schedule = IMechanism::Schedule();
+}
+
+void MechanismStore::linkTrigger(TriggerMechanism& trigger) {
+    const std::string& targetId = trigger.getTargetId();
+    if (targetId.empty() || targetId == trigger.getId()) return;
+
+    m_dependents[targetId].push_back(&trigger);
+    trigger.setTargetDoor(find<DoorMechanism>(targetId));
+}
+
+void MechanismStore::unlinkTrigger(TriggerMechanism& trigger) {
+    auto it = m_dependents.find(trigger.getTargetId());
+    if (it == m_dependents.end()) return;
+
+    auto& triggers = it->second;
+    triggers.erase(std::remove(triggers.begin(), triggers.end(), &trigger), triggers.end());
+    if (triggers.empty()) {
+        m_dependents.erase(it);
+    }
+    trigger.setTargetDoor(nullptr);
+}
+
+void MechanismStore::resolveDependents(const std::string& targetId) {
+    auto it = m_dependents.find(targetId);
+    if (it == m_dependents.end()) return;
+
+    DoorMechanism* door = find<DoorMechanism>(targetId);
+    for (TriggerMechanism* trigger : it->second) {
+        trigger->setTargetDoor(door);
+    }
+}
+
+size_t MechanismStore::getInstanceBytes() const {
+    size_t bytes = m_doors.getReservedBytes() + m_triggers.getReservedBytes() +
+        m_sequences.getReservedBytes() + m_machines.getReservedBytes();
+    forEach([&bytes](const IMechanism& mechanism) {
+        if (mechanism.getCollider()) bytes += sizeof(BoxCollider);
+        if (mechanism.getId().capacity() > 15) bytes += mechanism.getId().capacity() + 1;
+    });
+    return bytes;
+}
+
+size_t MechanismStore::validateLinks(const std::string& areaId) const {
+    size_t dangling = 0;
+
+    m_triggers.forEach([&](const TriggerMechanism& trigger) {
+        if (!needsMechanismTarget(trigger.getEffectType()) || trigger.getTargetDoor()) return;
+
+        if (!find(trigger.getTargetId())) {
+            std::cerr << "Trigger " << trigger.getId() << " in area " << areaId
+                << " targets unknown mechanism '" << trigger.getTargetId() << "'" << std::endl;
+        }
+        else {
+            std::cerr << "Trigger " << trigger.getId() << " in area " << areaId
+                << " targets " << trigger.getTargetId() << ", which is not a door" << std::endl;
+        }
+        ++dangling;
+    });
+
+    m_sequences.forEach([&](const SequenceMechanism& sequence) {
+        for (const auto& step : sequence.getSteps()) {
+            if (!find<TriggerMechanism>(step)) {
+                std::cerr << "Sequence " << sequence.getId() << " in area " << areaId
+                    << " has step '" << step << "' that names no trigger" << std::endl;
+                ++dangling;
+            }
+        }
+    });
+
+    return dangling;
+}
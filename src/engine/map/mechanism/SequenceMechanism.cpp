@@ -6,44 +6,52 @@ SequenceMechanism::SequenceMechanism(const std::string& id,
     , m_sequence(sequence)
     , m_currentStep(0)
     , m_timeLimit(0.0f)
-    , m_timer(0.0f) {
+    , m_startedAt(0.0) {
 }
 
 void SequenceMechanism::activate() {
     if (m_state != MechanismState::Active) {
-        m_state = MechanismState::Active;
-        m_timer = 0.0f;
+        setState(MechanismState::Active);
+        startTimeLimit(m_timeLimit);
     }
 }
 
 void SequenceMechanism::deactivate() {
     if (m_state == MechanismState::Active) {
-        m_state = MechanismState::Inactive;
         handleSequenceFailure();
     }
 }
 
 void SequenceMechanism::update(float deltaTime) {
-    if (m_state != MechanismState::Active) return;
-
-    if (m_timeLimit > 0.0f) {
-        m_timer += deltaTime;
-        if (m_timer >= m_timeLimit) {
-            handleSequenceFailure();
-            return;
-        }
-    }
-
-    if (isSequenceComplete()) {
-        m_state = MechanismState::Finished;
-    }
+    // Nothing per frame: steps come from activateTrigger, the time limit is a script
 }
 
 void SequenceMechanism::reset() {
+    cancelScript(m_timeLimitScript);
     m_currentSequence.clear();
     m_currentStep = 0;
-    m_timer = 0.0f;
-    m_state = MechanismState::Inactive;
+    setState(MechanismState::Inactive);
+}
+
+float SequenceMechanism::getElapsed() const {
+    return m_state == MechanismState::Active ? static_cast<float>(getScriptTime() - m_startedAt) : 0.0f;
+}
+
+void SequenceMechanism::restoreState(const IMechanism& previous) {
+    const auto& sequence = static_cast<const SequenceMechanism&>(previous);
+
+    // Progress only makes sense if the steps didn't change
+    if (sequence.m_sequence != m_sequence) {
+        return;
+    }
+
+    IMechanism::restoreState(previous);
+    m_currentSequence = sequence.m_currentSequence;
+    m_currentStep = sequence.m_currentStep;
+    if (m_state == MechanismState::Active) {
+        startTimeLimit(m_timeLimit - sequence.getElapsed());
+        m_startedAt -= sequence.getElapsed();
+    }
 }
 
 void SequenceMechanism::activateTrigger(const std::string& triggerId) {
@@ -55,7 +63,8 @@ void SequenceMechanism::activateTrigger(const std::string& triggerId) {
         m_currentStep++;
 
         if (isSequenceComplete()) {
-            m_state = MechanismState::Finished;
+            cancelScript(m_timeLimitScript);
+            setState(MechanismState::Finished);
         }
     }
     else {
@@ -78,8 +87,25 @@ bool SequenceMechanism::validateSequence() const {
 }
 
 void SequenceMechanism::handleSequenceFailure() {
+    cancelScript(m_timeLimitScript);
     m_currentSequence.clear();
     m_currentStep = 0;
 
-    m_state = MechanismState::Inactive;
-}
\ No newline at end of file
+    setState(MechanismState::Inactive);
+}
+
+void SequenceMechanism::startTimeLimit(float remaining) {
+    cancelScript(m_timeLimitScript);
+    m_startedAt = getScriptTime();
+    if (m_timeLimit > 0.0f) {
+        m_timeLimitScript = startScript(runTimeLimit(remaining));
+    }
+}
+
+ScriptTask SequenceMechanism::runTimeLimit(float seconds) {
+    co_await ScriptDelay{ seconds };
+
+    // Still running when time is up, completing would have cancelled this
+    m_timeLimitScript = ScriptScheduler::INVALID_SCRIPT;
+    handleSequenceFailure();
+}
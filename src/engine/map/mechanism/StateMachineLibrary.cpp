@@ -0,0 +1,39 @@
+#include "../../../../include/headers/map/mechanism/StateMachineLibrary.h"
+#include "../../../../include/headers/resource/ResourceManager.h"
+#include "../../../../include/headers/CommonDefines.h"
+
+std::shared_ptr<const MechanismStateTable> StateMachineLibrary::getMachine(const std::string& name) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // Failures are cached too, so a broken file is reported once per load
+    auto it = m_machines.find(name);
+    if (it != m_machines.end()) {
+        return it->second;
+    }
+
+    nlohmann::json json;
+    std::shared_ptr<const MechanismStateTable> table;
+    if (!ResourceManager::getInstance().loadMechanismConfig("machines", name, json) || json.is_null()) {
+        DEBUG_LOG_ERROR("Machine " << name << " not found at " << ResourceManager::getMechanismPath("machines", name));
+    }
+    else {
+        table = MechanismStateTable::compile(name, json);
+        if (table) {
+            DEBUG_LOG("Compiled machine " << name << ": " << table->getStateCount() << " states, "
+                << table->getEventCount() << " events");
+        }
+    }
+
+    m_machines[name] = table;
+    return table;
+}
+
+void StateMachineLibrary::setMachine(const std::string& name, std::shared_ptr<const MechanismStateTable> table) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_machines[name] = std::move(table);
+}
+
+void StateMachineLibrary::clear() {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_machines.clear();
+}
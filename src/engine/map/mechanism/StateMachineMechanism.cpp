@@ -0,0 +1,174 @@
+#include "../../../../include/headers/map/mechanism/StateMachineMechanism.h"
+#include "../../../../include/headers/collision/CollisionManager.h"
+#include "../../../../include/headers/renderer/Renderer.h"
+#include "../../../../include/headers/CommonDefines.h"
+#include <algorithm>
+
+StateMachineMechanism::StateMachineMechanism(const std::string& id, MechanismType type,
+    std::shared_ptr<const MechanismStateTable> table,
+    const glm::vec2& position, const glm::vec2& size)
+    : IMechanism(id, type)
+    , m_table(std::move(table))
+    , m_current(m_table->getInitialState())
+    , m_origin(position)
+{
+    auto collider = std::make_unique<BoxCollider>(position, size);
+    collider->setMoving(m_table->hasMovement());
+    setCollider(std::move(collider));
+    applyState();
+}
+
+void StateMachineMechanism::update(float deltaTime) {
+    m_stateTime += deltaTime;
+    if (m_moving) {
+        updateMovement();
+    }
+
+    const MachineStateInfo& info = m_table->getState(m_current);
+    auto timeout = static_cast<MechanismStateTable::EventId>(MachineEvent::Timeout);
+    if (info.timeout > 0.0f && m_stateTime >= info.timeout &&
+        m_table->getNext(m_current, timeout) != MechanismStateTable::NO_TRANSITION &&
+        m_pendingCount < MAX_PENDING_EVENTS) {
+        m_pending[m_pendingCount++] = timeout;
+    }
+
+    // Whatever is left past the budget waits for the next frame
+    size_t handled = 0;
+    while (handled < m_pendingCount && handled < MAX_STEPS_PER_UPDATE) {
+        MechanismStateTable::EventId event = m_pending[handled++];
+        if (m_table->getState(m_current).flags & MACHINE_STATE_FINAL) continue;
+
+        int16_t next = m_table->getNext(m_current, event);
+        if (next != MechanismStateTable::NO_TRANSITION) {
+            enterState(static_cast<MechanismStateTable::StateId>(next));
+        }
+    }
+    std::copy(m_pending.begin() + handled, m_pending.begin() + m_pendingCount, m_pending.begin());
+    m_pendingCount -= handled;
+}
+
+void StateMachineMechanism::reset() {
+    m_pendingCount = 0;
+    enterState(m_table->getInitialState());
+    wake();
+}
+
+void StateMachineMechanism::restoreState(const IMechanism& previous) {
+    const auto& machine = static_cast<const StateMachineMechanism&>(previous);
+
+    // States are matched by name, the edited machine may have renumbered them
+    int state = m_table->findState(machine.m_table->getStateName(machine.m_current));
+    if (state < 0) {
+        DEBUG_LOG("Machine " << getId() << " lost state " << machine.m_table->getStateName(machine.m_current)
+            << ", starting over");
+        return;
+    }
+
+    if (auto* collider = getCollider()) {
+        if (m_table->hasMovement() && machine.getCollider()) {
+            collider->setPosition(machine.getCollider()->getPosition());
+        }
+    }
+    m_current = static_cast<MechanismStateTable::StateId>(state);
+    m_stateTime = machine.m_stateTime;
+    applyState();
+
+    const MachineStateInfo& info = m_table->getState(m_current);
+    if (info.timeout > 0.0f) {
+        wakeAfter(std::max(0.0f, info.timeout - m_stateTime));
+    }
+    wake();
+}
+
+void StateMachineMechanism::render() {
+    auto* collider = getCollider();
+    const glm::vec4& color = m_table->getState(m_current).color;
+    if (!collider || color.a <= 0.0f) return;
+
+    Renderer::getInstance().drawRect(collider->getPosition(), collider->getSize(), glm::vec3(color), color.a);
+}
+
+void StateMachineMechanism::sendEvent(MechanismStateTable::EventId event) {
+    if (event >= m_table->getEventCount()) return;
+    if (m_table->getState(m_current).flags & MACHINE_STATE_FINAL) return;
+
+    if (m_pendingCount == MAX_PENDING_EVENTS) {
+        DEBUG_LOG_WARN("Machine " << getId() << " dropped event, queue is full");
+        return;
+    }
+    m_pending[m_pendingCount++] = event;
+    wake();
+}
+
+bool StateMachineMechanism::sendEvent(const std::string& event) {
+    int id = m_table->findEvent(event);
+    if (id < 0) return false;
+
+    sendEvent(static_cast<MechanismStateTable::EventId>(id));
+    return true;
+}
+
+void StateMachineMechanism::onOverlap(const OverlapEvent& event) {
+    if (event.type == OverlapEventType::Enter) {
+        sendEvent(static_cast<MechanismStateTable::EventId>(MachineEvent::Enter));
+    }
+    else if (event.type == OverlapEventType::Exit) {
+        sendEvent(static_cast<MechanismStateTable::EventId>(MachineEvent::Exit));
+    }
+}
+
+bool StateMachineMechanism::usesOverlap() const {
+    return m_table->handlesEvent(MachineEvent::Enter) || m_table->handlesEvent(MachineEvent::Exit);
+}
+
+void StateMachineMechanism::enterState(MechanismStateTable::StateId state) {
+    m_current = state;
+    m_stateTime = 0.0f;
+    applyState();
+
+    const MachineStateInfo& info = m_table->getState(m_current);
+    if (info.timeout > 0.0f) {
+        wakeAfter(info.timeout);
+    }
+}
+
+void StateMachineMechanism::applyState() {
+    const MachineStateInfo& info = m_table->getState(m_current);
+    if (info.flags & MACHINE_STATE_FINAL) setState(MechanismState::Finished);
+    else if (info.flags & MACHINE_STATE_ACTIVE) setState(MechanismState::Active);
+    else setState(MechanismState::Inactive);
+
+    auto* collider = getCollider();
+    if (!collider) return;
+
+    // Solid states block like a closed door, the rest only report overlaps
+    auto layer = CollisionManager::getInstance().getDefaultLayer(
+        (info.flags & MACHINE_STATE_SOLID) ? CollisionLayerBits::Door : CollisionLayerBits::Trigger);
+    collider->setCollisionLayer(layer.layer);
+    collider->setCollisionMask(layer.mask);
+
+    if (!m_table->hasMovement()) return;
+
+    glm::vec2 target = m_origin + info.offset;
+    if (info.moveTime > 0.0f && collider->getPosition() != target) {
+        m_moveFrom = collider->getPosition();
+        m_moving = true;
+    }
+    else {
+        collider->setPosition(target);
+        m_moving = false;
+    }
+}
+
+void StateMachineMechanism::updateMovement() {
+    auto* collider = getCollider();
+    const MachineStateInfo& info = m_table->getState(m_current);
+    if (!collider || info.moveTime <= 0.0f) {
+        m_moving = false;
+        return;
+    }
+
+    float progress = std::min(m_stateTime / info.moveTime, 1.0f);
+    collider->setPosition(glm::mix(m_moveFrom, m_origin + info.offset, progress));
+    m_moving = progress < 1.0f;
+}
@@ -1,17 +1,18 @@
 #include "../../../../include/headers/map/mechanism/TriggerMechanism.h"
+#include "../../../../include/headers/collision/CollisionManager.h"
 #include "../../../../include/headers/renderer/Renderer.h"
 #include <iostream>
 #include "../../../../include/headers/Engine.h"
 #include "../../../../include/headers/CommonDefines.h"
 #include "../../../../include/headers/audio/AudioManager.h"
 
-TriggerMechanism::TriggerMechanism(const std::string& id,
-    const TriggerCondition& condition,
-    const MechanismEffect& effect)
+TriggerMechanism::TriggerMechanism(const std::string& id, std::shared_ptr<const TriggerPrototype> prototype)
     : IMechanism(id, MechanismType::Trigger)
-    , m_condition(condition)
-    , m_effect(effect)
+    , m_prototype(std::move(prototype))
     , m_effectTimer(0.0f)
+    , m_effectValue(m_prototype->effect.value)
+    , m_platformStart(m_prototype->effect.movement.startPos)
+    , m_range(glm::vec2(0.0f), m_prototype->condition.triggerRadius > 0.0f ? m_prototype->condition.triggerRadius : 1.0f)
 {
     // Create default collider
     auto collider = std::make_unique<BoxCollider>(
@@ -25,43 +26,46 @@ TriggerMechanism::TriggerMechanism(const std::string& id,
     collider->setCollisionMask(triggerLayer.mask);
 
     setCollider(std::move(collider));
+
+    m_range.setCollisionLayer(triggerLayer.layer);
+    m_range.setCollisionMask(triggerLayer.mask);
+    syncRangeVolume();
 }
 
 void TriggerMechanism::activate() {
     DEBUG_LOG("Trigger " << getId() << " activated");
     if (m_state != MechanismState::Active) {
         AudioManager::getInstance().playSFX("trigger");
-        m_state = MechanismState::Active;
+        setState(MechanismState::Active);
         applyEffect();
+        startDuration(m_prototype->effect.duration);
+        wake();
     }
 }
 
 void TriggerMechanism::deactivate() {
     if (m_state == MechanismState::Active) {
-        m_state = MechanismState::Inactive;
+        cancelScript(m_durationScript);
+        setState(MechanismState::Inactive);
         removeEffect();
+        wake();     // a platform snapped back, the area resyncs its collider
     }
 }
 
 void TriggerMechanism::update(float deltaTime) {
     if (m_state == MechanismState::Active) {
-        // Update effect duration
-        if (m_effect.duration > 0) {
+        // Expiry is the duration script's job, the timer only drives movement and "time"
+        if (m_prototype->effect.duration > 0) {
             m_effectTimer += deltaTime;
-            if (m_effectTimer >= m_effect.duration) {
-                deactivate();
-                m_state = MechanismState::Finished;
-                return;
-            }
         }
 
         // Handle periodic effects
-        if (m_effect.timing.isPeriodic) {
+        if (m_prototype->effect.timing.isPeriodic) {
             applyPeriodicEffect(deltaTime);
         }
 
         // Handle movement effects
-        if (m_effect.type == EffectType::MovePlatform) {
+        if (m_prototype->effect.type == EffectType::MovePlatform) {
             handleMovementEffect(deltaTime);
         }
 
@@ -72,41 +76,102 @@ void TriggerMechanism::update(float deltaTime) {
     }
 }
 
+bool TriggerMechanism::isDormant() const {
+    return m_state != MechanismState::Active || !needsPolling();
+}
+
+bool TriggerMechanism::needsPolling() const {
+    // Radius triggers hear about the player through overlap events, everything
+    // else here changes from frame to frame
+    return m_prototype->condition.program || m_prototype->condition.triggerRadius <= 0.0f ||
+        m_prototype->effect.timing.isPeriodic || m_prototype->effect.type == EffectType::MovePlatform;
+}
+
 void TriggerMechanism::reset() {
     deactivate();
     m_effectTimer = 0.0f;
-    m_state = MechanismState::Inactive;
+    setState(MechanismState::Inactive);
 }
 
-bool TriggerMechanism::checkConditions() {
-    if (m_condition.customCondition && !m_condition.customCondition()) {
-        return false;
+void TriggerMechanism::restoreState(const IMechanism& previous) {
+    // Effects already applied stay applied, only the timer carries over
+    IMechanism::restoreState(previous);
+    const auto& trigger = static_cast<const TriggerMechanism&>(previous);
+    m_effectTimer = trigger.m_effectTimer;
+    m_effectValue = trigger.m_effectValue;
+    m_periodTimer = trigger.m_periodTimer;
+    m_platformStart = trigger.m_platformStart;
+    if (m_state == MechanismState::Active && m_prototype->effect.duration > 0) {
+        float elapsed = static_cast<float>(trigger.getScriptTime() - trigger.m_effectStartedAt);
+        startDuration(m_prototype->effect.duration - elapsed);
+        m_effectStartedAt -= elapsed;
+    }
+    wake();
+}
+
+MechanismEffect& TriggerMechanism::overrideEffect() {
+    // Copy on write: the shared prototype stays as the map data wrote it
+    auto copy = std::make_shared<TriggerPrototype>(*m_prototype);
+    MechanismEffect& effect = copy->effect;
+    m_prototype = std::move(copy);
+    return effect;
+}
+
+void TriggerMechanism::startDuration(float remaining) {
+    cancelScript(m_durationScript);
+    m_effectStartedAt = getScriptTime();
+    if (m_prototype->effect.duration > 0) {
+        m_durationScript = startScript(runDuration(remaining));
     }
+}
 
-    // Get player position
-    auto* playerCollider = Engine::getInstance().getPlayerCollider();
-    if (!playerCollider) return false;
+ScriptTask TriggerMechanism::runDuration(float seconds) {
+    co_await ScriptDelay{ seconds };
 
-    // Check if player is within trigger range
-    if (m_condition.triggerRadius > 0.0f) {
-        glm::vec2 triggerCenter = getCollider()->getPosition() +
-            getCollider()->getSize() * 0.5f;
-        glm::vec2 playerCenter = playerCollider->getPosition() +
-            playerCollider->getSize() * 0.5f;
+    m_durationScript = ScriptScheduler::INVALID_SCRIPT;
+    deactivate();
+    setState(MechanismState::Finished);
+}
+
+bool TriggerMechanism::checkConditions() {
+    if (m_prototype->condition.program) {
+        // Outside the store's batch the expression is run on the spot
+        bool met = m_conditionFresh ? m_conditionMet :
+            m_prototype->condition.program->test(Engine::getInstance().getExpressionEnvironment(), getExpressionContext());
+        m_conditionFresh = false;
+        if (!met) return false;
+    }
 
-        float distance = glm::length(triggerCenter - playerCenter);
-        return distance <= m_condition.triggerRadius;
+    // Radius triggers hear about the player through overlap events
+    if (m_prototype->condition.triggerRadius > 0.0f) {
+        return isOccupied();
     }
 
-    return true;
+    return Engine::getInstance().getPlayerCollider() != nullptr;
+}
+
+ExpressionContext TriggerMechanism::getExpressionContext() const {
+    ExpressionContext context;
+    if (const ICollider* collider = getCollider()) {
+        context.origin = collider->getPosition() + collider->getSize() * 0.5f;
+    }
+    context.time = m_effectTimer;
+    context.occupied = isOccupied();
+    return context;
 }
 
 void TriggerMechanism::applyEffect() {
-    switch (m_effect.type) {
+    const MechanismEffect& effect = m_prototype->effect;
+    if (effect.valueProgram) {
+        m_effectValue = effect.valueProgram->evaluate(Engine::getInstance().getExpressionEnvironment(),
+            getExpressionContext());
+    }
+
+    switch (effect.type) {
     case EffectType::Damage:
     case EffectType::Heal: {
-        if (auto* target = findTarget(m_effect.targetId)) {
-            float value = m_effect.type == EffectType::Damage ? -m_effect.value : m_effect.value;
+        if (auto* target = findTarget(effect.targetId)) {
+            float value = effect.type == EffectType::Damage ? -m_effectValue : m_effectValue;
             target->modifyHealth(value);
         }
         break;
@@ -114,33 +179,41 @@ void TriggerMechanism::applyEffect() {
 
     case EffectType::Buff:
     case EffectType::Debuff: {
-        if (auto* target = findTarget(m_effect.targetId)) {
-            target->applyStatusEffect(m_effect);
+        if (auto* target = findTarget(effect.targetId)) {
+            if (m_effectValue == effect.value) {
+                target->applyStatusEffect(effect);
+            }
+            else {
+                // Only computed values need their own copy
+                MechanismEffect applied = effect;
+                applied.value = m_effectValue;
+                target->applyStatusEffect(applied);
+            }
         }
         break;
     }
 
     case EffectType::MovePlatform: {
-        m_effect.movement.startPos = m_collider->getPosition();
+        m_platformStart = m_collider->getPosition();
         break;
     }
 
     case EffectType::Teleport: {
-        if (auto* target = findTarget(m_effect.targetId)) {
-            target->setPosition(m_effect.movement.endPos);
+        if (auto* target = findTarget(effect.targetId)) {
+            target->setPosition(effect.movement.endPos);
         }
         break;
     }
     }
-    DEBUG_LOG("Applied trigger effect to target: " << m_effect.targetId);
+    DEBUG_LOG("Applied trigger effect to target: " << effect.targetId);
 }
 
 void TriggerMechanism::removeEffect() {
-    switch (m_effect.type) {
+    switch (m_prototype->effect.type) {
     case EffectType::Buff:
     case EffectType::Debuff: {
-        if (auto* target = findTarget(m_effect.targetId)) {
-            target->removeStatusEffect(m_effect);
+        if (auto* target = findTarget(m_prototype->effect.targetId)) {
+            target->removeStatusEffect(m_prototype->effect);
         }
         break;
     }
@@ -148,7 +221,7 @@ void TriggerMechanism::removeEffect() {
     case EffectType::MovePlatform: {
         // Reset platform position
         if (auto* collider = getCollider()) {
-            collider->setPosition(m_effect.movement.startPos);
+            collider->setPosition(m_platformStart);
         }
         break;
     }
@@ -156,19 +229,19 @@ void TriggerMechanism::removeEffect() {
 }
 
 void TriggerMechanism::applyPeriodicEffect(float deltaTime) {
-    m_effect.timing.lastTriggerTime += deltaTime;
-    if (m_effect.timing.lastTriggerTime >= m_effect.timing.interval) {
+    m_periodTimer += deltaTime;
+    if (m_periodTimer >= m_prototype->effect.timing.interval) {
         applyEffect();
-        m_effect.timing.lastTriggerTime = 0.0f;
+        m_periodTimer = 0.0f;
     }
 }
 
 void TriggerMechanism::handleMovementEffect(float deltaTime) {
     if (auto* collider = getCollider()) {
-        float totalDistance = glm::length(m_effect.movement.endPos - m_effect.movement.startPos);
-        float progress = m_effectTimer * m_effect.movement.speed / totalDistance;
+        float totalDistance = glm::length(m_prototype->effect.movement.endPos - m_platformStart);
+        float progress = m_effectTimer * m_prototype->effect.movement.speed / totalDistance;
 
-        if (m_effect.movement.isLoop) {
+        if (m_prototype->effect.movement.isLoop) {
             progress = fmod(progress, 1.0f);
         }
         else {
@@ -181,8 +254,7 @@ void TriggerMechanism::handleMovementEffect(float deltaTime) {
 }
 
 glm::vec2 TriggerMechanism::calculateMovementPosition(float progress) {
-    return m_effect.movement.startPos +
-        (m_effect.movement.endPos - m_effect.movement.startPos) * progress;
+    return m_platformStart + (m_prototype->effect.movement.endPos - m_platformStart) * progress;
 }
 
 void TriggerMechanism::registerTarget(const std::string& id, IEffectTarget* target) {
@@ -218,14 +290,37 @@ bool TriggerMechanism::isPlayerInRange(const BoxCollider* playerCollider) const
     auto* triggerCollider = getCollider();
     if (!playerCollider || !triggerCollider) return false;
 
-    // Get player center position
-    glm::vec2 playerCenter = playerCollider->getPosition() + playerCollider->getSize() * 0.5f;
-    // Get trigger center position
-    glm::vec2 triggerCenter = triggerCollider->getPosition() + triggerCollider->getSize() * 0.5f;
+    if (m_prototype->condition.triggerRadius <= 0.0f) return false;
 
-    float distance = glm::length(playerCenter - triggerCenter);
+    // Radial trigger: the player's box has to reach into the circle around the trigger center.
+    // Squared distance to the box's closest point, same rule as ProximityKernel.
+    glm::vec2 center = triggerCollider->getPosition() + triggerCollider->getSize() * 0.5f;
+    Aabb player = playerCollider->getBounds();
+    glm::vec2 delta = glm::clamp(center, player.min, player.max) - center;
+    return glm::dot(delta, delta) < m_prototype->condition.triggerRadius * m_prototype->condition.triggerRadius;
+}
 
-    return distance <= m_condition.triggerRadius;
+void TriggerMechanism::syncRangeVolume() {
+    if (auto* collider = getCollider()) {
+        m_range.setCenter(collider->getPosition() + collider->getSize() * 0.5f);
+    }
+}
+
+void TriggerMechanism::onOverlap(const OverlapEvent& event) {
+    if (event.type == OverlapEventType::Enter) {
+        ++m_occupants;
+    }
+    else if (event.type == OverlapEventType::Exit && m_occupants > 0) {
+        --m_occupants;
+    }
+
+    if (event.type == OverlapEventType::Stay) return;
+    m_overlapSignal.notify();
+
+    // An active trigger rechecks its conditions
+    if (isActive()) {
+        wake();
+    }
 }
 
 void TriggerMechanism::initializeCollider(const glm::vec2& position, const glm::vec2& size) {
@@ -234,4 +329,5 @@ void TriggerMechanism::initializeCollider(const glm::vec2& position, const glm::
     collider->setCollisionLayer(triggerLayer.layer);
     collider->setCollisionMask(triggerLayer.mask);
     setCollider(std::move(collider));
+    syncRangeVolume();
 }
\ No newline at end of file
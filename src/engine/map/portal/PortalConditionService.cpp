@@ -0,0 +1,137 @@
+#include "../../../../include/headers/map/portal/PortalConditionService.h"
+#include "../../../../include/headers/map/portal/PortalSystem.h"
+#include "../../../../include/headers/map/Area.h"
+#include "../../../../include/headers/CommonDefines.h"
+#include <algorithm>
+
+namespace {
+    // GameState values a condition reads; none for constant ones
+    void collectReads(const PortalCondition& condition, std::vector<GameState::VarId>& outReads) {
+        auto& state = GameState::getInstance();
+        switch (condition.type) {
+        case PortalConditionType::Key:
+            outReads.push_back(state.intern(GameState::keyName(condition.requiredId)));
+            break;
+        case PortalConditionType::Quest:
+            outReads.push_back(state.intern(GameState::questName(condition.requiredId)));
+            break;
+        case PortalConditionType::Level:
+            outReads.push_back(state.getLevelId());
+            break;
+        case PortalConditionType::Custom:
+            if (condition.program) {
+                const auto& reads = condition.program->getReads();
+                outReads.insert(outReads.end(), reads.begin(), reads.end());
+            }
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+PortalConditionService::PortalConditionService() {
+    // Also makes sure GameState outlives this service
+    m_listener = GameState::getInstance().addChangeListener(
+        [this](GameState::VarId id) { onValueChanged(id); });
+}
+
+PortalConditionService::~PortalConditionService() {
+    GameState::getInstance().removeChangeListener(m_listener);
+}
+
+void PortalConditionService::addArea(Area& area) {
+    const auto& portals = area.getPortals();
+    for (size_t i = 0; i < portals.size(); ++i) {
+        PortalCondition& condition = area.getPortal(i).condition;
+        condition.isLive = condition.type == PortalConditionType::Custom &&
+            condition.program && condition.program->readsContext();
+
+        condition.isMet = PortalSystem::checkPortalConditions(portals[i]);
+        ++m_evaluations;
+
+        m_entries.push_back({ &area, static_cast<uint32_t>(i), false });
+        indexEntry(static_cast<uint32_t>(m_entries.size() - 1));
+    }
+}
+
+void PortalConditionService::removeArea(const Area* area) {
+    size_t before = m_entries.size();
+    m_entries.erase(std::remove_if(m_entries.begin(), m_entries.end(),
+        [area](const Entry& entry) { return entry.area == area; }), m_entries.end());
+
+    // Entry indices shifted; areas come and go rarely enough to rebuild
+    if (m_entries.size() != before) {
+        rebuildIndex();
+    }
+}
+
+void PortalConditionService::update() {
+    if (m_queue.empty()) return;
+
+    for (uint32_t index : m_queue) {
+        Entry& entry = m_entries[index];
+        entry.queued = false;
+        evaluate(entry);
+    }
+    m_queue.clear();
+}
+
+bool PortalConditionService::isOpen(const PortalData& portal) {
+    if (portal.condition.isLive) {
+        return PortalSystem::checkPortalConditions(portal);
+    }
+    return portal.condition.isMet;
+}
+
+void PortalConditionService::indexEntry(uint32_t entry) {
+    const PortalData& portal = m_entries[entry].area->getPortals()[m_entries[entry].portalIndex];
+    if (portal.condition.isLive) return;
+
+    std::vector<GameState::VarId> reads;
+    collectReads(portal.condition, reads);
+    for (GameState::VarId id : reads) {
+        if (id >= m_readers.size()) {
+            m_readers.resize(id + 1);
+        }
+        m_readers[id].push_back(entry);
+    }
+}
+
+void PortalConditionService::rebuildIndex() {
+    for (auto& readers : m_readers) {
+        readers.clear();
+    }
+    m_queue.clear();
+
+    for (uint32_t i = 0; i < m_entries.size(); ++i) {
+        indexEntry(i);
+        if (m_entries[i].queued) {
+            m_queue.push_back(i);
+        }
+    }
+}
+
+void PortalConditionService::onValueChanged(GameState::VarId id) {
+    if (id >= m_readers.size()) return;
+
+    for (uint32_t index : m_readers[id]) {
+        Entry& entry = m_entries[index];
+        if (!entry.queued) {
+            entry.queued = true;
+            m_queue.push_back(index);
+        }
+    }
+}
+
+void PortalConditionService::evaluate(const Entry& entry) {
+    PortalData& portal = entry.area->getPortal(entry.portalIndex);
+    bool met = PortalSystem::checkPortalConditions(portal);
+    ++m_evaluations;
+
+    if (met != portal.condition.isMet) {
+        DEBUG_LOG("Portal to " << portal.targetAreaId << " in " << entry.area->getId() <<
+            (met ? " opened" : " closed"));
+        portal.condition.isMet = met;
+    }
+}
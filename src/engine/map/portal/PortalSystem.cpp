@@ -1,6 +1,9 @@
 #include "../../../../include/headers/map/portal/PortalSystem.h"
+#include "../../../../include/headers/map/portal/PortalConditionService.h"
 #include <iostream>
 #include "../../../../include/headers/CommonDefines.h"
+#include "../../../../include/headers/core/GameState.h"
+#include "../../../../include/headers/Engine.h"
 
 bool PortalSystem::isInPortalRange(const BoxCollider* playerCollider,
     const PortalData& portal) {
@@ -20,6 +23,7 @@ bool PortalSystem::checkPortalTrigger(const BoxCollider* playerCollider,
             DEBUG_LOG_WARN("Invalid portal data detected");
             continue;
         }
+        if (!PortalConditionService::isOpen(portal)) continue;
 
         BoxCollider portalCollider(portal.position, portal.size);
         portalCollider.setCollisionLayer(0x0008);  // Portal layer
@@ -45,17 +49,22 @@ bool PortalSystem::checkPortalConditions(const PortalData& portal) {
         return true;
 
     case PortalConditionType::Key:
-        return portal.condition.isMet;
+        return GameState::getInstance().hasKey(portal.condition.requiredId);
 
     case PortalConditionType::Quest:
-        return portal.condition.isMet;
+        return GameState::getInstance().isQuestComplete(portal.condition.requiredId);
 
     case PortalConditionType::Level:
-        return portal.condition.isMet;
+        return GameState::getInstance().getLevel() >= portal.condition.requiredLevel;
 
-    case PortalConditionType::Custom:
-        return portal.condition.customCheck ?
-            portal.condition.customCheck() : false;
+    case PortalConditionType::Custom: {
+        // An expression that failed to compile keeps the portal shut
+        if (!portal.condition.program) return false;
+
+        ExpressionContext context;
+        context.origin = portal.position + portal.size * 0.5f;
+        return portal.condition.program->test(Engine::getInstance().getExpressionEnvironment(), context);
+    }
 
     default:
         return false;
@@ -205,6 +205,29 @@ void Renderer::drawTexturedQuad(const TextureData* texture, const RenderProperti
     glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
 }
 
+void Renderer::drawTexturedMesh(GLuint vao, GLsizei vertexCount, const TextureData* texture, const glm::vec4& color) {
+    if (!texture || !vao || vertexCount == 0) return;
+
+    glUseProgram(m_textureShaderProgram);
+
+    const glm::mat4 model(1.0f);
+    GLint modelLoc = glGetUniformLocation(m_textureShaderProgram, "model");
+    GLint viewLoc = glGetUniformLocation(m_textureShaderProgram, "view");
+    GLint projectionLoc = glGetUniformLocation(m_textureShaderProgram, "projection");
+    GLint colorLoc = glGetUniformLocation(m_textureShaderProgram, "color");
+
+    glUniformMatrix4fv(modelLoc, 1, GL_FALSE, glm::value_ptr(model));
+    glUniformMatrix4fv(viewLoc, 1, GL_FALSE, glm::value_ptr(m_camera->getViewMatrix()));
+    glUniformMatrix4fv(projectionLoc, 1, GL_FALSE, glm::value_ptr(m_camera->getProjectionMatrix()));
+    glUniform4fv(colorLoc, 1, glm::value_ptr(color));
+
+    glActiveTexture(GL_TEXTURE0);
+    glBindTexture(GL_TEXTURE_2D, texture->id);
+
+    glBindVertexArray(vao);
+    glDrawArrays(GL_TRIANGLES, 0, vertexCount);
+}
+
 void Renderer::shutdown() {
     glDeleteVertexArrays(1, &m_VAO);
     glDeleteBuffers(1, &m_VBO);
@@ -309,6 +332,13 @@ void Renderer::drawRect(const glm::vec2& position, const glm::vec2& size, const
     glDrawElements(GL_TRIANGLES, 6, GL_UNSIGNED_INT, 0);
 }
 
+void Renderer::drawScreenRect(const glm::vec2& position, const glm::vec2& size, const glm::vec3& color, float alpha) {
+    // The camera is centred on its position and scaled by its zoom
+    float zoom = m_camera->getZoom();
+    glm::vec2 viewTopLeft = m_camera->getPosition() - m_screenSize * 0.5f / zoom;
+    drawRect(viewTopLeft + position / zoom, size / zoom, color, alpha);
+}
+
 void Renderer::updateCamera(float deltaTime) {
     if (InputManager::getInstance().isKeyPressed(GLFW_KEY_MINUS)) {
         m_camera->setZoom(m_camera->getZoom() - deltaTime);
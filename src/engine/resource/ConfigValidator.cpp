@@ -37,6 +37,12 @@ bool ConfigValidator::validateMechanismConfig(const nlohmann::json& json) {
         case 1: // Sequence
             if (!validateSequenceMechanism(mech)) return false;
             break;
+        case 2: // Breakable
+        case 3: // MovingPlatform
+        case 4: // Trap
+        case 6: // BuffZone
+            if (!validateMachineMechanism(mech)) return false;
+            break;
         }
     }
 
@@ -67,4 +73,11 @@ bool ConfigValidator::validateSequenceMechanism(const nlohmann::json& json) {
         "sequence"
     };
     return checkRequiredFields(json, requiredFields);
+}
+
+bool ConfigValidator::validateMachineMechanism(const nlohmann::json& json) {
+    std::vector<std::string> requiredFields = {
+        "position", "size", "machine"
+    };
+    return checkRequiredFields(json, requiredFields);
 }
\ No newline at end of file
@@ -0,0 +1,236 @@
+#include "../../../include/headers/resource/FileWatcher.h"
+#include "../../../include/headers/CommonDefines.h"
+#include <filesystem>
+#include <iostream>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <sys/inotify.h>
+#include <poll.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    std::string trimTrailingSeparators(std::string path) {
+        while (path.size() > 1 && (path.back() == '/' || path.back() == '\\')) {
+            path.pop_back();
+        }
+        return path;
+    }
+}
+
+void FileWatcher::recordChange(const std::string& path) {
+    m_pending[path] = Clock::now();
+}
+
+std::vector<std::string> FileWatcher::takeSettledChanges(std::chrono::milliseconds debounce) {
+    std::vector<std::string> settled;
+    auto now = Clock::now();
+
+    for (auto it = m_pending.begin(); it != m_pending.end();) {
+        if (now - it->second >= debounce) {
+            settled.push_back(it->first);
+            it = m_pending.erase(it);
+        }
+        else {
+            ++it;
+        }
+    }
+    return settled;
+}
+
+#ifdef _WIN32
+
+namespace {
+    constexpr DWORD WATCH_BUFFER_SIZE = 64 * 1024;
+    constexpr DWORD WATCH_FILTER = FILE_NOTIFY_CHANGE_LAST_WRITE | FILE_NOTIFY_CHANGE_FILE_NAME | FILE_NOTIFY_CHANGE_SIZE;
+}
+
+bool FileWatcher::open(const std::string& rootPath) {
+    close();
+
+    std::string root = trimTrailingSeparators(rootPath);
+    HANDLE directory = CreateFileA(root.c_str(), FILE_LIST_DIRECTORY,
+        FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr, OPEN_EXISTING,
+        FILE_FLAG_BACKUP_SEMANTICS | FILE_FLAG_OVERLAPPED, nullptr);
+    if (directory == INVALID_HANDLE_VALUE) {
+        DEBUG_LOG_ERROR("Failed to watch directory: " << root);
+        return false;
+    }
+
+    HANDLE event = CreateEventA(nullptr, TRUE, FALSE, nullptr);
+    if (!event) {
+        CloseHandle(directory);
+        return false;
+    }
+
+    auto* overlapped = new OVERLAPPED{};
+    overlapped->hEvent = event;
+
+    m_rootPath = root;
+    m_directoryHandle = directory;
+    m_eventHandle = event;
+    m_overlapped = overlapped;
+    m_buffer.assign(WATCH_BUFFER_SIZE / sizeof(unsigned long), 0);
+
+    if (!issueRead()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+bool FileWatcher::issueRead() {
+    auto* overlapped = static_cast<OVERLAPPED*>(m_overlapped);
+    ResetEvent(overlapped->hEvent);
+
+    if (!ReadDirectoryChangesW(m_directoryHandle, m_buffer.data(), WATCH_BUFFER_SIZE, TRUE,
+        WATCH_FILTER, nullptr, overlapped, nullptr)) {
+        DEBUG_LOG_ERROR("ReadDirectoryChangesW failed for: " << m_rootPath);
+        return false;
+    }
+    return true;
+}
+
+void FileWatcher::close() {
+    if (m_directoryHandle) {
+        CancelIoEx(m_directoryHandle, static_cast<OVERLAPPED*>(m_overlapped));
+        DWORD ignored = 0;
+        GetOverlappedResult(m_directoryHandle, static_cast<OVERLAPPED*>(m_overlapped), &ignored, TRUE);
+        CloseHandle(m_directoryHandle);
+        m_directoryHandle = nullptr;
+    }
+    if (m_eventHandle) {
+        CloseHandle(m_eventHandle);
+        m_eventHandle = nullptr;
+    }
+    delete static_cast<OVERLAPPED*>(m_overlapped);
+    m_overlapped = nullptr;
+    m_pending.clear();
+}
+
+bool FileWatcher::isOpen() const {
+    return m_directoryHandle != nullptr;
+}
+
+void FileWatcher::waitForEvents(int timeoutMs) {
+    if (!m_directoryHandle) return;
+
+    if (WaitForSingleObject(m_eventHandle, static_cast<DWORD>(timeoutMs)) != WAIT_OBJECT_0) {
+        return;
+    }
+
+    DWORD bytes = 0;
+    if (!GetOverlappedResult(m_directoryHandle, static_cast<OVERLAPPED*>(m_overlapped), &bytes, FALSE)) {
+        issueRead();
+        return;
+    }
+
+    // bytes == 0 means the buffer overflowed, the events are lost but we keep watching
+    const auto* base = reinterpret_cast<const unsigned char*>(m_buffer.data());
+    for (DWORD offset = 0; bytes > 0;) {
+        const auto* info = reinterpret_cast<const FILE_NOTIFY_INFORMATION*>(base + offset);
+        if (info->Action == FILE_ACTION_ADDED || info->Action == FILE_ACTION_MODIFIED ||
+            info->Action == FILE_ACTION_RENAMED_NEW_NAME) {
+            std::wstring name(info->FileName, info->FileNameLength / sizeof(WCHAR));
+            recordChange((std::filesystem::path(m_rootPath) / name).generic_string());
+        }
+
+        if (info->NextEntryOffset == 0) break;
+        offset += info->NextEntryOffset;
+    }
+
+    issueRead();
+}
+
+#else
+
+namespace {
+    constexpr uint32_t WATCH_MASK = IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE;
+}
+
+bool FileWatcher::open(const std::string& rootPath) {
+    close();
+
+    m_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (m_fd < 0) {
+        DEBUG_LOG_ERROR("Failed to initialize inotify");
+        return false;
+    }
+
+    m_rootPath = trimTrailingSeparators(rootPath);
+    addWatchRecursive(m_rootPath);
+    if (m_watchPaths.empty()) {
+        close();
+        return false;
+    }
+    return true;
+}
+
+void FileWatcher::addWatchRecursive(const std::string& directory) {
+    int wd = inotify_add_watch(m_fd, directory.c_str(), WATCH_MASK);
+    if (wd < 0) {
+        DEBUG_LOG_WARN("Failed to watch directory: " << directory);
+        return;
+    }
+    m_watchPaths[wd] = directory;
+
+    std::error_code error;
+    for (const auto& entry : std::filesystem::directory_iterator(directory, error)) {
+        if (entry.is_directory(error)) {
+            addWatchRecursive(entry.path().generic_string());
+        }
+    }
+}
+
+void FileWatcher::close() {
+    if (m_fd >= 0) {
+        ::close(m_fd);
+        m_fd = -1;
+    }
+    m_watchPaths.clear();
+    m_pending.clear();
+}
+
+bool FileWatcher::isOpen() const {
+    return m_fd >= 0;
+}
+
+void FileWatcher::waitForEvents(int timeoutMs) {
+    if (m_fd < 0) return;
+
+    pollfd descriptor{ m_fd, POLLIN, 0 };
+    if (poll(&descriptor, 1, timeoutMs) <= 0) {
+        return;
+    }
+
+    alignas(inotify_event) char buffer[16 * 1024];
+    for (;;) {
+        ssize_t length = read(m_fd, buffer, sizeof(buffer));
+        if (length <= 0) break;
+
+        for (ssize_t offset = 0; offset < length;) {
+            const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+            offset += sizeof(inotify_event) + event->len;
+
+            auto it = m_watchPaths.find(event->wd);
+            if (it == m_watchPaths.end() || event->len == 0) continue;
+
+            std::string path = it->second + "/" + event->name;
+            if (event->mask & IN_ISDIR) {
+                if (event->mask & (IN_CREATE | IN_MOVED_TO)) {
+                    addWatchRecursive(path);
+                }
+                continue;
+            }
+
+            // IN_CREATE alone is followed by IN_CLOSE_WRITE once the content is there
+            if (event->mask & (IN_CLOSE_WRITE | IN_MOVED_TO)) {
+                recordChange(path);
+            }
+        }
+    }
+}
+
+#endif
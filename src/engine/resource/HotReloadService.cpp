@@ -0,0 +1,147 @@
+#include "../../../include/headers/resource/HotReloadService.h"
+#include "../../../include/headers/resource/ResourceManager.h"
+#include "../../../include/headers/map/AreaCooker.h"
+#include "../../../include/headers/map/MapManager.h"
+#include "../../../include/headers/map/mechanism/StateMachineLibrary.h"
+#include "../../../include/headers/CommonDefines.h"
+#include <filesystem>
+#include <algorithm>
+#include <iostream>
+
+namespace {
+    bool isImageFile(const std::filesystem::path& path) {
+        std::string extension = path.extension().string();
+        std::transform(extension.begin(), extension.end(), extension.begin(),
+            [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        return extension == ".png" || extension == ".jpg" || extension == ".jpeg" ||
+            extension == ".bmp" || extension == ".tga";
+    }
+}
+
+bool HotReloadService::start(const std::string& resourceRoot) {
+    if (m_running) return true;
+
+    if (!m_watcher.open(resourceRoot)) {
+        DEBUG_LOG_WARN("Hot reload disabled, cannot watch: " << resourceRoot);
+        return false;
+    }
+
+    m_resourceRoot = std::filesystem::path(resourceRoot).lexically_normal().generic_string();
+    m_running = true;
+    m_worker = std::thread(&HotReloadService::workerLoop, this);
+
+    std::cout << "Hot reload watching: " << m_resourceRoot << std::endl;
+    return true;
+}
+
+void HotReloadService::stop() {
+    if (!m_running) return;
+
+    m_running = false;
+    if (m_worker.joinable()) {
+        m_worker.join();
+    }
+    m_watcher.close();
+
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_pending.clear();
+}
+
+void HotReloadService::workerLoop() {
+    while (m_running) {
+        m_watcher.waitForEvents(POLL_INTERVAL_MS);
+
+        for (const auto& path : m_watcher.takeSettledChanges(DEBOUNCE)) {
+            processChange(path);
+        }
+    }
+}
+
+void HotReloadService::processChange(const std::string& path) {
+    std::filesystem::path relative = std::filesystem::path(path).lexically_normal()
+        .lexically_relative(m_resourceRoot);
+    std::vector<std::string> parts;
+    for (const auto& part : relative) {
+        parts.push_back(part.string());
+    }
+    if (parts.empty()) return;
+
+    if (parts[0] == "textures" && isImageFile(relative)) {
+        PendingReload reload{ ReloadKind::Texture, path };
+        if (ResourceManager::getInstance().decodeTexture(path, reload.texture)) {
+            queueReload(std::move(reload));
+        }
+        return;
+    }
+
+    if (relative.extension() != ".json") return;
+
+    // maps/mechanisms/machines/<name>.json is shared by every area that places one
+    if (parts.size() == 4 && parts[0] == "maps" && parts[1] == "mechanisms" && parts[2] == "machines") {
+        PendingReload reload{ ReloadKind::Machine, path, relative.stem().string() };
+        nlohmann::json json;
+        if (ResourceManager::getInstance().loadMechanismConfig("machines", reload.areaId, json)) {
+            reload.machine = MechanismStateTable::compile(reload.areaId, json);
+        }
+        if (!reload.machine) {
+            std::cerr << "Hot reload: " << path << " has errors, keeping the loaded machine" << std::endl;
+            return;
+        }
+        queueReload(std::move(reload));
+        return;
+    }
+
+    // maps/areas/<id>.json, or maps/mechanisms/triggers/<id>.json which belongs to area <id>
+    bool isArea = parts.size() == 3 && parts[0] == "maps" && parts[1] == "areas";
+    bool isTriggers = parts.size() == 4 && parts[0] == "maps" && parts[1] == "mechanisms" && parts[2] == "triggers";
+    if (!isArea && !isTriggers) return;
+
+    PendingReload reload{ ReloadKind::Area, path, relative.stem().string() };
+    if (!AreaCooker::loadJsonDefinition(reload.areaId, reload.area)) {
+        std::cerr << "Hot reload: " << path << " has errors, keeping the loaded area" << std::endl;
+        return;
+    }
+    queueReload(std::move(reload));
+}
+
+void HotReloadService::queueReload(PendingReload&& reload) {
+    std::lock_guard<std::mutex> lock(m_mutex);
+
+    // A newer result for the same file replaces the one not applied yet
+    for (auto& pending : m_pending) {
+        if (pending.kind == reload.kind &&
+            (reload.kind == ReloadKind::Texture ? pending.path == reload.path : pending.areaId == reload.areaId)) {
+            pending = std::move(reload);
+            return;
+        }
+    }
+    m_pending.push_back(std::move(reload));
+}
+
+void HotReloadService::applyPendingReloads() {
+    std::vector<PendingReload> pending;
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_pending.empty()) return;
+        pending.swap(m_pending);
+    }
+
+    for (auto& reload : pending) {
+        switch (reload.kind) {
+        case ReloadKind::Texture:
+            if (ResourceManager::getInstance().reloadTexturesFromFile(reload.path, reload.texture) == 0) {
+                DEBUG_LOG("Changed image is not loaded as a texture: " << reload.path);
+            }
+            break;
+        case ReloadKind::Area:
+            MapManager::getInstance().reloadArea(reload.areaId, reload.area);
+            break;
+        case ReloadKind::Machine: {
+            StateMachineLibrary::getInstance().setMachine(reload.areaId, std::move(reload.machine));
+            int areas = MapManager::getInstance().reloadMachineUsers(reload.areaId);
+            DEBUG_LOG("Reloaded machine " << reload.areaId << " in " << areas << " area(s)");
+            break;
+        }
+        }
+    }
+}
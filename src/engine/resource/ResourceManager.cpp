@@ -3,6 +3,7 @@
 #include <iostream>
 #include "../../../include/headers/resource/ResourceManager.h"
 #include "../../../include/headers/audio/AudioManager.h"
+#include "../../../include/headers/resource/MappedFile.h"
 #include <windows.h>
 
 // Path management
@@ -98,10 +99,12 @@ void ResourceManager::createResourceDirectories() {
         getTexturePath("backgrounds"),
         getTexturePath("ui"),
         getBasePath() + "maps/areas",
+        getBasePath() + "maps/cooked",
         getBasePath() + "maps/mechanisms/triggers",
         getBasePath() + "maps/mechanisms/sequences",
         getAudioPath("bgm"),
-        getAudioPath("sfx")
+        getAudioPath("sfx"),
+        getBasePath() + "config"
     };
 
     for (const auto& dir : directories) {
@@ -129,10 +132,6 @@ bool ResourceManager::loadTexture(const std::string& name, const std::string& pa
         return false;
     }
 
-    // Create new texture data
-    auto textureData = std::make_unique<TextureData>();
-    textureData->name = name;
-
     // Load image data
     int width, height, channels;
     unsigned char* data = loadTextureData(resolvedPath, width, height, channels);
@@ -141,6 +140,34 @@ bool ResourceManager::loadTexture(const std::string& name, const std::string& pa
         return false;
     }
 
+    createTexture(name, resolvedPath, data, width, height, channels);
+
+    // Free image data
+    freeTextureData(data);
+    return true;
+}
+
+bool ResourceManager::loadTextureFromDecoded(const std::string& name, const std::string& path,
+    const DecodedTexture& texture) {
+    if (m_textures.find(name) != m_textures.end()) {
+        return true;
+    }
+    if (texture.pixels.empty()) {
+        DEBUG_LOG_ERROR("No decoded pixels for texture: " << name);
+        return false;
+    }
+
+    createTexture(name, resolvePath(path), texture.pixels.data(), texture.width, texture.height, texture.channels);
+    return true;
+}
+
+void ResourceManager::createTexture(const std::string& name, const std::string& resolvedPath,
+    const unsigned char* pixels, int width, int height, int channels) {
+    // Create new texture data
+    auto textureData = std::make_unique<TextureData>();
+    textureData->name = name;
+    textureData->sourcePath = normalizePath(resolvedPath);
+
     // Create OpenGL texture
     GLuint textureID;
     glGenTextures(1, &textureID);
@@ -156,7 +183,7 @@ bool ResourceManager::loadTexture(const std::string& name, const std::string& pa
     GLenum format = getGLFormat(channels);
 
     // Load texture data to GPU and generate mipmaps
-    glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, data);
+    glTexImage2D(GL_TEXTURE_2D, 0, format, width, height, 0, format, GL_UNSIGNED_BYTE, pixels);
     glGenerateMipmap(GL_TEXTURE_2D);
 
     // Store texture data
@@ -165,15 +192,20 @@ bool ResourceManager::loadTexture(const std::string& name, const std::string& pa
     textureData->height = height;
     textureData->channels = channels;
 
-    // Free image data
-    freeTextureData(data);
-
     // Store in map
     m_textures[name] = std::move(textureData);
 
     std::cout << "Loaded texture: " << name << " (" << width << "x" << height
         << ", " << channels << " channels)" << std::endl;
-    return true;
+}
+
+size_t ResourceManager::getTextureMemoryUsage(const std::string& name) const {
+    auto it = m_textures.find(name);
+    if (it == m_textures.end()) return 0;
+
+    // base level plus roughly a third for the mip chain
+    size_t base = static_cast<size_t>(it->second->width) * it->second->height * it->second->channels;
+    return base + base / 3;
 }
 
 void ResourceManager::unloadTexture(const std::string& name) {
@@ -193,6 +225,59 @@ TextureData* ResourceManager::getTexture(const std::string& name) {
     return it->second.get();
 }
 
+bool ResourceManager::decodeTexture(const std::string& path, DecodedTexture& outTexture) const {
+    // per thread flag, the global one belongs to the GL thread
+    stbi_set_flip_vertically_on_load_thread(true);
+
+    int width, height, channels;
+    unsigned char* data = stbi_load(path.c_str(), &width, &height, &channels, 0);
+    if (!data) {
+        DEBUG_LOG_ERROR("Failed to decode image: " << path << " STB Error: " << stbi_failure_reason());
+        return false;
+    }
+
+    outTexture.width = width;
+    outTexture.height = height;
+    outTexture.channels = channels;
+    outTexture.pixels.assign(data, data + static_cast<size_t>(width) * height * channels);
+    stbi_image_free(data);
+    return true;
+}
+
+int ResourceManager::reloadTexturesFromFile(const std::string& path, const DecodedTexture& texture) {
+    std::string normalized = normalizePath(path);
+    GLenum format = getGLFormat(texture.channels);
+    int reloaded = 0;
+
+    for (auto& [name, textureData] : m_textures) {
+        if (textureData->sourcePath != normalized) continue;
+
+        // Same GL name, so sprites and renderers holding the id pick up the new pixels
+        glBindTexture(GL_TEXTURE_2D, textureData->id);
+        glTexImage2D(GL_TEXTURE_2D, 0, format, texture.width, texture.height, 0,
+            format, GL_UNSIGNED_BYTE, texture.pixels.data());
+        glGenerateMipmap(GL_TEXTURE_2D);
+
+        textureData->width = texture.width;
+        textureData->height = texture.height;
+        textureData->channels = texture.channels;
+        ++reloaded;
+
+        std::cout << "Reloaded texture: " << name << " (" << texture.width << "x" << texture.height << ")" << std::endl;
+    }
+
+    return reloaded;
+}
+
+std::string ResourceManager::normalizePath(const std::string& path) {
+    std::error_code error;
+    std::filesystem::path canonical = std::filesystem::weakly_canonical(path, error);
+    if (error) {
+        canonical = std::filesystem::path(path).lexically_normal();
+    }
+    return canonical.generic_string();
+}
+
 unsigned char* ResourceManager::loadTextureData(const std::string& path, int& width, int& height, int& channels) {
     stbi_set_flip_vertically_on_load(true);
     unsigned char* data = stbi_load(path.c_str(), &width, &height, &channels, 0);
@@ -239,6 +324,44 @@ bool ResourceManager::loadSound(const std::string& name, const std::string& path
     return true;
 }
 
+bool ResourceManager::readSoundFile(const std::string& path, std::vector<char>& outData) const {
+    std::string resolvedPath = resolvePath(path);
+    std::ifstream file(resolvedPath, std::ios::binary | std::ios::ate);
+    if (!file) {
+        DEBUG_LOG_WARN("Sound file not found: " << resolvedPath);
+        return false;
+    }
+
+    std::streamsize size = file.tellg();
+    file.seekg(0, std::ios::beg);
+    outData.resize(static_cast<size_t>(size));
+    if (size > 0 && !file.read(outData.data(), size)) {
+        DEBUG_LOG_ERROR("Failed to read sound file: " << resolvedPath);
+        outData.clear();
+        return false;
+    }
+    return true;
+}
+
+bool ResourceManager::loadSoundFromMemory(const std::string& name, const std::string& path, const std::vector<char>& data) {
+    if (!m_soundEngine) {
+        DEBUG_LOG_ERROR("Sound engine not initialized");
+        return false;
+    }
+
+    // irrKlang picks the decoder from the extension of the source name, so keep the file path
+    std::string resolvedPath = resolvePath(path);
+    auto source = m_soundEngine->addSoundSourceFromMemory(const_cast<char*>(data.data()),
+        static_cast<irrklang::ik_s32>(data.size()), resolvedPath.c_str(), true);
+    if (!source) {
+        DEBUG_LOG_ERROR("Failed to load sound: " << name);
+        return false;
+    }
+
+    m_sounds[name] = source;
+    return true;
+}
+
 void ResourceManager::unloadSound(const std::string& name) {
     auto it = m_sounds.find(name);
     if (it != m_sounds.end()) {
@@ -316,37 +439,100 @@ bool ResourceManager::preloadResources(const std::string& configPath) {
     return success;
 }
 
-bool ResourceManager::loadPreloadConfig(const std::string& configPath, PreloadConfig& config) {
-    nlohmann::json json;
-    std::string resolvedPath = resolvePath(configPath);
-
-    if (!loadJsonFile(resolvedPath, json)) {
-        return false;
-    }
-
-    try {
-        if (json.contains("textures")) {
-            for (const auto& texture : json["textures"]) {
-                config.textures.push_back(texture.get<std::string>());
+namespace {
+    // Collects the string arrays of a preload config straight from the parser
+    class PreloadConfigHandler {
+    public:
+        using json = nlohmann::json;
+
+        PreloadConfigHandler(std::vector<std::string>& textures, std::vector<std::string>& sounds,
+            std::vector<std::string>& maps)
+            : m_textures(textures), m_sounds(sounds), m_maps(maps) {}
+
+        const std::string& error() const { return m_error; }
+
+        bool null() { return unexpected(); }
+        bool boolean(bool) { return unexpected(); }
+        bool number_integer(json::number_integer_t) { return unexpected(); }
+        bool number_unsigned(json::number_unsigned_t) { return unexpected(); }
+        bool number_float(json::number_float_t, const json::string_t&) { return unexpected(); }
+        bool binary(json::binary_t&) { return unexpected(); }
+
+        bool string(json::string_t& value) {
+            if (m_depth == 2 && m_list) {
+                m_list->push_back(std::move(value));
+                return true;
             }
+            return unexpected();
         }
 
-        if (json.contains("sounds")) {
-            for (const auto& sound : json["sounds"]) {
-                config.sounds.push_back(sound.get<std::string>());
+        bool key(json::string_t& key) {
+            if (m_depth == 1) {
+                if (key == "textures") m_list = &m_textures;
+                else if (key == "sounds") m_list = &m_sounds;
+                else if (key == "maps") m_list = &m_maps;
+                else m_list = nullptr;
             }
+            return true;
+        }
+
+        bool start_object(std::size_t) {
+            if (m_depth > 0 && m_list) return unexpected();
+            return enter();
+        }
+        bool end_object() { return leave(); }
+        bool start_array(std::size_t) {
+            if (m_depth == 0 || (m_depth > 1 && m_list)) return unexpected();
+            return enter();
+        }
+        bool end_array() { return leave(); }
+
+        bool parse_error(std::size_t position, const std::string&, const nlohmann::detail::exception& e) {
+            m_error = "byte " + std::to_string(position) + ": " + e.what();
+            return false;
         }
 
-        if (json.contains("maps")) {
-            for (const auto& map : json["maps"]) {
-                config.maps.push_back(map.get<std::string>());
+    private:
+        std::vector<std::string>& m_textures;
+        std::vector<std::string>& m_sounds;
+        std::vector<std::string>& m_maps;
+        std::vector<std::string>* m_list = nullptr;
+        int m_depth = 0;
+        std::string m_error;
+
+        bool enter() { ++m_depth; return true; }
+        bool leave() { --m_depth; return true; }
+
+        // Unknown keys may hold anything, the three lists must only hold strings
+        bool unexpected() {
+            if (m_depth > 0 && m_list) {
+                m_error = "expected a string entry";
+                return false;
             }
+            if (m_depth == 0) {
+                m_error = "expected an object";
+                return false;
+            }
+            return true;
         }
+    };
+}
 
-        return true;
+bool ResourceManager::loadPreloadConfig(const std::string& configPath, PreloadConfig& config) {
+    std::string resolvedPath = resolvePath(configPath);
+
+    MappedFile file;
+    if (!file.open(resolvedPath)) {
+        DEBUG_LOG_ERROR("Failed to open file: " << resolvedPath);
+        return false;
     }
-    catch (const nlohmann::json::exception& e) {
-        DEBUG_LOG_ERROR("Failed to parse preload config: " << configPath << " Error: " << e.what());
+
+    const char* begin = reinterpret_cast<const char*>(file.data());
+    PreloadConfigHandler handler(config.textures, config.sounds, config.maps);
+    if (!nlohmann::json::sax_parse(begin, begin + file.size(), &handler)) {
+        DEBUG_LOG_ERROR("Failed to parse preload config: " << configPath << " Error: " << handler.error());
         return false;
     }
+
+    return true;
 }
\ No newline at end of file
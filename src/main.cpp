@@ -1,7 +1,16 @@
 #include "../include/headers/Engine.h"
+#include "../include/headers/map/AreaCooker.h"
+#include <cstring>
 
 
-int main() {
+int main(int argc, char* argv[]) {
+    // Compile every area json into resources/maps/cooked and exit
+    if (argc > 1 && std::strcmp(argv[1], "--cook-maps") == 0) {
+        int cooked = AreaCooker::cookAllAreas();
+        std::cout << "Cooked " << cooked << " areas" << std::endl;
+        return cooked > 0 ? 0 : -1;
+    }
+
     Engine& engine = Engine::getInstance();
 
     if (!engine.initialize("Game Project", 800, 600)) {
@@ -10,4 +19,4 @@ int main() {
 
     engine.run();
     return 0;
-}
\ No newline at end of file
+}